@@ -29,6 +29,9 @@ extern "C"
 #define ARM_DMA_USER_PROVIDED_MCODE     (0x01UL)    ///< Use User provided microcode; arg = microcode address in memory
 #define ARM_DMA_I2S_MONO_MODE           (0x02UL)    ///< Support for I2S mono mode;
 #define ARM_DMA_CRC_MODE                (0x03UL)    ///< Support for CRC which doesn't require handshaking
+#define ARM_DMA_SCATTER_GATHER          (0x04UL)    ///< Scatter-gather transfer; arg = pointer to \ref ARM_DMA_SG_LIST (0 to disable)
+#define ARM_DMA_CYCLIC_MODE             (0x05UL)    ///< Cyclic transfer; arg = number of periods 1..255 (0 to disable)
+#define ARM_DMA_PREPARE_XFER            (0x06UL)    ///< Build the channel program ahead of Start; arg = pointer to \ref ARM_DMA_PARAMS
 
 /**
 \brief DMA Data Direction
@@ -86,9 +89,43 @@ typedef struct _ARM_DMA_PARAMS {
   ARM_DMA_SignalEvent_t     cb_event;
 } ARM_DMA_PARAMS;
 
+/**
+\brief DMA Scatter-Gather segment
+*/
+typedef struct _ARM_DMA_SG_ENTRY {
+  volatile const void       *src_addr;  ///< Segment source address
+  volatile void             *dst_addr;  ///< Segment destination address
+  uint32_t                  num_bytes;  ///< Segment length in bytes
+  uint32_t                  flags;      ///< Segment flags \ref ARM_DMA_SG_FLAG_EVENT
+} ARM_DMA_SG_ENTRY;
+
+#define ARM_DMA_SG_FLAG_EVENT           (1UL << 0)  ///< Signal \ref ARM_DMA_EVENT_SEGMENT once the segment is written
+
+/**
+\brief DMA Scatter-Gather list
+
+The whole list is compiled into one channel program by \ref ARM_DMA_Start, so
+the chain costs a single start, completion interrupt and cache pass. The list,
+its entries and the microcode buffer must stay valid until the transfer is
+completed or stopped. When mcode is NULL the channel's own DMA_MICROCODE_SIZE
+buffer is used, which holds only a few segments.
+*/
+typedef struct _ARM_DMA_SG_LIST {
+  const ARM_DMA_SG_ENTRY    *entries;   ///< Segment array
+  uint32_t                  count;      ///< Number of segments
+  void                      *mcode;     ///< Microcode buffer for the chain (NULL: channel buffer)
+  uint32_t                  mcode_size; ///< Microcode buffer size in bytes (max 65535)
+} ARM_DMA_SG_LIST;
+
 /****** DMA Event *****/
 #define ARM_DMA_EVENT_COMPLETE          (1UL << 0)  ///< Transfer completed
 #define ARM_DMA_EVENT_ABORT             (1UL << 1)  ///< Operation Aborted
+#define ARM_DMA_EVENT_SEGMENT           (1UL << 2)  ///< Scatter-gather segment(s) flagged with \ref ARM_DMA_SG_FLAG_EVENT completed
+#define ARM_DMA_EVENT_PERIOD            (1UL << 3)  ///< Cyclic period completed, see \ref ARM_DMA_EVENT_PERIOD_INDEX
+
+#define ARM_DMA_EVENT_PERIOD_INDEX_Pos  16
+#define ARM_DMA_EVENT_PERIOD_INDEX_Msk  (0xFFUL << ARM_DMA_EVENT_PERIOD_INDEX_Pos)
+#define ARM_DMA_EVENT_PERIOD_INDEX(event) (((event) & ARM_DMA_EVENT_PERIOD_INDEX_Msk) >> ARM_DMA_EVENT_PERIOD_INDEX_Pos) ///< Last completed period
 
 
 
@@ -117,7 +154,17 @@ typedef struct _ARM_DMA_PARAMS {
   \return      \ref execution_status
 
   \fn          int32_t ARM_DMA_Start (DMA_Handle_Type *handle, ARM_DMA_PARAMS *params)
-  \brief       Start the DMA transfer operation using the params
+  \brief       Start the DMA transfer operation using the params. With
+               \ref ARM_DMA_SCATTER_GATHER set, src_addr, dst_addr and
+               num_bytes are taken from the list entries instead. With
+               \ref ARM_DMA_CYCLIC_MODE set, num_bytes is split in equal
+               periods and the transfer loops until \ref ARM_DMA_Stop; the
+               period length must be a multiple of the burst size and below
+               256 bursts. Memory refilled for a cyclic transmit has to be
+               cleaned from the D-cache by the application. When only the
+               addresses differ from the previous transfer (or from
+               \ref ARM_DMA_PREPARE_XFER), the channel program is reused
+               and just its address operands are updated.
   \param[in]   handle  DMA handle for which the transfer operation is requested
   \param[in]   params  DMA parameters required for this transfer operation
   \return      \ref execution_status
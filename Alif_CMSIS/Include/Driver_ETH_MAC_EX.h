@@ -0,0 +1,108 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/**************************************************************************//**
+ * @file     Driver_ETH_MAC_EX.h
+ * @version  V1.0.0
+ * @brief    Extended Header for ETH MAC Driver: zero-copy frame transfer.
+ *           Receive buffers come from a pool of the caller and are lent to
+ *           it with the received frame, transmit buffers are attached to the
+ *           DMA descriptors and handed back once the frame is sent. Received
+ *           frames can be harvested in batches and carry the result of the
+ *           checksum offload engine.
+ * @bug      None
+ * @Note     None
+ ******************************************************************************/
+
+#ifndef Driver_ETH_MAC_EX_H_
+#define Driver_ETH_MAC_EX_H_
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+#include "Driver_ETH_MAC.h"
+
+#define _ARM_Driver_ETH_MAC_EX_(n)      Driver_ETH_MAC##n##_EX
+#define  ARM_Driver_ETH_MAC_EX_(n) _ARM_Driver_ETH_MAC_EX_(n)
+
+/**
+\brief Allocate a receive buffer from the pool of the caller.
+       Buffers are 32-byte aligned and hold at least size bytes.
+\param[in]   size  Buffer size in bytes
+\return      buffer, NULL when the pool is empty
+*/
+typedef void *(*ARM_ETH_MAC_RxAlloc_t) (uint32_t size);
+
+/**
+\brief Give a receive buffer back to the pool of the caller.
+\param[in]   buf  Buffer from \ref ARM_ETH_MAC_RxAlloc_t
+*/
+typedef void  (*ARM_ETH_MAC_RxFree_t)  (void *buf);
+
+/**
+\brief Hand a transmit buffer back to the caller once it is sent.
+       Called from \ref ARM_DRIVER_ETH_MAC_EX::ReleaseTx and the send functions.
+\param[in]   token  Token passed with the buffer to \ref ARM_DRIVER_ETH_MAC_EX::SendFrameZC
+*/
+typedef void  (*ARM_ETH_MAC_TxDone_t)  (void *token);
+
+/****** Receive checksum status *****/
+#define ARM_ETH_MAC_RX_CSUM_IP          (1UL << 0)      ///< IPv4 header checksum verified by the MAC
+#define ARM_ETH_MAC_RX_CSUM_PAYLOAD     (1UL << 1)      ///< TCP, UDP or ICMP checksum verified by the MAC
+
+/**
+\brief Frame lent by \ref ARM_DRIVER_ETH_MAC_EX::ReadFramesZC
+*/
+typedef struct _ARM_ETH_MAC_RX_FRAME {
+  uint8_t  *frame;                      ///< Received frame, to be freed to the pool
+  uint32_t  len;                        ///< Frame length in bytes
+  uint32_t  csum;                       ///< Receive checksum status (ARM_ETH_MAC_RX_CSUM_...)
+} ARM_ETH_MAC_RX_FRAME;
+
+/**
+\brief Transfer counters
+*/
+typedef struct _ARM_ETH_MAC_EX_STATS {
+  uint32_t rx_frames_zc;                ///< Frames lent to the caller
+  uint32_t tx_frames_zc;                ///< Frames sent from caller buffers
+  uint32_t rx_frames_copied;            ///< Frames copied by ReadFrame
+  uint32_t tx_frames_copied;            ///< Frames copied by SendFrame
+  uint32_t bytes_copied;                ///< Bytes copied by ReadFrame and SendFrame
+  uint32_t rx_alloc_fail;               ///< Receive buffer refills refused by the pool
+  uint32_t tx_descs;                    ///< Tx descriptors queued, one per fragment
+  uint32_t rx_batches;                  ///< ReadFramesZC calls that returned frames
+  uint32_t rx_batch_frames;             ///< Frames returned by ReadFramesZC
+  uint32_t rx_batch_max;                ///< Largest batch returned by ReadFramesZC
+  uint32_t irqs;                        ///< DMA channel interrupts
+  uint32_t rx_irqs;                     ///< DMA channel interrupts signalling received frames
+  uint32_t rx_csum_errors;              ///< Frames dropped by the receive checksum offload
+} ARM_ETH_MAC_EX_STATS;
+
+/**
+\brief Access structure of the Ethernet MAC Driver extension
+*/
+typedef struct _ARM_DRIVER_ETH_MAC_EX {
+  int32_t  (*SetRxPool)   (ARM_ETH_MAC_RxAlloc_t alloc, ARM_ETH_MAC_RxFree_t free);                 ///< Refill the Rx descriptors from a buffer pool, NULL alloc restores the driver buffers. Pending frames are dropped.
+  int32_t  (*ReadFrameZC) (uint8_t **frame);                                                        ///< Lend the buffer of the received frame to the caller, who frees it to the pool. Returns the frame length, 0 when no frame is pending, ARM_DRIVER_ERROR_BUSY when the pool cannot refill the descriptor.
+  int32_t  (*ReadFramesZC)(ARM_ETH_MAC_RX_FRAME *frames, uint32_t max);                             ///< Lend up to max received frames at once, the Rx tail pointer is moved once per call. Returns the number of frames.
+  uint32_t (*GetRxFrameCsum)(void);                                                                 ///< Get the receive checksum status (ARM_ETH_MAC_RX_CSUM_...) of the frame ReadFrame or ReadFrameZC returns next
+  int32_t  (*SetTxDone)   (ARM_ETH_MAC_TxDone_t cb);                                                ///< Register the transmit buffer release callback
+  int32_t  (*SendFrameZC) (const uint8_t *frame, uint32_t len, uint32_t flags, void *token);        ///< Attach a buffer to a Tx descriptor without copy; flags as SendFrame. The buffer stays owned by the driver until cb(token).
+  uint32_t (*ReleaseTx)   (void);                                                                   ///< Release the buffers of sent frames, returns the number of free Tx descriptors
+  int32_t  (*GetStats)    (ARM_ETH_MAC_EX_STATS *stats);                                            ///< Get the transfer counters
+} const ARM_DRIVER_ETH_MAC_EX;
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* Driver_ETH_MAC_EX_H_ */
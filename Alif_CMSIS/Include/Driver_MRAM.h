@@ -29,7 +29,12 @@ extern "C"
 
 #include "Driver_Common.h"
 
-#define ARM_MRAM_API_VERSION ARM_DRIVER_VERSION_MAJOR_MINOR(1,0)  /* API version */
+#define ARM_MRAM_API_VERSION ARM_DRIVER_VERSION_MAJOR_MINOR(1,1)  /* API version */
+
+/****** MRAM Control Codes *****/
+#define ARM_MRAM_WRITE_SKIP             (0x01UL)    ///< Skip 128-bit lines already holding the data; arg: 0=disabled, 1=enabled
+#define ARM_MRAM_GET_STATS              (0x02UL)    ///< Get program statistics; arg: pointer to \ref ARM_MRAM_STATS
+#define ARM_MRAM_RESET_STATS            (0x03UL)    ///< Clear program statistics; arg: none
 
 // Function documentation
 /**
@@ -86,6 +91,13 @@ extern "C"
                Optional function for faster full chip erase.
   \return      \ref execution_status
 */
+/**
+  \fn          int32_t ARM_MRAM_Control (uint32_t control, uint32_t arg)
+  \brief       Control the MRAM interface.
+  \param[in]   control  Operation
+  \param[in]   arg      Argument of operation
+  \return      \ref execution_status
+*/
 
 /**
 \brief MRAM Driver Capabilities.
@@ -95,6 +107,15 @@ typedef struct _ARM_MRAM_CAPABILITIES {
   uint32_t reserved     : 31;           ///< Reserved (must be zero)
 } ARM_MRAM_CAPABILITIES;
 
+/**
+\brief MRAM program statistics.
+*/
+typedef struct _ARM_MRAM_STATS {
+  uint32_t lines_written;               ///< 128-bit lines programmed
+  uint32_t lines_skipped;               ///< 128-bit lines already holding the data
+  uint32_t cache_cleans;                ///< D-cache clean operations, one per run of programmed lines
+} ARM_MRAM_STATS;
+
 /**
 \brief Access structure of the MRAM Driver
 */
@@ -108,6 +129,7 @@ typedef struct _ARM_DRIVER_MRAM {
   int32_t                (*ProgramData)    (uint32_t addr, const void *data, uint32_t cnt); ///< Pointer to \ref ARM_MRAM_ProgramData : Program data to MRAM.
   int32_t                (*EraseSector)    (uint32_t addr);                                 ///< Pointer to \ref ARM_MRAM_EraseSector : Erase MRAM Sector.
   int32_t                (*EraseChip)      (void);                                          ///< Pointer to \ref ARM_MRAM_EraseChip : Erase complete MRAM.
+  int32_t                (*Control)        (uint32_t control, uint32_t arg);                ///< Pointer to \ref ARM_MRAM_Control : Control MRAM Interface.
 } const ARM_DRIVER_MRAM;
 
 #ifdef  __cplusplus
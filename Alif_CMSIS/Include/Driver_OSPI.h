@@ -141,6 +141,7 @@ extern "C"
 #define ARM_OSPI_SET_ADDR_LENGTH_WAIT_CYCLE    (0x15UL << ARM_OSPI_CONTROL_POS)
 #define ARM_OSPI_SET_FRAME_FORMAT              (0x16UL << ARM_OSPI_CONTROL_POS)
 #define ARM_OSPI_SET_DDR_MODE                  (0x17UL << ARM_OSPI_CONTROL_POS)
+#define ARM_OSPI_SET_TX_HEADER                 (0x18UL << ARM_OSPI_CONTROL_POS)     ///< Instruction/address frames sent ahead of the next Send; arg = pointer to \ref ARM_OSPI_TX_HEADER
 
 /*----- OSPI Custom Control codes -----*/
 
@@ -183,6 +184,17 @@ typedef struct _ARM_OSPI_STATUS {
     uint32_t reserved   : 29;
 } ARM_OSPI_STATUS;
 
+/**
+\brief OSPI instruction and address frames for \ref ARM_OSPI_SET_TX_HEADER. The
+       address frame is only sent when an address length is configured. The
+       data of the Send that follows is read packed in the frame width
+       (uint16_t items for 16 bit frames) instead of one uint32_t per frame.
+*/
+typedef struct _ARM_OSPI_TX_HEADER {
+    uint32_t cmd;                         ///< Instruction frame
+    uint32_t addr;                        ///< Address frame
+} ARM_OSPI_TX_HEADER;
+
 /****** OSPI Event *****/
 #define ARM_OSPI_EVENT_TRANSFER_COMPLETE (1UL << 0)  ///< Data Transfer completed
 #define ARM_OSPI_EVENT_DATA_LOST         (1UL << 1)  ///< Data lost: Receive overflow / Transmit underflow
@@ -54,11 +54,17 @@ extern "c"
 #define ARM_PDM_CHANNEL_GAIN                                0x0FUL
 #define ARM_PDM_CHANNEL_PEAK_DETECT_TH                      0x10UL
 #define ARM_PDM_CHANNEL_PEAK_DETECT_ITV                     0x11UL
+#define ARM_PDM_DMA_STREAMING                               0x12UL  /* arg1 = number of DMA periods 1..255, 0 = one shot */
 
 /* PDM event */
 #define ARM_PDM_EVENT_ERROR                                (1UL << 0)
 #define ARM_PDM_EVENT_CAPTURE_COMPLETE                     (1UL << 1)
 #define ARM_PDM_EVENT_AUDIO_DETECTION                      (1UL << 2)
+#define ARM_PDM_EVENT_CAPTURE_PERIOD                       (1UL << 6)  /* DMA streaming period captured */
+
+#define ARM_PDM_EVENT_PERIOD_INDEX_Pos                      16
+#define ARM_PDM_EVENT_PERIOD_INDEX_Msk                     (0xFFUL << ARM_PDM_EVENT_PERIOD_INDEX_Pos)
+#define ARM_PDM_EVENT_PERIOD_INDEX(event)                  (((event) & ARM_PDM_EVENT_PERIOD_INDEX_Msk) >> ARM_PDM_EVENT_PERIOD_INDEX_Pos)
 
 #define ARM_PDM_SELECT_RESOLUTION                          (1UL << 3)
 
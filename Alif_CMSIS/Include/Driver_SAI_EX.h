@@ -30,6 +30,16 @@ extern "C"
 /****** SAI Control Codes *****/
 #define ARM_SAI_USE_CUSTOM_DMA_MCODE_TX           (0xA0UL)    ///< Use User defined DMA microcode arg1 provides address
 #define ARM_SAI_USE_CUSTOM_DMA_MCODE_RX           (0xA1UL)    ///< Use User defined DMA microcode arg1 provides address
+#define ARM_SAI_DMA_STREAMING_TX                  (0xA2UL)    ///< Loop the DMA over the Send buffer; arg1 = number of periods 1..255 (0 = one shot)
+#define ARM_SAI_DMA_STREAMING_RX                  (0xA3UL)    ///< Loop the DMA over the Receive buffer; arg1 = number of periods 1..255 (0 = one shot)
+
+/****** SAI Events *****/
+#define ARM_SAI_EVENT_SEND_PERIOD                 (1UL << 5)  ///< Streaming: period sent and free to refill
+#define ARM_SAI_EVENT_RECEIVE_PERIOD              (1UL << 6)  ///< Streaming: period received
+
+#define ARM_SAI_EVENT_PERIOD_INDEX_Pos            16
+#define ARM_SAI_EVENT_PERIOD_INDEX_Msk            (0xFFUL << ARM_SAI_EVENT_PERIOD_INDEX_Pos)
+#define ARM_SAI_EVENT_PERIOD_INDEX(event)         (((event) & ARM_SAI_EVENT_PERIOD_INDEX_Msk) >> ARM_SAI_EVENT_PERIOD_INDEX_Pos)
 
 #ifdef  __cplusplus
 }
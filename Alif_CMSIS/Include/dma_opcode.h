@@ -137,7 +137,7 @@ typedef struct _dma_loop_t {
 typedef struct _dma_opcode_buf {
     uint8_t  *buf;            /*!< Start address of the opcode buffer   */
     uint16_t off;             /*!< Current Offset from start address    */
-    uint8_t  buf_size;        /*!< Total buffer size                    */
+    uint16_t buf_size;        /*!< Total buffer size                    */
 } dma_opcode_buf;
 
 /**
@@ -260,6 +260,41 @@ __STATIC_INLINE int32_t CRC_DMA_Stop(DMA_PERIPHERAL_CONFIG *dma_periph)
     return ARM_DRIVER_OK;
 }
 
+/**
+  \fn          static int32_t  CRC_DMA_StartChunk(CRC_RESOURCES *CRC)
+  \brief       Start the DMA for the next chunk of the input
+  \param[in]   CRC       Pointer to crc resources
+  \return      \ref execution_status
+*/
+static int32_t CRC_DMA_StartChunk(CRC_RESOURCES *CRC)
+{
+    ARM_DMA_PARAMS params;
+    uint32_t       chunk_len;
+
+    chunk_len = CRC_DMA_MAX_CHUNK_BEATS << CRC->dma_burst_size;
+    if(chunk_len > CRC->dma_remaining)
+        chunk_len = CRC->dma_remaining;
+
+    params.peri_reqno   = (int8_t)-1;
+    params.dir          = ARM_DMA_MEM_TO_DEV;
+    params.cb_event     = CRC->dma_cb;
+    params.src_addr     = CRC->dma_next;
+    params.burst_len    = 1;
+    params.burst_size   = CRC->dma_burst_size;
+    params.num_bytes    = chunk_len;
+    params.irq_priority = CRC->dma_irq_priority;
+
+    if(CRC->dma_burst_size == BS_BYTE_4)
+        params.dst_addr = crc_get_32bit_datain_addr(CRC->regs);
+    else
+        params.dst_addr = crc_get_8bit_datain_addr(CRC->regs);
+
+    CRC->dma_next      += chunk_len;
+    CRC->dma_remaining -= chunk_len;
+
+    return CRC_DMA_Start(&CRC->dma_cfg, &params);
+}
+
 /**
   \fn          static void  CRC_DMACallback(uint32_t event, int8_t peri_num, CRC_RESOURCES *CRC)
   \brief       Callback function from DMA for CRC
@@ -272,6 +307,16 @@ static void CRC_DMACallback(uint32_t event, int8_t peri_num, CRC_RESOURCES *CRC)
     uint8_t   algo_size;
 
     (void)peri_num;
+
+    /* Feed the next chunk, the CRC keeps accumulating in the hardware */
+    if((event & ARM_DMA_EVENT_COMPLETE) && CRC->dma_remaining)
+    {
+        if(CRC_DMA_StartChunk(CRC) == ARM_DRIVER_OK)
+            return;
+
+        event = ARM_DMA_EVENT_ABORT;
+    }
+
     CRC->dma_event = event;
 
     /* Deallocate the DMA channel */
@@ -321,38 +366,31 @@ static void CRC_DMACallback(uint32_t event, int8_t peri_num, CRC_RESOURCES *CRC)
 static int32_t CRC_DMA_Copy(const void *data_in, uint32_t data_len,
                             uint8_t algo_size, CRC_RESOURCES *CRC)
 {
-    ARM_DMA_PARAMS params;
     int32_t        ret;
 
-    /* Deallocate the DMA channel */
+    /* Allocate the DMA channel */
     if(CRC_DMA_Allocate(&CRC->dma_cfg))
         return ARM_DRIVER_ERROR;
 
-    params.peri_reqno   = (int8_t)-1;
-    params.dir          = ARM_DMA_MEM_TO_DEV;
-    params.cb_event     = CRC->dma_cb;
-    params.src_addr     = data_in;
-    params.burst_len    = 1;
-    params.num_bytes    = data_len;
-    params.irq_priority = CRC->dma_irq_priority;
-
     CRC->dma_event      = 0U;
+    CRC->dma_next       = (const uint8_t *)data_in;
+    CRC->dma_remaining  = data_len;
 
     switch(algo_size)
     {
     /* For 8 bit CRC */
     case CRC_8_BIT_SIZE:
     case CRC_16_BIT_SIZE:
-        params.dst_addr     = crc_get_8bit_datain_addr(CRC->regs);
-        params.burst_size   = BS_BYTE_1;
+        CRC->dma_burst_size = BS_BYTE_1;
         break;
     case CRC_32_BIT_SIZE:
-        params.dst_addr     = crc_get_32bit_datain_addr(CRC->regs);
-        params.burst_size   = BS_BYTE_4;
+        CRC->dma_burst_size = BS_BYTE_4;
         break;
     }
 
-    ret = CRC_DMA_Start(&CRC->dma_cfg, &params);
+    ret = CRC_DMA_StartChunk(CRC);
+    if(ret != ARM_DRIVER_OK)
+        CRC_DMA_DeAllocate(&CRC->dma_cfg);
 
     return ret;
 }
@@ -661,6 +699,9 @@ static int32_t CRC_Compute (const void *data_in, uint32_t len, uint32_t *data_ou
     int32_t   ret = ARM_DRIVER_OK;
     uint8_t   algo_size;
     uint32_t  control_val;
+#if CRC_DMA_ENABLE
+    bool      dma_xfer = false;
+#endif
 
     if(CRC->state.powered == 0)
     {
@@ -699,6 +740,7 @@ static int32_t CRC_Compute (const void *data_in, uint32_t len, uint32_t *data_ou
 #if CRC_DMA_ENABLE
         if(CRC->dma_enable && (CRC->transfer.len > CRC_DMA_MIN_TRANSFER_LEN))
         {
+            dma_xfer = true;
             ret = CRC_DMA_Copy(CRC->transfer.data_in,
                                CRC->transfer.len,
                                algo_size,
@@ -718,6 +760,7 @@ static int32_t CRC_Compute (const void *data_in, uint32_t len, uint32_t *data_ou
 #if CRC_DMA_ENABLE
         if(CRC->dma_enable && (CRC->transfer.len > CRC_DMA_MIN_TRANSFER_LEN))
         {
+            dma_xfer = true;
             ret = CRC_DMA_Copy(CRC->transfer.data_in,
                                CRC->transfer.len,
                                algo_size,
@@ -743,12 +786,14 @@ static int32_t CRC_Compute (const void *data_in, uint32_t len, uint32_t *data_ou
         /* Unaligned data is not supported, if Bit swap is disabled */
         if((CRC->transfer.unaligned_len > 0) & !(control_val & CRC_BIT_SWAP))
         {
+            CRC->busy = 0;
             return ARM_DRIVER_ERROR_UNSUPPORTED;
         }
 
 #if CRC_DMA_ENABLE
         if(CRC->dma_enable && (CRC->transfer.aligned_len > CRC_DMA_MIN_TRANSFER_LEN))
         {
+            dma_xfer = true;
             ret = CRC_DMA_Copy(CRC->transfer.data_in,
                                CRC->transfer.aligned_len,
                                algo_size,
@@ -773,10 +818,15 @@ static int32_t CRC_Compute (const void *data_in, uint32_t len, uint32_t *data_ou
     }
 
 #if CRC_DMA_ENABLE
-    if(CRC->dma_enable && (CRC->transfer.aligned_len > CRC_DMA_MIN_TRANSFER_LEN))
+    if(dma_xfer)
     {
+        if(ret != ARM_DRIVER_OK)
+        {
+            /* The DMA did not start, there will be no callback */
+            CRC->busy = 0;
+        }
         /* Wait till we get the DMA callback event */
-        if(ret == ARM_DRIVER_OK && !CRC->cb_event)
+        else if(!CRC->cb_event)
         {
             while(CRC->dma_event == 0)
             {
@@ -35,6 +35,9 @@
 #define CRC_32_BIT_SIZE          2          /* To select the 32 bit algorithm size */
 
 #define CRC_DMA_MIN_TRANSFER_LEN 900
+
+/* Beats per DMA start, longer buffers are fed in chunks from the callback */
+#define CRC_DMA_MAX_CHUNK_BEATS  (64U * 1024U)
 /**
  @brief   : CRC Driver states
  */
@@ -60,6 +63,9 @@ typedef struct _CRC_RESOURCES
     ARM_DMA_SignalEvent_t   dma_cb;             /* CRC DMA Callback               */
     DMA_PERIPHERAL_CONFIG   dma_cfg;            /* DMA configuration              */
     volatile uint32_t       dma_event;          /* Result of DMA operation        */
+    const uint8_t           *dma_next;          /* Start of the next DMA chunk    */
+    uint32_t                dma_remaining;      /* Bytes left for the next chunks */
+    uint8_t                 dma_burst_size;     /* DMA beat size of the algorithm */
 #endif
 }CRC_RESOURCES;
 
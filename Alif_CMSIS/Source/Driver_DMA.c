@@ -146,7 +146,7 @@ static const ARM_DMA_CAPABILITIES DriverCapabilities = {
     1,   /* supports memory to memory operation */
     1,   /* supports memory to peripheral operation */
     1,   /* supports peripheral to memory operation */
-    0,   /* supports Scatter Gather */
+    1,   /* supports Scatter Gather */
     1,   /* supports Secure/Non-Secure mode operation */
     0    /* reserved (must be zero) */
 };
@@ -241,45 +241,67 @@ static void DMA_InitDescDefaults(uint8_t channel_num, DMA_RESOURCES *DMA)
 }
 
 /**
-  \fn          int32_t DMA_CopyDesc(uint8_t         channel_num,
-                                    ARM_DMA_PARAMS *params,
-                                    DMA_RESOURCES  *DMA)
-  \brief       Copy the descriptor information
-  \param[in]   channel_num  DMA channel
+  \fn          int32_t DMA_CheckParams(ARM_DMA_PARAMS *params,
+                                       DMA_TRANSFER   *direction)
+  \brief       Validate the burst, callback and direction of the params
   \param[in]   params  Descriptor information
-  \param[in]   DMA  Pointer to DMA resources
+  \param[out]  direction  Transfer direction
   \return      \ref execution_status
 */
-static int32_t DMA_CopyDesc(uint8_t         channel_num,
-                            ARM_DMA_PARAMS *params,
-                            DMA_RESOURCES  *DMA)
+static int32_t DMA_CheckParams(ARM_DMA_PARAMS *params,
+                               DMA_TRANSFER   *direction)
 {
-    dma_config_info_t *dma_cfg = &DMA->cfg;
-    dma_desc_info_t    dma_desc;
-
     if(((1 << params->burst_size) > DMA_MAX_BURST_SIZE) ||
        (params->burst_len > DMA_MAX_BURST_LEN) ||
        (!params->burst_len) ||
-       (!params->cb_event) ||
-       (!params->num_bytes))
+       (!params->cb_event))
         return ARM_DRIVER_ERROR_PARAMETER;
 
     if(params->dir == ARM_DMA_MEM_TO_MEM)
-        dma_desc.direction = DMA_TRANSFER_MEM_TO_MEM;
+        *direction = DMA_TRANSFER_MEM_TO_MEM;
     else if(params->dir == ARM_DMA_MEM_TO_DEV)
-        dma_desc.direction = DMA_TRANSFER_MEM_TO_DEV;
+        *direction = DMA_TRANSFER_MEM_TO_DEV;
     else if(params->dir == ARM_DMA_DEV_TO_MEM)
-        dma_desc.direction = DMA_TRANSFER_DEV_TO_MEM;
+        *direction = DMA_TRANSFER_DEV_TO_MEM;
     else
         return ARM_DRIVER_ERROR_PARAMETER;
 
-    if((dma_desc.direction == DMA_TRANSFER_DEV_TO_MEM) ||
-       (dma_desc.direction == DMA_TRANSFER_MEM_TO_DEV))
+    if((*direction == DMA_TRANSFER_DEV_TO_MEM) ||
+       (*direction == DMA_TRANSFER_MEM_TO_DEV))
     {
         if(params->peri_reqno >= DMA_MAX_PERIPH_REQ)
             return ARM_DRIVER_ERROR_PARAMETER;
     }
 
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          int32_t DMA_CopyDesc(uint8_t         channel_num,
+                                    ARM_DMA_PARAMS *params,
+                                    DMA_RESOURCES  *DMA)
+  \brief       Copy the descriptor information
+  \param[in]   channel_num  DMA channel
+  \param[in]   params  Descriptor information
+  \param[in]   DMA  Pointer to DMA resources
+  \return      \ref execution_status
+*/
+static int32_t DMA_CopyDesc(uint8_t         channel_num,
+                            ARM_DMA_PARAMS *params,
+                            DMA_RESOURCES  *DMA)
+{
+    dma_config_info_t *dma_cfg = &DMA->cfg;
+    dma_desc_info_t    dma_desc;
+    dma_desc_info_t   *channel_desc_info;
+    int32_t            ret;
+
+    ret = DMA_CheckParams(params, &dma_desc.direction);
+    if(ret != ARM_DRIVER_OK)
+        return ret;
+
+    if(!params->num_bytes)
+        return ARM_DRIVER_ERROR_PARAMETER;
+
     dma_desc.periph_num  = (uint8_t)params->peri_reqno;
     dma_desc.dst_addr    = LocalToGlobal(params->dst_addr);
     dma_desc.src_addr    = LocalToGlobal(params->src_addr);
@@ -312,6 +334,17 @@ static int32_t DMA_CopyDesc(uint8_t         channel_num,
 
     dma_desc.src_bsize   = dma_desc.dst_bsize;
 
+    /* Anything but the addresses needs the opcode to be generated again */
+    channel_desc_info = dma_get_desc_info(dma_cfg, channel_num);
+    if((channel_desc_info->direction  != dma_desc.direction)  ||
+       (channel_desc_info->total_len  != dma_desc.total_len)  ||
+       (channel_desc_info->dst_bsize  != dma_desc.dst_bsize)  ||
+       (channel_desc_info->dst_blen   != dma_desc.dst_blen)   ||
+       (channel_desc_info->periph_num != dma_desc.periph_num))
+    {
+        dma_clear_prepared(dma_cfg, channel_num);
+    }
+
     dma_copy_desc_info(dma_cfg, channel_num, &dma_desc);
 
     return ARM_DRIVER_OK;
@@ -349,6 +382,387 @@ __STATIC_INLINE void DMA_CleanDCache(dma_desc_info_t *desc_info)
     }
 }
 
+/**
+  \fn          int32_t DMA_CopySGDesc(uint8_t                channel_num,
+                                      ARM_DMA_PARAMS        *params,
+                                      const ARM_DMA_SG_LIST *list,
+                                      DMA_RESOURCES         *DMA)
+  \brief       Validate the scatter-gather list and copy the channel
+               descriptor. Addresses describe the first segment and the
+               length covers the whole chain.
+  \param[in]   channel_num  DMA channel
+  \param[in]   params  Burst, direction and peripheral information
+  \param[in]   list  Scatter-gather list
+  \param[in]   DMA  Pointer to DMA resources
+  \return      \ref execution_status
+*/
+static int32_t DMA_CopySGDesc(uint8_t                channel_num,
+                              ARM_DMA_PARAMS        *params,
+                              const ARM_DMA_SG_LIST *list,
+                              DMA_RESOURCES         *DMA)
+{
+    dma_config_info_t      *dma_cfg = &DMA->cfg;
+    const ARM_DMA_SG_ENTRY *entry;
+    dma_desc_info_t         dma_desc;
+    uint32_t                total_len = 0;
+    uint32_t                count;
+    int32_t                 ret;
+
+    ret = DMA_CheckParams(params, &dma_desc.direction);
+    if(ret != ARM_DRIVER_OK)
+        return ret;
+
+    if(!list->entries || !list->count ||
+       (list->mcode && (!list->mcode_size || (list->mcode_size > 0xFFFF))))
+        return ARM_DRIVER_ERROR_PARAMETER;
+
+    for(count = 0; count < list->count; count++)
+    {
+        entry = &list->entries[count];
+
+        if(!entry->num_bytes)
+            return ARM_DRIVER_ERROR_PARAMETER;
+
+        if((dma_desc.direction != DMA_TRANSFER_MEM_TO_MEM) &&
+           ((LocalToGlobal(entry->dst_addr) |
+             LocalToGlobal(entry->src_addr) |
+             entry->num_bytes) & ((1 << params->burst_size) - 1)))
+            return ARM_DMA_ERROR_UNALIGNED;
+
+        total_len += entry->num_bytes;
+    }
+
+    dma_desc.periph_num  = (uint8_t)params->peri_reqno;
+    dma_desc.dst_addr    = LocalToGlobal(list->entries[0].dst_addr);
+    dma_desc.src_addr    = LocalToGlobal(list->entries[0].src_addr);
+    dma_desc.dst_blen    = params->burst_len;
+    dma_desc.src_blen    = params->burst_len;
+    dma_desc.total_len   = total_len;
+    dma_desc.dst_bsize   = params->burst_size;
+    dma_desc.src_bsize   = params->burst_size;
+
+    dma_copy_desc_info(dma_cfg, channel_num, &dma_desc);
+
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          int32_t DMA_GenerateSGOpcode(uint8_t                channel_num,
+                                            const ARM_DMA_SG_LIST *list,
+                                            DMA_RESOURCES         *DMA,
+                                            uint8_t              **opcode_buf)
+  \brief       Compile the scatter-gather list into one channel program
+  \param[in]   channel_num  DMA channel
+  \param[in]   list  Scatter-gather list
+  \param[in]   DMA  Pointer to DMA resources
+  \param[out]  opcode_buf  Start of the generated program
+  \return      \ref execution_status
+*/
+static int32_t DMA_GenerateSGOpcode(uint8_t                channel_num,
+                                    const ARM_DMA_SG_LIST *list,
+                                    DMA_RESOURCES         *DMA,
+                                    uint8_t              **opcode_buf)
+{
+    dma_config_info_t      *dma_cfg = &DMA->cfg;
+    const ARM_DMA_SG_ENTRY *entry;
+    dma_sg_seg_t            seg;
+    dma_opcode_buf          op_buf;
+    uint32_t                count;
+
+    if(list->mcode)
+    {
+        op_buf.buf      = (uint8_t *)list->mcode;
+        op_buf.buf_size = (uint16_t)list->mcode_size;
+    }
+    else
+    {
+        op_buf.buf      = dma_get_opcode_buf(dma_cfg, channel_num);
+        op_buf.buf_size = DMA_MICROCODE_SIZE;
+        dma_clear_prepared(dma_cfg, channel_num);
+    }
+    op_buf.off = 0;
+
+    for(count = 0; count < list->count; count++)
+    {
+        entry = &list->entries[count];
+
+        seg.src_addr = LocalToGlobal(entry->src_addr);
+        seg.dst_addr = LocalToGlobal(entry->dst_addr);
+        seg.len      = entry->num_bytes;
+        seg.event    = (entry->flags & ARM_DMA_SG_FLAG_EVENT) &&
+                       (count != (list->count - 1));
+
+        if(!dma_sg_opcode_add(dma_cfg, channel_num, &seg, &op_buf))
+            return ARM_DMA_ERROR_BUFFER;
+    }
+
+    if(!dma_sg_opcode_end(dma_cfg, channel_num, &op_buf))
+        return ARM_DMA_ERROR_BUFFER;
+
+    /* DMAEND is the last opcode, the final DMASEV sits right before it */
+    DMA->sg_end_pc[channel_num] = LocalToGlobal(op_buf.buf) + op_buf.off - 1;
+
+    RTSS_CleanDCache_by_Addr(op_buf.buf, op_buf.off);
+
+    *opcode_buf = op_buf.buf;
+
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          bool DMA_SGIsActive(uint8_t channel_num, DMA_RESOURCES *DMA)
+  \brief       Check whether the channel runs a driver built scatter-gather
+               program (user provided microcode takes precedence)
+  \param[in]   channel_num  DMA channel
+  \param[in]   DMA  Pointer to DMA resources
+  \return      bool true if the scatter-gather list is in use
+*/
+__STATIC_INLINE bool DMA_SGIsActive(uint8_t channel_num, DMA_RESOURCES *DMA)
+{
+    return (DMA->sg_list[channel_num] &&
+            !(dma_get_channel_flags(&DMA->cfg, channel_num) &
+              DMA_CHANNEL_FLAG_USE_USER_MCODE));
+}
+
+/**
+  \fn          void DMA_SGCleanDCache(const ARM_DMA_SG_LIST *list,
+                                      DMA_TRANSFER           direction)
+  \brief       Clean and invalidate the Dcache of every segment
+  \param[in]   list  Scatter-gather list
+  \param[in]   direction  Transfer direction
+  \return      None
+*/
+static void DMA_SGCleanDCache(const ARM_DMA_SG_LIST *list,
+                              DMA_TRANSFER           direction)
+{
+    const ARM_DMA_SG_ENTRY *entry;
+    uint32_t                count;
+
+    for(count = 0; count < list->count; count++)
+    {
+        entry = &list->entries[count];
+
+        if((direction == DMA_TRANSFER_MEM_TO_MEM) ||
+           (direction == DMA_TRANSFER_MEM_TO_DEV))
+        {
+            RTSS_CleanDCache_by_Addr((volatile void *)entry->src_addr,
+                                     (int32_t)entry->num_bytes);
+        }
+
+        if((direction == DMA_TRANSFER_MEM_TO_MEM) ||
+           (direction == DMA_TRANSFER_DEV_TO_MEM))
+        {
+            RTSS_InvalidateDCache_by_Addr(entry->dst_addr,
+                                          (int32_t)entry->num_bytes);
+        }
+    }
+}
+
+/**
+  \fn          void DMA_SGInvalidateDCache(uint8_t        channel_num,
+                                           uint32_t       last,
+                                           DMA_RESOURCES *DMA)
+  \brief       Invalidate the destination of the segments which are not
+               reported yet, up to and including the last one
+  \param[in]   channel_num  DMA channel
+  \param[in]   last  Last segment to invalidate
+  \param[in]   DMA  Pointer to DMA resources
+  \return      None
+*/
+static void DMA_SGInvalidateDCache(uint8_t        channel_num,
+                                   uint32_t       last,
+                                   DMA_RESOURCES *DMA)
+{
+    const ARM_DMA_SG_LIST  *list = DMA->sg_list[channel_num];
+    dma_desc_info_t        *desc_info;
+    const ARM_DMA_SG_ENTRY *entry;
+    uint32_t                count;
+
+    desc_info = dma_get_desc_info(&DMA->cfg, channel_num);
+
+    for(count = DMA->sg_next[channel_num];
+        (count <= last) && (count < list->count);
+        count++)
+    {
+        entry = &list->entries[count];
+
+        if((desc_info->direction == DMA_TRANSFER_MEM_TO_MEM) ||
+           (desc_info->direction == DMA_TRANSFER_DEV_TO_MEM))
+        {
+            RTSS_InvalidateDCache_by_Addr(entry->dst_addr,
+                                          (int32_t)entry->num_bytes);
+        }
+    }
+
+    DMA->sg_next[channel_num] = count;
+}
+
+/**
+  \fn          void DMA_InvalidateChannelDCache(uint8_t        channel_num,
+                                                DMA_RESOURCES *DMA)
+  \brief       Invalidate the Dcache of the channel transfer
+  \param[in]   channel_num  DMA channel
+  \param[in]   DMA  Pointer to DMA resources
+  \return      None
+*/
+static void DMA_InvalidateChannelDCache(uint8_t        channel_num,
+                                        DMA_RESOURCES *DMA)
+{
+    if(DMA_SGIsActive(channel_num, DMA))
+        DMA_SGInvalidateDCache(channel_num, UINT32_MAX, DMA);
+    else
+        DMA_InvalidateDCache(dma_get_desc_info(&DMA->cfg, channel_num));
+}
+
+/**
+  \fn          bool DMA_SGIsDone(uint8_t channel_num, DMA_RESOURCES *DMA)
+  \brief       Check whether the scatter-gather program raised its final
+               event. That event is followed only by DMAEND, so the thread
+               is either stopped or about to execute it.
+  \param[in]   channel_num  DMA channel
+  \param[in]   DMA  Pointer to DMA resources
+  \return      bool true if the whole chain is completed
+*/
+static bool DMA_SGIsDone(uint8_t channel_num, DMA_RESOURCES *DMA)
+{
+    if(dma_get_channel_status(DMA->regs, channel_num) == DMA_THREAD_STATUS_STOPPED)
+        return true;
+
+    return (dma_get_channel_pc(DMA->regs, channel_num) ==
+            DMA->sg_end_pc[channel_num]);
+}
+
+/**
+  \fn          int32_t DMA_CheckCyclic(uint8_t channel_num, DMA_RESOURCES *DMA)
+  \brief       Check that the buffer splits in periods the cyclic program
+               can loop over
+  \param[in]   channel_num  DMA channel
+  \param[in]   DMA  Pointer to DMA resources
+  \return      \ref execution_status
+*/
+static int32_t DMA_CheckCyclic(uint8_t channel_num, DMA_RESOURCES *DMA)
+{
+    dma_desc_info_t *desc_info = dma_get_desc_info(&DMA->cfg, channel_num);
+    uint32_t         periods   = dma_get_cyclic_periods(&DMA->cfg, channel_num);
+    uint32_t         period_len;
+
+    period_len = desc_info->total_len / periods;
+
+    if((desc_info->total_len % periods) ||
+       (period_len % (1U << desc_info->dst_bsize)) || !period_len)
+        return ARM_DMA_ERROR_UNALIGNED;
+
+    if((period_len / ((1U << desc_info->dst_bsize) * desc_info->dst_blen))
+       >= DMA_MAX_LP_CNT)
+        return ARM_DMA_ERROR_MAX_TRANSFER;
+
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          void DMA_CyclicPeriodDone(uint8_t        channel_num,
+                                         uint32_t      *event,
+                                         DMA_RESOURCES *DMA)
+  \brief       Find the last completed period from the channel position and
+               invalidate its destination. Periods completed while the
+               interrupt was pending are merged into the latest one.
+  \param[in]   channel_num  DMA channel
+  \param[out]  event  Event with the period index
+  \param[in]   DMA  Pointer to DMA resources
+  \return      None
+*/
+static void DMA_CyclicPeriodDone(uint8_t        channel_num,
+                                 uint32_t      *event,
+                                 DMA_RESOURCES *DMA)
+{
+    dma_desc_info_t *desc_info = dma_get_desc_info(&DMA->cfg, channel_num);
+    uint32_t         periods   = dma_get_cyclic_periods(&DMA->cfg, channel_num);
+    uint32_t         period_len, index, curr_addr;
+
+    period_len = desc_info->total_len / periods;
+
+    if(desc_info->direction == DMA_TRANSFER_MEM_TO_DEV)
+    {
+        curr_addr = dma_get_channel_src_addr(DMA->regs, channel_num);
+        index     = (curr_addr - desc_info->src_addr) / period_len;
+    }
+    else
+    {
+        curr_addr = dma_get_channel_dest_addr(DMA->regs, channel_num);
+        index     = (curr_addr - desc_info->dst_addr) / period_len;
+    }
+
+    /* The channel is in the period following the completed one */
+    if(index > periods)
+        index = periods;
+    index = (index + periods - 1) % periods;
+
+    if(desc_info->direction != DMA_TRANSFER_MEM_TO_DEV)
+    {
+        RTSS_InvalidateDCache_by_Addr(GlobalToLocal(desc_info->dst_addr +
+                                                    (index * period_len)),
+                                      (int32_t)period_len);
+    }
+
+    *event = ARM_DMA_EVENT_PERIOD |
+             ((index << ARM_DMA_EVENT_PERIOD_INDEX_Pos) &
+              ARM_DMA_EVENT_PERIOD_INDEX_Msk);
+}
+
+/**
+  \fn          int32_t DMA_PrepareOpcode(uint8_t         channel_num,
+                                         ARM_DMA_PARAMS *params,
+                                         DMA_RESOURCES  *DMA)
+  \brief       Make the channel opcode ready for the params. If only the
+               addresses differ from the previous transfer, the SAR/DAR
+               immediates are patched and just those lines are cleaned.
+  \param[in]   channel_num  DMA channel
+  \param[in]   params  Descriptor information
+  \param[in]   DMA  Pointer to DMA resources
+  \return      \ref execution_status
+*/
+static int32_t DMA_PrepareOpcode(uint8_t         channel_num,
+                                 ARM_DMA_PARAMS *params,
+                                 DMA_RESOURCES  *DMA)
+{
+    dma_config_info_t *dma_cfg = &DMA->cfg;
+    uint8_t           *opcode_buf;
+    uint16_t           off, len;
+    int32_t            ret;
+
+    ret = DMA_CopyDesc(channel_num, params, DMA);
+    if(ret < 0)
+        return ret;
+
+    opcode_buf = dma_get_opcode_buf(dma_cfg, channel_num);
+
+    if(dma_get_channel_flags(dma_cfg, channel_num) & DMA_CHANNEL_FLAG_PREPARED)
+    {
+        dma_patch_opcode_addr(dma_cfg, channel_num, &off, &len);
+        RTSS_CleanDCache_by_Addr(opcode_buf + off, len);
+        return ARM_DRIVER_OK;
+    }
+
+    if(dma_get_channel_flags(dma_cfg, channel_num) & DMA_CHANNEL_FLAG_CYCLIC_MODE)
+    {
+        ret = DMA_CheckCyclic(channel_num, DMA);
+        if(ret < 0)
+            return ret;
+
+        if(!dma_generate_cyclic_opcode(dma_cfg, channel_num))
+            return ARM_DMA_ERROR_BUFFER;
+    }
+    else if(!dma_generate_opcode(dma_cfg, channel_num))
+    {
+        return ARM_DMA_ERROR_BUFFER;
+    }
+
+    /* Flush the Cache now */
+    RTSS_CleanDCache_by_Addr(opcode_buf, DMA_MICROCODE_SIZE);
+
+    return ARM_DRIVER_OK;
+}
+
 /**
   \fn          int32_t DMA_DeAllocate(DMA_Handle_Type *handle,
                                       DMA_RESOURCES   *DMA)
@@ -389,6 +803,7 @@ __STATIC_INLINE int32_t DMA_DeAllocate(DMA_Handle_Type *handle,
     NVIC_DisableIRQ((IRQn_Type)(DMA->irq_start + event_index));
 
     DMA->cb_event[event_index] = (void *)0;
+    DMA->sg_list[channel_num]  = (void *)0;
 
     dma_release_event(dma_cfg, event_index);
     dma_release_channel(dma_cfg, channel_num);
@@ -470,7 +885,6 @@ static int32_t DMA_Stop(DMA_Handle_Type *handle, DMA_RESOURCES *DMA)
 {
     dma_config_info_t  *dma_cfg = &DMA->cfg;
     dma_dbginst0_t      dma_dbginst0;
-    dma_desc_info_t    *desc_info;
     uint8_t             kill_opcode_buf =  {0};
     uint8_t             channel_num;
     uint8_t             event_index;
@@ -534,8 +948,7 @@ static int32_t DMA_Stop(DMA_Handle_Type *handle, DMA_RESOURCES *DMA)
     NVIC_DisableIRQ((IRQn_Type)(DMA->irq_start + event_index));
 
     /* Invalidate the data from cache */
-    desc_info = dma_get_desc_info(dma_cfg, channel_num);
-    DMA_InvalidateDCache(desc_info);
+    DMA_InvalidateChannelDCache(channel_num, DMA);
 
     __enable_irq();
 
@@ -636,36 +1049,55 @@ static int32_t DMA_Start(DMA_Handle_Type *handle,
 
         dma_copy_desc_info(dma_cfg, channel_num, &desc_info);
     }
-    else
+    else if(DMA->sg_list[channel_num])
     {
-        ret = DMA_CopyDesc(channel_num, params, DMA);
+        ret = DMA_CopySGDesc(channel_num, params, DMA->sg_list[channel_num], DMA);
         if(ret < 0)
         {
             __enable_irq();
             return ret;
         }
 
-        ret = dma_generate_opcode(dma_cfg, channel_num);
+        ret = DMA_GenerateSGOpcode(channel_num, DMA->sg_list[channel_num],
+                                   DMA, &opcode_buf);
         if(ret < 0)
         {
             __enable_irq();
-            return ARM_DMA_ERROR_BUFFER;
+            return ret;
+        }
+    }
+    else
+    {
+        ret = DMA_PrepareOpcode(channel_num, params, DMA);
+        if(ret < 0)
+        {
+            __enable_irq();
+            return ret;
         }
 
-        /* Flush the Cache now */
         opcode_buf = dma_get_opcode_buf(dma_cfg, channel_num);
-        RTSS_CleanDCache_by_Addr(opcode_buf, DMA_MICROCODE_SIZE);
     }
 
     /* Assign the callback against the allocated event_index */
     DMA->cb_event[event_index] = params->cb_event;
 
     channel_desc_info = dma_get_desc_info(dma_cfg, channel_num);
-    /* Src: Clean the data from the cache */
-    DMA_CleanDCache(channel_desc_info);
 
-    /* Dst: Invalidate the data from cache */
-    DMA_InvalidateDCache(channel_desc_info);
+    if(DMA_SGIsActive(channel_num, DMA))
+    {
+        DMA->sg_next[channel_num] = 0;
+
+        /* Clean the source and invalidate the destination of every segment */
+        DMA_SGCleanDCache(DMA->sg_list[channel_num], channel_desc_info->direction);
+    }
+    else
+    {
+        /* Src: Clean the data from the cache */
+        DMA_CleanDCache(channel_desc_info);
+
+        /* Dst: Invalidate the data from cache */
+        DMA_InvalidateDCache(channel_desc_info);
+    }
 
     dma_construct_go(channel_desc_info->sec_state,
                      channel_num,
@@ -722,6 +1154,7 @@ static int32_t DMA_Control (DMA_Handle_Type *handle,
 {
     dma_config_info_t  *dma_cfg = &DMA->cfg;
     uint8_t             channel_num;
+    int32_t             ret;
 
     /* Verify whether the driver is initialized */
     if(!DMA->state.initialized)
@@ -745,10 +1178,50 @@ static int32_t DMA_Control (DMA_Handle_Type *handle,
         break;
     case ARM_DMA_I2S_MONO_MODE:
         dma_set_i2s_mono_mode(dma_cfg, channel_num);
+        dma_clear_prepared(dma_cfg, channel_num);
         break;
     case ARM_DMA_CRC_MODE:
         dma_set_crc_mode(dma_cfg, channel_num);
+        dma_clear_prepared(dma_cfg, channel_num);
+        break;
+    case ARM_DMA_SCATTER_GATHER:
+        DMA->sg_list[channel_num] = (const ARM_DMA_SG_LIST *)arg;
+        break;
+    case ARM_DMA_CYCLIC_MODE:
+        if(arg > 0xFF)
+            return ARM_DRIVER_ERROR_PARAMETER;
+        /* I2S and PDM set this on every start, keep the program if unchanged */
+        if(dma_get_cyclic_periods(dma_cfg, channel_num) != (uint8_t)arg)
+        {
+            dma_set_cyclic_mode(dma_cfg, channel_num, (uint8_t)arg);
+            dma_clear_prepared(dma_cfg, channel_num);
+        }
         break;
+    case ARM_DMA_PREPARE_XFER:
+        if(!arg)
+            return ARM_DRIVER_ERROR_PARAMETER;
+
+        if(!DMA->state.powered)
+            return ARM_DRIVER_ERROR;
+
+        if((dma_get_channel_flags(dma_cfg, channel_num) &
+            DMA_CHANNEL_FLAG_USE_USER_MCODE) || DMA->sg_list[channel_num])
+            return ARM_DRIVER_ERROR;
+
+        __disable_irq();
+
+        /* The opcode must not change under a running thread */
+        if(dma_get_channel_status(DMA->regs, channel_num) != DMA_THREAD_STATUS_STOPPED)
+        {
+            __enable_irq();
+            return ARM_DMA_ERROR_BUSY;
+        }
+
+        ret = DMA_PrepareOpcode(channel_num, (ARM_DMA_PARAMS *)arg, DMA);
+
+        __enable_irq();
+
+        return ret;
     default:
         return ARM_DRIVER_ERROR_UNSUPPORTED;
     }
@@ -1017,14 +1490,53 @@ static void DMA_IRQHandler(uint8_t event_idx, DMA_RESOURCES *DMA)
 {
     dma_config_info_t   *dma_cfg     = &DMA->cfg;
     dma_desc_info_t     *desc_info;
+    const ARM_DMA_SG_LIST *sg_list;
+    uint32_t             last, event;
     uint8_t              channel_num = dma_cfg->event_map[event_idx];
 
     dma_clear_interrupt(DMA->regs, event_idx);
 
     desc_info = dma_get_desc_info(dma_cfg, channel_num);
+    sg_list   = DMA->sg_list[channel_num];
+
+    /* Cyclic program built by the driver: report the period */
+    if(((dma_get_channel_flags(dma_cfg, channel_num) &
+         (DMA_CHANNEL_FLAG_CYCLIC_MODE | DMA_CHANNEL_FLAG_USE_USER_MCODE)) ==
+        DMA_CHANNEL_FLAG_CYCLIC_MODE) && !sg_list)
+    {
+        DMA_CyclicPeriodDone(channel_num, &event, DMA);
+
+        if(DMA->cb_event[event_idx])
+            DMA->cb_event[event_idx](event, (int8_t)desc_info->periph_num);
+        return;
+    }
+
+    if(DMA_SGIsActive(channel_num, DMA))
+    {
+        if(!DMA_SGIsDone(channel_num, DMA))
+        {
+            /* Intermediate event: report up to the next flagged segment */
+            for(last = DMA->sg_next[channel_num]; last < sg_list->count; last++)
+            {
+                if(sg_list->entries[last].flags & ARM_DMA_SG_FLAG_EVENT)
+                    break;
+            }
+
+            DMA_SGInvalidateDCache(channel_num, last, DMA);
+
+            if(DMA->cb_event[event_idx])
+                DMA->cb_event[event_idx](ARM_DMA_EVENT_SEGMENT,
+                                         (int8_t)desc_info->periph_num);
+            return;
+        }
+
+        /* The final event may have been raised after the clear above */
+        dma_clear_interrupt(DMA->regs, event_idx);
+        NVIC_ClearPendingIRQ((IRQn_Type)(DMA->irq_start + event_idx));
+    }
 
     /* Invalidate the data from cache */
-    DMA_InvalidateDCache(desc_info);
+    DMA_InvalidateChannelDCache(channel_num, DMA);
 
     if(DMA->cb_event[event_idx])
         DMA->cb_event[event_idx](ARM_DMA_EVENT_COMPLETE,
@@ -1059,7 +1571,7 @@ static void DMA_AbortIRQHandler(DMA_RESOURCES *DMA)
             event_idx = dma_get_event_index(dma_cfg, channel_num);
 
             /* Invalidate the data from cache */
-            DMA_InvalidateDCache(desc_info);
+            DMA_InvalidateChannelDCache(channel_num, DMA);
 
             if(DMA->cb_event[event_idx])
                 DMA->cb_event[event_idx](ARM_DMA_EVENT_ABORT,
@@ -1078,7 +1590,7 @@ static void DMA_AbortIRQHandler(DMA_RESOURCES *DMA)
             event_idx = dma_get_event_index(dma_cfg, channel_num);
 
             /* Invalidate the data from cache */
-            DMA_InvalidateDCache(desc_info);
+            DMA_InvalidateChannelDCache(channel_num, DMA);
 
             if(DMA->cb_event[event_idx])
                 DMA->cb_event[event_idx](ARM_DMA_EVENT_ABORT,
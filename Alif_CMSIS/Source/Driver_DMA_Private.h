@@ -52,6 +52,9 @@ typedef union _DMA_DRV_STATUS {
 typedef struct _DMA_RESOURCES {
     DMA_Type                 *regs;                   /*!< DMA register map               */
     ARM_DMA_SignalEvent_t    cb_event[DMA_MAX_EVENTS];   /*!< DMA Application Event Callback */
+    const ARM_DMA_SG_LIST    *sg_list[DMA_MAX_CHANNELS]; /*!< Scatter-gather list per channel */
+    uint32_t                 sg_end_pc[DMA_MAX_CHANNELS];/*!< Address of the final DMAEND    */
+    uint32_t                 sg_next[DMA_MAX_CHANNELS];  /*!< First segment not yet reported */
     dma_config_info_t        cfg;                     /*!< DMA Controller configuration   */
     DMA_SECURE_STATE         ns_iface;                /*!< DMA interface to be used       */
     DMA_DRV_STATUS           drv_status;              /*!< DMA Driver Status              */
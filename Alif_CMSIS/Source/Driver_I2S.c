@@ -329,6 +329,29 @@ __STATIC_INLINE int32_t I2S_DMA_Usermcode(DMA_PERIPHERAL_CONFIG *dma_periph,
     return ARM_DRIVER_OK;
 }
 
+/**
+  \fn          int32_t I2S_DMA_Cyclic(DMA_PERIPHERAL_CONFIG *dma_periph,
+                                      uint8_t periods)
+  \brief       Select one shot or cyclic I2S DMA transfer
+  \param[in]   dma_periph  Pointer to DMA resources
+  \param[in]   periods  Number of periods, 0 for one shot
+  \return      \ref execution_status
+*/
+__STATIC_INLINE int32_t I2S_DMA_Cyclic(DMA_PERIPHERAL_CONFIG *dma_periph,
+                                       uint8_t periods)
+{
+    int32_t        status;
+    ARM_DRIVER_DMA *dma_drv = dma_periph->dma_drv;
+
+    status = dma_drv->Control(&dma_periph->dma_handle,
+                              ARM_DMA_CYCLIC_MODE,
+                              periods);
+    if(status)
+        return ARM_DRIVER_ERROR;
+
+    return ARM_DRIVER_OK;
+}
+
 /**
   \fn          int32_t I2S_DMA_Start(DMA_PERIPHERAL_CONFIG *dma_periph,
                                      ARM_DMA_PARAMS *dma_params)
@@ -587,6 +610,9 @@ static int32_t I2S_Uninitialize(I2S_RESOURCES *I2S)
         I2S->dma_cfg->dma_rx.dma_handle = -1;
         I2S->dma_cfg->dma_tx.dma_handle = -1;
     }
+
+    I2S->tx_dma_periods    = 0U;
+    I2S->rx_dma_periods    = 0U;
 #endif
 
     I2S->flags             = 0U;
@@ -703,6 +729,11 @@ static int32_t I2S_Send(const void *data, uint32_t num, I2S_RESOURCES *I2S)
             dma_params.burst_len  = I2S_FIFO_DEPTH - I2S->cfg->tx_fifo_trg_lvl;
         }
 
+        /* Loop over the buffer when streaming */
+        status = I2S_DMA_Cyclic(&I2S->dma_cfg->dma_tx, I2S->tx_dma_periods);
+        if(status)
+            return ARM_DRIVER_ERROR;
+
         /* Start DMA transfer */
         status = I2S_DMA_Start(&I2S->dma_cfg->dma_tx, &dma_params);
         if(status)
@@ -760,6 +791,14 @@ static int32_t I2S_Receive(void *data, uint32_t num, I2S_RESOURCES *I2S)
     I2S->drv_status.status_b.rx_overflow = 0U;
 
 #if I2S_DMA_ENABLE
+    /* Mono reception writes past the buffer end, which can't loop */
+    if(I2S->cfg->dma_enable && I2S->rx_dma_periods
+       && (I2S->flags & I2S_FLAG_DRV_MONO_MODE))
+    {
+        I2S->drv_status.status_b.rx_busy = 0U;
+        return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+
     /* Check if DMA & Mono is enabled for this */
     if(I2S->cfg->dma_enable && (I2S->flags & I2S_FLAG_DRV_MONO_MODE))
     {
@@ -834,6 +873,11 @@ static int32_t I2S_Receive(void *data, uint32_t num, I2S_RESOURCES *I2S)
             dma_params.burst_len  = I2S->cfg->rx_fifo_trg_lvl + 1;
         }
 
+        /* Loop over the buffer when streaming */
+        status = I2S_DMA_Cyclic(&I2S->dma_cfg->dma_rx, I2S->rx_dma_periods);
+        if(status)
+            return ARM_DRIVER_ERROR;
+
         /* Start DMA transfer */
         status = I2S_DMA_Start(&I2S->dma_cfg->dma_rx, &dma_params);
         if(status)
@@ -1140,6 +1184,28 @@ static int32_t I2S_Control(uint32_t control, uint32_t arg1,
             return ARM_DRIVER_ERROR;
         else
             return ARM_DRIVER_OK;
+    case ARM_SAI_DMA_STREAMING_TX:
+        if(!I2S->cfg->dma_enable)
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+
+        if(arg1 > 0xFF)
+            return ARM_DRIVER_ERROR_PARAMETER;
+
+        /* Applied by the next Send */
+        I2S->tx_dma_periods = (uint8_t)arg1;
+
+        return ARM_DRIVER_OK;
+    case ARM_SAI_DMA_STREAMING_RX:
+        if(!I2S->cfg->dma_enable)
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+
+        if(arg1 > 0xFF)
+            return ARM_DRIVER_ERROR_PARAMETER;
+
+        /* Applied by the next Receive */
+        I2S->rx_dma_periods = (uint8_t)arg1;
+
+        return ARM_DRIVER_OK;
 #endif
     case ARM_SAI_MASK_SLOTS_TX:
     case ARM_SAI_MASK_SLOTS_RX:
@@ -1337,6 +1403,40 @@ static void I2S_DMACallback(uint32_t event, int8_t peri_num,
     if(!I2S->cb_event)
         return;
 
+    /* Streaming period completed, the transfer keeps running */
+    if(event & ARM_DMA_EVENT_PERIOD)
+    {
+        switch(peri_num)
+        {
+        case I2S0_DMA_TX_PERIPH_REQ:
+        case I2S1_DMA_TX_PERIPH_REQ:
+        case I2S2_DMA_TX_PERIPH_REQ:
+        case I2S3_DMA_TX_PERIPH_REQ:
+#if defined (M55_HE)
+        case LPI2S_DMA_TX_PERIPH_REQ:
+#endif
+            I2S->cb_event(ARM_SAI_EVENT_SEND_PERIOD |
+                          (ARM_DMA_EVENT_PERIOD_INDEX(event)
+                           << ARM_SAI_EVENT_PERIOD_INDEX_Pos));
+            break;
+
+        case I2S0_DMA_RX_PERIPH_REQ:
+        case I2S1_DMA_RX_PERIPH_REQ:
+        case I2S2_DMA_RX_PERIPH_REQ:
+        case I2S3_DMA_RX_PERIPH_REQ:
+#if defined (M55_HE)
+        case LPI2S_DMA_RX_PERIPH_REQ:
+#endif
+            I2S->cb_event(ARM_SAI_EVENT_RECEIVE_PERIOD |
+                          (ARM_DMA_EVENT_PERIOD_INDEX(event)
+                           << ARM_SAI_EVENT_PERIOD_INDEX_Pos));
+            break;
+
+        default:
+            break;
+        }
+    }
+
     /* Transfer Completed */
     if(event & ARM_DMA_EVENT_COMPLETE)
     {
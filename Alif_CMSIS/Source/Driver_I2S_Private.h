@@ -116,6 +116,10 @@ typedef struct _I2S_RESOURCES {
 
     /*!< DMA Controller configuration */
     I2S_DMA_HW_CONFIG *dma_cfg;
+
+    /*!< DMA streaming periods (0: one shot) */
+    uint8_t tx_dma_periods;
+    uint8_t rx_dma_periods;
 #endif
 
     /*!< I2S ARM I2S Status */
@@ -34,12 +34,13 @@
 #error "MRAM not configured in RTE_Device.h!"
 #endif
 
-#define ARM_MRAM_DRV_VERSION    ARM_DRIVER_VERSION_MAJOR_MINOR(1, 0) /* driver version */
+#define ARM_MRAM_DRV_VERSION    ARM_DRIVER_VERSION_MAJOR_MINOR(1, 1) /* driver version */
 
 /* MRAM Device Resources. */
 static MRAM_RESOURCES mram =
 {
-    .state  = {0}
+    .state      = {0},
+    .write_skip = RTE_MRAM_WRITE_SKIP
 };
 
 /* Driver Version */
@@ -174,8 +175,26 @@ static int32_t MRAM_ReadData(uint32_t addr, void *data, uint32_t cnt)
 }
 
 /**
-  \fn          void MRAM_write(uint8_t *p_dst, const uint8_t *p_src)
-  \brief       write 128-bit data from source to destination(MRAM).
+  \fn          void MRAM_CleanRange(uint8_t *p_start, uint8_t *p_end)
+  \brief       Clean the D-cache over a run of programmed 128-bit lines.
+  \param[in]   p_start   Pointer to the first line of the run, NULL if none.
+  \param[in]   p_end     Pointer past the last line of the run.
+  \return      none
+*/
+static void MRAM_CleanRange(uint8_t *p_start, uint8_t *p_end)
+{
+    if(p_start == NULL)
+        return;
+
+    /* clean/flush Dcache once for the whole run. */
+    RTSS_CleanDCache_by_Addr((uint32_t *)p_start, (int32_t)(p_end - p_start));
+
+    mram.stats.cache_cleans++;
+}
+
+/**
+  \fn          int32_t MRAM_ProgramData(uint32_t addr, const void *data, uint32_t cnt)
+  \brief       Program data to MRAM.
   \Note        It is CRITICAL that this code running on the Application core
                 contains the following:
                  - H/W Limitations with Rev A silicon:
@@ -189,22 +208,6 @@ static int32_t MRAM_ReadData(uint32_t addr, void *data, uint32_t cnt)
                  - The code should include the function / Intrinsic “__DSB()”
                     to make sure all the data writes are flushed out
                     and have occurred.
-  \param[out]  p_dst   Pointer to destination address.
-  \param[in]   p_src   Pointer to source address.
-  \return      none
-*/
-static void MRAM_write(uint8_t *p_dst, const uint8_t *p_src)
-{
-    /* write 128bit to MRAM. */
-    mram_write_128bit(p_dst, p_src);
-
-    /* clean/flush Dcache. */
-    RTSS_CleanDCache_by_Addr((uint32_t *)p_dst, MRAM_SECTOR_SIZE);
-}
-
-/**
-  \fn          int32_t MRAM_ProgramData(uint32_t addr, const void *data, uint32_t cnt)
-  \brief       Program data to MRAM.
   \param[in]   addr   MRAM address-offset.
   \param[in]   data   Pointer to a buffer containing the data to be programmed to MRAM.
   \param[in]   cnt    Number of data items to program.
@@ -226,73 +229,67 @@ static int32_t MRAM_ProgramData(uint32_t addr, const void *data, uint32_t cnt)
      * so add MRAM Base-address to it. */
     addr += MRAM_BASE;
 
-    /* check address with aligned to 16-Bytes.*/
-    uint32_t aligned_addr   = addr & MRAM_ADDR_ALIGN_MASK;
-    uint8_t *p_aligned_addr = (uint8_t *) aligned_addr;
-    uint8_t *p_data         = (uint8_t *) data;
-    uint32_t count          = cnt;
+    uint8_t *p_line         = (uint8_t *) (addr & MRAM_ADDR_ALIGN_MASK);
+    uint8_t *p_end          = (uint8_t *) (addr + cnt);
+    uint8_t *p_run          = NULL;
+    const uint8_t *p_data   = (const uint8_t *) data;
+    const uint8_t *p_src;
+    uint32_t offset         = addr & (~MRAM_ADDR_ALIGN_MASK);
+    uint32_t bytes;
 
-    /* use temporary buffer to store data in case of unaligned memory.*/
+    /* use temporary buffer to store data in case of partial line.*/
     uint8_t temp_buff[MRAM_SECTOR_SIZE] = {0}; /* 128-Bit */
 
-    /* is MRAM address aligned to 16-Byte? */
-    if(addr != aligned_addr)
+    while(p_line < p_end)
     {
-        /* unaligned MRAM address:
-         *  - make it to nearest aligned 16-Byte address,
-         *     by writing only unaligned bytes.
-         */
-
-        uint8_t offset           = addr & (~MRAM_ADDR_ALIGN_MASK);
-        uint8_t unaligned_bytes  = MRAM_SECTOR_SIZE - offset;
+        /* bytes of this line covered by the request. */
+        bytes = MRAM_SECTOR_SIZE - offset;
 
-        /* is unaligned bytes more than remaining count? */
-        if(unaligned_bytes > count)
+        if(bytes > (uint32_t)(p_end - (p_line + offset)))
         {
-            /* then take only remaining count. */
-            unaligned_bytes = count;
+            bytes = (uint32_t)(p_end - (p_line + offset));
         }
 
-        /* copy original one sector data from MRAM address to buffer. */
-        memcpy(temp_buff, p_aligned_addr, MRAM_SECTOR_SIZE);
-
-        /* overwrite buffer with new data as per offset and unaligned bytes. */
-        memcpy(temp_buff + offset, p_data, unaligned_bytes);
+        if(bytes != MRAM_SECTOR_SIZE)
+        {
+            /* partial line: merge the new bytes into
+             * the original line data. */
+            memcpy(temp_buff, p_line, MRAM_SECTOR_SIZE);
+            memcpy(temp_buff + offset, p_data, bytes);
+            p_src = temp_buff;
+        }
+        else
+        {
+            /* full line: copy directly from source-data. */
+            p_src = p_data;
+        }
 
-        /* now, copy 128bit from buffer to MRAM. */
-        MRAM_write(p_aligned_addr, temp_buff);
+        if(mram.write_skip && (memcmp(p_line, p_src, MRAM_SECTOR_SIZE) == 0))
+        {
+            /* line already holds the data:
+             * end the current run of programmed lines. */
+            MRAM_CleanRange(p_run, p_line);
+            p_run = NULL;
 
-        p_aligned_addr += MRAM_SECTOR_SIZE;
-        p_data         += unaligned_bytes;
-        count          -= unaligned_bytes;
-    }
+            mram.stats.lines_skipped++;
+        }
+        else
+        {
+            /* write 128bit to MRAM. */
+            mram_write_128bit(p_line, p_src);
 
-    uint32_t sector_cnt    = count / MRAM_SECTOR_SIZE;
-    uint8_t unaligned_cnt  = count % MRAM_SECTOR_SIZE;
+            if(p_run == NULL)
+                p_run = p_line;
 
-    /* program 128-bit to absolute sector. */
-    while(sector_cnt--)
-    {
-        /* as MRAM address is 16-byte aligned,
-         * directly copy 128bit from source-data to MRAM. */
-        MRAM_write(p_aligned_addr, p_data);
+            mram.stats.lines_written++;
+        }
 
-        p_aligned_addr += MRAM_SECTOR_SIZE;
-        p_data         += MRAM_SECTOR_SIZE;
+        p_line += MRAM_SECTOR_SIZE;
+        p_data += bytes;
+        offset  = 0;
     }
 
-    /* program remaining unaligned data. */
-    if(unaligned_cnt)
-    {
-        /* copy original one sector data from MRAM address to buffer.*/
-        memcpy(temp_buff, p_aligned_addr, MRAM_SECTOR_SIZE);
-
-        /* overwrite buffer with new data as per remaining unaligned count.*/
-        memcpy(temp_buff, p_data, unaligned_cnt);
-
-        /* now, copy 128bit from buffer to MRAM. */
-        MRAM_write(p_aligned_addr, temp_buff);
-    }
+    MRAM_CleanRange(p_run, p_line);
 
     return cnt;
 }
@@ -322,6 +319,42 @@ static int32_t MRAM_EraseChip(void)
 {
     return ARM_DRIVER_OK;
 }
+
+/**
+  \fn          int32_t MRAM_Control(uint32_t control, uint32_t arg)
+  \brief       Control the MRAM interface.
+  \param[in]   control  Operation
+  \param[in]   arg      Argument of operation
+  \return      \ref execution_status
+*/
+static int32_t MRAM_Control(uint32_t control, uint32_t arg)
+{
+    switch (control)
+    {
+    case ARM_MRAM_WRITE_SKIP:
+        if (arg > 1U)
+            return ARM_DRIVER_ERROR_PARAMETER;
+
+        mram.write_skip = (uint8_t)arg;
+        break;
+
+    case ARM_MRAM_GET_STATS:
+        if (arg == 0U)
+            return ARM_DRIVER_ERROR_PARAMETER;
+
+        *((ARM_MRAM_STATS *)arg) = mram.stats;
+        break;
+
+    case ARM_MRAM_RESET_STATS:
+        memset(&mram.stats, 0, sizeof(mram.stats));
+        break;
+
+    default:
+        return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+
+    return ARM_DRIVER_OK;
+}
 // End MRAM Interface
 
 
@@ -340,7 +373,8 @@ ARM_DRIVER_MRAM Driver_MRAM =
     MRAM_ReadData,
     MRAM_ProgramData,
     MRAM_EraseSector,
-    MRAM_EraseChip
+    MRAM_EraseChip,
+    MRAM_Control
 };
 #endif /* RTE_MRAM */
 
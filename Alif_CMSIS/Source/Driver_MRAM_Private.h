@@ -38,6 +38,10 @@ extern "C" {
 */
 #define MRAM_USER_SIZE            RTE_MRAM_SIZE
 
+#ifndef RTE_MRAM_WRITE_SKIP
+#define RTE_MRAM_WRITE_SKIP       0
+#endif
+
 /**
 \brief MRAM Driver states.
 */
@@ -53,7 +57,9 @@ typedef volatile struct _MRAM_DRIVER_STATE
 */
 typedef struct _MRAM_RESOURCES
 {
-  MRAM_DRIVER_STATE  state;    /* MRAM driver state  */
+  MRAM_DRIVER_STATE  state;      /* MRAM driver state                */
+  uint8_t            write_skip; /* Skip lines holding the data      */
+  ARM_MRAM_STATS     stats;      /* Program statistics               */
 } MRAM_RESOURCES;
 
 #ifdef __cplusplus
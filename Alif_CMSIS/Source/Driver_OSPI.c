@@ -575,12 +575,24 @@ static int32_t ARM_OSPI_Send(OSPI_RESOURCES *OSPI, const void *data, uint32_t nu
 
     OSPI->status.busy = 1;
     OSPI->transfer.tx_total_cnt      = num;
+    OSPI->transfer.tx_hdr_cnt        = 0;
     OSPI->transfer.mode              = SPI_TMOD_TX;
 
+    /* Instruction and address frames go ahead of the data, one-shot */
+    if (OSPI->tx_hdr_valid)
+    {
+        OSPI->tx_hdr_valid          = false;
+        OSPI->transfer.tx_hdr[0]    = OSPI->tx_hdr.cmd;
+        OSPI->transfer.tx_hdr[1]    = OSPI->tx_hdr.addr;
+        OSPI->transfer.tx_hdr_cnt   = (OSPI->transfer.addr_len == ARM_OSPI_ADDR_LENGTH_0_BITS) ? 1U : 2U;
+        OSPI->transfer.tx_total_cnt = num + OSPI->transfer.tx_hdr_cnt;
+    }
+
 #if OSPI_DMA_ENABLE
     ARM_DMA_PARAMS dma_params;
 
-    if (OSPI->dma_enable && (ospi_get_dfs(OSPI->regs) > 8))
+    /* Packed data behind a header is fed by the interrupt handler */
+    if (OSPI->dma_enable && (ospi_get_dfs(OSPI->regs) > 8) && (OSPI->transfer.tx_hdr_cnt == 0))
     {
         dma_params.peri_reqno   = OSPI->dma_config->dma_tx.dma_periph_req;
         dma_params.dir          = ARM_DMA_MEM_TO_DEV;
@@ -651,6 +663,7 @@ static int32_t ARM_OSPI_Receive(OSPI_RESOURCES *OSPI, void *data, uint32_t num)
     OSPI->transfer.rx_buff          = (uint8_t *) data;
     OSPI->transfer.rx_current_cnt   = 0;
     OSPI->transfer.rx_total_cnt     = num;
+    OSPI->transfer.tx_hdr_cnt       = 0;
     OSPI->transfer.mode             = SPI_TMOD_RX;
     OSPI->transfer.status           = SPI_TRANSFER_STATUS_NONE;
 
@@ -703,6 +716,7 @@ static int32_t ARM_OSPI_Transfer(OSPI_RESOURCES *OSPI, const void *data_out, voi
     OSPI->status.busy = 1;
 
     OSPI->transfer.rx_total_cnt   = num;
+    OSPI->transfer.tx_hdr_cnt     = 0;
     OSPI->transfer.mode           = SPI_TMOD_TX_AND_RX;
 
     /* Tx total count based on address length */
@@ -916,6 +930,8 @@ static int32_t ARM_OSPI_Control(OSPI_RESOURCES *OSPI, uint32_t control, uint32_t
             OSPI->transfer.rx_total_cnt         = 0;
             OSPI->transfer.tx_current_cnt       = 0;
             OSPI->transfer.rx_current_cnt       = 0;
+            OSPI->transfer.tx_hdr_cnt           = 0;
+            OSPI->tx_hdr_valid                  = false;
             OSPI->status.busy          			= 0;
 
             return ARM_DRIVER_OK;
@@ -940,6 +956,19 @@ static int32_t ARM_OSPI_Control(OSPI_RESOURCES *OSPI, uint32_t control, uint32_t
             break;
         }
 
+        case ARM_OSPI_SET_TX_HEADER:
+        {
+            if (arg == 0U)
+            {
+                return ARM_DRIVER_ERROR_PARAMETER;
+            }
+
+            OSPI->tx_hdr       = *((const ARM_OSPI_TX_HEADER *) arg);
+            OSPI->tx_hdr_valid = true;
+
+            return ARM_DRIVER_OK;
+        }
+
         default:
             return ARM_DRIVER_ERROR_UNSUPPORTED;
     }
@@ -76,6 +76,8 @@ typedef struct _OSPI_RESOURCES
     uint32_t                    rx_total_cnt;          /* Total count to receive */
     ospi_transfer_t             transfer;              /* Transfer structure for the instance */
     SPI_TMOD                    mode;                  /* Transfer mode */
+    ARM_OSPI_TX_HEADER          tx_hdr;                /* Header for the next Send */
+    bool                        tx_hdr_valid;          /* tx_hdr is set */
 #if OSPI_DMA_ENABLE
     ARM_DMA_SignalEvent_t       dma_cb;                /* Pointer to DMA callback function */
     OSPI_DMA_HW_CONFIG          *dma_config;           /* OSPI DMA configuration */
@@ -199,6 +199,29 @@ static inline int32_t PDM_DMA_Start(DMA_PERIPHERAL_CONFIG *dma_periph,
     return ARM_DRIVER_OK;
 }
 
+/**
+  \fn          int32_t PDM_DMA_Cyclic(DMA_PERIPHERAL_CONFIG *dma_periph,
+                                      uint8_t periods)
+  \brief       Select one shot or cyclic PDM DMA transfer
+  \param[in]   dma_periph  Pointer to DMA resources
+  \param[in]   periods  Number of periods, 0 for one shot
+  \return      \ref execution_status
+*/
+static inline int32_t PDM_DMA_Cyclic(DMA_PERIPHERAL_CONFIG *dma_periph,
+                                     uint8_t periods)
+{
+    int32_t        status;
+    ARM_DRIVER_DMA *dma_drv = dma_periph->dma_drv;
+
+    status = dma_drv->Control(&dma_periph->dma_handle,
+                              ARM_DMA_CYCLIC_MODE,
+                              periods);
+    if(status)
+        return ARM_DRIVER_ERROR;
+
+    return ARM_DRIVER_OK;
+}
+
 /**
   \fn          int32_t PDM_DMA_Stop(DMA_PERIPHERAL_CONFIG *dma_periph)
   \brief       Stop PDM DMA transfer
@@ -316,6 +339,14 @@ static void PDMx_DMACallback(uint32_t event, int8_t peri_num, PDM_RESOURCES *PDM
     if(!PDM->cb_event)
         return;
 
+    /* Streaming period captured, the transfer keeps running */
+    if(event & ARM_DMA_EVENT_PERIOD)
+    {
+        PDM->cb_event(ARM_PDM_EVENT_CAPTURE_PERIOD |
+                      (ARM_DMA_EVENT_PERIOD_INDEX(event)
+                       << ARM_PDM_EVENT_PERIOD_INDEX_Pos));
+    }
+
     if(event & ARM_DMA_EVENT_COMPLETE)
     {
         /* Disable the PDM error irq */
@@ -722,6 +753,21 @@ static int32_t PDMx_Control (uint32_t control,
         pdm_sample_advance(PDM->regs, arg1);
 
         break;
+
+#if PDM_DMA_ENABLE
+    case ARM_PDM_DMA_STREAMING:
+
+        if(!PDM->dma_enable)
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+
+        if(arg1 > 0xFF)
+            return ARM_DRIVER_ERROR_PARAMETER;
+
+        /* Applied by the next Receive */
+        PDM->dma_periods = (uint8_t)arg1;
+
+        break;
+#endif
     }
     return ARM_DRIVER_OK;
 }
@@ -805,6 +851,12 @@ static int32_t PDMx_Receive(void *data, uint32_t num, PDM_RESOURCES *PDM)
         dma_params.burst_len    = PDM->fifo_watermark + 1;
         dma_params.burst_size   = BS_BYTE_4;
 
+        /* Loop over the buffer when streaming */
+        if(PDM_DMA_Cyclic(&PDM->dma_cfg->dma_rx, PDM->dma_periods) != ARM_DRIVER_OK)
+        {
+            return ARM_DRIVER_ERROR;
+        }
+
         /* Start DMA transfer */
         if(PDM_DMA_Start(&PDM->dma_cfg->dma_rx, &dma_params) != ARM_DRIVER_OK)
         {
@@ -69,6 +69,7 @@ typedef struct _PDM_RESOURCES
     PDM_DMA_HW_CONFIG                *dma_cfg;              /* DMA controller configuration       */
     bool                              dma_enable;           /* PDM instance DMA enable            */
     uint8_t                           dma_irq_priority;     /* PDM instance DMA irq priority      */
+    uint8_t                           dma_periods;          /* DMA streaming periods, 0: one shot */
 #endif
     IRQn_Type                         error_irq;            /* PDM error IRQ number               */
     IRQn_Type                         warning_irq;          /* PDM warning IRQ number             */
@@ -22,19 +22,20 @@
 #include "driver_mac.h"
 #include "sys_ctrl_eth.h"
 
+#include <string.h>
+
 static MAC_DEV MAC0 = {
     .regs = (volatile MAC_REGS *) ETH_BASE,
     .flags  = 0,
     .cb_event = NULL,
-    .frame_end = NULL,
     .irq = (IRQn_Type) ETH_SBD_IRQ_IRQn,
     .irq_priority = RTE_ETH_MAC_IRQ_PRIORITY,
 };
 
 /* area for descriptors */
 static DMA_DESC dma_descs[RX_DESC_COUNT + TX_DESC_COUNT]__attribute__((section("eth_buf"))) __attribute__((aligned(16)));
-static uint32_t rx_buffers[RX_DESC_COUNT][ETH_BUF_SIZE >> 2]__attribute__((section("eth_buf")));
-static uint32_t tx_buffers[TX_DESC_COUNT][ETH_BUF_SIZE >> 2]__attribute__((section("eth_buf")));
+static uint32_t rx_buffers[RX_DESC_COUNT][ETH_BUF_SIZE >> 2]__attribute__((section("eth_buf"))) __attribute__((aligned(ETH_CACHE_LINE)));
+static uint32_t tx_buffers[TX_DESC_COUNT][ETH_BUF_SIZE >> 2]__attribute__((section("eth_buf"))) __attribute__((aligned(ETH_CACHE_LINE)));
 
 #define ARM_ETH_MAC_DRV_VERSION    ARM_DRIVER_VERSION_MAJOR_MINOR(1, 0) /* driver version */
 
@@ -44,8 +45,8 @@ static const ARM_DRIVER_VERSION DriverVersion = {
     ARM_ETH_MAC_DRV_VERSION
 };
 
-/* Driver Capabilities */
-static const ARM_ETH_MAC_CAPABILITIES DriverCapabilities = {
+/* Driver Capabilities, checksum offload is set from MAC_HW_FEATURE_0 at Initialize */
+static ARM_ETH_MAC_CAPABILITIES DriverCapabilities = {
     0,        /* IPv4 header checksum verified on receive */
     0,        /* IPv6 checksum verification supported on receive */
     0,        /* UDP payload checksum verified on receive */
@@ -78,9 +79,12 @@ static void setup_rxdesc(MAC_DEV *dev, uint32_t desc_id)
 
     SCB_InvalidateDCache_by_Addr((uint32_t *)desc, sizeof(DMA_DESC));
 
-    desc->des0 = (uint32_t) LocalToGlobal(&rx_buffers[desc_id][0]);
-    desc->des3 = RDES3_OWN | RDES3_INT_ON_COMPLETION_EN |
-                    RDES3_BUFFER1_VALID_ADDR;
+    desc->des0 = (uint32_t) LocalToGlobal(dev->rx_bufs[desc_id]);
+    desc->des3 = RDES3_OWN | RDES3_BUFFER1_VALID_ADDR;
+
+    /* Interrupt once per RTE_ETH_MAC_RX_IRQ_FRAMES frames, the Rx watchdog flushes the rest */
+    if ((desc_id % RTE_ETH_MAC_RX_IRQ_FRAMES) == (RTE_ETH_MAC_RX_IRQ_FRAMES - 1))
+        desc->des3 |= RDES3_INT_ON_COMPLETION_EN;
 
     SCB_CleanDCache_by_Addr((uint32_t *) desc, sizeof(DMA_DESC));
 }
@@ -98,6 +102,8 @@ static void init_rx_descs(MAC_DEV *dev)
     for (i = 0; i < RX_DESC_COUNT; i++)
         setup_rxdesc(dev, i);
 
+    dev->rx_desc_id = 0;
+
     dev->regs->DMA_CH0_RX_BASE_ADDR = (uint32_t) LocalToGlobal(dev->rx_descs);
     dev->regs->DMA_CH0_RX_RING_LEN = RX_DESC_COUNT - 1;
 
@@ -116,9 +122,20 @@ static void init_tx_descs(MAC_DEV *dev)
 {
     uint32_t i;
 
-    for (i = 0; i < TX_DESC_COUNT; i++)
+    for (i = 0; i < TX_DESC_COUNT; i++) {
         dev->tx_descs[i] = (DMA_DESC) {0, 0, 0, 0};
 
+        /* Hand back zero-copy buffers that will not be sent */
+        if (dev->tx_tokens[i] && dev->tx_done)
+            dev->tx_done(dev->tx_tokens[i]);
+        dev->tx_tokens[i] = NULL;
+    }
+
+    dev->tx_desc_id = 0;
+    dev->tx_clean_id = 0;
+    dev->tx_used = 0;
+    dev->flags &= ~ETH_TX_FRAGMENT;
+
     dev->regs->DMA_CH0_TX_BASE_ADDR = (uint32_t) LocalToGlobal(dev->tx_descs);
     dev->regs->DMA_CHO_TX_RING_LEN = TX_DESC_COUNT - 1;
 
@@ -134,6 +151,14 @@ static void init_tx_descs(MAC_DEV *dev)
 */
 static void init_descriptors(MAC_DEV *dev)
 {
+    uint32_t i;
+
+    /* Driver buffers unless a pool is installed */
+    for (i = 0; i < RX_DESC_COUNT; i++) {
+        if (!dev->rx_bufs[i])
+            dev->rx_bufs[i] = (uint8_t *) &rx_buffers[i][0];
+    }
+
     dev->descs = dma_descs;
     dev->tx_descs = (DMA_DESC *) dev->descs;
     dev->rx_descs = (dev->tx_descs + TX_DESC_COUNT);
@@ -231,7 +256,11 @@ static int32_t mac_hw_init(MAC_DEV *dev)
     dev->regs->DMA_CH0_TX_CTRL |= (16 << DMA_CH0_TX_CONTROL_TXPBL_SHIFT);
 
     dev->regs->DMA_CH0_RX_CTRL |= ((16 << DMA_CH0_RX_CONTROL_RXPBL_SHIFT) |
-                                   (2048 << DMA_CH0_RX_CONTROL_RBSZ_SHIFT));
+                                   (ETH_BUF_SIZE << DMA_CH0_RX_CONTROL_RBSZ_SHIFT));
+
+    /* Rx interrupt moderation */
+    dev->regs->DMA_CH0_RX_INT_WDT = (RTE_ETH_MAC_RX_IRQ_WATCHDOG & DMA_RX_INT_WDT_RWT_MASK) |
+                                    (DMA_RX_INT_WDT_RWTU_256 << DMA_RX_INT_WDT_RWTU_SHIFT);
 
     val = dev->regs->DMA_SYS_BUS_MODE;
     val |= DMA_SYSBUS_MODE_BLEN4 | DMA_SYSBUS_MODE_BLEN8 |
@@ -327,9 +356,31 @@ static ARM_ETH_MAC_CAPABILITIES ETH_MAC_GetCapabilities(void)
 */
 static int32_t Initialize(ARM_ETH_MAC_SignalEvent_t cb_event, MAC_DEV *dev)
 {
+    uint32_t rx_coe, tx_coe;
+
     if (!cb_event)
         return ARM_DRIVER_ERROR_PARAMETER;
 
+    /* The checksum offload engines are a synthesis option of the MAC */
+    enable_eth_periph_clk();
+
+    rx_coe = !!(dev->regs->MAC_HW_FEATURE_0 & MAC_HW_FEATURE0_RXCOESEL);
+    tx_coe = !!(dev->regs->MAC_HW_FEATURE_0 & MAC_HW_FEATURE0_TXCOESEL);
+
+    if (!(dev->flags & ETH_POWER))
+        disable_eth_periph_clk();
+
+    DriverCapabilities.checksum_offload_rx_ip4  = rx_coe;
+    DriverCapabilities.checksum_offload_rx_ip6  = rx_coe;
+    DriverCapabilities.checksum_offload_rx_udp  = rx_coe;
+    DriverCapabilities.checksum_offload_rx_tcp  = rx_coe;
+    DriverCapabilities.checksum_offload_rx_icmp = rx_coe;
+    DriverCapabilities.checksum_offload_tx_ip4  = tx_coe;
+    DriverCapabilities.checksum_offload_tx_ip6  = tx_coe;
+    DriverCapabilities.checksum_offload_tx_udp  = tx_coe;
+    DriverCapabilities.checksum_offload_tx_tcp  = tx_coe;
+    DriverCapabilities.checksum_offload_tx_icmp = tx_coe;
+
     dev->flags |=  ETH_INIT;
     dev->cb_event = cb_event;
 
@@ -501,10 +552,201 @@ static int32_t SetAddressFilter(const ARM_ETH_MAC_ADDR *ptr_addr, uint32_t num_a
     return ARM_DRIVER_OK;
 }
 
+/**
+  \fn          uint32_t release_tx (MAC_DEV *dev)
+  \brief       Release the Tx DMA descriptors of sent frames and hand their
+               zero-copy buffers back to the caller.
+  \param[in]   dev    Pointer to the MAC device instance
+  \return      number of free Tx DMA descriptors
+*/
+static uint32_t release_tx(MAC_DEV *dev)
+{
+    DMA_DESC *desc;
+    void *token;
+
+    while (dev->tx_used) {
+        /* The first descriptor of a frame being queued is not owned yet */
+        if ((dev->flags & ETH_TX_FRAGMENT) && (dev->tx_clean_id == dev->tx_first_id))
+            break;
+
+        desc = &dev->tx_descs[dev->tx_clean_id];
+
+        SCB_InvalidateDCache_by_Addr(desc, sizeof(DMA_DESC));
+
+        if (desc->des3 & TDES3_OWN)
+            break;
+
+        token = dev->tx_tokens[dev->tx_clean_id];
+        dev->tx_tokens[dev->tx_clean_id] = NULL;
+
+        if (token && dev->tx_done)
+            dev->tx_done(token);
+
+        dev->tx_clean_id++;
+        dev->tx_clean_id %= TX_DESC_COUNT;
+        dev->tx_used--;
+    }
+
+    /* One descriptor stays unused so that a full ring differs from an empty one */
+    return (TX_DESC_COUNT - 1) - dev->tx_used;
+}
+
+/**
+  \fn          void end_tx (MAC_DEV *dev, DMA_DESC *desc)
+  \brief       Mark the last Tx DMA descriptor of the frame being queued and
+               hand the frame to the DMA, moving the tail pointer.
+  \param[in]   dev    Pointer to the MAC device instance
+  \param[in]   desc   Last descriptor of the frame
+  \return      none.
+*/
+static void end_tx(MAC_DEV *dev, DMA_DESC *desc)
+{
+    desc->des2 |= TDES2_INTERRUPT_ON_COMPLETION;
+    desc->des3 |= TDES3_LAST_DESCRIPTOR;
+
+    SCB_CleanDCache_by_Addr((uint32_t *) desc, sizeof(DMA_DESC));
+
+    dev->flags &= ~ETH_TX_FRAGMENT;
+
+    /* Frame complete, hand it to the DMA */
+    desc = &dev->tx_descs[dev->tx_first_id];
+    desc->des3 |= TDES3_OWN | (dev->tx_frame_len & TDES3_PACKET_SIZE_MASK);
+
+    SCB_CleanDCache_by_Addr((uint32_t *) desc, sizeof(DMA_DESC));
+
+    dev->regs->DMA_CH0_TX_END_ADDR = (uint32_t) LocalToGlobal(&(dev->tx_descs[dev->tx_desc_id]));
+}
+
+/**
+  \fn          void queue_tx (MAC_DEV *dev, const uint8_t *buf, uint32_t len,
+                              uint32_t flags, void *token)
+  \brief       Attach a buffer to the next Tx DMA descriptor. The first
+               descriptor of a frame is handed to the DMA once the last one
+               is queued, the tail pointer is moved once per frame.
+  \param[in]   dev    Pointer to the MAC device instance
+  \param[in]   buf    Buffer, cleaned from the D-cache
+  \param[in]   len    Buffer length in bytes
+  \param[in]   flags  Frame transmit flags (see ARM_ETH_MAC_TX_FRAME_...)
+  \param[in]   token  Zero-copy buffer token, NULL for driver buffers
+  \return      none.
+*/
+static void queue_tx(MAC_DEV *dev, const uint8_t *buf, uint32_t len,
+    uint32_t flags, void *token)
+{
+    uint32_t cur_idx = dev->tx_desc_id;
+    DMA_DESC *desc = &dev->tx_descs[cur_idx];
+
+    if (!(dev->flags & ETH_TX_FRAGMENT)) {
+        /* new frame */
+        dev->tx_first_id = cur_idx;
+        dev->tx_frame_len = 0;
+    }
+
+    dev->tx_tokens[cur_idx] = token;
+    dev->tx_frame_len += len;
+
+    desc->des0 = (uint32_t) LocalToGlobal(buf);
+    desc->des1 = 0;
+    desc->des2 = len & TDES2_BUFFER1_SIZE_MASK;
+    if (cur_idx == dev->tx_first_id) {
+        desc->des3 = TDES3_FIRST_DESCRIPTOR;
+
+        /* Checksums of the whole frame, including the pseudo-header, are inserted by the MAC */
+        if (dev->flags & ETH_TX_CSUM)
+            desc->des3 |= TDES3_CIC_FULL << TDES3_CHECKSUM_INSERTION_SHIFT;
+    } else {
+        desc->des3 = TDES3_OWN;
+    }
+
+    dev->stats.tx_descs++;
+    dev->tx_used++;
+    dev->tx_desc_id++;
+    dev->tx_desc_id %= TX_DESC_COUNT;
+
+    if (flags & ARM_ETH_MAC_TX_FRAME_FRAGMENT) {
+        /* More data to come */
+        SCB_CleanDCache_by_Addr((uint32_t *) desc, sizeof(DMA_DESC));
+        dev->flags |= ETH_TX_FRAGMENT;
+        return;
+    }
+
+    end_tx(dev, desc);
+}
+
+/**
+  \fn          int32_t tx_ring_full (MAC_DEV *dev, const uint8_t *buf, uint32_t len,
+                                   uint32_t flags)
+  \brief       Queue a fragment that found no free Tx DMA descriptor. A
+               first fragment is retried later by the caller. A later one
+               is copied behind the previous fragment if that sits in a
+               driver buffer with room left, otherwise the frame is dropped:
+               a frame left half built would take the caller's next frame
+               as its continuation.
+  \param[in]   dev    Pointer to the MAC device instance
+  \param[in]   buf    Fragment to queue
+  \param[in]   len    Fragment length in bytes
+  \param[in]   flags  Frame transmit flags (see ARM_ETH_MAC_TX_FRAME_...)
+  \return      ARM_DRIVER_OK when the fragment was copied,
+               ARM_DRIVER_ERROR_BUSY for a first fragment,
+               ARM_DRIVER_ERROR when the frame was dropped
+*/
+static int32_t tx_ring_full(MAC_DEV *dev, const uint8_t *buf, uint32_t len,
+    uint32_t flags)
+{
+    uint32_t last_idx = (dev->tx_desc_id + TX_DESC_COUNT - 1) % TX_DESC_COUNT;
+    DMA_DESC *desc = &dev->tx_descs[last_idx];
+    uint8_t *last_buf = (uint8_t *) &tx_buffers[last_idx][0];
+    uint32_t last_len = desc->des2 & TDES2_BUFFER1_SIZE_MASK;
+    void *token;
+
+    if (!(dev->flags & ETH_TX_FRAGMENT))
+        return ARM_DRIVER_ERROR_BUSY;
+
+    /* The DMA owns none of this frame's descriptors yet */
+    if ((desc->des0 == (uint32_t) LocalToGlobal(last_buf)) &&
+        ((last_len + len) <= ETH_BUF_SIZE)) {
+        memcpy(last_buf + last_len, buf, len);
+        SCB_CleanDCache_by_Addr((uint32_t *) (last_buf + last_len), len);
+
+        dev->stats.bytes_copied += len;
+        dev->tx_frame_len += len;
+        desc->des2 = (last_len + len) & TDES2_BUFFER1_SIZE_MASK;
+
+        if (flags & ARM_ETH_MAC_TX_FRAME_FRAGMENT)
+            SCB_CleanDCache_by_Addr((uint32_t *) desc, sizeof(DMA_DESC));
+        else
+            end_tx(dev, desc);
+
+        return ARM_DRIVER_OK;
+    }
+
+    /* Drop the frame, the DMA has not been handed any of its descriptors */
+    while (dev->tx_desc_id != dev->tx_first_id) {
+        dev->tx_desc_id += TX_DESC_COUNT - 1;
+        dev->tx_desc_id %= TX_DESC_COUNT;
+
+        dev->tx_descs[dev->tx_desc_id] = (DMA_DESC) {0, 0, 0, 0};
+        SCB_CleanDCache_by_Addr((uint32_t *) &dev->tx_descs[dev->tx_desc_id], sizeof(DMA_DESC));
+
+        token = dev->tx_tokens[dev->tx_desc_id];
+        dev->tx_tokens[dev->tx_desc_id] = NULL;
+
+        if (token && dev->tx_done)
+            dev->tx_done(token);
+
+        dev->tx_used--;
+    }
+    dev->flags &= ~ETH_TX_FRAGMENT;
+
+    return ARM_DRIVER_ERROR;
+}
+
 /**
   \fn          int32_t SendFrame (const uint8_t *frame, uint32_t len, uint32_t flags,
                                     MAC_DEV *dev)
-  \brief       Send Ethernet frame.
+  \brief       Send Ethernet frame. Every fragment is copied to the buffer of
+               its own Tx DMA descriptor, or appended to the previous one
+               when the frame runs out of descriptors.
   \param[in]   frame  Pointer to frame buffer with data to send
   \param[in]   len    Frame buffer length in bytes
   \param[in]   flags  Frame transmit flags (see ARM_ETH_MAC_TX_FRAME_...)
@@ -514,68 +756,81 @@ static int32_t SetAddressFilter(const ARM_ETH_MAC_ADDR *ptr_addr, uint32_t num_a
 static int32_t SendFrame(const uint8_t *frame, uint32_t len, uint32_t flags,
     MAC_DEV *dev)
 {
-    uint32_t cur_idx;
-    uint8_t *dst;
-    uint32_t buffer_len = len;
-    DMA_DESC *desc;
+    uint8_t *buf;
+    int32_t status;
 
-    if (!frame || !len)
+    if (!frame || !len || (len > ETH_BUF_SIZE))
         return ARM_DRIVER_ERROR_PARAMETER;
 
     if (!(dev->flags & ETH_POWER))
         return ARM_DRIVER_ERROR;
 
-    cur_idx = dev->tx_desc_id;
-    desc = &dev->tx_descs[cur_idx];
+    if (!release_tx(dev)) {
+        status = tx_ring_full(dev, frame, len, flags);
+        if ((status == ARM_DRIVER_OK) && !(flags & ARM_ETH_MAC_TX_FRAME_FRAGMENT))
+            dev->stats.tx_frames_copied++;
+        return status;
+    }
 
-    SCB_InvalidateDCache_by_Addr(desc, sizeof(DMA_DESC));
+    buf = (uint8_t *) &tx_buffers[dev->tx_desc_id][0];
 
-    dst = dev->frame_end;
+    /* Copy the fragment to the buffer */
+    memcpy(buf, frame, len);
 
-    if (dst == NULL) {
-        /* new frame */
-        if (desc->des3 & TDES3_OWN) {
-            return ARM_DRIVER_ERROR_BUSY;
-        }
-        dst = (uint8_t *) &tx_buffers[cur_idx][0];
-        desc->des2 = TDES2_INTERRUPT_ON_COMPLETION | buffer_len;
-    } else {
-        /* frame fragment */
-        desc->des2 += len;
-    }
+    /* Only the lines written need to reach memory */
+    SCB_CleanDCache_by_Addr((uint32_t *) buf, len);
 
-    /* Copy the frame to the buffer */
-    for ( ; len > 7; dst += 8, frame += 8, len -= 8) {
-        ((uint32_t *) dst)[0] = ((uint32_t *) frame)[0];
-        ((uint32_t *) dst)[1] = ((uint32_t *) frame)[1];
-    }
-    /* Copy remaining 7 bytes */
-    for ( ; len > 1; dst += 2, frame += 2, len -= 2)
-        ((uint16_t *) dst)[0] = ((uint16_t *) frame)[0];
+    dev->stats.bytes_copied += len;
+    if (!(flags & ARM_ETH_MAC_TX_FRAME_FRAGMENT))
+        dev->stats.tx_frames_copied++;
 
-    if (len > 0)
-        dst++[0] = frame++[0];
+    queue_tx(dev, buf, len, flags, NULL);
 
-    SCB_CleanDCache_by_Addr((uint32_t *) &tx_buffers[cur_idx][0], ETH_BUF_SIZE);
+    return ARM_DRIVER_OK;
+}
 
-    if (flags & ARM_ETH_MAC_TX_FRAME_FRAGMENT) {
-        /* More data to come, remember current write position */
-        dev->frame_end = dst;
-        return ARM_DRIVER_OK;
-    }
+/**
+  \fn          int32_t SendFrameZC (const uint8_t *frame, uint32_t len, uint32_t flags,
+                                      void *token, MAC_DEV *dev)
+  \brief       Send Ethernet frame from a buffer of the caller, without copy.
+               Every fragment gets its own Tx DMA descriptor. A fragment that
+               finds none free while its frame holds them all is copied.
+  \param[in]   frame  Pointer to frame buffer with data to send
+  \param[in]   len    Frame buffer length in bytes
+  \param[in]   flags  Frame transmit flags (see ARM_ETH_MAC_TX_FRAME_...)
+  \param[in]   token  Passed to the Tx done callback once the buffer is sent
+  \param[in]   dev    Pointer to the MAC device instance
+  \return      \ref execution_status
+*/
+static int32_t SendFrameZC(const uint8_t *frame, uint32_t len, uint32_t flags,
+    void *token, MAC_DEV *dev)
+{
+    int32_t status;
 
-    dev->tx_desc_id++;
-    dev->tx_desc_id %= TX_DESC_COUNT;
-    desc->des0 = (uint32_t)LocalToGlobal(&tx_buffers[cur_idx][0]);
+    if (!frame || !len || (len > TDES2_BUFFER1_SIZE_MASK))
+        return ARM_DRIVER_ERROR_PARAMETER;
+
+    if (!(dev->flags & ETH_POWER))
+        return ARM_DRIVER_ERROR;
 
-    dev->frame_end = NULL;
+    if (!release_tx(dev)) {
+        status = tx_ring_full(dev, frame, len, flags);
+        if (status == ARM_DRIVER_OK) {
+            /* The fragment was copied, its buffer is free again */
+            if (token && dev->tx_done)
+                dev->tx_done(token);
+            if (!(flags & ARM_ETH_MAC_TX_FRAME_FRAGMENT))
+                dev->stats.tx_frames_zc++;
+        }
+        return status;
+    }
 
-    desc->des3 = TDES3_OWN | TDES3_LAST_DESCRIPTOR | TDES3_FIRST_DESCRIPTOR |
-                    buffer_len;
+    SCB_CleanDCache_by_Addr((uint32_t *) frame, len);
 
-    SCB_CleanDCache_by_Addr((uint32_t *) desc, sizeof(DMA_DESC));
+    if (!(flags & ARM_ETH_MAC_TX_FRAME_FRAGMENT))
+        dev->stats.tx_frames_zc++;
 
-    dev->regs->DMA_CH0_TX_END_ADDR = (uint32_t) LocalToGlobal(&(dev->tx_descs[dev->tx_desc_id]));
+    queue_tx(dev, frame, len, flags, token);
 
     return ARM_DRIVER_OK;
 }
@@ -593,7 +848,6 @@ static int32_t SendFrame(const uint8_t *frame, uint32_t len, uint32_t flags,
 static int32_t ReadFrame(uint8_t *frame, uint32_t len, MAC_DEV *dev)
 {
     uint32_t cur_idx;
-    int32_t buffer_len = (int32_t) len;
     uint8_t *src;
 
     if (!frame || !len)
@@ -602,23 +856,20 @@ static int32_t ReadFrame(uint8_t *frame, uint32_t len, MAC_DEV *dev)
     if (!(dev->flags & ETH_POWER))
         return ARM_DRIVER_ERROR;
 
+    if (len > ETH_BUF_SIZE)
+        len = ETH_BUF_SIZE;
+
     cur_idx = dev->rx_desc_id;
-    src = (uint8_t *) &rx_buffers[cur_idx][0];
+    src = dev->rx_bufs[cur_idx];
 
-    SCB_InvalidateDCache_by_Addr(src, ETH_BUF_SIZE);
+    /* Drop lines fetched while the DMA was writing, only as far as read */
+    SCB_InvalidateDCache_by_Addr(src, len);
 
     /* copy data to the buffer */
-    for ( ; len > 7; frame += 8, src += 8, len -= 8) {
-        ((uint32_t *) frame)[0] = ((uint32_t *) src)[0];
-        ((uint32_t *) frame)[1] = ((uint32_t *) src)[1];
-    }
+    memcpy(frame, src, len);
 
-    /* copy remaining 7 bytes */
-    for ( ; len > 1; frame += 2, src += 2, len -= 2)
-        ((uint16_t *) frame)[0] = ((uint16_t *)src)[0];
-
-    if (len > 0)
-        frame[0] = src[0];
+    dev->stats.rx_frames_copied++;
+    dev->stats.bytes_copied += len;
 
     /* refresh the descriptor */
     setup_rxdesc(dev, cur_idx);
@@ -628,7 +879,289 @@ static int32_t ReadFrame(uint8_t *frame, uint32_t len, MAC_DEV *dev)
     dev->rx_desc_id++;
     dev->rx_desc_id %= RX_DESC_COUNT;
 
-    return buffer_len;
+    return (int32_t) len;
+}
+
+/**
+  \fn          DMA_DESC *rx_desc (MAC_DEV *dev)
+  \brief       Get the Rx DMA descriptor of the next received Ethernet frame.
+               Frames failing the checks of the Rx checksum offload engine
+               are dropped on the way.
+  \param[in]   dev    Pointer to the MAC device instance
+  \return      descriptor, NULL when no frame is pending
+*/
+static DMA_DESC *rx_desc(MAC_DEV *dev)
+{
+    DMA_DESC *desc;
+
+    for (;;) {
+        desc = &dev->rx_descs[dev->rx_desc_id];
+
+        SCB_InvalidateDCache_by_Addr(desc, sizeof(DMA_DESC));
+
+        if (desc->des3 & RDES3_OWN)
+            return NULL;
+
+        if (!(dev->flags & ETH_RX_CSUM) || !(desc->des3 & RDES3_RDES1_VALID) ||
+                !(desc->des1 & RDES1_CSUM_ERRORS))
+            return desc;
+
+        dev->stats.rx_csum_errors++;
+
+        setup_rxdesc(dev, dev->rx_desc_id);
+
+        dev->regs->DMA_CH0_RX_END_ADDR = (uint32_t) LocalToGlobal(desc);
+
+        dev->rx_desc_id++;
+        dev->rx_desc_id %= RX_DESC_COUNT;
+    }
+}
+
+/**
+  \fn          uint32_t rx_csum_status (MAC_DEV *dev, DMA_DESC *desc)
+  \brief       Decode the checksums verified by the Rx checksum offload engine.
+  \param[in]   dev    Pointer to the MAC device instance
+  \param[in]   desc   Rx DMA descriptor of a received frame
+  \return      receive checksum status (ARM_ETH_MAC_RX_CSUM_...)
+*/
+static uint32_t rx_csum_status(MAC_DEV *dev, DMA_DESC *desc)
+{
+    uint32_t status = 0;
+
+    if (!(dev->flags & ETH_RX_CSUM) || !(desc->des3 & RDES3_RDES1_VALID))
+        return 0;
+
+    if (desc->des1 & RDES1_IPV4_HEADER)
+        status |= ARM_ETH_MAC_RX_CSUM_IP;
+
+    /* Payload type is 0 for protocols the engine does not know */
+    if ((desc->des1 & (RDES1_IPV4_HEADER | RDES1_IPV6_HEADER)) &&
+            (desc->des1 & RDES1_IP_PAYLOAD_TYPE_MASK) &&
+            !(desc->des1 & RDES1_IP_CSUM_BYPASSED))
+        status |= ARM_ETH_MAC_RX_CSUM_PAYLOAD;
+
+    return status;
+}
+
+/**
+  \fn          int32_t take_rx (MAC_DEV *dev, ARM_ETH_MAC_RX_FRAME *rx)
+  \brief       Take the buffer of the received Ethernet frame out of the ring
+               and refill the Rx DMA descriptor from the buffer pool. The
+               tail pointer of the refilled descriptor is left to the caller.
+  \param[in]   dev    Pointer to the MAC device instance
+  \param[out]  rx     Received frame, to be freed to the pool
+  \return      frame length in bytes, 0 when no frame is pending, or
+               ARM_DRIVER_ERROR_BUSY when the pool is empty
+*/
+static int32_t take_rx(MAC_DEV *dev, ARM_ETH_MAC_RX_FRAME *rx)
+{
+    uint32_t cur_idx, len;
+    DMA_DESC *desc;
+    uint8_t *fresh;
+
+    desc = rx_desc(dev);
+    if (!desc)
+        return 0;
+
+    cur_idx = dev->rx_desc_id;
+
+    /* Keep the frame in the ring when the pool is empty */
+    fresh = dev->rx_alloc(ETH_BUF_SIZE);
+    if (!fresh) {
+        dev->stats.rx_alloc_fail++;
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+
+    len = (desc->des3 & RDES3_PACKET_SIZE_MASK) - 4;
+
+    rx->frame = dev->rx_bufs[cur_idx];
+    rx->len = len;
+    rx->csum = rx_csum_status(dev, desc);
+    SCB_InvalidateDCache_by_Addr(rx->frame, len);
+
+    /* Lines of the new buffer dirtied by its previous user must not be written back over the DMA data */
+    SCB_InvalidateDCache_by_Addr(fresh, ETH_BUF_SIZE);
+    dev->rx_bufs[cur_idx] = fresh;
+
+    setup_rxdesc(dev, cur_idx);
+
+    dev->rx_desc_id++;
+    dev->rx_desc_id %= RX_DESC_COUNT;
+
+    return (int32_t) len;
+}
+
+/**
+  \fn          int32_t ReadFrameZC (uint8_t **frame, MAC_DEV *dev)
+  \brief       Lend the buffer of the received Ethernet frame to the caller
+               and refill the Rx DMA descriptor from the buffer pool.
+  \param[out]  frame  Pointer to the received frame, to be freed to the pool
+  \param[in]   dev    Pointer to the MAC device instance
+  \return      frame length in bytes, 0 when no frame is pending, or
+               \ref execution_status
+*/
+static int32_t ReadFrameZC(uint8_t **frame, MAC_DEV *dev)
+{
+    ARM_ETH_MAC_RX_FRAME rx;
+    uint32_t last_idx;
+    int32_t len;
+
+    if (!frame)
+        return ARM_DRIVER_ERROR_PARAMETER;
+
+    if (!(dev->flags & ETH_POWER) || !dev->rx_alloc)
+        return ARM_DRIVER_ERROR;
+
+    len = take_rx(dev, &rx);
+    if (len <= 0)
+        return len;
+
+    *frame = rx.frame;
+
+    last_idx = (dev->rx_desc_id + RX_DESC_COUNT - 1) % RX_DESC_COUNT;
+    dev->regs->DMA_CH0_RX_END_ADDR = (uint32_t) LocalToGlobal(&(dev->rx_descs[last_idx]));
+
+    dev->stats.rx_frames_zc++;
+
+    return len;
+}
+
+/**
+  \fn          int32_t ReadFramesZC (ARM_ETH_MAC_RX_FRAME *frames, uint32_t max,
+                                       MAC_DEV *dev)
+  \brief       Lend the buffers of all received Ethernet frames to the caller,
+               up to max. The Rx DMA descriptors are refilled from the buffer
+               pool and the tail pointer is moved once for the whole batch.
+  \param[out]  frames  Array for the received frames
+  \param[in]   max     Number of entries in the array
+  \param[in]   dev     Pointer to the MAC device instance
+  \return      number of frames, 0 when no frame is pending, or
+               \ref execution_status
+*/
+static int32_t ReadFramesZC(ARM_ETH_MAC_RX_FRAME *frames, uint32_t max,
+    MAC_DEV *dev)
+{
+    uint32_t count, last_idx;
+    int32_t len;
+
+    if (!frames || !max)
+        return ARM_DRIVER_ERROR_PARAMETER;
+
+    if (!(dev->flags & ETH_POWER) || !dev->rx_alloc)
+        return ARM_DRIVER_ERROR;
+
+    for (count = 0; count < max; count++) {
+        len = take_rx(dev, &frames[count]);
+        if (len <= 0)
+            break;
+    }
+
+    if (!count)
+        return 0;
+
+    /* Hand the whole batch of refilled descriptors back to the DMA at once */
+    last_idx = (dev->rx_desc_id + RX_DESC_COUNT - 1) % RX_DESC_COUNT;
+    dev->regs->DMA_CH0_RX_END_ADDR = (uint32_t) LocalToGlobal(&(dev->rx_descs[last_idx]));
+
+    dev->stats.rx_frames_zc += count;
+    dev->stats.rx_batch_frames += count;
+    dev->stats.rx_batches++;
+    if (count > dev->stats.rx_batch_max)
+        dev->stats.rx_batch_max = count;
+
+    return (int32_t) count;
+}
+
+/**
+  \fn          int32_t rx_dma_stop (MAC_DEV *dev)
+  \brief       Stop the Rx DMA and wait for it to go idle. Clearing SR lets a
+               frame already being transferred complete, so the ring may only
+               be rewritten once the Rx process is stopped or suspended.
+  \param[in]   dev    Pointer to the MAC device instance
+  \return      \ref execution_status
+*/
+static int32_t rx_dma_stop(MAC_DEV *dev)
+{
+    uint32_t rps, timeout = 10;
+
+    dev->regs->DMA_CH0_RX_CTRL &= ~DMA_CONTROL_SR;
+
+    do {
+        rps = (dev->regs->DMA_DEBUG_STATUS0 >> DMA_DEBUG_STATUS0_RPS0_SHIFT) &
+              DMA_DEBUG_STATUS0_RPS0_MASK;
+        if ((rps == DMA_RPS_STOPPED) || (rps == DMA_RPS_SUSPENDED))
+            return ARM_DRIVER_OK;
+        osDelay(1);
+    } while (--timeout);
+
+    return ARM_DRIVER_ERROR_TIMEOUT;
+}
+
+/**
+  \fn          int32_t SetRxPool (ARM_ETH_MAC_RxAlloc_t alloc, ARM_ETH_MAC_RxFree_t release,
+                                    MAC_DEV *dev)
+  \brief       Install a buffer pool for the Rx DMA descriptors, or go back to
+               the driver buffers when alloc is NULL. Frames pending in the
+               ring are dropped.
+  \param[in]   alloc  Pool allocation function
+  \param[in]   release  Pool release function
+  \param[in]   dev    Pointer to the MAC device instance
+  \return      \ref execution_status
+*/
+static int32_t SetRxPool(ARM_ETH_MAC_RxAlloc_t alloc, ARM_ETH_MAC_RxFree_t release,
+    MAC_DEV *dev)
+{
+    uint8_t *bufs[RX_DESC_COUNT];
+    uint32_t i, rx_ctrl = 0;
+
+    if (alloc && !release)
+        return ARM_DRIVER_ERROR_PARAMETER;
+
+    if (!(dev->flags & ETH_INIT))
+        return ARM_DRIVER_ERROR;
+
+    for (i = 0; i < RX_DESC_COUNT; i++) {
+        bufs[i] = alloc ? alloc(ETH_BUF_SIZE) : (uint8_t *) &rx_buffers[i][0];
+
+        if (!bufs[i] || ((uint32_t) bufs[i] & (ETH_CACHE_LINE - 1))) {
+            /* Only a pool can fail, give back what was taken */
+            if (bufs[i])
+                release(bufs[i]);
+            while (i--)
+                release(bufs[i]);
+            return ARM_DRIVER_ERROR;
+        }
+        SCB_InvalidateDCache_by_Addr(bufs[i], ETH_BUF_SIZE);
+    }
+
+    if (dev->flags & ETH_POWER) {
+        rx_ctrl = dev->regs->DMA_CH0_RX_CTRL;
+        if (rx_dma_stop(dev) != ARM_DRIVER_OK) {
+            /* The old buffers may still be written, keep them */
+            dev->regs->DMA_CH0_RX_CTRL = rx_ctrl;
+            if (alloc) {
+                for (i = 0; i < RX_DESC_COUNT; i++)
+                    release(bufs[i]);
+            }
+            return ARM_DRIVER_ERROR_TIMEOUT;
+        }
+    }
+
+    for (i = 0; i < RX_DESC_COUNT; i++) {
+        if (dev->rx_alloc && dev->rx_bufs[i])
+            dev->rx_free(dev->rx_bufs[i]);
+        dev->rx_bufs[i] = bufs[i];
+    }
+
+    dev->rx_alloc = alloc;
+    dev->rx_free = release;
+
+    if (dev->flags & ETH_POWER) {
+        init_rx_descs(dev);
+        dev->regs->DMA_CH0_RX_CTRL = rx_ctrl;
+    }
+
+    return ARM_DRIVER_OK;
 }
 
 /**
@@ -644,14 +1177,31 @@ static uint32_t GetRxFrameSize(MAC_DEV *dev)
     if (!(dev->flags & ETH_POWER))
         return 0;
 
-    desc = &dev->rx_descs[dev->rx_desc_id];
+    desc = rx_desc(dev);
+    if (!desc)
+        return 0;
 
-    SCB_InvalidateDCache_by_Addr(desc, sizeof(DMA_DESC));
+    return (desc->des3 & 0x7fff) - 4;
+}
 
-    if (desc->des3 & RDES3_OWN)
+/**
+  \fn          uint32_t GetRxFrameCsum (MAC_DEV *dev)
+  \param[in]   dev    Pointer to the MAC device instance
+  \brief       Get the receive checksum status of the received Ethernet frame.
+  \return      receive checksum status (ARM_ETH_MAC_RX_CSUM_...)
+*/
+static uint32_t GetRxFrameCsum(MAC_DEV *dev)
+{
+    DMA_DESC *desc;
+
+    if (!(dev->flags & ETH_POWER))
         return 0;
 
-    return (desc->des3 & 0x7fff) - 4;
+    desc = rx_desc(dev);
+    if (!desc)
+        return 0;
+
+    return rx_csum_status(dev, desc);
 }
 
 /**
@@ -764,7 +1314,8 @@ static int32_t Control(uint32_t control, uint32_t arg, MAC_DEV *dev)
         val = dev->regs->MAC_CONFIG &
               ~(MAC_CONFIG_FES |
               MAC_CONFIG_LM |
-              MAC_CONFIG_DM);
+              MAC_CONFIG_DM |
+              MAC_CONFIG_IPC);
 
         switch (arg & ARM_ETH_MAC_SPEED_Msk) {
         case ARM_ETH_MAC_SPEED_10M:
@@ -786,9 +1337,27 @@ static int32_t Control(uint32_t control, uint32_t arg, MAC_DEV *dev)
         if (arg & ARM_ETH_MAC_LOOPBACK)
             val |= MAC_CONFIG_LM;
 
-        if ((arg & ARM_ETH_MAC_CHECKSUM_OFFLOAD_RX) ||
-                    (arg & ARM_ETH_MAC_CHECKSUM_OFFLOAD_TX))
+        reg = dev->regs->MAC_HW_FEATURE_0;
+
+        /* Offload the MAC was synthesized without, see GetCapabilities */
+        if ((arg & ARM_ETH_MAC_CHECKSUM_OFFLOAD_RX) &&
+            !(reg & MAC_HW_FEATURE0_RXCOESEL))
             return ARM_DRIVER_ERROR_UNSUPPORTED;
+        if ((arg & ARM_ETH_MAC_CHECKSUM_OFFLOAD_TX) &&
+            !(reg & MAC_HW_FEATURE0_TXCOESEL))
+            return ARM_DRIVER_ERROR_UNSUPPORTED;
+
+        dev->flags &= ~(ETH_RX_CSUM | ETH_TX_CSUM);
+
+        /* Rx checksum offload engine, results reported in RDES1 */
+        if (arg & ARM_ETH_MAC_CHECKSUM_OFFLOAD_RX) {
+            val |= MAC_CONFIG_IPC;
+            dev->flags |= ETH_RX_CSUM;
+        }
+
+        /* Tx checksum insertion is requested per frame in TDES3 */
+        if (arg & ARM_ETH_MAC_CHECKSUM_OFFLOAD_TX)
+            dev->flags |= ETH_TX_CSUM;
 
         dev->regs->MAC_CONFIG = val;
 
@@ -845,10 +1414,11 @@ static int32_t Control(uint32_t control, uint32_t arg, MAC_DEV *dev)
 
     case ARM_ETH_MAC_FLUSH:
         if (arg & ARM_ETH_MAC_FLUSH_RX) {
-            val = dev->regs->DMA_CH0_RX_CTRL;
-            reg = val;
-            val &= ~DMA_CONTROL_SR;
-            dev->regs->DMA_CH0_RX_CTRL = val;
+            reg = dev->regs->DMA_CH0_RX_CTRL;
+            if (rx_dma_stop(dev) != ARM_DRIVER_OK) {
+                dev->regs->DMA_CH0_RX_CTRL = reg;
+                return ARM_DRIVER_ERROR_TIMEOUT;
+            }
             init_rx_descs(dev);
             dev->regs->DMA_CH0_RX_CTRL = reg;
         }
@@ -988,12 +1558,15 @@ static void ETH_IRQHandler(MAC_DEV *dev)
 
     if (dev->regs->DMA_STATUS & DMA_STATUS_CHAN0) {
         ch0_stat = dev->regs->DMA_CH0_STATUS;
+        dev->stats.irqs++;
 
         dev->regs->DMA_CH0_STATUS =
 		ch0_stat & (DMA_CHAN_STATUS_NIS | DMA_CHAN_STATUS_RI | DMA_CHAN_STATUS_TI);
 
-        if (ch0_stat & DMA_CHAN_STATUS_RI)
+        if (ch0_stat & DMA_CHAN_STATUS_RI) {
             event |= ARM_ETH_MAC_EVENT_RX_FRAME;
+            dev->stats.rx_irqs++;
+        }
 
         if (ch0_stat & DMA_CHAN_STATUS_TI)
             event |= ARM_ETH_MAC_EVENT_TX_FRAME;
@@ -1189,6 +1762,106 @@ static int32_t ETH_MAC0_PHY_Write(uint8_t phy_addr, uint8_t reg_addr, uint16_t d
     return PHY_Write(phy_addr, reg_addr, data, &MAC0);
 }
 
+/**
+  \fn          int32_t ETH_MAC0_SetRxPool (ARM_ETH_MAC_RxAlloc_t alloc, ARM_ETH_MAC_RxFree_t release)
+  \brief       Install a buffer pool for the Rx DMA descriptors.
+  \param[in]   alloc    Pool allocation function, NULL for the driver buffers
+  \param[in]   release  Pool release function
+  \return      \ref execution_status
+*/
+static int32_t ETH_MAC0_SetRxPool(ARM_ETH_MAC_RxAlloc_t alloc, ARM_ETH_MAC_RxFree_t release)
+{
+    return SetRxPool(alloc, release, &MAC0);
+}
+
+/**
+  \fn          int32_t ETH_MAC0_ReadFrameZC (uint8_t **frame)
+  \brief       Lend the buffer of the received Ethernet frame to the caller.
+  \param[out]  frame  Pointer to the received frame
+  \return      frame length in bytes, 0 when no frame is pending, or
+               \ref execution_status
+*/
+static int32_t ETH_MAC0_ReadFrameZC(uint8_t **frame)
+{
+    return ReadFrameZC(frame, &MAC0);
+}
+
+/**
+  \fn          int32_t ETH_MAC0_ReadFramesZC (ARM_ETH_MAC_RX_FRAME *frames, uint32_t max)
+  \brief       Lend the buffers of all received Ethernet frames to the caller.
+  \param[out]  frames  Array for the received frames
+  \param[in]   max     Number of entries in the array
+  \return      number of frames or \ref execution_status
+*/
+static int32_t ETH_MAC0_ReadFramesZC(ARM_ETH_MAC_RX_FRAME *frames, uint32_t max)
+{
+    return ReadFramesZC(frames, max, &MAC0);
+}
+
+/**
+  \fn          uint32_t ETH_MAC0_GetRxFrameCsum (void)
+  \brief       Get the receive checksum status of the received Ethernet frame.
+  \return      receive checksum status (ARM_ETH_MAC_RX_CSUM_...)
+*/
+static uint32_t ETH_MAC0_GetRxFrameCsum(void)
+{
+    return GetRxFrameCsum(&MAC0);
+}
+
+/**
+  \fn          int32_t ETH_MAC0_SetTxDone (ARM_ETH_MAC_TxDone_t cb)
+  \brief       Register the Tx buffer release callback.
+  \param[in]   cb  Callback, called with the token of each sent buffer
+  \return      \ref execution_status
+*/
+static int32_t ETH_MAC0_SetTxDone(ARM_ETH_MAC_TxDone_t cb)
+{
+    MAC0.tx_done = cb;
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          int32_t ETH_MAC0_SendFrameZC (const uint8_t *frame, uint32_t len, uint32_t flags, void *token)
+  \brief       Send Ethernet frame from a buffer of the caller, without copy.
+  \param[in]   frame  Pointer to frame buffer with data to send
+  \param[in]   len    Frame buffer length in bytes
+  \param[in]   flags  Frame transmit flags (see ARM_ETH_MAC_TX_FRAME_...)
+  \param[in]   token  Passed to the Tx done callback once the buffer is sent
+  \return      \ref execution_status
+*/
+static int32_t ETH_MAC0_SendFrameZC(const uint8_t *frame, uint32_t len, uint32_t flags, void *token)
+{
+    return SendFrameZC(frame, len, flags, token, &MAC0);
+}
+
+/**
+  \fn          uint32_t ETH_MAC0_ReleaseTx (void)
+  \brief       Release the buffers of sent frames.
+  \return      number of free Tx DMA descriptors
+*/
+static uint32_t ETH_MAC0_ReleaseTx(void)
+{
+    if (!(MAC0.flags & ETH_POWER))
+        return 0;
+
+    return release_tx(&MAC0);
+}
+
+/**
+  \fn          int32_t ETH_MAC0_GetStats (ARM_ETH_MAC_EX_STATS *stats)
+  \brief       Get the transfer counters.
+  \param[out]  stats  Pointer to counters
+  \return      \ref execution_status
+*/
+static int32_t ETH_MAC0_GetStats(ARM_ETH_MAC_EX_STATS *stats)
+{
+    if (!stats)
+        return ARM_DRIVER_ERROR_PARAMETER;
+
+    *stats = MAC0.stats;
+    return ARM_DRIVER_OK;
+}
+
 ARM_DRIVER_ETH_MAC Driver_ETH_MAC0 =
 {
     ETH_MAC_GetVersion,
@@ -1210,3 +1883,15 @@ ARM_DRIVER_ETH_MAC Driver_ETH_MAC0 =
     ETH_MAC0_PHY_Write
 };
 
+ARM_DRIVER_ETH_MAC_EX Driver_ETH_MAC0_EX =
+{
+    ETH_MAC0_SetRxPool,
+    ETH_MAC0_ReadFrameZC,
+    ETH_MAC0_ReadFramesZC,
+    ETH_MAC0_GetRxFrameCsum,
+    ETH_MAC0_SetTxDone,
+    ETH_MAC0_SendFrameZC,
+    ETH_MAC0_ReleaseTx,
+    ETH_MAC0_GetStats
+};
+
@@ -23,6 +23,7 @@
 #define _DRIVER_MAC_H_
 
 #include <Driver_ETH_MAC.h>
+#include <Driver_ETH_MAC_EX.h>
 
 #include "RTE_Device.h"
 #include "RTE_Components.h"
@@ -38,14 +39,41 @@
 
 #include "system_utils.h"
 
-#define RX_DESC_COUNT   8 /**< Rx DMA descriptor count */
-#define TX_DESC_COUNT   8 /**< Tx DMA descriptor count */
+#ifndef RTE_ETH_MAC_RX_DESC_COUNT
+#define RTE_ETH_MAC_RX_DESC_COUNT               8
+#endif
+#ifndef RTE_ETH_MAC_TX_DESC_COUNT
+#define RTE_ETH_MAC_TX_DESC_COUNT               8
+#endif
+#ifndef RTE_ETH_MAC_RX_IRQ_FRAMES
+#define RTE_ETH_MAC_RX_IRQ_FRAMES               1
+#endif
+#ifndef RTE_ETH_MAC_RX_IRQ_WATCHDOG
+#define RTE_ETH_MAC_RX_IRQ_WATCHDOG             0
+#endif
+
+#define RX_DESC_COUNT   RTE_ETH_MAC_RX_DESC_COUNT /**< Rx DMA descriptor count */
+#define TX_DESC_COUNT   RTE_ETH_MAC_TX_DESC_COUNT /**< Tx DMA descriptor count */
+
+#if (RX_DESC_COUNT < 4) || (RX_DESC_COUNT > 1024) || (TX_DESC_COUNT < 4) || (TX_DESC_COUNT > 1024)
+#error "ETH MAC descriptor ring sizes must be in the range 4..1024"
+#endif
+
+#if (RTE_ETH_MAC_RX_IRQ_FRAMES < 1) || (RTE_ETH_MAC_RX_IRQ_FRAMES > RX_DESC_COUNT)
+#error "RTE_ETH_MAC_RX_IRQ_FRAMES must be in the range 1..RX_DESC_COUNT"
+#endif
+
+#if (RTE_ETH_MAC_RX_IRQ_FRAMES > 1) && (RTE_ETH_MAC_RX_IRQ_WATCHDOG == 0)
+#error "Rx interrupt moderation needs the Rx watchdog to flush partial batches"
+#endif
 
 /* Each descriptor is 16 bytes */
 #define DESCS_AREA_SIZE   ((RX_DESC_COUNT + TX_DESC_COUNT) * 16) /**< Total memory area needed for descs */
 
 #define ETH_BUF_SIZE    1536 /**< Ethernet buffer size */
 
+#define ETH_CACHE_LINE  32   /**< D-cache line size, alignment of the DMA buffers */
+
 /** \brief Rx/Tx Dma Descriptor. */
 typedef struct {
   uint32_t des0;
@@ -105,7 +133,8 @@ typedef struct {
     uint32_t DMA_BUS_MODE;
     uint32_t DMA_SYS_BUS_MODE;
     uint32_t DMA_STATUS;
-    uint32_t RESERVED_12[61];
+    uint32_t DMA_DEBUG_STATUS0;
+    uint32_t RESERVED_12[60];
     uint32_t DMA_CH0_CTRL;
     uint32_t DMA_CH0_TX_CTRL;
     uint32_t DMA_CH0_RX_CTRL;
@@ -120,7 +149,8 @@ typedef struct {
     uint32_t DMA_CHO_TX_RING_LEN;
     uint32_t DMA_CH0_RX_RING_LEN;
     uint32_t DMA_CH0_INT_ENABLE;
-    uint32_t RESERVED_15[10];
+    uint32_t DMA_CH0_RX_INT_WDT;
+    uint32_t RESERVED_15[9];
     uint32_t DMA_CH0_STATUS;
 } MAC_REGS;
 
@@ -136,12 +166,24 @@ typedef struct {
   IRQn_Type irq;                     /**< IRQ number of the Ethernet MAC instance */
   uint8_t irq_priority;              /**< priority of the ETH MAC IRQ */
   uint8_t flags;                     /**< MAC driver flags */
-  uint8_t *frame_end;                /**< Current frame address, to support fragments */
+  uint32_t tx_clean_id;              /**< Index of the oldest Tx DMA descriptor not released */
+  uint32_t tx_used;                  /**< Tx DMA descriptors queued and not released */
+  uint32_t tx_first_id;              /**< First Tx DMA descriptor of the frame being queued */
+  uint32_t tx_frame_len;             /**< Length of the frame being queued */
+  uint8_t *rx_bufs[RX_DESC_COUNT];   /**< Buffer attached to each Rx DMA descriptor */
+  void *tx_tokens[TX_DESC_COUNT];    /**< Zero-copy buffer token of each Tx DMA descriptor */
+  ARM_ETH_MAC_RxAlloc_t rx_alloc;    /**< Rx buffer pool, NULL when using the driver buffers */
+  ARM_ETH_MAC_RxFree_t rx_free;      /**< Rx buffer pool release */
+  ARM_ETH_MAC_TxDone_t tx_done;      /**< Tx buffer release callback */
+  ARM_ETH_MAC_EX_STATS stats;        /**< Transfer counters */
 } MAC_DEV;
 
 /** \brief Driver state flags */
 #define ETH_INIT			                    0x01 /**< Driver initialized */
 #define ETH_POWER			                    0x02 /**< Driver power on */
+#define ETH_TX_FRAGMENT                         0x04 /**< Queueing the fragments of a Tx frame */
+#define ETH_TX_CSUM                             0x08 /**< Tx checksum insertion enabled */
+#define ETH_RX_CSUM                             0x10 /**< Rx checksum checking enabled */
 
 /*  MAC register fields */
 
@@ -266,6 +308,9 @@ typedef struct {
 #define MAC_INT_EN_TSIE                         BIT(12)
 #define MAC_INT_EN_PMTIE                        BIT(4)
 
+#define MAC_HW_FEATURE0_TXCOESEL                BIT(14)
+#define MAC_HW_FEATURE0_RXCOESEL                BIT(16)
+
 #define MAC_HW_FEATURE1_TXFIFOSIZE_SHIFT        6
 #define MAC_HW_FEATURE1_TXFIFOSIZE_MASK         0x1f
 #define MAC_HW_FEATURE1_RXFIFOSIZE_SHIFT        0
@@ -339,6 +384,17 @@ typedef struct {
 #define DMA_RBSZ_MASK                           MASK(14, 1)
 #define DMA_RBSZ_SHIFT                          1
 
+/* DMA Rx Channel X Interrupt Watchdog Timer */
+#define DMA_RX_INT_WDT_RWT_MASK                 MASK(7, 0)
+#define DMA_RX_INT_WDT_RWTU_SHIFT               16
+#define DMA_RX_INT_WDT_RWTU_256                 0 /**< RWT counts in units of 256 clock cycles */
+
+/* DMA Debug Status 0, Rx process state of channel 0 */
+#define DMA_DEBUG_STATUS0_RPS0_SHIFT            8
+#define DMA_DEBUG_STATUS0_RPS0_MASK             0xf
+#define DMA_RPS_STOPPED                         0x0
+#define DMA_RPS_SUSPENDED                       0x4 /**< No Rx descriptor available */
+
 /* Interrupt status per channel */
 #define DMA_CHAN_STATUS_REB                     MASK(21, 19)
 #define DMA_CHAN_STATUS_REB_SHIFT               19
@@ -394,6 +450,10 @@ typedef struct {
 #define TDES3_VLTV			                    BIT(16)
 #define TDES3_CHECKSUM_INSERTION_MASK	        MASK(17, 16)
 #define TDES3_CHECKSUM_INSERTION_SHIFT	        16
+#define TDES3_CIC_DISABLED                      0 /**< No checksum insertion */
+#define TDES3_CIC_IP_HDR                        1 /**< IPv4 header checksum only */
+#define TDES3_CIC_IP_PAYLOAD                    2 /**< IPv4 header and payload, pseudo-header checksum from software */
+#define TDES3_CIC_FULL                          3 /**< IPv4 header and payload, pseudo-header checksum in hardware */
 #define TDES3_TCP_PKT_PAYLOAD_MASK	            MASK(17, 0)
 #define TDES3_TCP_SEGMENTATION_ENABLE	        BIT(18)
 #define TDES3_HDR_LEN_SHIFT		                19
@@ -457,6 +517,7 @@ typedef struct {
 #define RDES1_TIMESTAMP_AVAILABLE_SHIFT         14
 #define RDES1_TIMESTAMP_DROPPED                 BIT(15)
 #define RDES1_IP_TYPE1_CSUM_MASK                MASK(31, 16)
+#define RDES1_CSUM_ERRORS                       (RDES1_IP_HDR_ERROR | RDES1_IP_CSUM_ERROR)
 
 /* RDES2 (write back format) */
 #define RDES2_L3_L4_HEADER_SIZE_MASK            MASK(9, 0)
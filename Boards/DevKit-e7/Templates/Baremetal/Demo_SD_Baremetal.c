@@ -34,6 +34,8 @@
 #endif  /* RTE_Compiler_IO_STDOUT */
 
 #define BAREMETAL_SD_TEST_RAW_SECTOR 0x2000     //start reading and writing raw data from partition sector
+#define BAREMETAL_SD_BENCH_BLKS      4          //sectors per read, size of sdbuffer
+#define BAREMETAL_SD_BENCH_LOOPS     256        //reads per bus speed mode
 volatile unsigned char sdbuffer[512*4] __attribute__((section("sd_dma_buf"))) __attribute__((aligned(32)));
 
 const diskio_t  *p_SD_Driver = &SD_Driver;
@@ -95,6 +97,54 @@ error:
 
 }
 
+/**
+  \fn           BareMetalSDSpeedTest(uint32_t startSec)
+  \brief        Sequential read throughput of every bus speed mode, runs
+                after BareMetalSDTest has initialized the card
+  \param[in]    startSec - first sector read
+  \return       none
+*/
+void BareMetalSDSpeedTest(uint32_t startSec){
+
+    static const char * const mode_name[] = {"DS", "HS", "SDR50", "SDR104", "DDR50"};
+    SDMMC_BUS_SPEED mode;
+    uint32_t start, cycles, i;
+    uint64_t kbps;
+
+    /* Cycle counter for the timing */
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for(mode = SDMMC_BUS_SPEED_DS; mode < SDMMC_BUS_SPEED_NONE; mode++){
+
+        /* Negotiation falls back, only report the mode actually reached */
+        if((sd_bus_speed(mode) != SD_DRV_STATUS_OK) || (sd_get_bus_speed() != mode)){
+            printf("%-6s: not supported\n", mode_name[mode]);
+            continue;
+        }
+
+        start = DWT->CYCCNT;
+
+        for(i = 0; i < BAREMETAL_SD_BENCH_LOOPS; i++){
+            if(p_SD_Driver->disk_read(startSec + (i * BAREMETAL_SD_BENCH_BLKS), BAREMETAL_SD_BENCH_BLKS, sdbuffer) != SD_DRV_STATUS_OK)
+                break;
+        }
+
+        cycles = DWT->CYCCNT - start;
+
+        if((i != BAREMETAL_SD_BENCH_LOOPS) || !cycles){
+            printf("%-6s: read error\n", mode_name[mode]);
+            continue;
+        }
+
+        kbps = ((uint64_t)BAREMETAL_SD_BENCH_LOOPS * BAREMETAL_SD_BENCH_BLKS * 512U * SystemCoreClock) / ((uint64_t)cycles * 1024U);
+        printf("%-6s: %u KB/s\n", mode_name[mode], (unsigned int)kbps);
+    }
+
+    /* Back to the configured mode */
+    sd_bus_speed(RTE_SDC_BUS_SPEED);
+}
+
 int main()
 {
     uint32_t  service_error_code;
@@ -129,6 +179,9 @@ int main()
     /* Enter the Baremetal demo Application.  */
     BareMetalSDTest(BAREMETAL_SD_TEST_RAW_SECTOR, BAREMETAL_SD_TEST_RAW_SECTOR+0x200);
 
+    /* Read throughput per bus speed mode */
+    BareMetalSDSpeedTest(BAREMETAL_SD_TEST_RAW_SECTOR);
+
     error_code = SERVICES_clocks_enable_clock(se_services_s_handle, CLKEN_CLK_100M, false, &service_error_code);
     if(error_code){
         printf("SE: SDMMC 100MHz clock disable = %d\n", error_code);
@@ -0,0 +1,405 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/**************************************************************************//**
+ * @file     FLASH_FTL_Baremetal.c
+ * @version  V1.0.0
+ * @brief    Baremetal Application to demo the flash translation layer on the
+ *           OSPI flash. Measures write amplification and throughput for
+ *           sequential, uniform random and hot/cold write patterns.
+ * @bug      None.
+ * @Note     None
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "pinconf.h"
+#include "Driver_Flash.h"
+#include "Driver_GPIO.h"
+#include "flash_ftl.h"
+#include "RTE_Components.h"
+#include CMSIS_device_header
+#if defined(RTE_Compiler_IO_STDOUT)
+#include "retarget_stdout.h"
+#endif  /* RTE_Compiler_IO_STDOUT */
+
+
+#define FLASH_NUM 1
+
+extern ARM_DRIVER_FLASH ARM_Driver_Flash_(FLASH_NUM);
+#define ptrFLASH (&ARM_Driver_Flash_(FLASH_NUM))
+
+#define OSPI_RESET_PORT     15
+#define OSPI_RESET_PIN      7
+
+extern  ARM_DRIVER_GPIO ARM_Driver_GPIO_(OSPI_RESET_PORT);
+ARM_DRIVER_GPIO *GPIODrv = &ARM_Driver_GPIO_(OSPI_RESET_PORT);
+
+/* FTL region, 1 MB in the upper half of the flash */
+#define FTL_FIRST_SECTOR    4096
+#define FTL_NUM_SECTORS     256
+
+/* Logical pages written per pattern, as a multiple of the capacity */
+#define BENCH_PASSES        4
+
+/* Hot/cold pattern: HOT_PERCENT of the writes go to HOT_SHARE percent of the pages */
+#define HOT_PERCENT         80
+#define HOT_SHARE           20
+
+/**
+ * @fn      static int32_t setup_PinMUX(void)
+ * @brief   Set up PinMUX and PinPAD
+ * @note    none
+ * @param   none
+ * @retval  -1 : On Error
+ *           0 : On Success
+ */
+static int32_t setup_PinMUX(void)
+{
+    int32_t ret;
+
+    ret = pinconf_set(PORT_9, PIN_5, PINMUX_ALTERNATE_FUNCTION_1,
+                     PADCTRL_OUTPUT_DRIVE_STRENGTH_12MA | PADCTRL_SLEW_RATE_FAST | PADCTRL_READ_ENABLE);
+    if (ret)
+        return -1;
+
+    ret = pinconf_set(PORT_9, PIN_6, PINMUX_ALTERNATE_FUNCTION_1,
+                     PADCTRL_OUTPUT_DRIVE_STRENGTH_12MA | PADCTRL_SLEW_RATE_FAST | PADCTRL_READ_ENABLE);
+    if (ret)
+        return -1;
+
+    ret = pinconf_set(PORT_9, PIN_7, PINMUX_ALTERNATE_FUNCTION_1,
+                     PADCTRL_OUTPUT_DRIVE_STRENGTH_12MA | PADCTRL_SLEW_RATE_FAST |  PADCTRL_READ_ENABLE);
+    if (ret)
+        return -1;
+
+    ret = pinconf_set(PORT_10, PIN_0, PINMUX_ALTERNATE_FUNCTION_1,
+                     PADCTRL_OUTPUT_DRIVE_STRENGTH_12MA | PADCTRL_SLEW_RATE_FAST | PADCTRL_READ_ENABLE);
+    if (ret)
+        return -1;
+
+    ret = pinconf_set(PORT_10, PIN_1, PINMUX_ALTERNATE_FUNCTION_1,
+                     PADCTRL_OUTPUT_DRIVE_STRENGTH_12MA | PADCTRL_SLEW_RATE_FAST | PADCTRL_READ_ENABLE);
+    if (ret)
+        return -1;
+
+    ret = pinconf_set(PORT_10, PIN_2, PINMUX_ALTERNATE_FUNCTION_1,
+                     PADCTRL_OUTPUT_DRIVE_STRENGTH_12MA | PADCTRL_SLEW_RATE_FAST | PADCTRL_READ_ENABLE);
+    if (ret)
+        return -1;
+
+    ret = pinconf_set(PORT_10, PIN_3, PINMUX_ALTERNATE_FUNCTION_1,
+                     PADCTRL_OUTPUT_DRIVE_STRENGTH_12MA | PADCTRL_SLEW_RATE_FAST | PADCTRL_READ_ENABLE);
+    if (ret)
+        return -1;
+
+    ret = pinconf_set(PORT_10, PIN_4, PINMUX_ALTERNATE_FUNCTION_1,
+                     PADCTRL_OUTPUT_DRIVE_STRENGTH_12MA | PADCTRL_SLEW_RATE_FAST |  PADCTRL_READ_ENABLE);
+    if (ret)
+        return -1;
+
+    ret = pinconf_set(PORT_10, PIN_7, PINMUX_ALTERNATE_FUNCTION_1,
+                     PADCTRL_OUTPUT_DRIVE_STRENGTH_12MA | PADCTRL_READ_ENABLE);
+    if (ret)
+        return -1;
+
+    ret = pinconf_set(PORT_5, PIN_5, PINMUX_ALTERNATE_FUNCTION_1,
+                     PADCTRL_OUTPUT_DRIVE_STRENGTH_12MA | PADCTRL_SLEW_RATE_FAST);
+    if (ret)
+        return -1;
+
+    ret = pinconf_set(PORT_8, PIN_0, PINMUX_ALTERNATE_FUNCTION_1, PADCTRL_OUTPUT_DRIVE_STRENGTH_12MA);
+    if (ret)
+        return -1;
+
+    ret = pinconf_set(PORT_5, PIN_6, PINMUX_ALTERNATE_FUNCTION_1,
+                     PADCTRL_READ_ENABLE | PADCTRL_OUTPUT_DRIVE_STRENGTH_12MA);
+    if (ret)
+        return -1;
+
+    ret = pinconf_set(PORT_5, PIN_7, PINMUX_ALTERNATE_FUNCTION_1,
+                     PADCTRL_OUTPUT_DRIVE_STRENGTH_12MA | PADCTRL_SLEW_RATE_FAST);
+    if (ret)
+        return -1;
+
+    ret = GPIODrv->Initialize(OSPI_RESET_PIN, NULL);
+    if (ret != ARM_DRIVER_OK)
+        return -1;
+
+    ret = GPIODrv->PowerControl(OSPI_RESET_PIN, ARM_POWER_FULL);
+    if (ret != ARM_DRIVER_OK)
+        return -1;
+
+    ret = GPIODrv->SetDirection(OSPI_RESET_PIN, GPIO_PIN_DIRECTION_OUTPUT);
+    if (ret != ARM_DRIVER_OK)
+        return -1;
+
+    ret = GPIODrv->SetValue(OSPI_RESET_PIN, GPIO_PIN_OUTPUT_STATE_LOW);
+    if (ret != ARM_DRIVER_OK)
+        return -1;
+
+    ret = GPIODrv->SetValue(OSPI_RESET_PIN, GPIO_PIN_OUTPUT_STATE_HIGH);
+    if (ret != ARM_DRIVER_OK)
+        return -1;
+
+    return 0;
+}
+
+/* Page buffers */
+uint8_t write_buff[FTL_PAGE_SIZE];
+uint8_t read_buff[FTL_PAGE_SIZE];
+
+static uint32_t bench_seed = 1;
+
+/**
+ * @fn      static uint32_t bench_rand(void)
+ * @brief   Pseudo random number for the write patterns
+ * @note    none
+ * @param   none
+ * @retval  31 bit random number
+ */
+static uint32_t bench_rand(void)
+{
+    bench_seed = (bench_seed * 1103515245U) + 12345U;
+    return (bench_seed >> 1);
+}
+
+/**
+ * @fn      static void fill_page(uint32_t page, uint32_t tag)
+ * @brief   Fill the write buffer with a pattern unique to a page and tag
+ * @note    none
+ * @param   page : logical page
+ * @param   tag  : write number
+ * @retval  none
+ */
+static void fill_page(uint32_t page, uint32_t tag)
+{
+    uint32_t index;
+
+    for (index = 0; index < FTL_PAGE_SIZE; index++)
+    {
+        write_buff[index] = (uint8_t)((page * 7U) + (tag * 13U) + index);
+    }
+}
+
+/**
+ * @fn      static void print_rate(const char *name, uint32_t bytes, uint32_t cycles)
+ * @brief   Print a throughput in KB/s
+ * @note    none
+ * @param   name   : label
+ * @param   bytes  : bytes moved
+ * @param   cycles : DWT cycles taken
+ * @retval  none
+ */
+static void print_rate(const char *name, uint32_t bytes, uint32_t cycles)
+{
+    uint64_t kbps = cycles ? (((uint64_t)bytes * SystemCoreClock) / ((uint64_t)cycles * 1024U)) : 0U;
+
+    printf("%-16s : %u KB/s\n", name, (unsigned int)kbps);
+}
+
+/**
+ * @fn      static int32_t ftl_benchmark(uint32_t pattern)
+ * @brief   Fill the FTL, overwrite it with a write pattern and print the
+ *          write amplification, throughput and erase count spread
+ * @note    Uses the DWT cycle counter, cycle counts wrap after
+ *          2^32 / SystemCoreClock seconds
+ * @param   pattern : 0 sequential, 1 uniform random, 2 hot/cold
+ * @retval  ARM_DRIVER_OK on success
+ */
+static int32_t ftl_benchmark(uint32_t pattern)
+{
+    static const char *names[] = {"Sequential", "Uniform random", "Hot/cold"};
+    uint32_t capacity, page, index, count, hot, start;
+    uint64_t cycles = 0;
+    ftl_stats_t stats;
+    int32_t status;
+
+    status = ftl_format(ptrFLASH, FTL_FIRST_SECTOR, FTL_NUM_SECTORS);
+    if (status != ARM_DRIVER_OK)
+    {
+        printf("FTL format failed\n");
+        return status;
+    }
+
+    capacity = ftl_get_capacity();
+    hot      = (capacity * HOT_SHARE) / 100U;
+
+    for (page = 0; page < capacity; page++)
+    {
+        fill_page(page, 0);
+        status = ftl_write(page, write_buff, 1);
+        if (status != ARM_DRIVER_OK)
+        {
+            printf("FTL fill failed\n");
+            return status;
+        }
+    }
+
+    ftl_reset_stats();
+    count = capacity * BENCH_PASSES;
+
+    for (index = 0; index < count; index++)
+    {
+        if (pattern == 0)
+        {
+            page = index % capacity;
+        }
+        else if ((pattern == 1) || ((bench_rand() % 100U) >= HOT_PERCENT))
+        {
+            page = bench_rand() % capacity;
+        }
+        else
+        {
+            page = bench_rand() % hot;
+        }
+
+        fill_page(page, index + 1U);
+
+        start  = DWT->CYCCNT;
+        status = ftl_write(page, write_buff, 1);
+        cycles += DWT->CYCCNT - start;
+
+        if (status != ARM_DRIVER_OK)
+        {
+            printf("FTL write failed\n");
+            return status;
+        }
+    }
+
+    ftl_get_stats(&stats);
+
+    printf("\n%s: %u pages of %u bytes\n", names[pattern], (unsigned int)count, FTL_PAGE_SIZE);
+    printf("Write amplification : %u.%02u\n",
+           (unsigned int)(stats.flash_writes / stats.host_writes),
+           (unsigned int)(((stats.flash_writes % stats.host_writes) * 100U) / stats.host_writes));
+    printf("GC runs : %u, pages moved : %u, wear leveling moves : %u\n",
+           (unsigned int)stats.gc_runs, (unsigned int)stats.gc_copies,
+           (unsigned int)stats.wl_moves);
+    printf("Erase count range : %u - %u\n", (unsigned int)stats.min_erase_count,
+           (unsigned int)stats.max_erase_count);
+    print_rate("Write throughput", count * FTL_PAGE_SIZE,
+               (uint32_t)(cycles > 0xFFFFFFFFU ? 0xFFFFFFFFU : cycles));
+
+    /* Read back the last page written and time a sequential read */
+    status = ftl_read(page, read_buff, 1);
+    if ((status != ARM_DRIVER_OK) || memcmp(read_buff, write_buff, FTL_PAGE_SIZE))
+    {
+        printf("FTL read back failed\n");
+        return ARM_DRIVER_ERROR;
+    }
+
+    start = DWT->CYCCNT;
+    for (page = 0; page < capacity; page++)
+    {
+        status = ftl_read(page, read_buff, 1);
+        if (status != ARM_DRIVER_OK)
+        {
+            printf("FTL read failed\n");
+            return status;
+        }
+    }
+    print_rate("Read throughput", capacity * FTL_PAGE_SIZE, DWT->CYCCNT - start);
+
+    return ARM_DRIVER_OK;
+}
+
+/**
+ * @fn      int main ()
+ * @brief   Main Function
+ * @note    none
+ * @param   none
+ * @retval  0 : Success
+ */
+int main ()
+{
+    uint32_t ret, pattern;
+    int32_t status;
+
+    #if defined(RTE_Compiler_IO_STDOUT_User)
+    ret = stdout_init();
+    if(ret != ARM_DRIVER_OK)
+    {
+        while(1)
+        {
+        }
+    }
+    #endif
+
+    printf("OSPI Flash FTL demo\n");
+
+    ret = setup_PinMUX();
+
+    if (ret != ARM_DRIVER_OK)
+    {
+        printf("Set up pinmux failed\n");
+        goto error_pinmux;
+    }
+
+    /* Blocking flash driver, the FTL waits on every operation anyway */
+    status = ptrFLASH->Initialize(NULL);
+
+    if (status != ARM_DRIVER_OK)
+    {
+        printf("Flash initialization failed\n");
+        goto error_uninitialize;
+    }
+
+    status = ptrFLASH->PowerControl(ARM_POWER_FULL);
+
+    if (status != ARM_DRIVER_OK)
+    {
+        printf("Flash Power control failed\n");
+        goto error_poweroff;
+    }
+
+    status = ftl_mount(ptrFLASH, FTL_FIRST_SECTOR, FTL_NUM_SECTORS);
+
+    if (status != ARM_DRIVER_OK)
+    {
+        printf("FTL mount failed\n");
+        goto error_poweroff;
+    }
+
+    printf("FTL capacity : %u pages of %u bytes\n", (unsigned int)ftl_get_capacity(),
+           FTL_PAGE_SIZE);
+
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (pattern = 0; pattern < 3; pattern++)
+    {
+        if (ftl_benchmark(pattern) != ARM_DRIVER_OK)
+        {
+            goto error_poweroff;
+        }
+    }
+
+    printf("\nFTL demo done\n");
+
+    while (1);
+
+error_poweroff :
+    status = ptrFLASH->PowerControl(ARM_POWER_OFF);
+    if (status != ARM_DRIVER_OK)
+    {
+        printf("Flash Power control failed\n");
+    }
+
+error_uninitialize :
+    status = ptrFLASH->Uninitialize();
+    if (status != ARM_DRIVER_OK)
+    {
+        printf("Flash un-initialization failed\n");
+    }
+
+error_pinmux :
+    return 0;
+}
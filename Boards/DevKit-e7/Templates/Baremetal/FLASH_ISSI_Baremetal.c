@@ -44,6 +44,10 @@ ARM_DRIVER_GPIO *GPIODrv = &ARM_Driver_GPIO_(OSPI_RESET_PORT);
 #define FLASH_ADDR  0x00
 #define BUFFER_SIZE 1024
 
+/* Read throughput test, sizes in 16 bit items */
+#define BENCH_BUFFER_SIZE   16384
+#define BENCH_LOOPS         8
+
 /**
  * @fn      static int32_t setup_PinMUX(void)
  * @brief   Set up PinMUX and PinPAD
@@ -146,6 +150,51 @@ static int32_t setup_PinMUX(void)
 /* Buffers for reading and writing data */
 uint16_t read_buff[BUFFER_SIZE];
 uint16_t write_buff[BUFFER_SIZE];
+uint16_t bench_buff[BENCH_BUFFER_SIZE];
+
+/**
+ * @fn      static void flash_read_benchmark(void)
+ * @brief   Print the read throughput for several read sizes
+ * @note    Uses the DWT cycle counter
+ * @param   none
+ * @retval  none
+ */
+static void flash_read_benchmark(void)
+{
+    static const uint32_t sizes[] = {256, 1024, 4096, BENCH_BUFFER_SIZE};
+    uint32_t index, iter, start, cycles;
+    uint64_t kbps;
+    int32_t status = 0;
+
+    DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+
+    for (index = 0; index < (sizeof(sizes) / sizeof(sizes[0])); index++)
+    {
+        start = DWT->CYCCNT;
+
+        for (iter = 0; iter < BENCH_LOOPS; iter++)
+        {
+            status = ptrFLASH->ReadData(FLASH_ADDR, bench_buff, sizes[index]);
+
+            if (status != (int32_t)sizes[index])
+                break;
+        }
+
+        cycles = DWT->CYCCNT - start;
+
+        if ((iter != BENCH_LOOPS) || !cycles)
+        {
+            printf("Read %6u bytes : read error\n", sizes[index] * 2);
+            continue;
+        }
+
+        kbps = ((uint64_t)BENCH_LOOPS * sizes[index] * 2U * SystemCoreClock) / ((uint64_t)cycles * 1024U);
+
+        printf("Read %6u bytes : %u.%02u MB/s\n", sizes[index] * 2, (uint32_t)(kbps / 1024U),
+               (uint32_t)(((kbps % 1024U) * 100U) / 1024U));
+    }
+}
 
 /**
  * @fn      int main ()
@@ -285,6 +334,10 @@ int main ()
 
     printf("Total errors after reading data written to flash = %d\n", count);
 
+    printf("Read throughput\n");
+
+    flash_read_benchmark();
+
     iter = 0;
     count = 0;
 
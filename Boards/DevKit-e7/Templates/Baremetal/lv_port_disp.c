@@ -58,6 +58,12 @@
 #define DIMAGE_X                 (RTE_PANEL_HACTIVE_TIME)
 #define DIMAGE_Y                 (RTE_PANEL_VACTIVE_LINE)
 
+/* SE service calls issued as one batch at display bring-up */
+#define SE_BATCH_CLK_100M        0
+#define SE_BATCH_CLK_HFOSC       1
+#define SE_BATCH_GET_RUN_CFG     2
+#define SE_BATCH_ENTRIES         3
+
 static uint8_t lcd_image[DIMAGE_Y][DIMAGE_X][PIXEL_BYTES] __attribute__((section("lcd_frame_buf")));
 static uint8_t lcd_image2[DIMAGE_Y][DIMAGE_X][PIXEL_BYTES] __attribute__((section("lcd_frame_buf")));
 
@@ -68,6 +74,8 @@ static ARM_DRIVER_CDC200 *CDCdrv = &Driver_CDC200;
 volatile uint8_t line_irq_status = 0;
 volatile uint8_t dsi_err = 0;
 
+static uint8_t se_batch_arena[(2 * sizeof(clk_set_enable_svc_t)) + sizeof(aipm_get_run_profile_svc_t)] __attribute__((aligned(4)));
+
 /**
   \fn          void hw_disp_cb(uint32_t event)
   \brief       Display callback
@@ -101,29 +109,47 @@ static void hw_disp_init(void)
     uint32_t  service_error_code;
     uint32_t  error_code;
     run_profile_t runp = {0};
+    services_batch_t       batch;
+    services_batch_entry_t batch_entries[SE_BATCH_ENTRIES];
+    uint32_t               batch_errors[SE_BATCH_ENTRIES];
+    uint32_t               batch_service_errors[SE_BATCH_ENTRIES];
 
     /* Initialize the SE services */
     se_services_port_init();
 
-    /* Enable MIPI Clocks */
-    error_code = SERVICES_clocks_enable_clock(se_services_s_handle, CLKEN_CLK_100M, true, &service_error_code);
+    /* Enable MIPI Clocks and get the current run configuration from SE
+     * in one batch, the requests are pipelined to SE */
+    SERVICES_batch_init(&batch, se_batch_arena, sizeof(se_batch_arena),
+                        batch_entries, batch_errors, SE_BATCH_ENTRIES);
+    SERVICES_batch_clocks_enable_clock(&batch, CLKEN_CLK_100M, true, &batch_service_errors[SE_BATCH_CLK_100M]);
+    SERVICES_batch_clocks_enable_clock(&batch, CLKEN_HFOSC, true, &batch_service_errors[SE_BATCH_CLK_HFOSC]);
+    SERVICES_batch_get_run_cfg(&batch, &runp, &batch_service_errors[SE_BATCH_GET_RUN_CFG]);
+
+    SERVICES_batch_execute(se_services_s_handle, &batch, DEFAULT_TIMEOUT);
+
+    error_code = batch_errors[SE_BATCH_CLK_100M];
     if(error_code != SERVICES_REQ_SUCCESS)
     {
         printf("SE: MIPI 100MHz clock enable = %d\n", error_code);
+
+        /* HFOSC was enabled in the same batch */
+        if(batch_errors[SE_BATCH_CLK_HFOSC] == SERVICES_REQ_SUCCESS)
+        {
+            error_code = SERVICES_clocks_enable_clock(se_services_s_handle, CLKEN_HFOSC, false, &service_error_code);
+            if(error_code != SERVICES_REQ_SUCCESS)
+                printf("SE: MIPI 38.4Mhz(HFOSC)  clock disable = %d\n", error_code);
+        }
         return;
     }
 
-    error_code = SERVICES_clocks_enable_clock(se_services_s_handle, CLKEN_HFOSC, true, &service_error_code);
+    error_code = batch_errors[SE_BATCH_CLK_HFOSC];
     if(error_code != SERVICES_REQ_SUCCESS)
     {
         printf("SE: MIPI 38.4Mhz(HFOSC) clock enable = %d\n", error_code);
         goto error_disable_100mhz_clk;
     }
 
-    /* Get the current run configuration from SE */
-    error_code = SERVICES_get_run_cfg(se_services_s_handle,
-                                      &runp,
-                                      &service_error_code);
+    error_code = batch_errors[SE_BATCH_GET_RUN_CFG];
     if(error_code)
     {
         printf("\r\nSE: get_run_cfg error = %d\n", error_code);
@@ -35,6 +35,13 @@
 #include "lwip/apps/fs.h"
 #include <string.h>
 
+/** Entry of the file index appended to fsdata.c by makefsindex.py */
+struct fsdata_index {
+  const struct fsdata_file *file;
+  const char *etag;               /* quoted ETag, NULL for files without one */
+  const char *not_modified;       /* prebuilt "304 Not Modified" response */
+  u16_t not_modified_len;
+};
 
 #include HTTPD_FSDATA_FILE
 
@@ -52,11 +59,29 @@ int fs_read_custom(struct fs_file *file, char *buffer, int count);
 #endif /* LWIP_HTTPD_FS_ASYNC_READ */
 #endif /* LWIP_HTTPD_CUSTOM_FILES */
 
+#ifdef FS_INDEX_SIZE
+/* FNV-1a of the file name, seeded so that fs_index has no collisions */
+static u32_t
+fs_index_hash(const char *name)
+{
+  u32_t h = FS_INDEX_SEED;
+
+  while (*name != 0) {
+    h ^= (u8_t)*name++;
+    h *= 16777619UL;
+  }
+  return h;
+}
+#endif /* FS_INDEX_SIZE */
+
 /*-----------------------------------------------------------------------------------*/
 err_t
 fs_open(struct fs_file *file, const char *name)
 {
   const struct fsdata_file *f;
+#ifdef FS_INDEX_SIZE
+  const struct fsdata_index *idx;
+#endif /* FS_INDEX_SIZE */
 
   if ((file == NULL) || (name == NULL)) {
     return ERR_ARG;
@@ -70,25 +95,85 @@ fs_open(struct fs_file *file, const char *name)
   file->is_custom_file = 0;
 #endif /* LWIP_HTTPD_CUSTOM_FILES */
 
+#ifdef FS_INDEX_SIZE
+  /* the index is a perfect hash: one probe, one compare */
+  idx = &fs_index[fs_index_hash(name) & (FS_INDEX_SIZE - 1)];
+  f = idx->file;
+  if ((f != NULL) && strcmp(name, (const char *)f->name)) {
+    f = NULL;
+  }
+#else /* FS_INDEX_SIZE */
   for (f = FS_ROOT; f != NULL; f = f->next) {
     if (!strcmp(name, (const char *)f->name)) {
-      file->data = (const char *)f->data;
-      file->len = f->len;
-      file->index = f->len;
-      file->pextension = NULL;
-      file->flags = f->flags;
+      break;
+    }
+  }
+#endif /* FS_INDEX_SIZE */
+  if (f == NULL) {
+    /* file not found */
+    return ERR_VAL;
+  }
+
+  file->data = (const char *)f->data;
+  file->len = f->len;
+  file->index = f->len;
+#ifdef FS_INDEX_SIZE
+  file->pextension = LWIP_CONST_CAST(void *, idx);
+#else /* FS_INDEX_SIZE */
+  file->pextension = NULL;
+#endif /* FS_INDEX_SIZE */
+  file->flags = f->flags;
 #if HTTPD_PRECALCULATED_CHECKSUM
-      file->chksum_count = f->chksum_count;
-      file->chksum = f->chksum;
+  file->chksum_count = f->chksum_count;
+  file->chksum = f->chksum;
 #endif /* HTTPD_PRECALCULATED_CHECKSUM */
 #if LWIP_HTTPD_FILE_STATE
-      file->state = fs_state_init(file, name);
+  file->state = fs_state_init(file, name);
 #endif /* #if LWIP_HTTPD_FILE_STATE */
-      return ERR_OK;
-    }
+  return ERR_OK;
+}
+
+/*-----------------------------------------------------------------------------------*/
+/** Swap an opened file for its prebuilt "304 Not Modified" response when one
+ * of the entity tags of an If-None-Match header matches the file.
+ *
+ * @param file file opened by fs_open
+ * @param tags value of the If-None-Match header (not NUL-terminated)
+ * @param len length of tags
+ * @return 1 if the file now holds the 304 response, 0 otherwise
+ */
+u8_t
+fs_etag_match(struct fs_file *file, const char *tags, u16_t len)
+{
+#ifdef FS_INDEX_SIZE
+  const struct fsdata_index *idx = (const struct fsdata_index *)file->pextension;
+
+#if LWIP_HTTPD_CUSTOM_FILES
+  if (file->is_custom_file) {
+    return 0;
   }
-  /* file not found */
-  return ERR_VAL;
+#endif /* LWIP_HTTPD_CUSTOM_FILES */
+  if ((idx == NULL) || (idx->etag == NULL)) {
+    return 0;
+  }
+  /* matches "tag", W/"tag" and lists of tags; "*" matches any file */
+  if (((len == 0) || (tags[0] != '*')) && (lwip_strnstr(tags, idx->etag, len) == NULL)) {
+    return 0;
+  }
+  file->data = idx->not_modified;
+  file->len = idx->not_modified_len;
+  file->index = file->len;
+#if HTTPD_PRECALCULATED_CHECKSUM
+  file->chksum_count = 0;
+  file->chksum = NULL;
+#endif /* HTTPD_PRECALCULATED_CHECKSUM */
+  return 1;
+#else /* FS_INDEX_SIZE */
+  LWIP_UNUSED_ARG(file);
+  LWIP_UNUSED_ARG(tags);
+  LWIP_UNUSED_ARG(len);
+  return 0;
+#endif /* FS_INDEX_SIZE */
 }
 
 /*-----------------------------------------------------------------------------------*/
@@ -32,9 +32,9 @@ static const unsigned char FSDATA_ALIGN_PRE data__img_sics_gif[] FSDATA_ALIGN_PO
 0x2f,0x69,0x6d,0x67,0x2f,0x73,0x69,0x63,0x73,0x2e,0x67,0x69,0x66,0x00,0x00,0x00,
 
 /* HTTP header */
-/* "HTTP/1.0 200 OK
+/* "HTTP/1.1 200 OK
 " (17 bytes) */
-0x48,0x54,0x54,0x50,0x2f,0x31,0x2e,0x30,0x20,0x32,0x30,0x30,0x20,0x4f,0x4b,0x0d,
+0x48,0x54,0x54,0x50,0x2f,0x31,0x2e,0x31,0x20,0x32,0x30,0x30,0x20,0x4f,0x4b,0x0d,
 0x0a,
 /* "Server: lwIP/2.0.3d (http://savannah.nongnu.org/projects/lwip)
 " (64 bytes) */
@@ -47,6 +47,10 @@ static const unsigned char FSDATA_ALIGN_PRE data__img_sics_gif[] FSDATA_ALIGN_PO
 " (18+ bytes) */
 0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x2d,0x4c,0x65,0x6e,0x67,0x74,0x68,0x3a,0x20,
 0x37,0x32,0x34,0x0d,0x0a,
+/* "ETag: "221743ce"
+" (18 bytes) */
+0x45,0x54,0x61,0x67,0x3a,0x20,0x22,0x32,0x32,0x31,0x37,0x34,0x33,0x63,0x65,0x22,
+0x0d,0x0a,
 /* "Content-Type: image/gif
 
 " (27 bytes) */
@@ -108,9 +112,9 @@ static const unsigned char FSDATA_ALIGN_PRE data__404_html[] FSDATA_ALIGN_POST =
 0x2f,0x34,0x30,0x34,0x2e,0x68,0x74,0x6d,0x6c,0x00,0x00,0x00,
 
 /* HTTP header */
-/* "HTTP/1.0 404 File not found
+/* "HTTP/1.1 404 File not found
 " (29 bytes) */
-0x48,0x54,0x54,0x50,0x2f,0x31,0x2e,0x30,0x20,0x34,0x30,0x34,0x20,0x46,0x69,0x6c,
+0x48,0x54,0x54,0x50,0x2f,0x31,0x2e,0x31,0x20,0x34,0x30,0x34,0x20,0x46,0x69,0x6c,
 0x65,0x20,0x6e,0x6f,0x74,0x20,0x66,0x6f,0x75,0x6e,0x64,0x0d,0x0a,
 /* "Server: lwIP/2.0.3d (http://savannah.nongnu.org/projects/lwip)
 " (64 bytes) */
@@ -174,9 +178,9 @@ static const unsigned char FSDATA_ALIGN_PRE data__index_html[] FSDATA_ALIGN_POST
 0x2f,0x69,0x6e,0x64,0x65,0x78,0x2e,0x68,0x74,0x6d,0x6c,0x00,
 
 /* HTTP header */
-/* "HTTP/1.0 200 OK
+/* "HTTP/1.1 200 OK
 " (17 bytes) */
-0x48,0x54,0x54,0x50,0x2f,0x31,0x2e,0x30,0x20,0x32,0x30,0x30,0x20,0x4f,0x4b,0x0d,
+0x48,0x54,0x54,0x50,0x2f,0x31,0x2e,0x31,0x20,0x32,0x30,0x30,0x20,0x4f,0x4b,0x0d,
 0x0a,
 /* "Server: lwIP/2.0.3d (http://savannah.nongnu.org/projects/lwip)
 " (64 bytes) */
@@ -189,6 +193,10 @@ static const unsigned char FSDATA_ALIGN_PRE data__index_html[] FSDATA_ALIGN_POST
 " (18+ bytes) */
 0x43,0x6f,0x6e,0x74,0x65,0x6e,0x74,0x2d,0x4c,0x65,0x6e,0x67,0x74,0x68,0x3a,0x20,
 0x31,0x37,0x35,0x31,0x0d,0x0a,
+/* "ETag: "10772794"
+" (18 bytes) */
+0x45,0x54,0x61,0x67,0x3a,0x20,0x22,0x31,0x30,0x37,0x37,0x32,0x37,0x39,0x34,0x22,
+0x0d,0x0a,
 /* "Content-Type: text/html
 
 " (27 bytes) */
@@ -313,7 +321,7 @@ file_NULL,
 data__img_sics_gif,
 data__img_sics_gif + 16,
 sizeof(data__img_sics_gif) - 16,
-FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT,
+FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT | FS_FILE_FLAGS_HEADER_HTTPVER_1_1,
 }};
 
 const struct fsdata_file file__404_html[] = { {
@@ -321,7 +329,7 @@ file__img_sics_gif,
 data__404_html,
 data__404_html + 12,
 sizeof(data__404_html) - 12,
-FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT,
+FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT | FS_FILE_FLAGS_HEADER_HTTPVER_1_1,
 }};
 
 const struct fsdata_file file__index_html[] = { {
@@ -329,9 +337,36 @@ file__404_html,
 data__index_html,
 data__index_html + 12,
 sizeof(data__index_html) - 12,
-FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT,
+FS_FILE_FLAGS_HEADER_INCLUDED | FS_FILE_FLAGS_HEADER_PERSISTENT | FS_FILE_FLAGS_HEADER_HTTPVER_1_1,
 }};
 
 #define FS_ROOT file__index_html
 #define FS_NUMFILES 3
 
+/* File index generated by makefsindex.py */
+#define FS_INDEX_SIZE 8
+#define FS_INDEX_SEED 0x811c9dc7UL
+
+static const char not_modified__img_sics_gif[] =
+  "HTTP/1.1 304 Not Modified\r\n"
+  "Server: lwIP/2.0.3d (http://savannah.nongnu.org/projects/lwip)\r\n"
+  "ETag: \"221743ce\"\r\n"
+  "\r\n";
+
+static const char not_modified__index_html[] =
+  "HTTP/1.1 304 Not Modified\r\n"
+  "Server: lwIP/2.0.3d (http://savannah.nongnu.org/projects/lwip)\r\n"
+  "ETag: \"10772794\"\r\n"
+  "\r\n";
+
+static const struct fsdata_index fs_index[FS_INDEX_SIZE] = {
+/*  0 */ {NULL, NULL, NULL, 0},
+/*  1 */ {NULL, NULL, NULL, 0},
+/*  2 */ {NULL, NULL, NULL, 0},
+/*  3 */ {file__index_html, "\"10772794\"", not_modified__index_html, sizeof(not_modified__index_html) - 1},
+/*  4 */ {NULL, NULL, NULL, 0},
+/*  5 */ {NULL, NULL, NULL, 0},
+/*  6 */ {file__img_sics_gif, "\"221743ce\"", not_modified__img_sics_gif, sizeof(not_modified__img_sics_gif) - 1},
+/*  7 */ {file__404_html, NULL, NULL, 0},
+};
+/* End of file index */
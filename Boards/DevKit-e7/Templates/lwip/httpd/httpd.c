@@ -121,8 +121,71 @@
 #if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
 #define HTTP11_CONNECTIONKEEPALIVE  "Connection: keep-alive"
 #define HTTP11_CONNECTIONKEEPALIVE2 "Connection: Keep-Alive"
+#define HTTP11_CONNECTIONCLOSE      "Connection: close"
+#define HTTP11_CONNECTIONCLOSE2     "Connection: Close"
+#define HTTP11_REQUEST              "HTTP/1.1"
 #endif
 
+#ifndef LWIP_HTTPD_SUPPORT_PIPELINING
+/** Set this to 1 to queue the requests received on a persistent connection
+ * while a response is sent and to answer them in order (HTTP/1.1 pipelining).
+ * Queued requests are limited by LWIP_HTTPD_REQ_BUFSIZE and LWIP_HTTPD_REQ_QUEUELEN. */
+#define LWIP_HTTPD_SUPPORT_PIPELINING (LWIP_HTTPD_SUPPORT_11_KEEPALIVE && LWIP_HTTPD_SUPPORT_REQUESTLIST)
+#endif
+
+#ifndef LWIP_HTTPD_CHUNKED
+/** Set this to 1 to send a body of unknown length (SSI or a file without
+ * FS_FILE_FLAGS_HEADER_PERSISTENT) with chunked transfer encoding to HTTP/1.1
+ * clients instead of closing the connection after it. Works with the headers
+ * generated by httpd (LWIP_HTTPD_DYNAMIC_HEADERS) only. */
+#define LWIP_HTTPD_CHUNKED (LWIP_HTTPD_SUPPORT_11_KEEPALIVE && LWIP_HTTPD_DYNAMIC_HEADERS)
+#endif
+
+#ifndef LWIP_HTTPD_MAX_CHUNK_LEN
+/** Largest chunk of a chunked body in bytes, sizes a static buffer */
+#define LWIP_HTTPD_MAX_CHUNK_LEN 512
+#endif
+
+#ifndef LWIP_HTTPD_REUSE_IDLE_CONNECTIONS
+/** Set this to 1 to close the least recently used persistent connection that
+ * waits for its next request when a new connection finds no free connection
+ * state, before LWIP_HTTPD_KILL_OLD_ON_CONNECTIONS_EXCEEDED aborts an active one. */
+#define LWIP_HTTPD_REUSE_IDLE_CONNECTIONS LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+#endif
+
+#if LWIP_HTTPD_SUPPORT_PIPELINING && !(LWIP_HTTPD_SUPPORT_11_KEEPALIVE && LWIP_HTTPD_SUPPORT_REQUESTLIST)
+#error "LWIP_HTTPD_SUPPORT_PIPELINING needs LWIP_HTTPD_SUPPORT_11_KEEPALIVE and LWIP_HTTPD_SUPPORT_REQUESTLIST"
+#endif
+#if LWIP_HTTPD_CHUNKED && !(LWIP_HTTPD_SUPPORT_11_KEEPALIVE && LWIP_HTTPD_DYNAMIC_HEADERS)
+#error "LWIP_HTTPD_CHUNKED needs LWIP_HTTPD_SUPPORT_11_KEEPALIVE and LWIP_HTTPD_DYNAMIC_HEADERS"
+#endif
+#if LWIP_HTTPD_REUSE_IDLE_CONNECTIONS && !LWIP_HTTPD_SUPPORT_11_KEEPALIVE
+#error "LWIP_HTTPD_REUSE_IDLE_CONNECTIONS needs LWIP_HTTPD_SUPPORT_11_KEEPALIVE"
+#endif
+
+/* The list of connections is needed to kill or reuse one of them */
+#define HTTPD_TRACK_CONNECTIONS (LWIP_HTTPD_KILL_OLD_ON_CONNECTIONS_EXCEEDED || LWIP_HTTPD_REUSE_IDLE_CONNECTIONS)
+
+#if LWIP_HTTPD_CHUNKED
+#define HTTP_CHUNKED_ALLOWED    1 /* request is HTTP/1.1 */
+#define HTTP_CHUNKED_ACTIVE     2 /* response body is sent chunked */
+/* Chunk size line (up to 4 hex digits and CRLF) and CRLF after the data */
+#define HTTP_CHUNK_OVERHEAD     8
+#define HTTP_LAST_CHUNK         "0" CRLF CRLF
+#endif /* LWIP_HTTPD_CHUNKED */
+
+#ifndef LWIP_HTTPD_ETAG
+/** Set this to 1 to answer an If-None-Match request with the prebuilt
+ * "304 Not Modified" response of the file (fsdata.c processed by makefsindex.py) */
+#define LWIP_HTTPD_ETAG 1
+#endif
+
+#if LWIP_HTTPD_ETAG
+#define HTTP_HDR_IF_NONE_MATCH "If-None-Match:"
+/* in fs.c, not part of the lwIP fs.h API */
+u8_t fs_etag_match(struct fs_file *file, const char *tags, u16_t len);
+#endif /* LWIP_HTTPD_ETAG */
+
 #if LWIP_HTTPD_DYNAMIC_FILE_READ
 #define HTTP_IS_DYNAMIC_FILE(hs) ((hs)->buf != NULL)
 #else
@@ -166,6 +229,11 @@ static const default_filename httpd_default_filenames[] = {
 static char httpd_req_buf[LWIP_HTTPD_MAX_REQ_LENGTH + 1];
 #endif /* LWIP_HTTPD_SUPPORT_REQUESTLIST */
 
+#if LWIP_HTTPD_CHUNKED
+/** A chunk is assembled here so that it is enqueued by one altcp_write() */
+static char http_chunk_buf[LWIP_HTTPD_MAX_CHUNK_LEN + HTTP_CHUNK_OVERHEAD];
+#endif /* LWIP_HTTPD_CHUNKED */
+
 #if LWIP_HTTPD_SUPPORT_POST
 #if LWIP_HTTPD_POST_MAX_RESPONSE_URI_LEN > LWIP_HTTPD_MAX_REQUEST_URI_LEN
 #define LWIP_HTTPD_URI_BUF_LEN LWIP_HTTPD_POST_MAX_RESPONSE_URI_LEN
@@ -239,9 +307,9 @@ struct http_ssi_tag_description {
 #endif /* LWIP_HTTPD_SSI */
 
 struct http_state {
-#if LWIP_HTTPD_KILL_OLD_ON_CONNECTIONS_EXCEEDED
+#if HTTPD_TRACK_CONNECTIONS
   struct http_state *next;
-#endif /* LWIP_HTTPD_KILL_OLD_ON_CONNECTIONS_EXCEEDED */
+#endif /* HTTPD_TRACK_CONNECTIONS */
   struct fs_file file_handle;
   struct fs_file *handle;
   const char *file;       /* Pointer to first unsent byte in buf. */
@@ -260,6 +328,16 @@ struct http_state {
 #if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
   u8_t keepalive;
 #endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+#if LWIP_HTTPD_CHUNKED
+  u8_t chunked;     /* HTTP_CHUNKED_ALLOWED or HTTP_CHUNKED_ACTIVE */
+#endif /* LWIP_HTTPD_CHUNKED */
+#if LWIP_HTTPD_SUPPORT_PIPELINING
+  u16_t req_len;    /* Bytes of req taken by the request being answered */
+#endif /* LWIP_HTTPD_SUPPORT_PIPELINING */
+#if LWIP_HTTPD_ETAG
+  const char *etag; /* If-None-Match value, valid while the request is parsed */
+  u16_t etag_len;
+#endif /* LWIP_HTTPD_ETAG */
 #if LWIP_HTTPD_SSI
   struct http_ssi_state *ssi;
 #endif /* LWIP_HTTPD_SSI */
@@ -311,6 +389,14 @@ static err_t http_find_file(struct http_state *hs, const char *uri, int is_09);
 static err_t http_init_file(struct http_state *hs, struct fs_file *file, int is_09, const char *uri, u8_t tag_check, char *params);
 static err_t http_poll(void *arg, struct altcp_pcb *pcb);
 static u8_t http_check_eof(struct altcp_pcb *pcb, struct http_state *hs);
+#if LWIP_HTTPD_SUPPORT_PIPELINING
+static err_t http_parse_request(struct pbuf *inp, struct http_state *hs, struct altcp_pcb *pcb);
+static u8_t http_send(struct altcp_pcb *pcb, struct http_state *hs);
+static void http_pipeline_next(struct altcp_pcb *pcb, struct http_state *hs);
+
+/** Connection whose queued requests are being answered by http_pipeline_next() */
+static struct http_state *http_pipeline_hs;
+#endif /* LWIP_HTTPD_SUPPORT_PIPELINING */
 #if LWIP_HTTPD_FS_ASYNC_READ
 static void http_continue(void *connection);
 #endif /* LWIP_HTTPD_FS_ASYNC_READ */
@@ -345,9 +431,9 @@ static char *http_cgi_params[LWIP_HTTPD_MAX_CGI_PARAMETERS]; /* Params extracted
 static char *http_cgi_param_vals[LWIP_HTTPD_MAX_CGI_PARAMETERS]; /* Values for each extracted param */
 #endif /* LWIP_HTTPD_CGI */
 
-#if LWIP_HTTPD_KILL_OLD_ON_CONNECTIONS_EXCEEDED
-/** global list of active HTTP connections, use to kill the oldest when
-    running out of memory */
+#if HTTPD_TRACK_CONNECTIONS
+/** global list of active HTTP connections, most recently active first, use to
+    reuse an idle one or kill the oldest when running out of memory */
 static struct http_state *http_connections;
 
 static void
@@ -377,6 +463,42 @@ http_remove_connection(struct http_state *hs)
   }
 }
 
+#if LWIP_HTTPD_REUSE_IDLE_CONNECTIONS
+/** Close the least recently active persistent connection that is waiting
+ * for its next request, which frees its http_state.
+ *
+ * @return 1 if a connection was closed, 0 if none is idle
+ */
+static u8_t
+http_close_idle_connection(void)
+{
+  struct http_state *hs;
+  struct http_state *idle = NULL;
+
+  for (hs = http_connections; hs != NULL; hs = hs->next) {
+    /* keepalive is set once a response has been sent on the connection */
+    if (hs->keepalive && (hs->handle == NULL)
+#if LWIP_HTTPD_SUPPORT_REQUESTLIST
+        && (hs->req == NULL)
+#endif /* LWIP_HTTPD_SUPPORT_REQUESTLIST */
+#if LWIP_HTTPD_SUPPORT_POST
+        && (hs->post_content_len_left == 0)
+#endif /* LWIP_HTTPD_SUPPORT_POST */
+       ) {
+      idle = hs;
+    }
+  }
+  if (idle == NULL) {
+    return 0;
+  }
+  LWIP_DEBUGF(HTTPD_DEBUG, ("Closing idle connection %p\n", (void *)idle->pcb));
+  /* nothing is in flight, so close with FIN (this also unlinks the http_state) */
+  http_close_conn(idle->pcb, idle);
+  return 1;
+}
+#endif /* LWIP_HTTPD_REUSE_IDLE_CONNECTIONS */
+
+#if LWIP_HTTPD_KILL_OLD_ON_CONNECTIONS_EXCEEDED
 static void
 http_kill_oldest_connection(u8_t ssi_required)
 {
@@ -405,12 +527,13 @@ http_kill_oldest_connection(u8_t ssi_required)
     http_close_or_abort_conn(hs_free_next->next->pcb, hs_free_next->next, 1); /* this also unlinks the http_state from the list */
   }
 }
-#else /* LWIP_HTTPD_KILL_OLD_ON_CONNECTIONS_EXCEEDED */
+#endif /* LWIP_HTTPD_KILL_OLD_ON_CONNECTIONS_EXCEEDED */
+#else /* HTTPD_TRACK_CONNECTIONS */
 
 #define http_add_connection(hs)
 #define http_remove_connection(hs)
 
-#endif /* LWIP_HTTPD_KILL_OLD_ON_CONNECTIONS_EXCEEDED */
+#endif /* HTTPD_TRACK_CONNECTIONS */
 
 #if LWIP_HTTPD_SSI
 /** Allocate as struct http_ssi_state. */
@@ -458,6 +581,11 @@ static struct http_state *
 http_state_alloc(void)
 {
   struct http_state *ret = HTTP_ALLOC_HTTP_STATE();
+#if LWIP_HTTPD_REUSE_IDLE_CONNECTIONS
+  if ((ret == NULL) && http_close_idle_connection()) {
+    ret = HTTP_ALLOC_HTTP_STATE();
+  }
+#endif /* LWIP_HTTPD_REUSE_IDLE_CONNECTIONS */
 #if LWIP_HTTPD_KILL_OLD_ON_CONNECTIONS_EXCEEDED
   if (ret == NULL) {
     http_kill_oldest_connection(0);
@@ -516,6 +644,12 @@ http_state_free(struct http_state *hs)
   if (hs != NULL) {
     http_state_eof(hs);
     http_remove_connection(hs);
+#if LWIP_HTTPD_SUPPORT_PIPELINING
+    if (http_pipeline_hs == hs) {
+      /* tell http_pipeline_next() that the connection is gone */
+      http_pipeline_hs = NULL;
+    }
+#endif /* LWIP_HTTPD_SUPPORT_PIPELINING */
     HTTP_FREE_HTTP_STATE(hs);
   }
 }
@@ -585,6 +719,66 @@ http_write(struct altcp_pcb *pcb, const void *ptr, u16_t *length, u8_t apiflags)
   return err;
 }
 
+#if LWIP_HTTPD_CHUNKED
+/** Like http_write(), but sends the data as one chunk of a chunked body.
+ * Size line, data and CRLF are enqueued by a single altcp_write() so that
+ * a failed write never leaves half a chunk in the send queue.
+ */
+static err_t
+http_write_chunk(struct altcp_pcb *pcb, const void *ptr, u16_t *length)
+{
+  static const char hex[] = "0123456789abcdef";
+  u16_t len, max_len, hdr_len;
+  int shift;
+  err_t err;
+
+  len = LWIP_MIN(*length, LWIP_HTTPD_MAX_CHUNK_LEN);
+  if (len == 0) {
+    /* a chunk of size 0 would end the body */
+    return ERR_OK;
+  }
+  max_len = altcp_sndbuf(pcb);
+  if (max_len <= HTTP_CHUNK_OVERHEAD) {
+    *length = 0;
+    return ERR_MEM;
+  }
+  if (len > max_len - HTTP_CHUNK_OVERHEAD) {
+    len = (u16_t)(max_len - HTTP_CHUNK_OVERHEAD);
+  }
+  do {
+    hdr_len = 0;
+    for (shift = 12; (shift > 0) && ((len >> shift) == 0); shift -= 4);
+    for (; shift >= 0; shift -= 4) {
+      http_chunk_buf[hdr_len++] = hex[(len >> shift) & 0xf];
+    }
+    http_chunk_buf[hdr_len++] = '\r';
+    http_chunk_buf[hdr_len++] = '\n';
+    MEMCPY(&http_chunk_buf[hdr_len], ptr, len);
+    http_chunk_buf[hdr_len + len] = '\r';
+    http_chunk_buf[hdr_len + len + 1] = '\n';
+    err = altcp_write(pcb, http_chunk_buf, (u16_t)(hdr_len + len + 2), TCP_WRITE_FLAG_COPY);
+    if (err != ERR_MEM) {
+      break;
+    }
+    if ((altcp_sndbuf(pcb) == 0) || (altcp_sndqueuelen(pcb) >= TCP_SND_QUEUELEN)) {
+      /* no need to try smaller sizes */
+      break;
+    }
+    len /= 2;
+  } while (len > 0);
+
+  *length = (err == ERR_OK) ? len : 0;
+  /* see http_write() */
+  altcp_nagle_enable(pcb);
+  return err;
+}
+
+#define http_write_body(pcb, hs, ptr, length, apiflags) \
+  (((hs)->chunked == HTTP_CHUNKED_ACTIVE) ? http_write_chunk(pcb, ptr, length) : http_write(pcb, ptr, length, apiflags))
+#else /* LWIP_HTTPD_CHUNKED */
+#define http_write_body(pcb, hs, ptr, length, apiflags) http_write(pcb, ptr, length, apiflags)
+#endif /* LWIP_HTTPD_CHUNKED */
+
 /**
  * The connection shall be actively closed (using RST to close from fault states).
  * Reset the sent- and recv-callbacks.
@@ -654,9 +848,24 @@ http_close_conn(struct altcp_pcb *pcb, struct http_state *hs)
 static void
 http_eof(struct altcp_pcb *pcb, struct http_state *hs)
 {
-  /* HTTP/1.1 persistent connection? (Not supported for SSI) */
+#if LWIP_HTTPD_CHUNKED
+  if (hs->chunked == HTTP_CHUNKED_ACTIVE) {
+    /* End the chunked body. With the send buffer full, this is tried again
+       from http_sent/http_poll as the file is still open. */
+    if (altcp_write(pcb, HTTP_LAST_CHUNK, sizeof(HTTP_LAST_CHUNK) - 1, 0) != ERR_OK) {
+      return;
+    }
+    hs->chunked = 0;
+  }
+#endif /* LWIP_HTTPD_CHUNKED */
+  /* HTTP/1.1 persistent connection? (Not supported for SSI without LWIP_HTTPD_CHUNKED) */
 #if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
   if (hs->keepalive) {
+#if LWIP_HTTPD_SUPPORT_PIPELINING
+    /* requests received while this response was sent */
+    struct pbuf *req = hs->req;
+    hs->req = NULL;
+#endif /* LWIP_HTTPD_SUPPORT_PIPELINING */
     http_remove_connection(hs);
 
     http_state_eof(hs);
@@ -667,6 +876,12 @@ http_eof(struct altcp_pcb *pcb, struct http_state *hs)
     http_add_connection(hs);
     /* ensure nagle doesn't interfere with sending all data as fast as possible: */
     altcp_nagle_disable(pcb);
+#if LWIP_HTTPD_SUPPORT_PIPELINING
+    hs->req = req;
+    if ((req != NULL) && (http_pipeline_hs != hs)) {
+      http_pipeline_next(pcb, hs);
+    }
+#endif /* LWIP_HTTPD_SUPPORT_PIPELINING */
   } else
 #endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
   {
@@ -845,6 +1060,7 @@ get_http_headers(struct http_state *hs, const char *uri)
   char *tmp;
   char *ext;
   char *vars;
+  u8_t status;
 
   /* In all cases, the second header we send is the server identification
      so set it here. */
@@ -875,14 +1091,21 @@ get_http_headers(struct http_state *hs, const char *uri)
       indicative of a 404 server error whereas all other files require
       the 200 OK header. */
   if (strstr(uri, "404")) {
-    hs->hdrs[HDR_STRINGS_IDX_HTTP_STATUS] = g_psHTTPHeaderStrings[HTTP_HDR_NOT_FOUND];
+    status = HTTP_HDR_NOT_FOUND;
   } else if (strstr(uri, "400")) {
-    hs->hdrs[HDR_STRINGS_IDX_HTTP_STATUS] = g_psHTTPHeaderStrings[HTTP_HDR_BAD_REQUEST];
+    status = HTTP_HDR_BAD_REQUEST;
   } else if (strstr(uri, "501")) {
-    hs->hdrs[HDR_STRINGS_IDX_HTTP_STATUS] = g_psHTTPHeaderStrings[HTTP_HDR_NOT_IMPL];
+    status = HTTP_HDR_NOT_IMPL;
   } else {
-    hs->hdrs[HDR_STRINGS_IDX_HTTP_STATUS] = g_psHTTPHeaderStrings[HTTP_HDR_OK];
+    status = HTTP_HDR_OK;
   }
+#if LWIP_HTTPD_CHUNKED
+  if (hs->chunked == HTTP_CHUNKED_ACTIVE) {
+    /* Transfer-Encoding needs an HTTP/1.1 status line */
+    status += HTTP_HDR_OK_11 - HTTP_HDR_OK;
+  }
+#endif /* LWIP_HTTPD_CHUNKED */
+  hs->hdrs[HDR_STRINGS_IDX_HTTP_STATUS] = g_psHTTPHeaderStrings[status];
 
   /* Determine if the URI has any variables and, if so, temporarily remove
       them. */
@@ -924,6 +1147,13 @@ get_http_headers(struct http_state *hs, const char *uri)
     /* Force the header index to a value indicating that all headers
        have already been sent. */
     hs->hdr_index = NUM_FILE_HDR_STRINGS;
+#if LWIP_HTTPD_CHUNKED
+    if (hs->chunked == HTTP_CHUNKED_ACTIVE) {
+      /* without headers, the end of the body is the end of the connection */
+      hs->chunked = 0;
+      hs->keepalive = 0;
+    }
+#endif /* LWIP_HTTPD_CHUNKED */
     return;
   }
 #endif /* LWIP_HTTPD_OMIT_HEADER_FOR_EXTENSIONLESS_URI */
@@ -975,6 +1205,11 @@ get_http_content_length(struct http_state *hs)
 #if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
   if (add_content_len) {
     hs->hdrs[HDR_STRINGS_IDX_CONTENT_LEN_KEEPALIVE] = g_psHTTPHeaderStrings[HTTP_HDR_KEEPALIVE_LEN];
+#if LWIP_HTTPD_CHUNKED
+  } else if (hs->chunked == HTTP_CHUNKED_ACTIVE) {
+    /* persistent without length, the body is sent in chunks */
+    hs->hdrs[HDR_STRINGS_IDX_CONTENT_LEN_KEEPALIVE] = g_psHTTPHeaderStrings[HTTP_HDR_CHUNKED];
+#endif /* LWIP_HTTPD_CHUNKED */
   } else {
     hs->hdrs[HDR_STRINGS_IDX_CONTENT_LEN_KEEPALIVE] = g_psHTTPHeaderStrings[HTTP_HDR_CONN_CLOSE];
     hs->keepalive = 0;
@@ -1199,7 +1434,7 @@ http_send_data_nonssi(struct altcp_pcb *pcb, struct http_state *hs)
    * Just send the data as we received it from the file. */
   len = (u16_t)LWIP_MIN(hs->left, 0xffff);
 
-  err = http_write(pcb, hs->file, &len, HTTP_IS_DATA_VOLATILE(hs));
+  err = http_write_body(pcb, hs, hs->file, &len, HTTP_IS_DATA_VOLATILE(hs));
   if (err == ERR_OK) {
     data_to_send = 1;
     hs->file += len;
@@ -1237,7 +1472,7 @@ http_send_data_ssi(struct altcp_pcb *pcb, struct http_state *hs)
   if (ssi->parsed > hs->file) {
     len = (u16_t)LWIP_MIN(ssi->parsed - hs->file, 0xffff);
 
-    err = http_write(pcb, hs->file, &len, HTTP_IS_DATA_VOLATILE(hs));
+    err = http_write_body(pcb, hs, hs->file, &len, HTTP_IS_DATA_VOLATILE(hs));
     if (err == ERR_OK) {
       data_to_send = 1;
       hs->file += len;
@@ -1413,7 +1648,7 @@ http_send_data_ssi(struct altcp_pcb *pcb, struct http_state *hs)
               len = (u16_t)LWIP_MIN(ssi->tag_started - hs->file, 0xffff);
 #endif /* LWIP_HTTPD_SSI_INCLUDE_TAG*/
 
-              err = http_write(pcb, hs->file, &len, HTTP_IS_DATA_VOLATILE(hs));
+              err = http_write_body(pcb, hs, hs->file, &len, HTTP_IS_DATA_VOLATILE(hs));
               if (err == ERR_OK) {
                 data_to_send = 1;
 #if !LWIP_HTTPD_SSI_INCLUDE_TAG
@@ -1454,7 +1689,7 @@ http_send_data_ssi(struct altcp_pcb *pcb, struct http_state *hs)
           len = (u16_t)LWIP_MIN(ssi->tag_started - hs->file, 0xffff);
 #endif /* LWIP_HTTPD_SSI_INCLUDE_TAG*/
           if (len != 0) {
-            err = http_write(pcb, hs->file, &len, HTTP_IS_DATA_VOLATILE(hs));
+            err = http_write_body(pcb, hs, hs->file, &len, HTTP_IS_DATA_VOLATILE(hs));
           } else {
             err = ERR_OK;
           }
@@ -1491,8 +1726,8 @@ http_send_data_ssi(struct altcp_pcb *pcb, struct http_state *hs)
              * single tag insert buffer per connection. If we don't do
              * this, insert corruption can occur if more than one insert
              * is processed before we call tcp_output. */
-            err = http_write(pcb, &(ssi->tag_insert[ssi->tag_index]), &len,
-                             HTTP_IS_TAG_VOLATILE(hs));
+            err = http_write_body(pcb, hs, &(ssi->tag_insert[ssi->tag_index]), &len,
+                                  HTTP_IS_TAG_VOLATILE(hs));
             if (err == ERR_OK) {
               data_to_send = 1;
               ssi->tag_index += len;
@@ -1538,7 +1773,7 @@ http_send_data_ssi(struct altcp_pcb *pcb, struct http_state *hs)
       len = (u16_t)LWIP_MIN(ssi->parsed - hs->file, 0xffff);
     }
 
-    err = http_write(pcb, hs->file, &len, HTTP_IS_DATA_VOLATILE(hs));
+    err = http_write_body(pcb, hs, hs->file, &len, HTTP_IS_DATA_VOLATILE(hs));
     if (err == ERR_OK) {
       data_to_send = 1;
       hs->file += len;
@@ -1941,7 +2176,7 @@ http_continue(void *connection)
  * When data has been received in the correct state, try to parse it
  * as a HTTP request.
  *
- * @param inp the received pbuf
+ * @param inp the received pbuf (NULL to parse a request already queued on hs->req)
  * @param hs the connection state
  * @param pcb the altcp_pcb which received this packet
  * @return ERR_OK if request was OK and hs has been initialized correctly
@@ -1963,7 +2198,11 @@ http_parse_request(struct pbuf *inp, struct http_state *hs, struct altcp_pcb *pc
 #endif /* LWIP_HTTPD_SUPPORT_POST */
 
   LWIP_UNUSED_ARG(pcb); /* only used for post */
+#if LWIP_HTTPD_SUPPORT_PIPELINING
+  LWIP_ASSERT("p != NULL", (p != NULL) || (hs->req != NULL));
+#else /* LWIP_HTTPD_SUPPORT_PIPELINING */
   LWIP_ASSERT("p != NULL", p != NULL);
+#endif /* LWIP_HTTPD_SUPPORT_PIPELINING */
   LWIP_ASSERT("hs != NULL", hs != NULL);
 
   if ((hs->handle != NULL) || (hs->file != NULL)) {
@@ -1975,21 +2214,25 @@ http_parse_request(struct pbuf *inp, struct http_state *hs, struct altcp_pcb *pc
 
 #if LWIP_HTTPD_SUPPORT_REQUESTLIST
 
-  LWIP_DEBUGF(HTTPD_DEBUG, ("Received %"U16_F" bytes\n", p->tot_len));
+  if (p != NULL) {
+    LWIP_DEBUGF(HTTPD_DEBUG, ("Received %"U16_F" bytes\n", p->tot_len));
 
-  /* first check allowed characters in this pbuf? */
+    /* first check allowed characters in this pbuf? */
 
-  /* enqueue the pbuf */
-  if (hs->req == NULL) {
-    LWIP_DEBUGF(HTTPD_DEBUG, ("First pbuf\n"));
-    hs->req = p;
-  } else {
-    LWIP_DEBUGF(HTTPD_DEBUG, ("pbuf enqueued\n"));
-    pbuf_cat(hs->req, p);
+    /* enqueue the pbuf */
+    if (hs->req == NULL) {
+      LWIP_DEBUGF(HTTPD_DEBUG, ("First pbuf\n"));
+      hs->req = p;
+    } else {
+      LWIP_DEBUGF(HTTPD_DEBUG, ("pbuf enqueued\n"));
+      pbuf_cat(hs->req, p);
+    }
+    /* increase pbuf ref counter as it is freed when we return but we want to
+       keep it on the req list */
+    pbuf_ref(p);
   }
-  /* increase pbuf ref counter as it is freed when we return but we want to
-     keep it on the req list */
-  pbuf_ref(p);
+  /* a pipelined request starts in the first pbuf of the list */
+  p = hs->req;
 
   if (hs->req->next != NULL) {
     data_len = LWIP_MIN(hs->req->tot_len, LWIP_HTTPD_MAX_REQ_LENGTH);
@@ -2057,17 +2300,29 @@ http_parse_request(struct pbuf *inp, struct http_state *hs, struct altcp_pcb *pc
       uri_len = (u16_t)(sp2 - (sp1 + 1));
       if ((sp2 != 0) && (sp2 > sp1)) {
         /* wait for CRLFCRLF (indicating end of HTTP headers) before parsing anything */
-        if (lwip_strnstr(data, CRLF CRLF, data_len) != NULL) {
+        char *crlfcrlf = lwip_strnstr(data, CRLF CRLF, data_len);
+        if (crlfcrlf != NULL) {
           char *uri = sp1 + 1;
 #if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
-          /* This is HTTP/1.0 compatible: for strict 1.1, a connection
-             would always be persistent unless "close" was specified. */
-          if (!is_09 && (lwip_strnstr(data, HTTP11_CONNECTIONKEEPALIVE, data_len) ||
-                         lwip_strnstr(data, HTTP11_CONNECTIONKEEPALIVE2, data_len))) {
+          /* Only look at the headers of this request: with pipelining,
+             more requests may follow in the same buffer. An HTTP/1.1
+             connection is persistent unless "close" was specified, an
+             HTTP/1.0 one only if "keep-alive" was. */
+          u16_t hdr_len = (u16_t)((crlfcrlf + 2) - data);
+          int is_11 = !is_09 && ((crlf - sp2) > 8) && !strncmp(sp2 + 1, HTTP11_REQUEST, 8);
+          if (is_11) {
+            hs->keepalive = !lwip_strnstr(data, HTTP11_CONNECTIONCLOSE, hdr_len) &&
+                            !lwip_strnstr(data, HTTP11_CONNECTIONCLOSE2, hdr_len);
+          } else if (!is_09 && (lwip_strnstr(data, HTTP11_CONNECTIONKEEPALIVE, hdr_len) ||
+                                lwip_strnstr(data, HTTP11_CONNECTIONKEEPALIVE2, hdr_len))) {
             hs->keepalive = 1;
           } else {
             hs->keepalive = 0;
           }
+#if LWIP_HTTPD_CHUNKED
+          /* only HTTP/1.1 clients understand Transfer-Encoding */
+          hs->chunked = (hs->keepalive && is_11) ? HTTP_CHUNKED_ALLOWED : 0;
+#endif /* LWIP_HTTPD_CHUNKED */
 #endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
           /* null-terminate the METHOD (pbuf is freed anyway wen returning) */
           *sp1 = 0;
@@ -2095,6 +2350,24 @@ http_parse_request(struct pbuf *inp, struct http_state *hs, struct altcp_pcb *pc
           } else
 #endif /* LWIP_HTTPD_SUPPORT_POST */
           {
+#if LWIP_HTTPD_ETAG
+            char *tags = lwip_strnstr(crlf, CRLF HTTP_HDR_IF_NONE_MATCH, (crlfcrlf + 2) - crlf);
+            if (!is_09 && (tags != NULL)) {
+              /* the header line ends at or before the final CRLF CRLF */
+              char *tags_end;
+              tags += 2 + sizeof(HTTP_HDR_IF_NONE_MATCH) - 1;
+              tags_end = lwip_strnstr(tags, CRLF, (crlfcrlf + 2) - tags);
+              while (*tags == ' ') {
+                tags++;
+              }
+              hs->etag = tags;
+              hs->etag_len = (u16_t)(tags_end - tags);
+            }
+#endif /* LWIP_HTTPD_ETAG */
+#if LWIP_HTTPD_SUPPORT_PIPELINING
+            /* anything after this request is kept for http_pipeline_next() */
+            hs->req_len = (u16_t)((crlfcrlf + 4) - data);
+#endif /* LWIP_HTTPD_SUPPORT_PIPELINING */
             return http_find_file(hs, uri, is_09);
           }
         }
@@ -2305,6 +2578,11 @@ static err_t
 http_init_file(struct http_state *hs, struct fs_file *file, int is_09, const char *uri,
                u8_t tag_check, char *params)
 {
+#if LWIP_HTTPD_ETAG
+  const char *etag = hs->etag;
+  /* points into the request, only valid for this call */
+  hs->etag = NULL;
+#endif /* LWIP_HTTPD_ETAG */
 #if !LWIP_HTTPD_SUPPORT_V09
   LWIP_UNUSED_ARG(is_09);
 #endif
@@ -2315,6 +2593,13 @@ http_init_file(struct http_state *hs, struct fs_file *file, int is_09, const cha
     LWIP_ASSERT("file->data != NULL", file->data != NULL);
 #endif
 
+#if LWIP_HTTPD_ETAG
+    if ((etag != NULL) && !tag_check) {
+      /* on a match the file is swapped for its 304 response */
+      fs_etag_match(file, etag, hs->etag_len);
+    }
+#endif /* LWIP_HTTPD_ETAG */
+
 #if LWIP_HTTPD_SSI
     if (tag_check) {
       struct http_ssi_state *ssi = http_ssi_state_alloc();
@@ -2389,17 +2674,21 @@ http_init_file(struct http_state *hs, struct fs_file *file, int is_09, const cha
     hs->left = 0;
     hs->retries = 0;
   }
-#if LWIP_HTTPD_DYNAMIC_HEADERS
-  /* Determine the HTTP headers to send based on the file extension of
-   * the requested URI. */
-  if ((hs->handle == NULL) || ((hs->handle->flags & FS_FILE_FLAGS_HEADER_INCLUDED) == 0)) {
-    get_http_headers(hs, uri);
-  }
-#else /* LWIP_HTTPD_DYNAMIC_HEADERS */
-  LWIP_UNUSED_ARG(uri);
-#endif /* LWIP_HTTPD_DYNAMIC_HEADERS */
 #if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
   if (hs->keepalive) {
+#if LWIP_HTTPD_CHUNKED
+    if ((hs->chunked == HTTP_CHUNKED_ALLOWED) && (hs->handle != NULL) &&
+        ((hs->handle->flags & FS_FILE_FLAGS_HEADER_INCLUDED) == 0) &&
+        (((hs->handle->flags & FS_FILE_FLAGS_HEADER_PERSISTENT) == 0)
+#if LWIP_HTTPD_SSI
+         || (hs->ssi != NULL)
+#endif /* LWIP_HTTPD_SSI */
+        )) {
+      /* length unknown in advance: keep the connection by sending the
+         body in chunks (this is decided before the headers are built) */
+      hs->chunked = HTTP_CHUNKED_ACTIVE;
+    } else
+#endif /* LWIP_HTTPD_CHUNKED */
 #if LWIP_HTTPD_SSI
     if (hs->ssi != NULL) {
       hs->keepalive = 0;
@@ -2413,6 +2702,15 @@ http_init_file(struct http_state *hs, struct fs_file *file, int is_09, const cha
     }
   }
 #endif /* LWIP_HTTPD_SUPPORT_11_KEEPALIVE */
+#if LWIP_HTTPD_DYNAMIC_HEADERS
+  /* Determine the HTTP headers to send based on the file extension of
+   * the requested URI. */
+  if ((hs->handle == NULL) || ((hs->handle->flags & FS_FILE_FLAGS_HEADER_INCLUDED) == 0)) {
+    get_http_headers(hs, uri);
+  }
+#else /* LWIP_HTTPD_DYNAMIC_HEADERS */
+  LWIP_UNUSED_ARG(uri);
+#endif /* LWIP_HTTPD_DYNAMIC_HEADERS */
   return ERR_OK;
 }
 
@@ -2508,6 +2806,75 @@ http_poll(void *arg, struct altcp_pcb *pcb)
   return ERR_OK;
 }
 
+#if LWIP_HTTPD_SUPPORT_REQUESTLIST
+/** Free the request on hs->req once http_parse_request() is done with it.
+ * With pipelining, anything the client sent after it stays queued.
+ */
+static void
+http_req_done(struct http_state *hs, err_t parsed)
+{
+  LWIP_UNUSED_ARG(parsed);
+  if (hs->req != NULL) {
+#if LWIP_HTTPD_SUPPORT_PIPELINING
+    if ((parsed == ERR_OK) && hs->keepalive && (hs->req_len != 0) &&
+        (hs->req_len < hs->req->tot_len)) {
+      hs->req = pbuf_free_header(hs->req, hs->req_len);
+    } else
+#endif /* LWIP_HTTPD_SUPPORT_PIPELINING */
+    {
+      pbuf_free(hs->req);
+      hs->req = NULL;
+    }
+  }
+#if LWIP_HTTPD_SUPPORT_PIPELINING
+  hs->req_len = 0;
+#endif /* LWIP_HTTPD_SUPPORT_PIPELINING */
+}
+#endif /* LWIP_HTTPD_SUPPORT_REQUESTLIST */
+
+#if LWIP_HTTPD_SUPPORT_PIPELINING
+/** Answer the requests that were received while a response was being sent.
+ * Called by http_eof() when a persistent connection is ready for the next
+ * request; responses go out in request order. Stops at the first response
+ * that does not fit into the send buffer: its http_eof() continues later.
+ */
+static void
+http_pipeline_next(struct altcp_pcb *pcb, struct http_state *hs)
+{
+  struct http_state *outer = http_pipeline_hs;
+
+  http_pipeline_hs = hs;
+  while ((hs->req != NULL) && (hs->handle == NULL)) {
+    u8_t data_to_send;
+    err_t parsed = http_parse_request(NULL, hs, pcb);
+    if (parsed == ERR_INPROGRESS) {
+      /* wait for the rest of the request */
+      break;
+    }
+    http_req_done(hs, parsed);
+    if (parsed != ERR_OK) {
+      http_close_conn(pcb, hs);
+      break;
+    }
+#if LWIP_HTTPD_SUPPORT_POST
+    if (hs->post_content_len_left != 0) {
+      /* body still to come: http_recv() continues */
+      break;
+    }
+#endif /* LWIP_HTTPD_SUPPORT_POST */
+    data_to_send = http_send(pcb, hs);
+    if (http_pipeline_hs != hs) {
+      /* connection closed, hs has been freed */
+      break;
+    }
+    if (data_to_send) {
+      altcp_output(pcb);
+    }
+  }
+  http_pipeline_hs = outer;
+}
+#endif /* LWIP_HTTPD_SUPPORT_PIPELINING */
+
 /**
  * Data has been received on this pcb.
  * For HTTP 1.0, this should normally only happen once (if the request fits in one packet).
@@ -2534,6 +2901,16 @@ http_recv(void *arg, struct altcp_pcb *pcb, struct pbuf *p, err_t err)
     return ERR_OK;
   }
 
+#if LWIP_HTTPD_SUPPORT_PIPELINING
+  if ((hs->handle != NULL) && hs->keepalive && (hs->req != NULL) &&
+      (((u32_t)hs->req->tot_len + p->tot_len > LWIP_HTTPD_REQ_BUFSIZE) ||
+       (pbuf_clen(hs->req) + pbuf_clen(p) > LWIP_HTTPD_REQ_QUEUELEN))) {
+    /* Request queue full: refuse the data, TCP delivers it again later
+       and the closed window throttles the client meanwhile. */
+    return ERR_MEM;
+  }
+#endif /* LWIP_HTTPD_SUPPORT_PIPELINING */
+
 #if LWIP_HTTPD_SUPPORT_POST && LWIP_HTTPD_POST_MANUAL_WND
   if (hs->no_auto_wnd) {
     hs->unrecved_bytes += p->tot_len;
@@ -2566,10 +2943,7 @@ http_recv(void *arg, struct altcp_pcb *pcb, struct pbuf *p, err_t err)
 #if LWIP_HTTPD_SUPPORT_REQUESTLIST
       if (parsed != ERR_INPROGRESS) {
         /* request fully parsed or error */
-        if (hs->req != NULL) {
-          pbuf_free(hs->req);
-          hs->req = NULL;
-        }
+        http_req_done(hs, parsed);
       }
 #endif /* LWIP_HTTPD_SUPPORT_REQUESTLIST */
       pbuf_free(p);
@@ -2587,6 +2961,17 @@ http_recv(void *arg, struct altcp_pcb *pcb, struct pbuf *p, err_t err)
       }
     } else {
       LWIP_DEBUGF(HTTPD_DEBUG, ("http_recv: already sending data\n"));
+#if LWIP_HTTPD_SUPPORT_PIPELINING
+      if (hs->keepalive) {
+        /* pipelined request: queue it, http_eof() answers it next */
+        if (hs->req == NULL) {
+          hs->req = p;
+        } else {
+          pbuf_cat(hs->req, p);
+        }
+        return ERR_OK;
+      }
+#endif /* LWIP_HTTPD_SUPPORT_PIPELINING */
       /* already sending but still receiving data, we might want to RST here? */
       pbuf_free(p);
     }
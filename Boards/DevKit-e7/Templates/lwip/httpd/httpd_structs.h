@@ -30,6 +30,7 @@ static const char *const g_psHTTPHeaderStrings[] = {
   "\r\n<html><body><h2>404: The requested file cannot be found.</h2></body></html>\r\n"
 #if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
   , "Connection: keep-alive\r\nContent-Length: 77\r\n\r\n<html><body><h2>404: The requested file cannot be found.</h2></body></html>\r\n"
+  , "Connection: keep-alive\r\nTransfer-Encoding: chunked\r\n"
 #endif
 };
 
@@ -50,6 +51,7 @@ static const char *const g_psHTTPHeaderStrings[] = {
 #define DEFAULT_404_HTML        13 /* default 404 body */
 #if LWIP_HTTPD_SUPPORT_11_KEEPALIVE
 #define DEFAULT_404_HTML_PERSISTENT 14 /* default 404 body, but including Connection: keep-alive */
+#define HTTP_HDR_CHUNKED        15 /* Connection: keep-alive + Transfer-Encoding: chunked (HTTP 1.1) */
 #endif
 
 #define HTTP_CONTENT_TYPE(contenttype) "Content-Type: "contenttype"\r\n\r\n"
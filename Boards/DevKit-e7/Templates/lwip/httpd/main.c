@@ -38,6 +38,7 @@
 #include <stdio.h>
 #include <stdint.h>
 
+#include "Driver_ETH_MAC.h"
 #include "ethernetif.h"
 #include "lwip/init.h"
 #include "lwip/netif.h"
@@ -53,11 +54,14 @@
 #endif  /* RTE_Compiler_IO_STDOUT */
 
 static void net_init (void);
+static void net_checksum_ctrl (struct netif *netif);
 static void net_periodic (uint32_t tick);
 static void net_timer (uint32_t *tick);
 
 static struct netif netif;
 
+extern ARM_DRIVER_ETH_MAC Driver_ETH_MAC0;
+
 #define HTTP_DEMO_DEBUG
 
 static int pin_mux_init(void)
@@ -111,6 +115,49 @@ static int pin_mux_init(void)
   return 0;
 }
 
+/* Leave to the MAC the checksums it offloads, clearing from the netif the
+ * NETIF_CHECKSUM_GEN_* / CHECK_* flags the driver reports as offloaded.
+ * The project's lwipopts.h must provide:
+ *
+ *   #define LWIP_CHECKSUM_CTRL_PER_NETIF  1
+ *
+ * and keep CHECKSUM_GEN_IP/UDP/TCP/ICMP and CHECKSUM_CHECK_IP/UDP/TCP/ICMP
+ * at their default of 1, so the software paths stay for what the MAC does
+ * not cover. Without LWIP_CHECKSUM_CTRL_PER_NETIF this is a no-op and lwIP
+ * computes every checksum itself. ethernetif must configure the MAC with
+ * ARM_ETH_MAC_CHECKSUM_OFFLOAD_RX / _TX for the reported capabilities,
+ * otherwise transmitted frames leave with empty checksums.
+ */
+static void net_checksum_ctrl (struct netif *netif)
+{
+#if LWIP_CHECKSUM_CTRL_PER_NETIF
+  ARM_ETH_MAC_CAPABILITIES cap = Driver_ETH_MAC0.GetCapabilities ();
+  uint16_t flags = NETIF_CHECKSUM_ENABLE_ALL;
+
+  if (cap.checksum_offload_tx_ip4)
+    flags &= ~NETIF_CHECKSUM_GEN_IP;
+  if (cap.checksum_offload_tx_udp)
+    flags &= ~NETIF_CHECKSUM_GEN_UDP;
+  if (cap.checksum_offload_tx_tcp)
+    flags &= ~NETIF_CHECKSUM_GEN_TCP;
+  if (cap.checksum_offload_tx_icmp)
+    flags &= ~NETIF_CHECKSUM_GEN_ICMP;
+
+  if (cap.checksum_offload_rx_ip4)
+    flags &= ~NETIF_CHECKSUM_CHECK_IP;
+  if (cap.checksum_offload_rx_udp)
+    flags &= ~NETIF_CHECKSUM_CHECK_UDP;
+  if (cap.checksum_offload_rx_tcp)
+    flags &= ~NETIF_CHECKSUM_CHECK_TCP;
+  if (cap.checksum_offload_rx_icmp)
+    flags &= ~NETIF_CHECKSUM_CHECK_ICMP;
+
+  NETIF_SET_CHECKSUM_CTRL (netif, flags);
+#else
+  (void)netif;
+#endif
+}
+
 /* Initialize lwIP */
 static void net_init (void)
 {
@@ -133,6 +180,8 @@ static void net_init (void)
   /* Add the network interface to the netif_list. */
   netif_add(&netif, &ipaddr, &netmask, &gw, NULL, &ethernetif_init, &ethernet_input);
 
+  net_checksum_ctrl (&netif);
+
   /* Register the default network interface. */
   netif_set_default(&netif);
   netif_set_up(&netif);
@@ -0,0 +1,245 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+# Use, distribution and modification of this code is permitted under the
+# terms stated in the Alif Semiconductor Software License Agreement
+#
+# You should have received a copy of the Alif Semiconductor Software
+# License Agreement with this file. If not, please write to:
+# contact@alifsemi.com, or visit: https://alifsemi.com/license
+#
+
+"""Add a hashed file index and ETags to an lwIP httpd fsdata.c.
+
+Post-processes the fsdata.c written by lwIP's makefsdata (with HTTP headers
+included, the default). Every static file answered with 200 gets an
+"ETag" line in its prebuilt header, the ETag being derived from the file
+contents, and a prebuilt "304 Not Modified" response. Files handled as
+SSI (by extension or FS_FILE_FLAGS_SSI) are dynamic and get neither.
+
+A perfect hash of the file names is appended as fs_index[]: fs_open() in
+fs.c finds a file with one FNV-1a hash and one strcmp() instead of walking
+FS_ROOT, and httpd.c answers a matching If-None-Match with the prebuilt
+304 response. Run it again after every makefsdata run; the file is
+rewritten in place unless -o is given.
+
+With --http11, the prebuilt headers of files with a Content-Length
+(FS_FILE_FLAGS_HEADER_PERSISTENT) are changed to "HTTP/1.1" so that
+HTTP/1.1 clients keep the connection open and may pipeline requests.
+
+Example:
+    makefsdata fs -f:fsdata.c && makefsindex.py --http11 fsdata.c
+"""
+
+import argparse
+import re
+import sys
+
+FNV_PRIME = 16777619
+FNV_OFFSET = 0x811C9DC5
+SEED_TRIES = 100000
+
+SSI_EXTENSIONS = (".shtml", ".shtm", ".ssi", ".xml", ".json")   # g_pcSSIExtensions in httpd_structs.h
+
+INDEX_START = "/* File index generated by makefsindex.py */"
+INDEX_END = "/* End of file index */"
+
+ARRAY_RE = re.compile(r"static const unsigned char FSDATA_ALIGN_PRE (data_\w+)\[\] FSDATA_ALIGN_POST = \{(.*?)\};",
+                      re.S)
+FILE_RE = re.compile(r"const struct fsdata_file (file_\w+)\[\] = \{ \{\s*(\w+),\s*(data_\w+),\s*"
+                     r"data_\w+ \+ (\d+),\s*sizeof\(data_\w+\) - \d+,\s*([^,}]*?),?\s*\}\};", re.S)
+COMMENT_RE = re.compile(r"/\*.*?\*/", re.S)
+HEX_RE = re.compile(r"0x([0-9a-fA-F]{2})")
+ETAG_CHUNK_RE = re.compile(r"/\* \"ETag: [^\n]*\n\" \(\d+ bytes\) \*/\n(?:(?:0x[0-9a-f]{2},)+\n)+", re.S)
+STATUS_10_CHUNK_RE = re.compile(r"/\* \"HTTP/1\.0 ([^\n]*)\n\" \((\d+) bytes\) \*/\n(?:(?:0x[0-9a-f]{2},)+\n)+")
+
+
+def fnv1a(data, seed=FNV_OFFSET):
+    value = seed
+    for byte in data:
+        value = ((value ^ byte) * FNV_PRIME) & 0xFFFFFFFF
+    return value
+
+
+def hex_lines(data):
+    """Format bytes the way makefsdata does, 16 per line."""
+    return "".join("".join("0x%02x," % b for b in data[i:i + 16]) + "\n" for i in range(0, len(data), 16))
+
+
+def parse(text):
+    arrays = {}
+    for match in ARRAY_RE.finditer(text):
+        body = COMMENT_RE.sub("", match.group(2))
+        arrays[match.group(1)] = bytes(int(h, 16) for h in HEX_RE.findall(body))
+
+    files = []
+    for match in FILE_RE.finditer(text):
+        symbol, _, array, offset, flags = match.groups()
+        data = arrays[array]
+        offset = int(offset)
+        name = data[:offset].split(b"\0", 1)[0].decode("ascii")
+        files.append({"symbol": symbol, "array": array, "name": name,
+                      "content": data[offset:], "flags": flags})
+    if not files:
+        raise ValueError("no struct fsdata_file found, not a makefsdata output?")
+    return files
+
+
+def split_header(content):
+    end = content.find(b"\r\n\r\n")
+    if end < 0:
+        return None, content
+    return content[:end + 2], content[end + 4:]
+
+
+def perfect_hash(names):
+    size = 1
+    while size < 2 * len(names):
+        size *= 2
+    while True:
+        for tries in range(SEED_TRIES):
+            seed = (FNV_OFFSET + tries) & 0xFFFFFFFF
+            slots = {}
+            for name in names:
+                slot = fnv1a(name.encode("ascii"), seed) & (size - 1)
+                if slot in slots:
+                    break
+                slots[slot] = name
+            else:
+                return size, seed, slots
+        size *= 2
+
+
+def c_string(data):
+    out = '"'
+    for pos, byte in enumerate(data):
+        char = chr(byte)
+        if char == "\r":
+            out += "\\r"
+        elif char == "\n":
+            out += "\\n" if pos == len(data) - 1 else "\\n\"\n  \""
+        elif char in '"\\':
+            out += "\\" + char
+        else:
+            out += char
+    return out + '"'
+
+
+def use_http11(text, files):
+    """Answer persistent files with an HTTP/1.1 status line."""
+    for entry in files:
+        if "FS_FILE_FLAGS_HEADER_PERSISTENT" not in entry["flags"] or not entry["content"].startswith(b"HTTP/1.0 "):
+            continue
+        array_start = text.index("%s[] FSDATA_ALIGN_POST = {" % entry["array"])
+        match = STATUS_10_CHUNK_RE.search(text, array_start, text.index("};", array_start))
+        if match is None:
+            continue
+        line = ("HTTP/1.1 %s\r\n" % match.group(1)).encode("ascii")
+        chunk = '/* "HTTP/1.1 %s\n" (%d bytes) */\n%s' % (match.group(1), len(line), hex_lines(line))
+        text = text[:match.start()] + chunk + text[match.end():]
+
+        if "FS_FILE_FLAGS_HEADER_HTTPVER_1_1" not in entry["flags"]:
+            struct_start = text.index("const struct fsdata_file %s[] = {" % entry["symbol"])
+            flags_start = text.index(entry["flags"], struct_start)
+            flags_end = flags_start + len(entry["flags"])
+            text = text[:flags_end] + " | FS_FILE_FLAGS_HEADER_HTTPVER_1_1" + text[flags_end:]
+    return text
+
+
+def process(text, http11=False):
+    text = ETAG_CHUNK_RE.sub("", text)
+    start = text.find(INDEX_START)
+    if start >= 0:
+        end = text.index(INDEX_END) + len(INDEX_END)
+        text = (text[:start].rstrip("\n") + "\n" + text[end:].lstrip("\n"))
+
+    files = parse(text)
+    if http11:
+        text = use_http11(text, files)
+        files = parse(text)
+    report = []
+
+    for entry in files:
+        entry["etag"] = None
+        header, body = split_header(entry["content"])
+        if header is None or "FS_FILE_FLAGS_HEADER_INCLUDED" not in entry["flags"]:
+            continue
+        status = header.split(b"\r\n", 1)[0].split(b" ")
+        if len(status) < 2 or status[1] != b"200":
+            continue
+        if entry["name"].lower().endswith(SSI_EXTENSIONS) or "FS_FILE_FLAGS_SSI" in entry["flags"]:
+            continue
+
+        etag = '"%08x"' % fnv1a(body)
+        line = ("ETag: %s\r\n" % etag).encode("ascii")
+        chunk = '/* "ETag: %s\n" (%d bytes) */\n%s' % (etag, len(line), hex_lines(line))
+
+        # The ETag goes before the Content-Type line, the last one of the header
+        array_start = text.index("%s[] FSDATA_ALIGN_POST = {" % entry["array"])
+        array_end = text.index("};", array_start)
+        insert = text.find('/* "Content-Type:', array_start, array_end)
+        if insert < 0:
+            continue
+        text = text[:insert] + chunk + text[insert:]
+
+        not_modified = status[0] + b" 304 Not Modified\r\n"
+        for field in header.split(b"\r\n")[1:]:
+            if field.startswith((b"Server:", b"Connection:")):
+                not_modified += field + b"\r\n"
+        not_modified += line + b"\r\n"
+
+        entry["etag"] = etag
+        entry["not_modified"] = not_modified
+        report.append("%-40s %s" % (entry["name"], etag))
+
+    size, seed, slots = perfect_hash([entry["name"] for entry in files])
+    by_name = {entry["name"]: entry for entry in files}
+
+    index = [INDEX_START, "#define FS_INDEX_SIZE %d" % size, "#define FS_INDEX_SEED 0x%08xUL" % seed, ""]
+    for entry in files:
+        if entry["etag"]:
+            index.append("static const char not_modified_%s[] =\n  %s;\n" %
+                         (entry["symbol"][len("file_"):], c_string(entry["not_modified"])))
+    index.append("static const struct fsdata_index fs_index[FS_INDEX_SIZE] = {")
+    for slot in range(size):
+        entry = by_name.get(slots.get(slot))
+        if entry is None:
+            index.append("/* %2d */ {NULL, NULL, NULL, 0}," % slot)
+        elif entry["etag"]:
+            symbol = "not_modified_" + entry["symbol"][len("file_"):]
+            index.append("/* %2d */ {%s, \"%s\", %s, sizeof(%s) - 1}," %
+                         (slot, entry["symbol"], entry["etag"].replace('"', '\\"'), symbol, symbol))
+        else:
+            index.append("/* %2d */ {%s, NULL, NULL, 0}," % (slot, entry["symbol"]))
+    index += ["};", INDEX_END, ""]
+
+    text = text.rstrip("\n") + "\n\n" + "\n".join(index)
+    report.append("index: %d files in %d slots, seed 0x%08x" % (len(files), size, seed))
+    return text, report
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("fsdata", help="fsdata.c written by makefsdata")
+    parser.add_argument("-o", "--output", help="output file (default: rewrite the input)")
+    parser.add_argument("--http11", action="store_true",
+                        help="send files with a Content-Length as HTTP/1.1 (persistent connections)")
+    args = parser.parse_args()
+
+    try:
+        with open(args.fsdata, encoding="ascii") as fin:
+            text = fin.read()
+        text, report = process(text, args.http11)
+    except (OSError, ValueError, UnicodeDecodeError) as err:
+        print("error: %s" % err, file=sys.stderr)
+        return 2
+
+    with open(args.output or args.fsdata, "w", encoding="ascii", newline="\n") as fout:
+        fout.write(text)
+    for line in report:
+        print(line)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
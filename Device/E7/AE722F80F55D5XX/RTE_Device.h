@@ -18,6 +18,10 @@
 #define RTE_MRAM          1
 #if RTE_MRAM
 #define RTE_MRAM_SIZE     0x00580000
+// <q> Skip unchanged lines
+// <i> Compare every 128-bit line with the MRAM content before programming it and skip identical lines.
+// <i> Can be changed at run time with ARM_MRAM_WRITE_SKIP.
+#define RTE_MRAM_WRITE_SKIP 0
 #endif
 // </e> MRAM (NVM (Non-Volatile Memory)) [Driver_MRAM]
 
@@ -1928,6 +1932,28 @@
 // <i> Defines the OSPI Bus speed
 // <i> Default: 100000000
 #define RTE_ISSI_FLASH_OSPI_BUS_SPEED           100000000
+
+// <o> ISSI FLASH program/erase queue depth
+// <i> Defines the number of program/erase operations queued when Initialize registers a callback
+// <i> Default: 8
+#define RTE_ISSI_FLASH_QUEUE_DEPTH              8
+
+// <e> ISSI FLASH LPTIMER poll
+// <i> Poll the flag status from an LPTIMER channel while a program/erase is in progress,
+// <i> otherwise it is read back to back from the OSPI interrupt
+#define RTE_ISSI_FLASH_POLL_LPTIMER             0
+#if RTE_ISSI_FLASH_POLL_LPTIMER
+// <o> LPTIMER channel <0-3>
+// <i> Defines the LPTIMER channel used for the poll
+// <i> Default: 3
+#define RTE_ISSI_FLASH_LPTIMER_CHANNEL          3
+
+// <o> Poll interval
+// <i> Defines the poll interval in LPTIMER counts (30.5us each at 32.768KHz)
+// <i> Default: 8
+#define RTE_ISSI_FLASH_POLL_TICKS               8
+#endif
+// </e> ISSI FLASH LPTIMER poll
 #endif
 // </e> FLASH (ISSI FLASH) [Driver_Flash]
 
@@ -9023,6 +9049,32 @@
 // <i> Default: ADMA2
 #define RTE_SDC_DMA_SELECT 1
 
+//    <o> SDC interrupt priority <0-255>
+// <i> Defines SDC0 interrupt priority used by the queued block requests
+// <i> Default: 0
+#define RTE_SDC_IRQ_PRI 0
+
+//    <o> SDC BUS SPEED SELECT
+//    <0=> DEFAULT_SPEED
+//    <1=> HIGH_SPEED
+//    <2=> UHS_SDR50
+//    <3=> UHS_SDR104
+//    <4=> UHS_DDR50
+// <i> Defines SDC0 fastest bus speed negotiated with the card, slower modes are tried when switching or tuning fails
+// <i> UHS-I modes need 1.8v signaling and the 4 bit bus
+// <i> Default: DEFAULT_SPEED
+#define RTE_SDC_BUS_SPEED 0
+
+//    <o> SDC sector cache size <1-256>
+// <i> Defines the number of 512 byte sectors held by the optional sector cache, component ::Device:SOC Peripherals:SDMMC Cache
+// <i> Default: 32
+#define RTE_SDC_CACHE_SECTORS 32
+
+//    <o> SDC sector cache read-ahead <0-32>
+// <i> Defines the number of sectors prefetched once sequential reads are detected
+// <i> Default: 8
+#define RTE_SDC_CACHE_READ_AHEAD 8
+
 #endif
 // </e> SDC0 (Secure Digital Controller 0) [Driver_SDC0]
 // </h> SDC (Secure Digital Controller)
@@ -9039,6 +9091,30 @@
 // <i> Default: 0
 #define RTE_ETH_MAC_IRQ_PRIORITY                    0
 
+// <o> Rx DMA descriptors <4-1024>
+// <i> Defines the size of the receive descriptor ring
+// <i> Default: 8
+#define RTE_ETH_MAC_RX_DESC_COUNT                   8
+
+// <o> Tx DMA descriptors <4-1024>
+// <i> Defines the size of the transmit descriptor ring, one descriptor is
+// <i> used per frame fragment.
+// <i> Default: 8
+#define RTE_ETH_MAC_TX_DESC_COUNT                   8
+
+// <o> Rx frames per interrupt <1-1024>
+// <i> Defines after how many received frames an interrupt is raised. Values
+// <i> above 1 need the Rx interrupt watchdog and must not exceed the Rx DMA
+// <i> descriptors.
+// <i> Default: 1
+#define RTE_ETH_MAC_RX_IRQ_FRAMES                   1
+
+// <o> Rx interrupt watchdog <0-255>
+// <i> Defines the delay, in units of 256 system clock cycles, after which an
+// <i> interrupt is raised for frames received without one. 0 disables it.
+// <i> Default: 0
+#define RTE_ETH_MAC_RX_IRQ_WATCHDOG                 0
+
 #endif
 // </e> ETH (Ethernet MAC) [Driver_ETH_MAC0]
 // </h> ETH (Ethernet MAC)
@@ -20,6 +20,8 @@
 #ifndef __IS25WX256_H__
 #define __IS25WX256_H__
 
+#include <stdint.h>
+
 #ifdef  __cplusplus
 extern "C"
 {
@@ -30,6 +32,11 @@ extern "C"
 #define FLASH_ISSI_PAGE_SIZE                          ((uint32_t)256)     /* Programming page size in bytes */
 #define FLASH_ISSI_PROGRAM_UNIT                       ((uint32_t)2)       /* Smallest programmable unit in bytes */
 #define FLASH_ISSI_ERASED_VALUE                       ((uint8_t)0xFF)     /* Contents of erased memory */
+#define FLASH_ISSI_BLOCK_32K_SIZE                     ((uint32_t)0x8000)  /* 32kB block erase */
+#define FLASH_ISSI_BLOCK_128K_SIZE                    ((uint32_t)0x20000) /* 128kB block erase */
+
+/* Erase the sectors covering [addr, addr + size), with block erases where the range allows */
+int32_t ISSI_Flash_EraseRange (uint32_t addr, uint32_t size);
 
 #ifdef __cplusplus
 }
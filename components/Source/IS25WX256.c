@@ -26,6 +26,26 @@
 #include "IS25WX256.h"
 #include CMSIS_device_header
 
+#ifndef RTE_ISSI_FLASH_POLL_LPTIMER
+#define RTE_ISSI_FLASH_POLL_LPTIMER                              0
+#endif
+
+#ifndef RTE_ISSI_FLASH_QUEUE_DEPTH
+#define RTE_ISSI_FLASH_QUEUE_DEPTH                               8
+#endif
+
+#if RTE_ISSI_FLASH_POLL_LPTIMER
+#include "Driver_LPTIMER.h"
+
+#ifndef RTE_ISSI_FLASH_LPTIMER_CHANNEL
+#define RTE_ISSI_FLASH_LPTIMER_CHANNEL                           3
+#endif
+
+#ifndef RTE_ISSI_FLASH_POLL_TICKS
+#define RTE_ISSI_FLASH_POLL_TICKS                                8
+#endif
+#endif
+
 #if !(RTE_ISSI_FLASH)
 #error "ISSI Flash driver is not enabled in RTE_Device.h"
 #endif
@@ -34,6 +54,10 @@
 #error "ISSI Flash driver is not enabled in RTE_Components.h"
 #endif
 
+#if (RTE_ISSI_FLASH_POLL_LPTIMER) && !defined(RTE_Drivers_LPTIMER)
+#error "LPTIMER driver is not enabled in RTE_Components.h, needed by the ISSI Flash poll"
+#endif
+
 #define ARM_FLASH_DRV_VERSION ARM_DRIVER_VERSION_MAJOR_MINOR(1,0) /* driver version */
 
 
@@ -57,6 +81,8 @@
 #define CMD_PAGE_PROGRAM                                        (0x84U)
 #define CMD_READ_FLAG_STATUS                                    (0x70U)
 #define CMD_SECTOR_ERASE                                        (0x21U)
+#define CMD_BLOCK_ERASE_32K                                     (0x5CU)
+#define CMD_BLOCK_ERASE_128K                                    (0xDCU)
 #define CMD_BULK_ERASE                                          (0xC7U)
 
 #define IO_MODE_ADDRESS                                         0x00000000U
@@ -71,15 +97,29 @@
 /* Flash Driver ISSI_Flags */
 #define FLASH_INIT                                              (0x01U)
 #define FLASH_POWER                                             (0x02U)
+#define FLASH_READ_SETUP                                        (0x04U)
 
 
 /* SPI Driver */
 extern ARM_DRIVER_OSPI ARM_Driver_OSPI_(DRIVER_OSPI_NUM);
 static ARM_DRIVER_OSPI * ptrOSPI = &ARM_Driver_OSPI_(DRIVER_OSPI_NUM);
 
+#if RTE_ISSI_FLASH_POLL_LPTIMER
+/* LPTIMER pacing the flag status poll */
+extern ARM_DRIVER_LPTIMER DRIVER_LPTIMER0;
+static ARM_DRIVER_LPTIMER * ptrLPTIMER = &DRIVER_LPTIMER0;
+#endif
+
 /* SPI Bus Speed */
 #define OSPI_BUS_SPEED                                           ((uint32_t)DRIVER_OSPI_BUS_SPEED)
+
+/* Max frames per read transfer: the RX FIFO depth for interrupt driven
+ * transfers, the 16 bit frame counter (CTRLR1.NDF) when OSPI DMA is used */
+#if (((DRIVER_OSPI_NUM == 0) && RTE_OSPI0_DMA_ENABLE) || ((DRIVER_OSPI_NUM == 1) && RTE_OSPI1_DMA_ENABLE))
+#define OSPI_MAX_RX_COUNT                                        65536
+#else
 #define OSPI_MAX_RX_COUNT                                        256
+#endif
 
 /* Flash Information */
 ARM_FLASH_INFO ISSI_FlashInfo = {
@@ -103,6 +143,48 @@ static uint8_t ISSI_Flags;
 /* Flag to monitor OSPI events */
 static volatile uint32_t issi_event_flag;
 
+/* Program/erase engine state */
+typedef enum _ISSI_STATE {
+    ISSI_STATE_IDLE,                    /* No job queued                        */
+    ISSI_STATE_WRITE_ENABLE,            /* Write enable sent                    */
+    ISSI_STATE_CHECK_WEL,               /* Status register read for WEL         */
+    ISSI_STATE_COMMAND,                 /* Page program/erase command sent      */
+    ISSI_STATE_POLL_WAIT,               /* Waiting for the next poll tick       */
+    ISSI_STATE_POLL                     /* Flag status register read            */
+} ISSI_STATE;
+
+/* Program/erase job types */
+#define ISSI_JOB_PROGRAM                                        (0x00U)
+#define ISSI_JOB_ERASE                                          (0x01U)
+#define ISSI_JOB_ERASE_CHIP                                     (0x02U)
+
+/* Queued program/erase job, advanced one page or erase block per step */
+typedef struct _ISSI_JOB {
+    uint32_t                type;       /* ISSI_JOB_xxx                         */
+    uint32_t                addr;       /* Byte address of the next step        */
+    uint32_t                end;        /* End of the range to erase            */
+    const uint16_t          *data;      /* Data left to program                 */
+    uint32_t                cnt;        /* 16 bit items left to program         */
+    uint32_t                step;       /* Items/bytes of the step in progress  */
+} ISSI_JOB;
+
+static ISSI_JOB                 issi_queue[RTE_ISSI_FLASH_QUEUE_DEPTH];
+static volatile uint32_t        issi_q_head;
+static volatile uint32_t        issi_q_count;
+static volatile ISSI_STATE      issi_state;
+static volatile int32_t         issi_result;
+static ARM_Flash_SignalEvent_t  issi_cb_event;
+
+/* Command/status frames of the job in progress */
+static uint32_t issi_cmd[3];
+
+static void JobEvent (uint32_t event);
+static void JobComplete (int32_t result);
+static void JobAbort (void);
+#if RTE_ISSI_FLASH_POLL_LPTIMER
+static void lptimer_callback_event (uint8_t event);
+#endif
+
 /* Driver Version */
 const ARM_DRIVER_VERSION DriverVersion = {
     ARM_FLASH_API_VERSION,
@@ -111,7 +193,7 @@ const ARM_DRIVER_VERSION DriverVersion = {
 
 /* Driver Capabilities */
 const ARM_FLASH_CAPABILITIES DriverCapabilities = {
-    0U,                                 /* event_ready */
+    1U,                                 /* event_ready */
     1U,                                 /* data_width = 0:8-bit, 1:16-bit, 2:32-bit */
     1U,                                 /* erase_chip */
 #if (ARM_FLASH_API_VERSION > 0x200U)
@@ -126,6 +208,12 @@ const ARM_FLASH_CAPABILITIES DriverCapabilities = {
 **/
 static void spi_callback_event(uint32_t event)
 {
+    if (issi_state != ISSI_STATE_IDLE)
+    {
+        JobEvent(event);
+        return;
+    }
+
     issi_event_flag = event;
 }
 
@@ -187,6 +275,9 @@ static int32_t ReadStatusReg (uint8_t command, uint8_t *stat)
     int32_t status = ARM_DRIVER_OK;
     uint32_t cmd[3];
 
+    /* Bus is reconfigured, ReadData has to set it up again */
+    ISSI_Flags &= ~FLASH_READ_SETUP;
+
     status = ptrOSPI->Control(ARM_OSPI_MODE_MASTER |
                     ARM_OSPI_DATA_BITS(8) |
                     ARM_OSPI_SS_MASTER_SW,
@@ -252,6 +343,9 @@ static int32_t SetWriteEnable (void)
     uint32_t cmd;
     uint8_t val;
 
+    /* Bus is reconfigured, ReadData has to set it up again */
+    ISSI_Flags &= ~FLASH_READ_SETUP;
+
     status = ptrOSPI->Control(ARM_OSPI_MODE_MASTER |
              ARM_OSPI_DATA_BITS(8) |
              ARM_OSPI_SS_MASTER_SW,
@@ -317,7 +411,12 @@ static int32_t SetWriteEnable (void)
  static int32_t ARM_Flash_Initialize (ARM_Flash_SignalEvent_t cb_event)
  {
     int32_t status;
-    (void)cb_event;
+#if RTE_ISSI_FLASH_POLL_LPTIMER
+    uint32_t count = RTE_ISSI_FLASH_POLL_TICKS;
+#endif
+
+    /* With a callback, program/erase return once queued and signal ARM_FLASH_EVENT_READY */
+    issi_cb_event = cb_event;
 
     ISSI_FlashStatus.busy  = 0U;
     ISSI_FlashStatus.error = 0U;
@@ -329,6 +428,29 @@ static int32_t SetWriteEnable (void)
         return ARM_DRIVER_ERROR;
     }
 
+#if RTE_ISSI_FLASH_POLL_LPTIMER
+    status = ptrLPTIMER->Initialize(RTE_ISSI_FLASH_LPTIMER_CHANNEL, lptimer_callback_event);
+
+    if (status != ARM_DRIVER_OK)
+    {
+        return ARM_DRIVER_ERROR;
+    }
+
+    status = ptrLPTIMER->PowerControl(RTE_ISSI_FLASH_LPTIMER_CHANNEL, ARM_POWER_FULL);
+
+    if (status != ARM_DRIVER_OK)
+    {
+        return ARM_DRIVER_ERROR;
+    }
+
+    status = ptrLPTIMER->Control(RTE_ISSI_FLASH_LPTIMER_CHANNEL, ARM_LPTIMER_SET_COUNT1, &count);
+
+    if (status != ARM_DRIVER_OK)
+    {
+        return ARM_DRIVER_ERROR;
+    }
+#endif
+
     ISSI_Flags |= FLASH_INIT;
 
     return ARM_DRIVER_OK;
@@ -341,7 +463,15 @@ static int32_t SetWriteEnable (void)
 **/
 static int32_t ARM_Flash_Uninitialize (void)
 {
+    JobAbort();
+
+#if RTE_ISSI_FLASH_POLL_LPTIMER
+    ptrLPTIMER->PowerControl(RTE_ISSI_FLASH_LPTIMER_CHANNEL, ARM_POWER_OFF);
+    ptrLPTIMER->Uninitialize(RTE_ISSI_FLASH_LPTIMER_CHANNEL);
+#endif
+
     ISSI_Flags = 0U;
+    issi_cb_event = NULL;
     return ptrOSPI->Uninitialize();
 }
 
@@ -361,7 +491,9 @@ static int32_t ARM_Flash_PowerControl (ARM_POWER_STATE state)
     {
         case ARM_POWER_OFF:
         {
-            ISSI_Flags &= ~FLASH_POWER;
+            JobAbort();
+
+            ISSI_Flags &= ~(FLASH_POWER | FLASH_READ_SETUP);
             ISSI_FlashStatus.busy  = 0U;
             ISSI_FlashStatus.error = 0U;
 
@@ -579,7 +711,9 @@ static int32_t ARM_Flash_PowerControl (ARM_POWER_STATE state)
 
 /**
   \fn          int32_t ARM_Flash_ReadData (uint32_t addr, void *data, uint32_t cnt)
-  \brief       Read data from Flash.
+  \brief       Read data from Flash. The bus is set up for reading once and
+               kept until a status read, program or erase changes it, so
+               back to back reads only issue the read command.
   \param[in]   addr  Data address.
   \param[out]  data  Pointer to a buffer storing the data read from Flash.
   \param[in]   cnt   Number of data items to read.
@@ -596,38 +730,35 @@ static int32_t ARM_Flash_ReadData (uint32_t addr, void *data, uint32_t cnt)
         return ARM_DRIVER_ERROR_PARAMETER;
     }
 
-    data_ptr = (uint16_t *) data;
-
-    status = ptrOSPI->Control(ARM_OSPI_SET_ADDR_LENGTH_WAIT_CYCLE, (ARM_OSPI_ADDR_LENGTH_0_BITS << ARM_OSPI_ADDR_LENGTH_POS) | (0 << ARM_OSPI_WAIT_CYCLE_POS));
-
-    if (status != ARM_DRIVER_OK)
+    /* Bus is owned by the program/erase engine until the queue drains */
+    if (issi_state != ISSI_STATE_IDLE)
     {
-        return ARM_DRIVER_ERROR;
+        return ARM_DRIVER_ERROR_BUSY;
     }
 
-    status = SetWriteEnable();
+    data_ptr = (uint16_t *) data;
 
-    if (status != ARM_DRIVER_OK)
+    if ((ISSI_Flags & FLASH_READ_SETUP) == 0U)
     {
-        return ARM_DRIVER_ERROR;
-    }
+        status = ptrOSPI->Control(ARM_OSPI_SET_ADDR_LENGTH_WAIT_CYCLE, (ARM_OSPI_ADDR_LENGTH_32_BITS << ARM_OSPI_ADDR_LENGTH_POS) | (16 << ARM_OSPI_WAIT_CYCLE_POS));
 
-    status = ptrOSPI->Control(ARM_OSPI_SET_ADDR_LENGTH_WAIT_CYCLE, (ARM_OSPI_ADDR_LENGTH_32_BITS << ARM_OSPI_ADDR_LENGTH_POS) | (16 << ARM_OSPI_WAIT_CYCLE_POS));
+        if (status != ARM_DRIVER_OK)
+        {
+            return ARM_DRIVER_ERROR;
+        }
 
-    if (status != ARM_DRIVER_OK)
-    {
-        return ARM_DRIVER_ERROR;
-    }
+        /* Switch to 16 bit mode for reading data */
+        status = ptrOSPI->Control(ARM_OSPI_MODE_MASTER |
+                    ARM_OSPI_DATA_BITS(16) |
+                    ARM_OSPI_SS_MASTER_SW,
+                    OSPI_BUS_SPEED);
 
-    /* Switch to 16 bit mode for reading data */
-    status = ptrOSPI->Control(ARM_OSPI_MODE_MASTER |
-                ARM_OSPI_DATA_BITS(16) |
-                ARM_OSPI_SS_MASTER_SW,
-                OSPI_BUS_SPEED);
+        if (status != ARM_DRIVER_OK)
+        {
+            return ARM_DRIVER_ERROR;
+        }
 
-    if (status != ARM_DRIVER_OK)
-    {
-        return ARM_DRIVER_ERROR;
+        ISSI_Flags |= FLASH_READ_SETUP;
     }
 
     while(cnt)
@@ -639,7 +770,8 @@ static int32_t ARM_Flash_ReadData (uint32_t addr, void *data, uint32_t cnt)
             return ARM_DRIVER_ERROR;
         }
 
-        /* At frequency > 2.5 MHz, max no. of frames that can be read by OSPI is 256 (RX_FIFO_DEPTH) */
+        /* At frequency > 2.5 MHz, max no. of frames that can be read by OSPI is 256 (RX_FIFO_DEPTH),
+         * with DMA the whole request is streamed in transfers of up to 64K frames */
         data_cnt = OSPI_MAX_RX_COUNT;
 
         if (data_cnt > cnt)
@@ -690,418 +822,645 @@ static int32_t ARM_Flash_ReadData (uint32_t addr, void *data, uint32_t cnt)
     return status;
 }
 
-/* temporary buffer used in ProgramData below */
-static uint32_t cmd[261];
-
 /**
-  \fn          int32_t ARM_Flash_ProgramData (uint32_t addr, const void *data, uint32_t cnt)
-  \brief       Program data to Flash.
-  \param[in]   addr  Data address.
-  \param[in]   data  Pointer to a buffer containing the data to be programmed to Flash.
-  \param[in]   cnt   Number of data items to program.
-  \return      number of data items programmed or \ref execution_status
+  \fn          uint32_t EraseBlockSize (uint32_t addr, uint32_t end, uint32_t *command)
+  \brief       Pick the largest erase the range allows at addr.
+  \param[in]   addr     Start address, sector aligned
+  \param[in]   end      End of the range to erase
+  \param[out]  command  Erase command to send
+  \return      Number of bytes erased by the command
 **/
-static int32_t ARM_Flash_ProgramData (uint32_t addr, const void *data, uint32_t cnt)
+static uint32_t EraseBlockSize (uint32_t addr, uint32_t end, uint32_t *command)
 {
-    const uint16_t *data_ptr;
-    uint8_t val = 0;
-    int32_t status = ARM_DRIVER_OK;
-    uint32_t num = 0, data_cnt, index, iter = 0, it = 0;
+    if (((addr & (FLASH_ISSI_BLOCK_128K_SIZE - 1U)) == 0U) && ((end - addr) >= FLASH_ISSI_BLOCK_128K_SIZE))
+    {
+        *command = CMD_BLOCK_ERASE_128K;
+        return FLASH_ISSI_BLOCK_128K_SIZE;
+    }
 
-    if ((addr > (FLASH_ISSI_SECTOR_COUNT * FLASH_ISSI_SECTOR_SIZE)) || (data == NULL) || ((addr + cnt) > (FLASH_ISSI_SECTOR_COUNT * FLASH_ISSI_SECTOR_SIZE)))
+    if (((addr & (FLASH_ISSI_BLOCK_32K_SIZE - 1U)) == 0U) && ((end - addr) >= FLASH_ISSI_BLOCK_32K_SIZE))
     {
-        return ARM_DRIVER_ERROR_PARAMETER;
+        *command = CMD_BLOCK_ERASE_32K;
+        return FLASH_ISSI_BLOCK_32K_SIZE;
     }
 
-    data_ptr = data;
+    *command = CMD_SECTOR_ERASE;
+    return FLASH_ISSI_SECTOR_SIZE;
+}
+
+/**
+  \fn          int32_t JobStartWriteEnable (void)
+  \brief       Start the write enable ahead of the next program/erase command.
+  \return      \ref execution_status
+**/
+static int32_t JobStartWriteEnable (void)
+{
+    int32_t status;
+
+    /* Bus is reconfigured, ReadData has to set it up again */
+    ISSI_Flags &= ~FLASH_READ_SETUP;
+
+    issi_state = ISSI_STATE_WRITE_ENABLE;
+
+    status = ptrOSPI->Control(ARM_OSPI_MODE_MASTER |
+                ARM_OSPI_DATA_BITS(8) |
+                ARM_OSPI_SS_MASTER_SW,
+                OSPI_BUS_SPEED);
 
-    while (cnt)
+    if (status != ARM_DRIVER_OK)
     {
-        ISSI_FlashStatus.busy  = 1U;
-        ISSI_FlashStatus.error = 0U;
+        return ARM_DRIVER_ERROR;
+    }
 
-        status = ptrOSPI->Control(ARM_OSPI_SET_ADDR_LENGTH_WAIT_CYCLE, (ARM_OSPI_ADDR_LENGTH_0_BITS << ARM_OSPI_ADDR_LENGTH_POS) | (0 << ARM_OSPI_WAIT_CYCLE_POS));
+    status = ptrOSPI->Control(ARM_OSPI_SET_ADDR_LENGTH_WAIT_CYCLE, (ARM_OSPI_ADDR_LENGTH_0_BITS << ARM_OSPI_ADDR_LENGTH_POS) | (0 << ARM_OSPI_WAIT_CYCLE_POS));
 
-        if (status != ARM_DRIVER_OK)
-        {
-            return ARM_DRIVER_ERROR;
-        }
+    if (status != ARM_DRIVER_OK)
+    {
+        return ARM_DRIVER_ERROR;
+    }
 
-        status = SetWriteEnable();
+    status = ControlSlaveSelect(true);
 
-        if (status != ARM_DRIVER_OK)
-        {
-            return ARM_DRIVER_ERROR;
-        }
+    if (status != ARM_DRIVER_OK)
+    {
+        return ARM_DRIVER_ERROR;
+    }
 
-        data_cnt = (FLASH_ISSI_PAGE_SIZE - (addr % FLASH_ISSI_PAGE_SIZE)) >> 1;
+    issi_cmd[0] = CMD_WRITE_ENABLE;
 
-        if (data_cnt > cnt)
-        {
-            data_cnt = cnt;
-        }
+    return ptrOSPI->Send(issi_cmd, 1U);
+}
 
+/**
+  \fn          int32_t JobStartStatusRead (uint8_t command)
+  \brief       Start reading the status or the flag status register.
+  \param[in]   command : Status register/ Flag Status Register
+  \return      \ref execution_status
+**/
+static int32_t JobStartStatusRead (uint8_t command)
+{
+    int32_t status;
 
-        /* Prepare command with address */
-        cmd[0] = CMD_PAGE_PROGRAM;
-        cmd[1] = addr;
+    status = ptrOSPI->Control(ARM_OSPI_MODE_MASTER |
+                ARM_OSPI_DATA_BITS(8) |
+                ARM_OSPI_SS_MASTER_SW,
+                OSPI_BUS_SPEED);
 
-        index = 2;
+    if (status != ARM_DRIVER_OK)
+    {
+        return ARM_DRIVER_ERROR;
+    }
 
-        for ( it = 0; it < data_cnt; it++)
-        {
-            cmd[index++] = data_ptr[iter++];
-        }
+    status = ptrOSPI->Control(ARM_OSPI_SET_ADDR_LENGTH_WAIT_CYCLE, (ARM_OSPI_ADDR_LENGTH_0_BITS << ARM_OSPI_ADDR_LENGTH_POS) | (8 << ARM_OSPI_WAIT_CYCLE_POS));
 
-        status = ptrOSPI->Control(ARM_OSPI_SET_ADDR_LENGTH_WAIT_CYCLE, (ARM_OSPI_ADDR_LENGTH_32_BITS << ARM_OSPI_ADDR_LENGTH_POS) | (0 << ARM_OSPI_WAIT_CYCLE_POS));
+    if (status != ARM_DRIVER_OK)
+    {
+        return ARM_DRIVER_ERROR;
+    }
 
-        if (status != ARM_DRIVER_OK)
-        {
-            return ARM_DRIVER_ERROR;
-        }
+    status = ControlSlaveSelect(true);
 
-        /* Switch to 16 bit mode for program data */
-        status = ptrOSPI->Control(ARM_OSPI_MODE_MASTER |
-                 ARM_OSPI_DATA_BITS(16) |
-                 ARM_OSPI_SS_MASTER_SW,
-                 OSPI_BUS_SPEED);
+    if (status != ARM_DRIVER_OK)
+    {
+        return ARM_DRIVER_ERROR;
+    }
 
-        if (status != ARM_DRIVER_OK)
-        {
-            return ARM_DRIVER_ERROR;
-        }
+    issi_cmd[0] = command;
+    issi_cmd[1] = 0U;
 
-        status = ControlSlaveSelect(true);
+    return ptrOSPI->Transfer(&issi_cmd[0], &issi_cmd[1], 2U);
+}
 
-        if (status != ARM_DRIVER_OK)
-        {
-            return ARM_DRIVER_ERROR;
-        }
+/**
+  \fn          int32_t JobStartCommand (ISSI_JOB *job)
+  \brief       Start the page program or erase command of the current job step.
+               Page data is sent straight from the caller's buffer behind the
+               command and address frames.
+  \param[in]   job : Job at the head of the queue
+  \return      \ref execution_status
+**/
+static int32_t JobStartCommand (ISSI_JOB *job)
+{
+    ARM_OSPI_TX_HEADER hdr;
+    uint32_t addr_len = ARM_OSPI_ADDR_LENGTH_32_BITS, data_bits = 8U;
+    int32_t status;
 
-        do {
-            /* Send data along with the command and address bytes (+2) */
-            status = ptrOSPI->Send(cmd, (data_cnt + 2));
-        } while (status == ARM_DRIVER_ERROR_BUSY);
+    if (job->type == ISSI_JOB_PROGRAM)
+    {
+        data_bits = 16U;
+    }
+    else if (job->type == ISSI_JOB_ERASE_CHIP)
+    {
+        addr_len = ARM_OSPI_ADDR_LENGTH_0_BITS;
+    }
 
-        if (status != ARM_DRIVER_OK)
-        {
-            return ARM_DRIVER_ERROR;
-        }
+    issi_state = ISSI_STATE_COMMAND;
 
-        while (!issi_event_flag)
-        {
-             __WFE();
-        }
+    status = ptrOSPI->Control(ARM_OSPI_SET_ADDR_LENGTH_WAIT_CYCLE, (addr_len << ARM_OSPI_ADDR_LENGTH_POS) | (0 << ARM_OSPI_WAIT_CYCLE_POS));
 
-        if (!(issi_event_flag & ARM_OSPI_EVENT_TRANSFER_COMPLETE))
-        {
-            ControlSlaveSelect(false);
-            issi_event_flag = 0;
-            return ARM_DRIVER_ERROR;
-        }
+    if (status != ARM_DRIVER_OK)
+    {
+        return ARM_DRIVER_ERROR;
+    }
 
-        issi_event_flag = 0;
+    status = ptrOSPI->Control(ARM_OSPI_MODE_MASTER |
+                ARM_OSPI_DATA_BITS(data_bits) |
+                ARM_OSPI_SS_MASTER_SW,
+                OSPI_BUS_SPEED);
 
-        /* For 16 bit data frames, increment the byte address with 2 * data_cnt programmed */
-        addr += (data_cnt * 2);
-        num  += data_cnt;
-        cnt  -= data_cnt;
+    if (status != ARM_DRIVER_OK)
+    {
+        return ARM_DRIVER_ERROR;
+    }
 
-        status = ControlSlaveSelect(false);
+    status = ControlSlaveSelect(true);
 
-        if (status != ARM_DRIVER_OK)
-        {
-            return ARM_DRIVER_ERROR;
-        }
+    if (status != ARM_DRIVER_OK)
+    {
+        return ARM_DRIVER_ERROR;
+    }
 
-        /* Read status until device ready */
-        do
+    switch (job->type)
+    {
+        case ISSI_JOB_PROGRAM:
         {
-            status = ReadStatusReg(CMD_READ_FLAG_STATUS, &val);
+            /* Up to the end of the page, in 16 bit frames */
+            job->step = (FLASH_ISSI_PAGE_SIZE - (job->addr % FLASH_ISSI_PAGE_SIZE)) >> 1;
 
-            if (status != ARM_DRIVER_OK)
+            if (job->step > job->cnt)
             {
-                break;
+                job->step = job->cnt;
             }
 
-            /* Check ISSI_Flags Status register value */
-            if ((val & FLAG_STATUS_BUSY) != 0U)
-            {
-                ISSI_FlashStatus.busy = 0U;
-            }
+            hdr.cmd  = CMD_PAGE_PROGRAM;
+            hdr.addr = job->addr;
 
-            /* Check Program and Erase bits */
-            if ((val & FLAG_STATUS_ERROR) == 0U)
-            {
-                ISSI_FlashStatus.error = 0U;
-            }
-            else
+            status = ptrOSPI->Control(ARM_OSPI_SET_TX_HEADER, (uint32_t) &hdr);
+
+            if (status != ARM_DRIVER_OK)
             {
-                ISSI_FlashStatus.error = 1U;
+                return ARM_DRIVER_ERROR;
             }
-        }while ((val & FLAG_STATUS_BUSY) == 0);
-    }
 
-    status = ControlSlaveSelect(false);
-    if (status != ARM_DRIVER_OK)
-    {
-        return ARM_DRIVER_ERROR;
-    }
+            return ptrOSPI->Send(job->data, job->step);
+        }
 
-    /* Number of data items programmed */
-    status = (int32_t)num;
-    return status;
+        case ISSI_JOB_ERASE:
+        {
+            job->step = EraseBlockSize(job->addr, job->end, &issi_cmd[0]);
+            issi_cmd[1] = job->addr;
+
+            return ptrOSPI->Send(issi_cmd, 2U);
+        }
+
+        default:
+        {
+            issi_cmd[0] = CMD_BULK_ERASE;
+
+            return ptrOSPI->Send(issi_cmd, 1U);
+        }
+    }
 }
 
 /**
-  \fn          int32_t ARM_Flash_EraseSector (uint32_t addr)
-  \brief       Erase Flash Sector.
-  \param[in]   addr  Sector address
-  \return      \ref execution_status
+  \fn          void JobPollStart (void)
+  \brief       Wait for the program/erase controller. With the LPTIMER poll the
+               flag status is read once per timer period, otherwise it is read
+               again as soon as the previous read completes.
+  \return      none
 **/
-static int32_t ARM_Flash_EraseSector (uint32_t addr)
+static void JobPollStart (void)
 {
-    int32_t status;
-    uint8_t num;
-    uint32_t cmd[2];
+#if RTE_ISSI_FLASH_POLL_LPTIMER
+    issi_state = ISSI_STATE_POLL_WAIT;
 
-    if (addr > (FLASH_ISSI_SECTOR_COUNT * FLASH_ISSI_SECTOR_SIZE))
+    if (ptrLPTIMER->Start(RTE_ISSI_FLASH_LPTIMER_CHANNEL) != ARM_DRIVER_OK)
     {
-        return ARM_DRIVER_ERROR_PARAMETER;
+        JobComplete(ARM_DRIVER_ERROR);
     }
+#else
+    issi_state = ISSI_STATE_POLL;
 
-    status = ptrOSPI->Control(ARM_OSPI_SET_ADDR_LENGTH_WAIT_CYCLE, (ARM_OSPI_ADDR_LENGTH_0_BITS << ARM_OSPI_ADDR_LENGTH_POS) | (0 << ARM_OSPI_WAIT_CYCLE_POS));
-
-    if (status != ARM_DRIVER_OK)
+    if (JobStartStatusRead(CMD_READ_FLAG_STATUS) != ARM_DRIVER_OK)
     {
-        return ARM_DRIVER_ERROR;
+        JobComplete(ARM_DRIVER_ERROR);
     }
+#endif
+}
+
+/**
+  \fn          void JobComplete (int32_t result)
+  \brief       Retire the job at the head of the queue and start the next one.
+               ARM_FLASH_EVENT_READY is signaled once the queue is empty.
+  \param[in]   result : \ref execution_status of the retired job
+  \return      none
+**/
+static void JobComplete (int32_t result)
+{
+    ControlSlaveSelect(false);
 
-    status = SetWriteEnable();
+#if RTE_ISSI_FLASH_POLL_LPTIMER
+    ptrLPTIMER->Stop(RTE_ISSI_FLASH_LPTIMER_CHANNEL);
+#endif
 
-    if (status == ARM_DRIVER_OK)
+    while (1)
     {
-        ISSI_FlashStatus.busy  = 1U;
-        ISSI_FlashStatus.error = 0U;
+        if (result != ARM_DRIVER_OK)
+        {
+            ISSI_FlashStatus.error = 1U;
+            issi_result = ARM_DRIVER_ERROR;
 
-        status = ptrOSPI->Control(ARM_OSPI_MODE_MASTER |
-                    ARM_OSPI_DATA_BITS(8) |
-                    ARM_OSPI_SS_MASTER_SW,
-                    OSPI_BUS_SPEED);
+            if (issi_cb_event != NULL)
+            {
+                issi_cb_event(ARM_FLASH_EVENT_ERROR);
+            }
+        }
 
-        if (status != ARM_DRIVER_OK)
+        issi_q_head = (issi_q_head + 1U) % RTE_ISSI_FLASH_QUEUE_DEPTH;
+        issi_q_count--;
+
+        if (issi_q_count == 0U)
         {
-            return ARM_DRIVER_ERROR;
+            issi_state = ISSI_STATE_IDLE;
+            ISSI_FlashStatus.busy = 0U;
+
+            if (issi_cb_event != NULL)
+            {
+                issi_cb_event(ARM_FLASH_EVENT_READY);
+            }
+            return;
         }
 
-        /* Select Slave */
-        status = ControlSlaveSelect(true);
+        result = JobStartWriteEnable();
 
-        if (status == ARM_DRIVER_OK)
+        if (result == ARM_DRIVER_OK)
         {
-            /* Prepare command with address */
-            cmd[0] = CMD_SECTOR_ERASE;
-            cmd[1] = addr;
+            return;
+        }
 
+        ControlSlaveSelect(false);
+    }
+}
 
-            status = ptrOSPI->Control(ARM_OSPI_SET_ADDR_LENGTH_WAIT_CYCLE, (ARM_OSPI_ADDR_LENGTH_32_BITS << ARM_OSPI_ADDR_LENGTH_POS) | (0 << ARM_OSPI_WAIT_CYCLE_POS));
+/**
+  \fn          void JobEvent (uint32_t event)
+  \brief       Advance the job at the head of the queue on OSPI completion.
+  \param[in]   event : OSPI event
+  \return      none
+**/
+static void JobEvent (uint32_t event)
+{
+    ISSI_JOB *job = &issi_queue[issi_q_head];
+    int32_t status = ARM_DRIVER_OK;
+    uint8_t val;
 
-            if (status != ARM_DRIVER_OK)
-            {
-                return ARM_DRIVER_ERROR;
-            }
+    if (!(event & ARM_OSPI_EVENT_TRANSFER_COMPLETE))
+    {
+        JobComplete(ARM_DRIVER_ERROR);
+        return;
+    }
 
-            status = ptrOSPI->Send(cmd, 2U);
+    ControlSlaveSelect(false);
 
-            if (status != ARM_DRIVER_OK)
+    switch (issi_state)
+    {
+        case ISSI_STATE_WRITE_ENABLE:
+        {
+            issi_state = ISSI_STATE_CHECK_WEL;
+            status = JobStartStatusRead(CMD_READ_STATUS);
+            break;
+        }
+
+        case ISSI_STATE_CHECK_WEL:
+        {
+            val = (uint8_t) issi_cmd[1];
+
+            if ((val & 0x02) == 0)
             {
-                return ARM_DRIVER_ERROR;
+                status = ARM_DRIVER_ERROR;
+                break;
             }
 
-            while (!issi_event_flag)
+            status = JobStartCommand(job);
+            break;
+        }
+
+        case ISSI_STATE_COMMAND:
+        {
+            JobPollStart();
+            return;
+        }
+
+        case ISSI_STATE_POLL:
+        {
+            val = (uint8_t) issi_cmd[1];
+
+            /* Program or erase controller still busy */
+            if ((val & FLAG_STATUS_BUSY) == 0U)
             {
-                 __WFE();
+#if RTE_ISSI_FLASH_POLL_LPTIMER
+                issi_state = ISSI_STATE_POLL_WAIT;
+#else
+                status = JobStartStatusRead(CMD_READ_FLAG_STATUS);
+#endif
+                break;
             }
 
-            if (!(issi_event_flag & ARM_OSPI_EVENT_TRANSFER_COMPLETE))
+            if ((val & FLAG_STATUS_ERROR) != 0U)
             {
-                ControlSlaveSelect(false);
-                issi_event_flag = 0;
-                return ARM_DRIVER_ERROR;
+                status = ARM_DRIVER_ERROR;
+                break;
             }
 
-            issi_event_flag = 0;
+#if RTE_ISSI_FLASH_POLL_LPTIMER
+            ptrLPTIMER->Stop(RTE_ISSI_FLASH_LPTIMER_CHANNEL);
+#endif
 
-            do
+            /* Step done, move on within the job */
+            if (job->type == ISSI_JOB_PROGRAM)
             {
-                status = ReadStatusReg(CMD_READ_FLAG_STATUS, &num);
-                if (status != ARM_DRIVER_OK)
+                /* For 16 bit data frames, increment the byte address with 2 * frames programmed */
+                job->addr += (job->step * 2);
+                job->data += job->step;
+                job->cnt  -= job->step;
+
+                if (job->cnt != 0U)
                 {
+                    status = JobStartWriteEnable();
                     break;
                 }
+            }
+            else if (job->type == ISSI_JOB_ERASE)
+            {
+                job->addr += job->step;
 
-                /* Check ISSI_Flags Status register value */
-                if ((num & FLAG_STATUS_BUSY) != 0U)
+                if (job->addr < job->end)
                 {
-                    ISSI_FlashStatus.busy = 0U;
+                    status = JobStartWriteEnable();
+                    break;
                 }
+            }
 
-                /* Check Program and Erase bits */
-                if ((num & FLAG_STATUS_ERROR) == 0U)
-                {
-                    ISSI_FlashStatus.error = 0U;
-                }
-                else
-                {
-                    ISSI_FlashStatus.error = 1U;
-                }
-            } while ((num & FLAG_STATUS_BUSY) == 0);
+            JobComplete(ARM_DRIVER_OK);
+            return;
         }
 
-        status = ControlSlaveSelect(false);
+        default:
+            return;
+    }
+
+    if (status != ARM_DRIVER_OK)
+    {
+        JobComplete(status);
     }
-    return status;
 }
 
+#if RTE_ISSI_FLASH_POLL_LPTIMER
+/**
+  \fn          void lptimer_callback_event (uint8_t event)
+  \brief       Poll tick, read the flag status unless a read is in flight.
+  \param[in]   event : LPTIMER event
+  \return      none
+**/
+static void lptimer_callback_event (uint8_t event)
+{
+    if ((event & ARM_LPTIMER_EVENT_UNDERFLOW) && (issi_state == ISSI_STATE_POLL_WAIT))
+    {
+        issi_state = ISSI_STATE_POLL;
 
- /**
-  \fn          int32_t ARM_Flash_EraseChip (void)
-  \brief       Erase complete Flash.
-               Optional function for faster full chip erase.
+        if (JobStartStatusRead(CMD_READ_FLAG_STATUS) != ARM_DRIVER_OK)
+        {
+            JobComplete(ARM_DRIVER_ERROR);
+        }
+    }
+}
+#endif
+
+/**
+  \fn          int32_t JobSubmit (const ISSI_JOB *job)
+  \brief       Queue a program/erase job and start it when the engine is idle.
+               An erase that continues the last queued (not started) erase is
+               merged into it, so that a range can use block erases. Without a
+               callback registered the call waits for the queue to drain.
+  \param[in]   job : Job to queue
   \return      \ref execution_status
 **/
-static int32_t ARM_Flash_EraseChip (void)
+static int32_t JobSubmit (const ISSI_JOB *job)
 {
-    uint32_t cmd;
-    uint8_t num;
-    int32_t status;
+    ISSI_JOB *last;
+    int32_t status = ARM_DRIVER_OK;
 
-    ISSI_FlashStatus.busy  = 1U;
-    ISSI_FlashStatus.error = 0U;
+    if ((ISSI_Flags & FLASH_POWER) == 0U)
+    {
+        return ARM_DRIVER_ERROR;
+    }
 
-    status = ptrOSPI->Control(ARM_OSPI_SET_ADDR_LENGTH_WAIT_CYCLE, (ARM_OSPI_ADDR_LENGTH_0_BITS << ARM_OSPI_ADDR_LENGTH_POS) | (0 << ARM_OSPI_WAIT_CYCLE_POS));
+    __disable_irq();
 
-    if (status != ARM_DRIVER_OK)
+    if ((job->type == ISSI_JOB_ERASE) && (issi_q_count > 1U))
     {
-        return ARM_DRIVER_ERROR;
+        last = &issi_queue[(issi_q_head + issi_q_count - 1U) % RTE_ISSI_FLASH_QUEUE_DEPTH];
+
+        if ((last->type == ISSI_JOB_ERASE) && (last->end == job->addr))
+        {
+            last->end = job->end;
+            __enable_irq();
+            return ARM_DRIVER_OK;
+        }
+    }
+
+    if (issi_q_count == RTE_ISSI_FLASH_QUEUE_DEPTH)
+    {
+        __enable_irq();
+        return ARM_DRIVER_ERROR_BUSY;
     }
 
-    status = SetWriteEnable();
+    issi_queue[(issi_q_head + issi_q_count) % RTE_ISSI_FLASH_QUEUE_DEPTH] = *job;
+    issi_q_count++;
 
-    if (status == ARM_DRIVER_OK)
+    if (issi_state == ISSI_STATE_IDLE)
     {
+        ISSI_FlashStatus.busy  = 1U;
+        ISSI_FlashStatus.error = 0U;
+        issi_result = ARM_DRIVER_OK;
 
-        status = ptrOSPI->Control(ARM_OSPI_MODE_MASTER |
-                    ARM_OSPI_DATA_BITS(8) |
-                    ARM_OSPI_SS_MASTER_SW,
-                    OSPI_BUS_SPEED);
+        status = JobStartWriteEnable();
 
         if (status != ARM_DRIVER_OK)
         {
-            return ARM_DRIVER_ERROR;
+            ControlSlaveSelect(false);
+            issi_q_count = 0U;
+            issi_state = ISSI_STATE_IDLE;
+            ISSI_FlashStatus.busy  = 0U;
+            ISSI_FlashStatus.error = 1U;
+            status = ARM_DRIVER_ERROR;
         }
+    }
 
-        /* Select Slave */
-        status = ControlSlaveSelect(true);
+    __enable_irq();
 
-        if (status == ARM_DRIVER_OK)
+    if ((status == ARM_DRIVER_OK) && (issi_cb_event == NULL))
+    {
+        while (issi_state != ISSI_STATE_IDLE)
         {
-            /* Prepare command */
-            cmd = CMD_BULK_ERASE;
+             __WFE();
+        }
+        status = issi_result;
+    }
 
-            status = ptrOSPI->Control(ARM_OSPI_SET_ADDR_LENGTH_WAIT_CYCLE, (ARM_OSPI_ADDR_LENGTH_0_BITS << ARM_OSPI_ADDR_LENGTH_POS) | (0 << ARM_OSPI_WAIT_CYCLE_POS));
+    return status;
+}
 
-            if (status != ARM_DRIVER_OK)
-            {
-                return ARM_DRIVER_ERROR;
-            }
+/**
+  \fn          void JobAbort (void)
+  \brief       Drop every queued job, aborting the one in progress.
+  \return      none
+**/
+static void JobAbort (void)
+{
+    __disable_irq();
 
-            status = ptrOSPI->Send(&cmd, 1U);
+    if (issi_state != ISSI_STATE_IDLE)
+    {
+#if RTE_ISSI_FLASH_POLL_LPTIMER
+        ptrLPTIMER->Stop(RTE_ISSI_FLASH_LPTIMER_CHANNEL);
+#endif
+        ptrOSPI->Control(ARM_OSPI_ABORT_TRANSFER, 0U);
+        ControlSlaveSelect(false);
+    }
 
-            if (status != ARM_DRIVER_OK)
-            {
-                return ARM_DRIVER_ERROR;
-            }
+    issi_q_head  = 0U;
+    issi_q_count = 0U;
+    issi_state   = ISSI_STATE_IDLE;
 
-            while (!issi_event_flag)
-            {
-                 __WFE();
-            }
+    __enable_irq();
+}
 
-            if (!(issi_event_flag & ARM_OSPI_EVENT_TRANSFER_COMPLETE))
-            {
-                ControlSlaveSelect(false);
-                issi_event_flag = 0;
-                return ARM_DRIVER_ERROR;
-            }
+/**
+  \fn          int32_t ARM_Flash_ProgramData (uint32_t addr, const void *data, uint32_t cnt)
+  \brief       Program data to Flash. With a callback registered the pages are
+               programmed in the background, data must stay valid until
+               ARM_FLASH_EVENT_READY, and 0 is returned.
+  \param[in]   addr  Data address.
+  \param[in]   data  Pointer to a buffer containing the data to be programmed to Flash.
+  \param[in]   cnt   Number of data items to program.
+  \return      number of data items programmed or \ref execution_status
+**/
+static int32_t ARM_Flash_ProgramData (uint32_t addr, const void *data, uint32_t cnt)
+{
+    ISSI_JOB job;
+    int32_t status;
 
-            issi_event_flag = 0;
+    if ((addr > (FLASH_ISSI_SECTOR_COUNT * FLASH_ISSI_SECTOR_SIZE)) || (data == NULL) || ((addr + cnt) > (FLASH_ISSI_SECTOR_COUNT * FLASH_ISSI_SECTOR_SIZE)))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
 
-            do
-            {
-                status = ReadStatusReg(CMD_READ_FLAG_STATUS, &num);
-                if (status != ARM_DRIVER_OK)
-                {
-                    break;
-                }
+    /* Program unit is a 16 bit item */
+    if ((addr % FLASH_ISSI_PROGRAM_UNIT) != 0U)
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
 
-                /* Check ISSI_Flags Status register value */
-                if ((num & FLAG_STATUS_BUSY) != 0U)
-                {
-                    ISSI_FlashStatus.busy = 0U;
-                }
+    if (cnt == 0U)
+    {
+        return 0;
+    }
 
-                /* Check Program and Erase bits */
-                if ((num & FLAG_STATUS_ERROR) == 0U)
-                {
-                    ISSI_FlashStatus.error = 0U;
-                }
-                else
-                {
-                    ISSI_FlashStatus.error = 1U;
-                }
-            } while ((num & FLAG_STATUS_BUSY) == 0);
-        }
-        status = ControlSlaveSelect(false);
+    job.type = ISSI_JOB_PROGRAM;
+    job.addr = addr;
+    job.end  = addr + (cnt * 2);
+    job.data = data;
+    job.cnt  = cnt;
+
+    status = JobSubmit(&job);
+
+    if ((status != ARM_DRIVER_OK) || (issi_cb_event != NULL))
+    {
+        return status;
     }
-    return status;
+
+    /* Number of data items programmed */
+    return (int32_t)cnt;
 }
 
 /**
-  \fn          ARM_FLASH_STATUS ARM_Flash_GetStatus (void)
-  \brief       Get Flash status.
-  \return      Flash status \ref ARM_FLASH_STATUS
+  \fn          int32_t ARM_Flash_EraseSector (uint32_t addr)
+  \brief       Erase Flash Sector.
+  \param[in]   addr  Sector address
+  \return      \ref execution_status
 **/
-static ARM_FLASH_STATUS ARM_Flash_GetStatus (void)
+static int32_t ARM_Flash_EraseSector (uint32_t addr)
 {
-    uint8_t val;
+    ISSI_JOB job;
 
-    if (ISSI_FlashStatus.busy == 1U)
+    if (addr >= (FLASH_ISSI_SECTOR_COUNT * FLASH_ISSI_SECTOR_SIZE))
     {
-        /* Read flag status register */
-        if (ReadStatusReg (CMD_READ_FLAG_STATUS, &val) == ARM_DRIVER_OK)
-        {
-            /* Check "Program or erase controller" bit */
-            if ((val & FLAG_STATUS_BUSY) != 0U)
-            {
-                ISSI_FlashStatus.busy = 0U;
-            }
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
 
-            /* Check Erase and Program bits */
-            if ((val & FLAG_STATUS_ERROR) == 0U)
-            {
-                ISSI_FlashStatus.error = 0U;
-            }
-            else
-            {
-                ISSI_FlashStatus.error = 1U;
-            }
-        }
-        else
-        {
-            ISSI_FlashStatus.error = 1U;
-        }
+    job.type = ISSI_JOB_ERASE;
+    job.addr = addr & ~(FLASH_ISSI_SECTOR_SIZE - 1U);
+    job.end  = job.addr + FLASH_ISSI_SECTOR_SIZE;
+    job.data = NULL;
+    job.cnt  = 0U;
+
+    return JobSubmit(&job);
+}
+
+/**
+  \fn          int32_t ISSI_Flash_EraseRange (uint32_t addr, uint32_t size)
+  \brief       Erase the sectors covering a range, using 128K/32K block erases
+               wherever the range allows it.
+  \param[in]   addr  Start address
+  \param[in]   size  Number of bytes
+  \return      \ref execution_status
+**/
+int32_t ISSI_Flash_EraseRange (uint32_t addr, uint32_t size)
+{
+    ISSI_JOB job;
+
+    if ((size == 0U) || (addr >= (FLASH_ISSI_SECTOR_COUNT * FLASH_ISSI_SECTOR_SIZE)) ||
+        (size > ((FLASH_ISSI_SECTOR_COUNT * FLASH_ISSI_SECTOR_SIZE) - addr)))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
     }
+
+    job.type = ISSI_JOB_ERASE;
+    job.addr = addr & ~(FLASH_ISSI_SECTOR_SIZE - 1U);
+    job.end  = (addr + size + FLASH_ISSI_SECTOR_SIZE - 1U) & ~(FLASH_ISSI_SECTOR_SIZE - 1U);
+    job.data = NULL;
+    job.cnt  = 0U;
+
+    return JobSubmit(&job);
+}
+
+ /**
+  \fn          int32_t ARM_Flash_EraseChip (void)
+  \brief       Erase complete Flash.
+               Optional function for faster full chip erase.
+  \return      \ref execution_status
+**/
+static int32_t ARM_Flash_EraseChip (void)
+{
+    ISSI_JOB job;
+
+    job.type = ISSI_JOB_ERASE_CHIP;
+    job.addr = 0U;
+    job.end  = 0U;
+    job.data = NULL;
+    job.cnt  = 0U;
+
+    return JobSubmit(&job);
+}
+
+/**
+  \fn          ARM_FLASH_STATUS ARM_Flash_GetStatus (void)
+  \brief       Get Flash status. Busy while program/erase jobs are queued.
+  \return      Flash status \ref ARM_FLASH_STATUS
+**/
+static ARM_FLASH_STATUS ARM_Flash_GetStatus (void)
+{
     return ISSI_FlashStatus;
 }
 
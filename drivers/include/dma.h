@@ -343,6 +343,20 @@ static inline uint32_t dma_get_channel_dest_addr(DMA_Type *dma,
     return dma->DMA_RT_CHANNEL_CFG[channel_num].DMA_DAR;
 }
 
+/**
+  \fn          uint32_t dma_get_channel_pc(DMA_Type *dma,
+                                           uint8_t   channel_num)
+  \brief       Get Program Counter of the Channel
+  \param[in]   dma    Pointer to DMA register map
+  \param[in]   channel_num Channel Number
+  \return      uint32_t Current Program Counter
+*/
+static inline uint32_t dma_get_channel_pc(DMA_Type *dma,
+                                          uint8_t   channel_num)
+{
+    return dma->DMA_CHANNEL_RT_INFO[channel_num].DMA_CPC;
+}
+
 /**
   \fn          bool dma_debug_is_busy(DMA_Type *dma)
   \brief       Get Debug Status of DMAC
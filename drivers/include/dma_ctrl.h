@@ -64,6 +64,9 @@ typedef struct _dma_channel_info_t {
     uint32_t          flags;                       /*!< Channel flags                   */
     bool              last_req;                    /*!< If this is last request         */
     uint8_t           event_index;                 /*!< Event/IRQ index                 */
+    uint8_t           periods;                     /*!< Cyclic mode periods             */
+    uint16_t          sar_off;                     /*!< Offset of DMAMOV SAR in mcode   */
+    uint16_t          dar_off;                     /*!< Offset of DMAMOV DAR in mcode   */
     dma_desc_info_t   desc_info;                   /*!< DMA descriptor                  */
 } dma_channel_info_t;
 
@@ -31,8 +31,18 @@ typedef enum _DMA_CHANNEL_FLAG {
     DMA_CHANNEL_FLAG_USE_USER_MCODE      = (1 << 0),         /*!< Use user provided mcode for channel */
     DMA_CHANNEL_FLAG_I2S_MONO_MODE       = (1 << 1),         /*!< DMA channel in I2S mono mode */
     DMA_CHANNEL_FLAG_CRC_MODE            = (1 << 2),         /*!< CRC: Skip peripheral flush and wait */
+    DMA_CHANNEL_FLAG_CYCLIC_MODE         = (1 << 3),         /*!< Loop over the buffer, event per period */
+    DMA_CHANNEL_FLAG_PREPARED            = (1 << 4),         /*!< mcode is valid for the desc shape */
 } DMA_CHANNEL_FLAG;
 
+/* Scatter-gather segment */
+typedef struct _dma_sg_seg_t {
+    uint32_t    src_addr;                   /*!< Source address (global)         */
+    uint32_t    dst_addr;                   /*!< Destination address (global)    */
+    uint32_t    len;                        /*!< Number of bytes                 */
+    bool        event;                      /*!< Raise the channel event after   */
+} dma_sg_seg_t;
+
 
 /**
   \fn          void dma_assign_user_opcode(dma_config_info_t *dma_cfg,
@@ -89,6 +99,65 @@ static inline void dma_set_crc_mode(dma_config_info_t *dma_cfg,
     channel_info->flags     |= DMA_CHANNEL_FLAG_CRC_MODE;
 }
 
+/**
+  \fn          void dma_set_cyclic_mode(dma_config_info_t *dma_cfg,
+                                        uint8_t            channel_num,
+                                        uint8_t            periods)
+  \brief       Set cyclic operation, 0 periods disables it
+  \param[in]   dma_cfg  Pointer to DMA Configuration resources
+  \param[in]   channel_num  Channel Number
+  \param[in]   periods  Number of periods in the buffer
+  \return      None
+*/
+static inline void dma_set_cyclic_mode(dma_config_info_t *dma_cfg,
+                                       uint8_t            channel_num,
+                                       uint8_t            periods)
+{
+    dma_thread_info_t  *thread_info    = &dma_cfg->channel_thread[channel_num];
+    dma_channel_info_t *channel_info   = &thread_info->channel_info;
+
+    channel_info->periods    = periods;
+
+    if(periods)
+        channel_info->flags |= DMA_CHANNEL_FLAG_CYCLIC_MODE;
+    else
+        channel_info->flags &= ~DMA_CHANNEL_FLAG_CYCLIC_MODE;
+}
+
+/**
+  \fn          uint8_t dma_get_cyclic_periods(dma_config_info_t *dma_cfg,
+                                              uint8_t            channel_num)
+  \brief       Get the number of periods of a cyclic channel
+  \param[in]   dma_cfg  Pointer to DMA Configuration resources
+  \param[in]   channel_num  Channel Number
+  \return      uint8_t Number of periods
+*/
+static inline uint8_t dma_get_cyclic_periods(dma_config_info_t *dma_cfg,
+                                             uint8_t            channel_num)
+{
+    dma_thread_info_t  *thread_info    = &dma_cfg->channel_thread[channel_num];
+    dma_channel_info_t *channel_info   = &thread_info->channel_info;
+
+    return channel_info->periods;
+}
+
+/**
+  \fn          void dma_clear_prepared(dma_config_info_t *dma_cfg,
+                                        uint8_t            channel_num)
+  \brief       Force the next start to generate the opcode again
+  \param[in]   dma_cfg  Pointer to DMA Configuration resources
+  \param[in]   channel_num  Channel Number
+  \return      None
+*/
+static inline void dma_clear_prepared(dma_config_info_t *dma_cfg,
+                                      uint8_t            channel_num)
+{
+    dma_thread_info_t  *thread_info    = &dma_cfg->channel_thread[channel_num];
+    dma_channel_info_t *channel_info   = &thread_info->channel_info;
+
+    channel_info->flags     &= ~DMA_CHANNEL_FLAG_PREPARED;
+}
+
 /**
   \fn          uint8_t* dma_get_opcode_buf(dma_config_info_t *dma_cfg,
                                            uint8_t            channel_num)
@@ -119,6 +188,68 @@ static inline uint8_t* dma_get_opcode_buf(dma_config_info_t *dma_cfg,
 */
 bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num);
 
+/**
+  \fn          bool dma_generate_cyclic_opcode(dma_config_info_t *dma_cfg,
+                                               uint8_t            channel_num)
+  \brief       Prepare a looping DMA opcode raising the channel event after
+               every period of the buffer
+  \param[in]   dma_cfg  Pointer to DMA Configuration resources
+  \param[in]   channel_num  Channel Number
+  \return      bool false if the buffer is not enough or a period needs
+               DMA_MAX_LP_CNT bursts or more, true otherwise
+*/
+bool dma_generate_cyclic_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num);
+
+/**
+  \fn          void dma_patch_opcode_addr(dma_config_info_t *dma_cfg,
+                                           uint8_t            channel_num,
+                                           uint16_t          *off,
+                                           uint16_t          *len)
+  \brief       Rewrite the SAR/DAR immediates of a prepared opcode with the
+               addresses of the channel descriptor
+  \param[in]   dma_cfg  Pointer to DMA Configuration resources
+  \param[in]   channel_num  Channel Number
+  \param[out]  off  Offset of the first modified byte
+  \param[out]  len  Number of bytes from off covering the modification
+  \return      None
+*/
+void dma_patch_opcode_addr(dma_config_info_t *dma_cfg,
+                           uint8_t            channel_num,
+                           uint16_t          *off,
+                           uint16_t          *len);
+
+/**
+  \fn          bool dma_sg_opcode_add(dma_config_info_t  *dma_cfg,
+                                      uint8_t             channel_num,
+                                      const dma_sg_seg_t *seg,
+                                      dma_opcode_buf     *op_buf)
+  \brief       Append one scatter-gather segment to the channel program
+  \param[in]   dma_cfg  Pointer to DMA Configuration resources
+  \param[in]   channel_num  Channel Number
+  \param[in]   seg  Segment to be appended
+  \param[in]   op_buf  Opcode buffer info
+  \return      bool false if the buffer is not enough or the segment is
+               not aligned to the burst size, true otherwise
+*/
+bool dma_sg_opcode_add(dma_config_info_t  *dma_cfg,
+                       uint8_t             channel_num,
+                       const dma_sg_seg_t *seg,
+                       dma_opcode_buf     *op_buf);
+
+/**
+  \fn          bool dma_sg_opcode_end(dma_config_info_t *dma_cfg,
+                                      uint8_t            channel_num,
+                                      dma_opcode_buf    *op_buf)
+  \brief       Terminate the scatter-gather program of the channel
+  \param[in]   dma_cfg  Pointer to DMA Configuration resources
+  \param[in]   channel_num  Channel Number
+  \param[in]   op_buf  Opcode buffer info
+  \return      bool false if the buffer is not enough, true otherwise
+*/
+bool dma_sg_opcode_end(dma_config_info_t *dma_cfg,
+                       uint8_t            channel_num,
+                       dma_opcode_buf    *op_buf);
+
 #ifdef  __cplusplus
 }
 #endif
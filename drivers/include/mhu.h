@@ -22,6 +22,12 @@
 #define MHU_NUMBER_OF_CHANNELS_MAX        124
 #define MHU_DEBUG_PRINT_ENABLE            0
 
+/* Measure the receive ISR duration with the DWT cycle counter. The
+ * application must enable DWT->CYCCNT. */
+#ifndef MHU_RECEIVER_CYCLE_COUNT_ENABLE
+#define MHU_RECEIVER_CYCLE_COUNT_ENABLE   0
+#endif
+
 #if MHU_DEBUG_PRINT_ENABLE == 1
 #define debug_print drv_debug_print_fn
 #else
@@ -64,6 +70,20 @@ typedef mhu_send_status_t (*MHU_send_message_t)(uint32_t mhu_id,
                                                 uint32_t channel_number,
                                                 uint32_t message_data);
 
+/*
+ * Completion of a queued message, called from the sender interrupt
+ */
+typedef void (*MHU_send_complete_callback_t)(uint32_t mhu_id,
+                                             uint32_t channel_number,
+                                             uint32_t message_data,
+                                             mhu_send_status_t status);
+
+typedef mhu_send_status_t (*MHU_send_message_async_t)(
+                                  uint32_t mhu_id,
+                                  uint32_t channel_number,
+                                  uint32_t message_data,
+                                  MHU_send_complete_callback_t callback);
+
 typedef void (*MHU_irq_handler_t)(uint32_t mhu_id);
 
 /**
@@ -74,6 +94,7 @@ typedef void (*MHU_irq_handler_t)(uint32_t mhu_id);
 typedef struct 
 {
   MHU_send_message_t send_message;          // Called by Services
+  MHU_send_message_async_t send_message_async; // Queued, non-blocking send
   MHU_irq_handler_t sender_irq_handler;     // Called by client IRQ handler
   MHU_irq_handler_t receiver_irq_handler;   // Called by client IRQ handler
 } mhu_driver_out_t;
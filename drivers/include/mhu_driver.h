@@ -58,6 +58,14 @@
 #define MHU_NUMBER_MAX       10
 #define MHU_CHANNELS         2
 
+// Messages queued per sender channel, must be a power of two
+#define MHU_SEND_QUEUE_DEPTH     8
+
+// Channels per combined interrupt status register (CH_INT_STn)
+#define MHU_CHANNEL_GROUP_SIZE   32
+#define MHU_CHANNEL_GROUPS       \
+  ((MHU_CHANNELS + MHU_CHANNEL_GROUP_SIZE - 1) / MHU_CHANNEL_GROUP_SIZE)
+
 /*******************************************************************************
  *  T Y P E D E F S
  ******************************************************************************/
@@ -299,6 +307,19 @@ typedef enum
   MHU_CHANNEL_COMBINED_CH96_123,
 } mhu_channel_combined_group_t;
 
+/**
+ * @struct MHU_receiver_stats_t
+ * Receive interrupt statistics of one receiver frame
+ */
+typedef struct
+{
+  uint32_t irq_count;       // receive interrupts handled
+  uint32_t message_count;   // messages dispatched
+  uint32_t spurious_count;  // interrupts without a pending channel
+  uint32_t last_cycles;     // last ISR duration (MHU_RECEIVER_CYCLE_COUNT_ENABLE)
+  uint32_t max_cycles;      // longest ISR duration (MHU_RECEIVER_CYCLE_COUNT_ENABLE)
+} MHU_receiver_stats_t;
+
 /*******************************************************************************
  *  F U N C T I O N   P R O T O T Y P E S
  ******************************************************************************/
@@ -313,11 +334,20 @@ void MHU_send_message_irq_handler(uint32_t sender_id);
 mhu_send_status_t MHU_send_message(uint32_t sender_id,
                                    uint32_t channel_number,
                                    uint32_t message_data);
+mhu_send_status_t MHU_send_message_async(uint32_t sender_id,
+                                         uint32_t channel_number,
+                                         uint32_t message_data,
+                                         MHU_send_complete_callback_t callback);
 
 void MHU_receiver_initialize(
     uint32_t receiver_frame_base_address_list[],
     uint32_t receiver_frame_count,
     MHU_rx_msg_callback_t callback);
 void MHU_receive_message_irq_handler(uint32_t receiver_id);
+bool MHU_receiver_register_channel_callback(uint32_t receiver_id,
+                                            uint32_t channel_number,
+                                            MHU_rx_msg_callback_t callback);
+void MHU_receiver_get_stats(uint32_t receiver_id,
+                            MHU_receiver_stats_t *stats);
 
 #endif /* __MHU_DRIVER_H__ */
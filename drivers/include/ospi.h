@@ -349,6 +349,8 @@ typedef struct _ospi_transfer_t {
     uint32_t                        addr_len;           /**< Address length for the transfer  */
     uint32_t                        dummy_cycle;        /**< Dummy cycles for the transfer    */
     uint32_t                        ddr;                /**< DDR / SDR mode for the transfer  */
+    uint32_t                        tx_hdr[2];          /**< Instruction and address frames   */
+    uint32_t                        tx_hdr_cnt;         /**< Header frames sent ahead of a packed tx_buff */
     bool                            tx_default_enable;  /**< Enable Tx default value transfer */
     SPI_TMOD                        mode;               /**< SPI transfer mode                */
     volatile SPI_TRANSFER_STATUS    status;             /**< transfer status                  */
@@ -32,6 +32,14 @@ extern "C" {
 //#define SDMMC_PRINTF_SD_STATE_DEBUG
 //#define SDMMC_PRINT_SEC_DATA
 
+#ifndef RTE_SDC_IRQ_PRI
+#define RTE_SDC_IRQ_PRI 0
+#endif
+
+#ifndef RTE_SDC_BUS_SPEED
+#define RTE_SDC_BUS_SPEED SDMMC_BUS_SPEED_DS
+#endif
+
 /**
  * @brief  SD driver status enum definition
  */
@@ -90,6 +98,25 @@ typedef struct _sd_cmd_t{
     uint8_t data_present;   /*!< SD Command uses Data lines */
 }sd_cmd_t;
 
+/**
+ * @brief  SD queued block request, owned by the driver from sd_submit()
+ *         until its callback runs
+ */
+typedef struct _sd_req_t sd_req_t;
+
+typedef void (*sd_req_cb_t)(sd_req_t *req, SD_DRV_STATUS status);
+
+struct _sd_req_t{
+    sd_req_t                *next;          /*!< Next queued request (driver use)       */
+    volatile uint8_t        *buff;          /*!< Source/Destination buffer              */
+    uint32_t                sector;         /*!< First sector                           */
+    uint16_t                blk_cnt;        /*!< Number of blocks                       */
+    uint8_t                 write;          /*!< 1: write, 0: read                      */
+    uint8_t                 retry;          /*!< Retries left (driver use)              */
+    sd_req_cb_t             cb;             /*!< Completion callback, IRQ context       */
+    void                    *user;          /*!< Application context                    */
+};
+
 /**
  * @brief  Global SD Handle Information Structure definition
  */
@@ -107,6 +134,10 @@ typedef struct _sd_handle_t{
     uint16_t                hc_version;     /*!< Host controller version                */
     uint8_t                 bus_width;      /*!< 1Bit, 4Bit, 8Bit Mode                  */
     uint8_t                 dma_mode;       /*!< SDMA, ADMA2, and ADMA3 Mode            */
+    uint8_t                 max_speed;      /*!< Fastest bus speed to negotiate         */
+    uint8_t                 bus_speed;      /*!< Bus speed in use, SDMMC_BUS_SPEED      */
+    sd_req_t                *req_head;      /*!< Request in progress, then the queue    */
+    sd_req_t                *req_tail;      /*!< Last queued request                    */
 }sd_handle_t;
 
 /**
@@ -132,12 +163,22 @@ SD_DRV_STATUS sd_host_init(sd_handle_t *, uint8_t, uint8_t);
 SD_DRV_STATUS sd_card_init(sd_handle_t *);
 SD_DRV_STATUS sd_write(uint32_t, uint32_t, volatile unsigned char *);
 SD_DRV_STATUS sd_read(uint32_t, uint16_t, volatile unsigned char *);
+SD_DRV_STATUS sd_readv(uint32_t, const sd_iovec_t *, uint32_t);
+SD_DRV_STATUS sd_writev(uint32_t, const sd_iovec_t *, uint32_t);
 SD_DRV_STATUS sd_error_handler();
+SD_DRV_STATUS sd_set_bus_speed(sd_handle_t *, SDMMC_BUS_SPEED);
+SD_DRV_STATUS sd_bus_speed(SDMMC_BUS_SPEED);
+SDMMC_BUS_SPEED sd_get_bus_speed(void);
+uint8_t sd_speed_usable(uint16_t, uint32_t, uint8_t, SDMMC_BUS_SPEED);
+SDMMC_BUS_SPEED sd_speed_next(uint8_t, SDMMC_BUS_SPEED);
+SD_DRV_STATUS sd_submit(sd_req_t *);
+void sd_irq_handler(sd_handle_t *);
 SDMMC_HC_STATUS hc_send_cmd(sd_handle_t *, sd_cmd_t *);
 SDMMC_HC_STATUS hc_reset(sd_handle_t *, uint8_t);
 void hc_set_bus_power(sd_handle_t *, uint8_t);
 SDMMC_HC_STATUS hc_set_clk_freq(sd_handle_t *, uint16_t);
 void hc_set_tout(sd_handle_t *, uint8_t);
+void hc_config_interrupt(sd_handle_t *);
 SDMMC_HC_STATUS hc_identify_card(sd_handle_t *);
 SDMMC_HC_STATUS hc_get_card_ifcond(sd_handle_t *);
 SDMMC_HC_STATUS hc_get_card_opcond(sd_handle_t *);
@@ -146,12 +187,18 @@ SDMMC_HC_STATUS hc_get_card_csd(sd_handle_t *);
 SDMMC_HC_STATUS hc_config_dma(sd_handle_t *, uint8_t);
 SDMMC_HC_STATUS hc_set_bus_width(sd_handle_t *, uint8_t);
 SDMMC_HC_STATUS hc_switch_1v8(sd_handle_t *);
+SDMMC_HC_STATUS hc_switch_func(sd_handle_t *, uint32_t, uint8_t *);
+SDMMC_HC_STATUS hc_set_bus_speed(sd_handle_t *, SDMMC_BUS_SPEED);
+SDMMC_HC_STATUS hc_execute_tuning(sd_handle_t *);
 SDMMC_HC_STATUS hc_go_idle(sd_handle_t *);
 SDMMC_HC_STATUS hc_sel_card(sd_handle_t *, uint32_t);
 SDMMC_HC_STATUS hc_set_blk_size(sd_handle_t *, uint32_t);
 SDMMC_HC_STATUS hc_set_blk_cnt(sd_handle_t *, uint32_t);
 SDMMC_HC_STATUS hc_read_setup(sd_handle_t *, uint32_t , uint32_t , uint16_t);
 SDMMC_HC_STATUS hc_write_setup(sd_handle_t *, uint32_t , uint32_t , uint16_t);
+SDMMC_HC_STATUS hc_readv_setup(sd_handle_t *, const sd_iovec_t *, uint32_t, uint32_t , uint16_t);
+SDMMC_HC_STATUS hc_writev_setup(sd_handle_t *, const sd_iovec_t *, uint32_t, uint32_t , uint16_t);
+uint32_t hc_adma2_build_desc(adma2_desc_t *, uint32_t, const sd_iovec_t *, uint32_t);
 SDMMC_HC_STATUS hc_check_xfer_done(sd_handle_t *, uint32_t);
 SDMMC_HC_STATUS hc_get_rca(sd_handle_t *, uint32_t *);
 SDMMC_HC_STATUS hc_get_card_status(sd_handle_t *pHsd, uint32_t *);
@@ -0,0 +1,72 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/**************************************************************************//**
+ * @file     sd_cache.h
+ * @version  V0.0.1
+ * @brief    Optional SD sector cache with read-ahead and write-back.
+ * @bug      None.
+ * @Note     None
+ ******************************************************************************/
+#ifndef _SD_CACHE_H_
+#define _SD_CACHE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sd.h"
+
+#ifndef RTE_SDC_CACHE_SECTORS
+#define RTE_SDC_CACHE_SECTORS       32
+#endif
+
+#ifndef RTE_SDC_CACHE_READ_AHEAD
+#define RTE_SDC_CACHE_READ_AHEAD    8
+#endif
+
+/* Memory section holding the cached sectors, must be reachable by the SDMMC DMA */
+#ifndef SD_CACHE_SECTION
+#define SD_CACHE_SECTION            "sd_dma_buf"
+#endif
+
+/**
+ * @brief  SD sector cache counters. Cycle counts are read from DWT->CYCCNT,
+ *         which the application must enable.
+ */
+typedef struct _sd_cache_stats_t{
+    uint32_t                read_hits;          /*!< Sectors read from the cache            */
+    uint32_t                read_misses;        /*!< Sectors read from the card on demand   */
+    uint32_t                read_ahead;         /*!< Sectors prefetched by read-ahead       */
+    uint32_t                write_hits;         /*!< Sector writes to an already cached one */
+    uint32_t                write_misses;       /*!< Sector writes allocating a new entry   */
+    uint32_t                writeback_sectors;  /*!< Dirty sectors written back to the card */
+    uint32_t                card_reads;         /*!< Read commands sent to the card         */
+    uint32_t                card_writes;        /*!< Write commands sent to the card        */
+    uint64_t                read_cycles;        /*!< Cycles spent in card reads             */
+    uint64_t                write_cycles;       /*!< Cycles spent in card writes            */
+}sd_cache_stats_t;
+
+/* Cached drop-in replacement for SD_Driver */
+extern const diskio_t SD_Cache_Driver;
+
+SD_DRV_STATUS sd_cache_init(uint8_t, uint8_t, uint8_t);
+SD_DRV_STATUS sd_cache_uninit(uint8_t);
+SD_DRV_STATUS sd_cache_read(uint32_t, uint16_t, volatile unsigned char *);
+SD_DRV_STATUS sd_cache_write(uint32_t, uint32_t, volatile unsigned char *);
+SD_DRV_STATUS sd_cache_flush(void);
+void sd_cache_get_stats(sd_cache_stats_t *);
+void sd_cache_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
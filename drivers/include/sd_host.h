@@ -125,6 +125,18 @@ typedef enum _SDMMC_HC_STATUS{
     SDMMC_HC_STATUS_INV_STATE
 }SDMMC_HC_STATUS;
 
+/**
+ * @brief  SD bus speed modes, values are the CMD6 access mode function numbers
+ */
+typedef enum _SDMMC_BUS_SPEED{
+    SDMMC_BUS_SPEED_DS,         /*!< Default Speed / SDR12, 25MHz   */
+    SDMMC_BUS_SPEED_HS,         /*!< High Speed / SDR25, 50MHz      */
+    SDMMC_BUS_SPEED_SDR50,      /*!< UHS-I SDR50, 100MHz            */
+    SDMMC_BUS_SPEED_SDR104,     /*!< UHS-I SDR104, host max 100MHz  */
+    SDMMC_BUS_SPEED_DDR50,      /*!< UHS-I DDR50, 50MHz             */
+    SDMMC_BUS_SPEED_NONE
+}SDMMC_BUS_SPEED;
+
 /**
  * @brief ADMA 32-Bit descriptor table
  */
@@ -140,6 +152,17 @@ typedef struct _adma2_desc_t{
 #define SDMMC_ADMA2_DESC_END                    (0x1U << 1U)
 #define SDMMC_ADMA2_DESC_INT                    (0x1U << 2U)
 #define SDMMC_ADMA2_DESC_TRAN                   (0x1U << 5U)
+#define SDMMC_ADMA2_DESC_TBL_SIZE               32U
+#define SDMMC_ADMA2_ALIGN_Msk                   0x3U        /*!< 32-bit ADMA2 address/length alignment */
+#define SDMMC_ADMA2_MAX_BLK_CNT                 ((SDMMC_ADMA2_DESC_TBL_SIZE * SDMMC_ADMA2_DESC_MAX_LEN) / SDMMC_BLK_SIZE_512_Msk) /*!< blocks one descriptor table can map */
+
+/**
+ * @brief Scatter-gather buffer segment for vectored transfers
+ */
+typedef struct _sd_iovec_t{
+    volatile uint8_t *buff;     /*!< Segment start, local or global address */
+    uint32_t len;               /*!< Segment length in bytes                */
+}sd_iovec_t;
 
 /* SDMMC Device ID Constnat */
 #define SDMMC_DEV_ID                            1U
@@ -256,6 +279,7 @@ typedef struct _adma2_desc_t{
 #define DMA_IRQ_Msk                             (1U << DMA_IRQ_Pos)
 #define NORMAL_INT_STAT_XFER_COMPLETE_Pos       1U
 #define NORMAL_INT_STAT_XFER_COMPLETE_Msk       (1U << NORMAL_INT_STAT_XFER_COMPLETE_Pos)
+#define SDMMC_BUF_RD_EN_Msk                     0x00000800U
 
 /* Card CSD */
 #define CSD_SPEC_VER_Msk                        0x003C0000U
@@ -313,6 +337,11 @@ typedef struct _adma2_desc_t{
 #define SDMMC_HOST_SD_CAP_VOLT_3V3_Msk          0x01000000U /*!< 3.3V support */
 #define SDMMC_HOST_SD_CAP_VOLT_3V0_Msk          0x02000000U /*!< 3.0V support */
 #define SDMMC_HOST_SD_CAP_VOLT_1V8_Msk          0x04000000U /*!< 1.8V support */
+#define SDMMC_HOST_CAP2_SDR50_Msk               0x00000001U /*!< SDR50 support              */
+#define SDMMC_HOST_CAP2_SDR104_Msk              0x00000002U /*!< SDR104 support             */
+#define SDMMC_HOST_CAP2_DDR50_Msk               0x00000004U /*!< DDR50 support              */
+#define SDMMC_HOST_CAP2_UHS_Msk                 0x00000007U /*!< Any UHS-I mode support     */
+#define SDMMC_HOST_CAP2_SDR50_TUNING_Msk        0x00002000U /*!< SDR50 needs tuning         */
 
 /* Xfer Mode Control */
 #define SDMMC_XFER_MODE_DMA_EN_Pos              0U
@@ -391,6 +420,24 @@ typedef struct _adma2_desc_t{
 #define SDMMC_HOST_CTRL2_VER4_EN_Msk            (1U << 12U)
 #define SDMMC_HOST_CTRL2_CMD23_EN_Msk           (1U << 11U)
 #define SDMMC_HOST_CTRL2_SIGNALING_EN_Msk       (1U << 3U)
+#define SDMMC_HOST_CTRL2_UHS_MODE_SEL_Msk       0x7U
+#define SDMMC_HOST_CTRL2_EXEC_TUNING_Msk        (1U << 6U)
+#define SDMMC_HOST_CTRL2_SAMPLE_CLK_SEL_Msk     (1U << 7U)
+#define SDMMC_HOST_CTRL2_UHS_SDR12              0x0U
+#define SDMMC_HOST_CTRL2_UHS_SDR25              0x1U
+#define SDMMC_HOST_CTRL2_UHS_SDR50              0x2U
+#define SDMMC_HOST_CTRL2_UHS_SDR104             0x3U
+#define SDMMC_HOST_CTRL2_UHS_DDR50              0x4U
+
+/* Switch function (CMD6) and tuning (CMD19) */
+#define SDMMC_SWITCH_MODE_CHECK                 0x00000000U
+#define SDMMC_SWITCH_MODE_SET                   0x80000000U
+#define SDMMC_SWITCH_GRP_KEEP                   0x00FFFFF0U /*!< Groups 2-6 unchanged          */
+#define SDMMC_SWITCH_STATUS_LEN                 64U         /*!< Switch status block, bytes    */
+#define SDMMC_SWITCH_GRP1_SUPPORT_BYTE          12U         /*!< Status bits 415:400           */
+#define SDMMC_SWITCH_GRP1_SELECT_BYTE           16U         /*!< Status bits 379:376           */
+#define SDMMC_TUNING_BLK_LEN                    64U         /*!< CMD19 tuning block, 4bit bus  */
+#define SDMMC_TUNING_MAX_LOOP                   40U
 
 /* Card Interface Conditions constants */
 #define SDMMC_CMD8_VOL_PATTERN                  0x1AAU   /*!< CMD8 Voltage Pattern */
@@ -43,6 +43,7 @@ int8_t dma_allocate_channel(dma_config_info_t *dma_cfg)
 
             channel_info  = &channel_thread[channel_num].channel_info;
             channel_info->flags = 0;
+            channel_info->periods = 0;
 
             return (int8_t)channel_num;
         }
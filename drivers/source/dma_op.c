@@ -24,46 +24,31 @@
 #include <stdbool.h>
 
 /**
-  \fn          bool dma_generate_opcode(dma_config_info_t *dma_cfg,
-                                        uint8_t            channel_num)
-  \brief       Prepare the DMA opcode for the channel
-  \param[in]   dma_cfg  Pointer to DMA Configuration resources
-  \param[in]   channel_num  Channel Number
+  \fn          static bool dma_construct_bursts(dma_channel_info_t *channel_info,
+                                                dma_desc_info_t    *desc,
+                                                dma_ccr_t           dma_ccr,
+                                                dma_opcode_buf     *op_buf)
+  \brief       Append the burst loops and the remainder moving desc->total_len
+               bytes from the current SAR to the current DAR. LC1 is only
+               used when the block needs DMA_MAX_LP_CNT bursts or more.
+  \param[in]   channel_info  Channel information (flags)
+  \param[in]   desc  Block to be transferred
+  \param[in]   dma_ccr  Channel control for the block
+  \param[in]   op_buf  Opcode buffer info
   \return      bool false if the buffer is not enough, true otherwise
 */
-bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
+static bool dma_construct_bursts(dma_channel_info_t *channel_info,
+                                 dma_desc_info_t    *desc,
+                                 dma_ccr_t           dma_ccr,
+                                 dma_opcode_buf     *op_buf)
 {
-    dma_thread_info_t  *thread_info   = &dma_cfg->channel_thread[channel_num];
-    dma_channel_info_t *channel_info  = &thread_info->channel_info;
-    dma_desc_info_t    *desc          = &channel_info->desc_info;
-    dma_ccr_t           dma_ccr;
     dma_loop_t          lp_args;
-    dma_opcode_buf      op_buf;
     uint32_t            total_bytes, req_burst, rem_blen;
     uint32_t            burst, rem_bytes;
     uint16_t            lp_start_lc1, lp_start_lc0;
     uint16_t            lc0, lc1;
     DMA_XFER            xfer_type;
-    bool                ret;
-
-    op_buf.buf      = &thread_info->dma_mcode[0];
-    op_buf.buf_size = DMA_MICROCODE_SIZE;
-    op_buf.off      = 0;
-
-
-    dma_ccr = dma_get_channel_ctrl_info(dma_cfg, channel_num);
-
-    ret = dma_construct_move(dma_ccr.value, DMA_REG_CCR, &op_buf);
-    if(!ret)
-        return ret;
-
-    ret = dma_construct_move(desc->src_addr, DMA_REG_SAR, &op_buf);
-    if(!ret)
-        return ret;
-
-    ret = dma_construct_move(desc->dst_addr, DMA_REG_DAR, &op_buf);
-    if(!ret)
-        return ret;
+    bool                ret = true;
 
     burst       = (1 << desc->dst_bsize) * desc->dst_blen;
     total_bytes = desc->total_len;
@@ -95,20 +80,20 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
         lp_start_lc1 = 0;
         if(lc1)
         {
-            ret = dma_construct_loop(DMA_LC_1, (uint8_t)lc1, &op_buf);
+            ret = dma_construct_loop(DMA_LC_1, (uint8_t)lc1, op_buf);
             if(!ret)
                 return ret;
-            lp_start_lc1 = op_buf.off;
+            lp_start_lc1 = op_buf->off;
         }
 
         if(lc0 == 0)
             return ret;
 
-        ret = dma_construct_loop(DMA_LC_0, (uint8_t)lc0, &op_buf);
+        ret = dma_construct_loop(DMA_LC_0, (uint8_t)lc0, op_buf);
         if(!ret)
             return ret;
 
-        lp_start_lc0 = op_buf.off;
+        lp_start_lc0 = op_buf->off;
 
         if(desc->dst_blen == 1)
             xfer_type = DMA_XFER_SINGLE;
@@ -119,24 +104,24 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
         {
             if(!(channel_info->flags & DMA_CHANNEL_FLAG_CRC_MODE))
             {
-                ret = dma_construct_flushperiph(desc->periph_num, &op_buf);
+                ret = dma_construct_flushperiph(desc->periph_num, op_buf);
                 if (!ret)
                     return ret;
 
-                ret = dma_construct_wfp(xfer_type, desc->periph_num, &op_buf);
+                ret = dma_construct_wfp(xfer_type, desc->periph_num, op_buf);
                 if (!ret)
                     return ret;
             }
 
             if(desc->direction ==  DMA_TRANSFER_MEM_TO_DEV)
             {
-                ret = dma_construct_load(xfer_type, &op_buf);
+                ret = dma_construct_load(xfer_type, op_buf);
                 if(!ret)
                     return ret;
 
                 if(channel_info->flags & DMA_CHANNEL_FLAG_CRC_MODE)
                 {
-                    ret = dma_construct_store(xfer_type, &op_buf);
+                    ret = dma_construct_store(xfer_type, op_buf);
                     if (!ret)
                         return ret;
                 }
@@ -144,7 +129,7 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
                 {
                     ret = dma_construct_storeperiph(xfer_type,
                                                     desc->periph_num,
-                                                    &op_buf);
+                                                    op_buf);
                     if(!ret)
                         return ret;
                 }
@@ -152,7 +137,7 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
                 /* If I2S mono mode is enabled for this channel, write zeros */
                 if(channel_info->flags & DMA_CHANNEL_FLAG_I2S_MONO_MODE)
                 {
-                    ret = dma_construct_store_zeros(&op_buf);
+                    ret = dma_construct_store_zeros(op_buf);
                     if(!ret)
                         return ret;
                 }
@@ -161,11 +146,11 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
             {
                 ret = dma_construct_loadperiph(xfer_type,
                                                desc->periph_num,
-                                               &op_buf);
+                                               op_buf);
                 if(!ret)
                     return ret;
 
-                ret = dma_construct_store(xfer_type, &op_buf);
+                ret = dma_construct_store(xfer_type, op_buf);
                 if(!ret)
                     return ret;
 
@@ -174,15 +159,15 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
                 {
                     ret = dma_construct_loadperiph(xfer_type,
                                                    desc->periph_num,
-                                                   &op_buf);
+                                                   op_buf);
                     if(!ret)
                         return ret;
-                    ret = dma_construct_store(xfer_type, &op_buf);
+                    ret = dma_construct_store(xfer_type, op_buf);
                     if(!ret)
                         return ret;
                     ret = dma_construct_addneg(DMA_REG_DAR,
                                                (int16_t)(1 << desc->dst_bsize),
-                                               &op_buf);
+                                               op_buf);
                     if(!ret)
                         return ret;
                 }
@@ -190,33 +175,33 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
         }
         else /* ARM_DMA_MEM_TO_MEM */
         {
-            ret = dma_construct_load(DMA_XFER_FORCE, &op_buf);
+            ret = dma_construct_load(DMA_XFER_FORCE, op_buf);
             if(!ret)
                 return ret;
-            ret = dma_construct_store(DMA_XFER_FORCE, &op_buf);
+            ret = dma_construct_store(DMA_XFER_FORCE, op_buf);
             if(!ret)
                 return ret;
         }
 
-        if((op_buf.off - lp_start_lc0) > DMA_MAX_BACKWARD_JUMP)
+        if((op_buf->off - lp_start_lc0) > DMA_MAX_BACKWARD_JUMP)
             return false;
-        lp_args.jump = (uint8_t)(op_buf.off - lp_start_lc0);
+        lp_args.jump = (uint8_t)(op_buf->off - lp_start_lc0);
         lp_args.lc = DMA_LC_0;
         lp_args.nf = 1;
         lp_args.xfer_type = DMA_XFER_FORCE;
-        ret = dma_construct_loopend(&lp_args, &op_buf);
+        ret = dma_construct_loopend(&lp_args, op_buf);
         if(!ret)
             return ret;
 
         if(lc1)
         {
-            if((op_buf.off - lp_start_lc1) > DMA_MAX_BACKWARD_JUMP)
+            if((op_buf->off - lp_start_lc1) > DMA_MAX_BACKWARD_JUMP)
                 return false;
-            lp_args.jump = (uint8_t)(op_buf.off - lp_start_lc1);
+            lp_args.jump = (uint8_t)(op_buf->off - lp_start_lc1);
             lp_args.lc = DMA_LC_1;
             lp_args.nf = 1;
             lp_args.xfer_type = DMA_XFER_FORCE;
-            ret = dma_construct_loopend(&lp_args, &op_buf);
+            ret = dma_construct_loopend(&lp_args, op_buf);
             if(!ret)
                 return ret;
         }
@@ -228,7 +213,7 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
         dma_ccr.value_b.dst_burst_len = rem_blen - 1;
         dma_ccr.value_b.src_burst_len = rem_blen - 1;
 
-        ret = dma_construct_move(dma_ccr.value, DMA_REG_CCR, &op_buf);
+        ret = dma_construct_move(dma_ccr.value, DMA_REG_CCR, op_buf);
         if(!ret)
             return ret;
 
@@ -236,25 +221,25 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
         {
             if(!(channel_info->flags & DMA_CHANNEL_FLAG_CRC_MODE))
             {
-                ret = dma_construct_flushperiph(desc->periph_num, &op_buf);
+                ret = dma_construct_flushperiph(desc->periph_num, op_buf);
                 if(!ret)
                     return ret;
 
                 ret = dma_construct_wfp(DMA_XFER_BURST,
                                         desc->periph_num,
-                                        &op_buf);
+                                        op_buf);
                 if(!ret)
                     return ret;
             }
 
             if(desc->direction ==  DMA_TRANSFER_MEM_TO_DEV)
             {
-                ret = dma_construct_load(DMA_XFER_BURST, &op_buf);
+                ret = dma_construct_load(DMA_XFER_BURST, op_buf);
                 if(!ret)
                     return ret;
 
                 if(channel_info->flags & DMA_CHANNEL_FLAG_CRC_MODE) {
-                    ret = dma_construct_store(DMA_XFER_BURST, &op_buf);
+                    ret = dma_construct_store(DMA_XFER_BURST, op_buf);
                     if(!ret)
                         return ret;
                 }
@@ -262,7 +247,7 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
                 {
                     ret = dma_construct_storeperiph(DMA_XFER_BURST,
                                                     desc->periph_num,
-                                                    &op_buf);
+                                                    op_buf);
                     if(!ret)
                         return ret;
                 }
@@ -270,7 +255,7 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
                 /* If I2S mono mode is enabled for this channel, write zeros */
                 if(channel_info->flags & DMA_CHANNEL_FLAG_I2S_MONO_MODE)
                 {
-                    ret = dma_construct_store_zeros(&op_buf);
+                    ret = dma_construct_store_zeros(op_buf);
                     if(!ret)
                         return ret;
                 }
@@ -279,11 +264,11 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
             {
                 ret = dma_construct_loadperiph(DMA_XFER_BURST,
                                                desc->periph_num,
-                                               &op_buf);
+                                               op_buf);
                 if(!ret)
                     return ret;
 
-                ret = dma_construct_store(DMA_XFER_BURST, &op_buf);
+                ret = dma_construct_store(DMA_XFER_BURST, op_buf);
                 if(!ret)
                     return ret;
 
@@ -292,15 +277,15 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
                 {
                     ret = dma_construct_loadperiph(DMA_XFER_BURST,
                                                    desc->periph_num,
-                                                   &op_buf);
+                                                   op_buf);
                     if(!ret)
                         return ret;
-                    ret = dma_construct_store(DMA_XFER_BURST, &op_buf);
+                    ret = dma_construct_store(DMA_XFER_BURST, op_buf);
                     if(!ret)
                         return ret;
                     ret = dma_construct_addneg(DMA_REG_DAR,
                                                (int16_t)(1 << desc->dst_bsize),
-                                               &op_buf);
+                                               op_buf);
                     if(!ret)
                         return ret;
                 }
@@ -308,15 +293,180 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
         }
         else /* ARM_DMA_MEM_TO_MEM */
         {
-            ret = dma_construct_load(DMA_XFER_FORCE, &op_buf);
+            ret = dma_construct_load(DMA_XFER_FORCE, op_buf);
             if(!ret)
                 return ret;
-            ret = dma_construct_store(DMA_XFER_FORCE, &op_buf);
+            ret = dma_construct_store(DMA_XFER_FORCE, op_buf);
             if(!ret)
                 return ret;
         }
     }
 
+    return true;
+}
+
+/**
+  \fn          static bool dma_construct_xfer(dma_channel_info_t *channel_info,
+                                              dma_desc_info_t    *desc,
+                                              dma_ccr_t           dma_ccr,
+                                              dma_opcode_buf     *op_buf)
+  \brief       Append the opcodes moving one contiguous block: CCR, SAR and
+               DAR set up followed by the burst loops and the remainder
+  \param[in]   channel_info  Channel information (flags)
+  \param[in]   desc  Block to be transferred
+  \param[in]   dma_ccr  Channel control for the block
+  \param[in]   op_buf  Opcode buffer info
+  \return      bool false if the buffer is not enough, true otherwise
+*/
+static bool dma_construct_xfer(dma_channel_info_t *channel_info,
+                               dma_desc_info_t    *desc,
+                               dma_ccr_t           dma_ccr,
+                               dma_opcode_buf     *op_buf)
+{
+    bool ret;
+
+    ret = dma_construct_move(dma_ccr.value, DMA_REG_CCR, op_buf);
+    if(!ret)
+        return ret;
+
+    /* Remembered for dma_patch_opcode_addr() */
+    channel_info->sar_off = op_buf->off;
+
+    ret = dma_construct_move(desc->src_addr, DMA_REG_SAR, op_buf);
+    if(!ret)
+        return ret;
+
+    channel_info->dar_off = op_buf->off;
+
+    ret = dma_construct_move(desc->dst_addr, DMA_REG_DAR, op_buf);
+    if(!ret)
+        return ret;
+
+    return dma_construct_bursts(channel_info, desc, dma_ccr, op_buf);
+}
+
+/**
+  \fn          bool dma_generate_opcode(dma_config_info_t *dma_cfg,
+                                        uint8_t            channel_num)
+  \brief       Prepare the DMA opcode for the channel
+  \param[in]   dma_cfg  Pointer to DMA Configuration resources
+  \param[in]   channel_num  Channel Number
+  \return      bool false if the buffer is not enough, true otherwise
+*/
+bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
+{
+    dma_thread_info_t  *thread_info   = &dma_cfg->channel_thread[channel_num];
+    dma_channel_info_t *channel_info  = &thread_info->channel_info;
+    dma_desc_info_t    *desc          = &channel_info->desc_info;
+    dma_ccr_t           dma_ccr;
+    dma_opcode_buf      op_buf;
+    bool                ret;
+
+    op_buf.buf      = &thread_info->dma_mcode[0];
+    op_buf.buf_size = DMA_MICROCODE_SIZE;
+    op_buf.off      = 0;
+
+    channel_info->flags &= ~DMA_CHANNEL_FLAG_PREPARED;
+
+    dma_ccr = dma_get_channel_ctrl_info(dma_cfg, channel_num);
+
+    ret = dma_construct_xfer(channel_info, desc, dma_ccr, &op_buf);
+    if(!ret)
+        return ret;
+
+    ret = dma_construct_wmb(&op_buf);
+    if(!ret)
+        return ret;
+
+    ret = dma_construct_send_event(channel_info->event_index, &op_buf);
+    if(!ret)
+        return ret;
+
+    ret = dma_construct_end(&op_buf);
+    if(!ret)
+        return ret;
+
+    channel_info->flags |= DMA_CHANNEL_FLAG_PREPARED;
+
+    return true;
+}
+
+/**
+  \fn          bool dma_generate_cyclic_opcode(dma_config_info_t *dma_cfg,
+                                               uint8_t            channel_num)
+  \brief       Prepare a looping DMA opcode for the channel. The buffer is
+               split in equal periods, an event is raised after each period
+               and the program restarts from the buffer start forever:
+
+                   SAR/DAR = start
+                   LP LC1 periods
+                       CCR, period bursts (LC0 only), WMB, SEV
+                   LPEND LC1
+                   LPFE
+
+  \param[in]   dma_cfg  Pointer to DMA Configuration resources
+  \param[in]   channel_num  Channel Number
+  \return      bool false if the buffer is not enough or a period needs
+               DMA_MAX_LP_CNT bursts or more, true otherwise
+*/
+bool dma_generate_cyclic_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
+{
+    dma_thread_info_t  *thread_info   = &dma_cfg->channel_thread[channel_num];
+    dma_channel_info_t *channel_info  = &thread_info->channel_info;
+    dma_desc_info_t     period        = channel_info->desc_info;
+    dma_ccr_t           dma_ccr;
+    dma_loop_t          lp_args;
+    dma_opcode_buf      op_buf;
+    uint32_t            burst;
+    uint16_t            lp_start_fe, lp_start_lc1;
+    bool                ret;
+
+    channel_info->flags &= ~DMA_CHANNEL_FLAG_PREPARED;
+
+    if(!channel_info->periods)
+        return false;
+
+    period.total_len = period.total_len / channel_info->periods;
+
+    burst = (1 << period.dst_bsize) * period.dst_blen;
+    if((period.total_len / burst) >= DMA_MAX_LP_CNT)
+        return false;
+
+    op_buf.buf      = &thread_info->dma_mcode[0];
+    op_buf.buf_size = DMA_MICROCODE_SIZE;
+    op_buf.off      = 0;
+
+    dma_ccr = dma_get_channel_ctrl_info(dma_cfg, channel_num);
+
+    lp_start_fe = op_buf.off;
+
+    channel_info->sar_off = op_buf.off;
+
+    ret = dma_construct_move(period.src_addr, DMA_REG_SAR, &op_buf);
+    if(!ret)
+        return ret;
+
+    channel_info->dar_off = op_buf.off;
+
+    ret = dma_construct_move(period.dst_addr, DMA_REG_DAR, &op_buf);
+    if(!ret)
+        return ret;
+
+    ret = dma_construct_loop(DMA_LC_1, channel_info->periods, &op_buf);
+    if(!ret)
+        return ret;
+
+    lp_start_lc1 = op_buf.off;
+
+    /* The remainder of the previous period may have changed the burst */
+    ret = dma_construct_move(dma_ccr.value, DMA_REG_CCR, &op_buf);
+    if(!ret)
+        return ret;
+
+    ret = dma_construct_bursts(channel_info, &period, dma_ccr, &op_buf);
+    if(!ret)
+        return ret;
+
     ret = dma_construct_wmb(&op_buf);
     if(!ret)
         return ret;
@@ -325,9 +475,177 @@ bool dma_generate_opcode(dma_config_info_t *dma_cfg, uint8_t channel_num)
     if(!ret)
         return ret;
 
+    if((op_buf.off - lp_start_lc1) > DMA_MAX_BACKWARD_JUMP)
+        return false;
+    lp_args.jump = (uint8_t)(op_buf.off - lp_start_lc1);
+    lp_args.lc = DMA_LC_1;
+    lp_args.nf = 1;
+    lp_args.xfer_type = DMA_XFER_FORCE;
+    ret = dma_construct_loopend(&lp_args, &op_buf);
+    if(!ret)
+        return ret;
+
+    if((op_buf.off - lp_start_fe) > DMA_MAX_BACKWARD_JUMP)
+        return false;
+    lp_args.jump = (uint8_t)(op_buf.off - lp_start_fe);
+    lp_args.nf = 0;
+    ret = dma_construct_loopend(&lp_args, &op_buf);
+    if(!ret)
+        return ret;
+
     ret = dma_construct_end(&op_buf);
     if(!ret)
         return ret;
 
+    channel_info->flags |= DMA_CHANNEL_FLAG_PREPARED;
+
     return true;
 }
+
+/**
+  \fn          void dma_patch_opcode_addr(dma_config_info_t *dma_cfg,
+                                           uint8_t            channel_num,
+                                           uint16_t          *off,
+                                           uint16_t          *len)
+  \brief       Rewrite the SAR/DAR immediates of a prepared opcode with the
+               addresses of the channel descriptor. Both DMAMOVs sit next
+               to each other, so the change spans at most two cache lines.
+  \param[in]   dma_cfg  Pointer to DMA Configuration resources
+  \param[in]   channel_num  Channel Number
+  \param[out]  off  Offset of the first modified byte
+  \param[out]  len  Number of bytes from off covering the modification
+  \return      None
+*/
+void dma_patch_opcode_addr(dma_config_info_t *dma_cfg,
+                           uint8_t            channel_num,
+                           uint16_t          *off,
+                           uint16_t          *len)
+{
+    dma_thread_info_t  *thread_info   = &dma_cfg->channel_thread[channel_num];
+    dma_channel_info_t *channel_info  = &thread_info->channel_info;
+    dma_desc_info_t    *desc          = &channel_info->desc_info;
+    dma_opcode_buf      op_buf;
+    uint16_t            first, last;
+
+    op_buf.buf      = &thread_info->dma_mcode[0];
+    op_buf.buf_size = DMA_MICROCODE_SIZE;
+
+    op_buf.off      = channel_info->sar_off;
+    dma_construct_move(desc->src_addr, DMA_REG_SAR, &op_buf);
+
+    op_buf.off      = channel_info->dar_off;
+    dma_construct_move(desc->dst_addr, DMA_REG_DAR, &op_buf);
+
+    first = channel_info->sar_off;
+    last  = channel_info->dar_off;
+    if(first > last)
+    {
+        first = channel_info->dar_off;
+        last  = channel_info->sar_off;
+    }
+
+    *off = first;
+    *len = (uint16_t)(last + DMA_OP_6BYTE_LEN - first);
+}
+
+/**
+  \fn          bool dma_sg_opcode_add(dma_config_info_t *dma_cfg,
+                                      uint8_t            channel_num,
+                                      const dma_sg_seg_t *seg,
+                                      dma_opcode_buf    *op_buf)
+  \brief       Append one scatter-gather segment to the channel program.
+               Direction, burst and peripheral come from the channel
+               descriptor; memory to memory segments drop the burst size
+               until it matches the segment alignment.
+  \param[in]   dma_cfg  Pointer to DMA Configuration resources
+  \param[in]   channel_num  Channel Number
+  \param[in]   seg  Segment to be appended
+  \param[in]   op_buf  Opcode buffer info
+  \return      bool false if the buffer is not enough or the segment is
+               not aligned to the burst size, true otherwise
+*/
+bool dma_sg_opcode_add(dma_config_info_t  *dma_cfg,
+                       uint8_t             channel_num,
+                       const dma_sg_seg_t *seg,
+                       dma_opcode_buf     *op_buf)
+{
+    dma_thread_info_t  *thread_info   = &dma_cfg->channel_thread[channel_num];
+    dma_channel_info_t *channel_info  = &thread_info->channel_info;
+    dma_desc_info_t     desc          = channel_info->desc_info;
+    dma_ccr_t           dma_ccr;
+    bool                ret;
+
+    /* dma_construct_xfer() moves sar_off/dar_off into this program, so
+       the channel program can't be re-armed by patching any more */
+    channel_info->flags &= ~DMA_CHANNEL_FLAG_PREPARED;
+
+    desc.src_addr  = seg->src_addr;
+    desc.dst_addr  = seg->dst_addr;
+    desc.total_len = seg->len;
+
+    if(desc.direction == DMA_TRANSFER_MEM_TO_MEM)
+    {
+        while((desc.dst_addr | desc.src_addr | desc.total_len) &
+              ((1 << desc.dst_bsize) - 1))
+        {
+            desc.dst_bsize = desc.dst_bsize - 1;
+        }
+    }
+    else if((desc.dst_addr | desc.src_addr | desc.total_len) &
+            ((1 << desc.dst_bsize) - 1))
+    {
+        return false;
+    }
+
+    desc.src_bsize = desc.dst_bsize;
+
+    dma_ccr = dma_get_channel_ctrl_info(dma_cfg, channel_num);
+    dma_ccr.value_b.dst_burst_size = desc.dst_bsize;
+    dma_ccr.value_b.src_burst_size = desc.src_bsize;
+
+    ret = dma_construct_xfer(channel_info, &desc, dma_ccr, op_buf);
+    if(!ret)
+        return ret;
+
+    if(seg->event)
+    {
+        /* Make the segment visible before signalling it */
+        ret = dma_construct_wmb(op_buf);
+        if(!ret)
+            return ret;
+
+        ret = dma_construct_send_event(channel_info->event_index, op_buf);
+        if(!ret)
+            return ret;
+    }
+
+    return true;
+}
+
+/**
+  \fn          bool dma_sg_opcode_end(dma_config_info_t *dma_cfg,
+                                      uint8_t            channel_num,
+                                      dma_opcode_buf    *op_buf)
+  \brief       Terminate the scatter-gather program of the channel
+  \param[in]   dma_cfg  Pointer to DMA Configuration resources
+  \param[in]   channel_num  Channel Number
+  \param[in]   op_buf  Opcode buffer info
+  \return      bool false if the buffer is not enough, true otherwise
+*/
+bool dma_sg_opcode_end(dma_config_info_t *dma_cfg,
+                       uint8_t            channel_num,
+                       dma_opcode_buf    *op_buf)
+{
+    bool ret;
+
+    ret = dma_construct_wmb(op_buf);
+    if(!ret)
+        return ret;
+
+    ret = dma_construct_send_event(dma_get_event_index(dma_cfg, channel_num),
+                                   op_buf);
+    if(!ret)
+        return ret;
+
+    return dma_construct_end(op_buf);
+}
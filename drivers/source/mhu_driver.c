@@ -33,6 +33,7 @@ void MHU_driver_initialize(mhu_driver_in_t * data_in,
                           data_in->rx_msg_callback);
 
   data_out->send_message = MHU_send_message;
+  data_out->send_message_async = MHU_send_message_async;
   data_out->sender_irq_handler = MHU_send_message_irq_handler;
   data_out->receiver_irq_handler = MHU_receive_message_irq_handler;
 }
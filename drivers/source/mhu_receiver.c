@@ -24,6 +24,17 @@
  *  M A C R O   D E F I N E S
  ******************************************************************************/
 
+// Valid channel bits of the last combined status register
+#if (MHU_CHANNELS % MHU_CHANNEL_GROUP_SIZE) != 0
+#define MHU_LAST_GROUP_MASK   ((1UL << (MHU_CHANNELS % MHU_CHANNEL_GROUP_SIZE)) - 1)
+#else
+#define MHU_LAST_GROUP_MASK   0xFFFFFFFFUL
+#endif
+
+#if MHU_RECEIVER_CYCLE_COUNT_ENABLE
+#define MHU_DWT_CYCCNT        0xE0001004UL
+#endif
+
 /*******************************************************************************
  *  T Y P E D E F S
  ******************************************************************************/
@@ -39,6 +50,8 @@
 static uint32_t s_receiver_frame_base_address_list[MHU_NUMBER_MAX];
 static uint32_t s_receiver_frame_count = 0;
 static MHU_rx_msg_callback_t s_callback;
+static MHU_rx_msg_callback_t s_channel_callback[MHU_NUMBER_MAX][MHU_CHANNELS];
+static MHU_receiver_stats_t s_receiver_stats[MHU_NUMBER_MAX];
 
 static bool receiver_id_valid(uint32_t receiver_id)
 {
@@ -57,41 +70,13 @@ static __inline MHU_receiver_frame_register_t
   return (MHU_receiver_frame_register_t *)receiver_address;
 }
 
-/**
- * @brief     Function clears the channel mask
- * @param[in] channel_number    Channel number
- * @return    Channel group number
- */
-static mhu_channel_combined_group_t sender_receiver_combined_ch_group(
-    mhu_channel_number_t channel_number)
-{
-  mhu_channel_combined_group_t channel_group;
-
-  if (channel_number < MHU_CHANNEL_32)
-  {
-    channel_group = MHU_CHANNEL_COMBINED_CH0_31;
-  }
-  else if (channel_number < MHU_CHANNEL_64)
-  {
-    channel_group = MHU_CHANNEL_COMBINED_CH32_63;
-  }
-  else if (channel_number < MHU_CHANNEL_96)
-  {
-    channel_group = MHU_CHANNEL_COMBINED_CH64_95;
-  }
-  else
-  {
-    channel_group = MHU_CHANNEL_COMBINED_CH96_123;
-  }
-
-  return channel_group;
-}
-
 /**
  * @fn        void MHU_receive_message_irq_handler(uint32_t receiver_id)
  * @brief     This functions handles received messages
  * @param[in] receiver_id    Receiver frame id
  * @return    none
+ * @note      Each combined status register is read once and only its set
+ *            bits are visited, lowest channel first.
  */
 void MHU_receive_message_irq_handler(uint32_t receiver_id)
 {
@@ -100,33 +85,114 @@ void MHU_receive_message_irq_handler(uint32_t receiver_id)
     return;
   }
 
+#if MHU_RECEIVER_CYCLE_COUNT_ENABLE
+  uint32_t start_cycles = READ_REGISTER_U32(MHU_DWT_CYCCNT);
+#endif
+  MHU_receiver_stats_t * stats = &s_receiver_stats[receiver_id];
+  uint32_t message_count = 0;
+
   MHU_receiver_frame_register_t * receiver_reg_base =
                       get_receiver_frame_base_address(receiver_id);
+  const volatile uint32_t * status_reg_base = &receiver_reg_base->CH_INT_ST0;
 
-  for (mhu_channel_number_t channel_number = 0;
-       channel_number < MHU_CHANNELS; channel_number++)
+  for (uint32_t channel_group = 0;
+       channel_group < MHU_CHANNEL_GROUPS; channel_group++)
   {
-    mhu_channel_combined_group_t channel_group =
-        sender_receiver_combined_ch_group(channel_number);
-
-    const volatile uint32_t * status_reg_base = &receiver_reg_base->CH_INT_ST0;
     uint32_t channel_irq_status = status_reg_base[channel_group];
 
-    // Message has been received on this channel
-    if (channel_irq_status & (0x1 << channel_number))
+    if (channel_group == (MHU_CHANNEL_GROUPS - 1))
+    {
+      channel_irq_status &= MHU_LAST_GROUP_MASK;
+    }
+
+    while (channel_irq_status != 0)
     {
+      // Lowest pending channel of the group, RBIT + CLZ on Armv8.1-M
+      uint32_t channel_number = (channel_group * MHU_CHANNEL_GROUP_SIZE)
+                                + (uint32_t)__builtin_ctz(channel_irq_status);
+      channel_irq_status &= channel_irq_status - 1;
+
       // Get message data
       uint32_t message_data = receiver_reg_base->CHANNEL[channel_number].CH_ST;
 
-      // Invoke the user callback
-      s_callback(receiver_id, channel_number, message_data);
-      debug_print("[MHU] rx isr: rx_id=0x%x ch_irq_status=0x%x ch=0x%x data=0x%x\n",
-                  receiver_id, channel_irq_status, channel_number, message_data);
+      // Invoke the channel callback, or the default one
+      MHU_rx_msg_callback_t callback =
+          s_channel_callback[receiver_id][channel_number];
+      if (NULL == callback)
+      {
+        callback = s_callback;
+      }
+      if (NULL != callback)
+      {
+        callback(receiver_id, channel_number, message_data);
+      }
+      debug_print("[MHU] rx isr: rx_id=0x%x ch=0x%x data=0x%x\n",
+                  receiver_id, channel_number, message_data);
 
       // Clear channel data
       WRITE_REGISTER_U32(&receiver_reg_base->CHANNEL[channel_number].CH_CLR, 0xFFFFFFFF);
+      message_count++;
     }
   }
+
+  stats->irq_count++;
+  stats->message_count += message_count;
+  if (0 == message_count)
+  {
+    stats->spurious_count++;
+  }
+
+#if MHU_RECEIVER_CYCLE_COUNT_ENABLE
+  uint32_t cycles = READ_REGISTER_U32(MHU_DWT_CYCCNT) - start_cycles;
+  stats->last_cycles = cycles;
+  if (cycles > stats->max_cycles)
+  {
+    stats->max_cycles = cycles;
+  }
+#endif
+}
+
+/**
+ * @fn        bool MHU_receiver_register_channel_callback(uint32_t receiver_id,
+ *                                     uint32_t channel_number,
+ *                                     MHU_rx_msg_callback_t callback)
+ * @brief     Register a dedicated callback for one receiver channel
+ * @param[in] receiver_id     Receiver frame id
+ * @param[in] channel_number  Channel number
+ * @param[in] callback        Channel callback, NULL restores the default
+ *                            callback given at initialization
+ * @return    false if the receiver or channel is invalid
+ */
+bool MHU_receiver_register_channel_callback(uint32_t receiver_id,
+                                            uint32_t channel_number,
+                                            MHU_rx_msg_callback_t callback)
+{
+  if (!receiver_id_valid(receiver_id) || (channel_number >= MHU_CHANNELS))
+  {
+    return false;
+  }
+
+  s_channel_callback[receiver_id][channel_number] = callback;
+  return true;
+}
+
+/**
+ * @fn        void MHU_receiver_get_stats(uint32_t receiver_id,
+ *                                        MHU_receiver_stats_t *stats)
+ * @brief     Read the receive interrupt statistics
+ * @param[in] receiver_id    Receiver frame id
+ * @param[out] stats         Statistics copy
+ * @return    none
+ */
+void MHU_receiver_get_stats(uint32_t receiver_id,
+                            MHU_receiver_stats_t *stats)
+{
+  if (!receiver_id_valid(receiver_id) || (NULL == stats))
+  {
+    return;
+  }
+
+  *stats = s_receiver_stats[receiver_id];
 }
 
 /**
@@ -199,6 +265,8 @@ void MHU_receiver_initialize(
   }
   s_receiver_frame_count = receiver_frame_count;
   s_callback = callback;
+  memset(s_channel_callback, 0, sizeof(s_channel_callback));
+  memset(s_receiver_stats, 0, sizeof(s_receiver_stats));
 
   MHU_receiver_interrupt_initialize(receiver_frame_count);
 }
@@ -20,6 +20,44 @@
 
 #define MHU_RECEIVER_TIMEOUT_MAX              0x100000
 
+/*
+ * Queued transmit state of a channel
+ */
+typedef enum
+{
+  MHU_SEND_STATE_IDLE,         // nothing in flight
+  MHU_SEND_STATE_WAIT_ACCESS,  // message popped, waiting for ACCESS_READY
+  MHU_SEND_STATE_WAIT_ACK,     // message written, waiting for the receiver
+} mhu_send_state_t;
+
+/*
+ * One FIFO slot. The sequence number tells producers and the consumer
+ * whose turn the slot is (bounded MPMC ring), so producers never take
+ * a lock and never wait for each other.
+ */
+typedef struct
+{
+  volatile uint32_t            sequence;
+  uint32_t                     message_data;
+  MHU_send_complete_callback_t callback;
+} mhu_send_queue_slot_t;
+
+/*
+ * Per channel transmit queue. Whoever holds 'owner' is the only consumer,
+ * ownership moves between the producer that found the channel idle and
+ * the sender interrupt.
+ */
+typedef struct
+{
+  mhu_send_queue_slot_t        slot[MHU_SEND_QUEUE_DEPTH];
+  volatile uint32_t            head;
+  volatile uint32_t            tail;
+  volatile uint32_t            owner;
+  volatile uint32_t            state;
+  uint32_t                     message_data;
+  MHU_send_complete_callback_t callback;
+} mhu_send_queue_t;
+
 static MHU_sender_callback s_nr2r_callback;
 static MHU_sender_callback s_r2nr_callback;
 static MHU_send_msg_acked_callback_t s_chcomb_callback;
@@ -28,6 +66,8 @@ static volatile bool nr2r_irq_occurred = false;
 static uint32_t s_sender_frame_base_address_list[MHU_NUMBER_MAX];
 static uint32_t s_sender_frame_count = 0;
 
+static mhu_send_queue_t s_send_queue[MHU_NUMBER_MAX][MHU_CHANNELS];
+
 /**
  * @fn    static bool sender_id_valid(uint32_t sender_id)
  * @param sender_id
@@ -103,7 +143,6 @@ static void clear_irq(MHU_sender_frame_register_t * sender_reg_base,
   WRITE_REGISTER_U32(&sender_reg_base->INT_CLR, mask);
 }
 
-#if 0
 /**
  * @brief     Function returns access ready status
  * @param     sender_id Sender frame ID
@@ -114,7 +153,172 @@ static bool sender_is_access_ready(uint32_t sender_id)
   MHU_sender_frame_register_t * sender_reg_base = get_sender_frame(sender_id);
   return (sender_reg_base->ACCESS_READY & MHU_ACC_RDY) == MHU_ACC_RDY;
 }
-#endif
+
+/**
+ * @brief     Add a message to a channel queue, safe against concurrent
+ *            producers
+ * @param     queue
+ * @param     message_data
+ * @param     callback
+ * @return    false if the queue is full
+ */
+static bool send_queue_push(mhu_send_queue_t * queue,
+                            uint32_t message_data,
+                            MHU_send_complete_callback_t callback)
+{
+  mhu_send_queue_slot_t * slot;
+  uint32_t pos = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+
+  while (1)
+  {
+    slot = &queue->slot[pos & (MHU_SEND_QUEUE_DEPTH - 1)];
+    uint32_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+    int32_t diff = (int32_t)(sequence - pos);
+
+    if (diff == 0)
+    {
+      if (__atomic_compare_exchange_n(&queue->tail, &pos, pos + 1, true,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      {
+        break;
+      }
+    }
+    else if (diff < 0)
+    {
+      return false;
+    }
+    else
+    {
+      pos = __atomic_load_n(&queue->tail, __ATOMIC_RELAXED);
+    }
+  }
+
+  slot->message_data = message_data;
+  slot->callback = callback;
+  __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+  return true;
+}
+
+/**
+ * @brief     Check whether the oldest slot of a channel queue holds a
+ *            published message
+ * @param     queue
+ * @return    true if send_queue_pop() would succeed
+ */
+static bool send_queue_head_published(mhu_send_queue_t * queue)
+{
+  uint32_t pos = queue->head;
+  mhu_send_queue_slot_t * slot = &queue->slot[pos & (MHU_SEND_QUEUE_DEPTH - 1)];
+
+  return (int32_t)(__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) - (pos + 1)) >= 0;
+}
+
+/**
+ * @brief     Take the oldest message of a channel queue into the in-flight
+ *            slot, only called by the queue owner
+ * @param     queue
+ * @return    false if the queue is empty
+ */
+static bool send_queue_pop(mhu_send_queue_t * queue)
+{
+  uint32_t pos = queue->head;
+  mhu_send_queue_slot_t * slot = &queue->slot[pos & (MHU_SEND_QUEUE_DEPTH - 1)];
+
+  if (!send_queue_head_published(queue))
+  {
+    return false;
+  }
+
+  queue->message_data = slot->message_data;
+  queue->callback = slot->callback;
+  __atomic_store_n(&slot->sequence, pos + MHU_SEND_QUEUE_DEPTH, __ATOMIC_RELEASE);
+  queue->head = pos + 1;
+  return true;
+}
+
+/**
+ * @brief     Write the in-flight message once access is granted. Called
+ *            from both the producer and the NR2R interrupt, whoever moves
+ *            the channel out of WAIT_ACCESS first writes the message.
+ * @param     sender_id
+ * @param     channel_number
+ */
+static void send_queue_transmit(uint32_t sender_id, uint32_t channel_number)
+{
+  mhu_send_queue_t * queue = &s_send_queue[sender_id][channel_number];
+  uint32_t expected = MHU_SEND_STATE_WAIT_ACCESS;
+
+  if (!__atomic_compare_exchange_n(&queue->state, &expected,
+                                   MHU_SEND_STATE_WAIT_ACK, false,
+                                   __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+  {
+    return;
+  }
+
+  MHU_sender_frame_register_t * sender_reg_base = get_sender_frame(sender_id);
+
+  // Enable channel interrupt
+  WRITE_REGISTER_U32(&sender_reg_base->CHANNEL[channel_number].CH_INT_CLR, MHU_CH_CLR);
+  WRITE_REGISTER_U32(&sender_reg_base->CHANNEL[channel_number].CH_INT_EN, MHU_CH_CLR);
+
+  // Write message to send channel
+  sender_reg_base->CHANNEL[channel_number].CH_SET = queue->message_data;
+}
+
+/**
+ * @brief     Start the next queued message of a channel, or give up the
+ *            queue ownership when it is empty. Caller must own the queue.
+ * @param     sender_id
+ * @param     channel_number
+ */
+static void send_queue_start_next(uint32_t sender_id, uint32_t channel_number)
+{
+  mhu_send_queue_t * queue = &s_send_queue[sender_id][channel_number];
+
+  while (1)
+  {
+    if (send_queue_pop(queue))
+    {
+      queue->state = MHU_SEND_STATE_WAIT_ACCESS;
+      sender_request_access(sender_id);
+
+      // NR2R does not fire again if access is already granted
+      if (sender_is_access_ready(sender_id))
+      {
+        send_queue_transmit(sender_id, channel_number);
+      }
+      return;
+    }
+
+    __atomic_store_n(&queue->owner, 0, __ATOMIC_RELEASE);
+
+    // A producer may have published after the pop but before the release.
+    // A slot claimed but not yet published is left to its producer, which
+    // takes the ownership itself once it has published.
+    if (!send_queue_head_published(queue)
+        || (__atomic_exchange_n(&queue->owner, 1, __ATOMIC_ACQ_REL) != 0))
+    {
+      return;
+    }
+  }
+}
+
+/**
+ * @brief     Check that no queued message of a sender frame is in flight
+ * @param     sender_id
+ * @return    true if every channel queue is idle
+ */
+static bool send_queue_frame_idle(uint32_t sender_id)
+{
+  for (uint32_t channel = 0; channel < MHU_CHANNELS; channel++)
+  {
+    if (s_send_queue[sender_id][channel].state != MHU_SEND_STATE_IDLE)
+    {
+      return false;
+    }
+  }
+  return true;
+}
 
 /**
  * @brief     Interrupt handler for send message
@@ -142,6 +346,12 @@ void MHU_send_message_irq_handler(uint32_t sender_id)
       s_nr2r_callback();
     }
     nr2r_irq_occurred = true;
+
+    // Write the queued messages waiting for access
+    for (uint32_t channel = 0; channel < MHU_CHANNELS; channel++)
+    {
+      send_queue_transmit(sender_id, channel);
+    }
   }
 
   if (status & MHU_R2NR)
@@ -161,7 +371,7 @@ void MHU_send_message_irq_handler(uint32_t sender_id)
     // Send OS message for Channel combined interrupt
     const volatile uint32_t * status_reg_base = &sender_reg_base->CH_INT_ST0;
     chcomb_status = status_reg_base[MHU_CHANNEL_COMBINED_CH0_31];
-    for(uint32_t channel = 0; channel < 2; channel++)
+    for(uint32_t channel = 0; channel < MHU_CHANNELS; channel++)
     {
       if (chcomb_status & (1 << channel))
       {
@@ -174,6 +384,29 @@ void MHU_send_message_irq_handler(uint32_t sender_id)
           // Disable channel interrupt
           CLEAR_REGISTER_BITS_U32(&sender_reg_base->CHANNEL[channel].CH_INT_EN, MHU_CH_CLR);
 
+          mhu_send_queue_t * queue = &s_send_queue[sender_id][channel];
+          if (queue->state == MHU_SEND_STATE_WAIT_ACK)
+          {
+            uint32_t message_data = queue->message_data;
+            MHU_send_complete_callback_t callback = queue->callback;
+
+            // Issue the next queued message before notifying the client
+            queue->state = MHU_SEND_STATE_IDLE;
+            send_queue_start_next(sender_id, channel);
+
+            if (send_queue_frame_idle(sender_id))
+            {
+              sender_release_access(sender_id);
+            }
+
+            if (NULL != callback)
+            {
+              callback(sender_id, channel, message_data,
+                       MHU_SEND_COMPLETED_OK);
+            }
+            continue;
+          }
+
           sender_release_access(sender_id);
 
           // Invoke the user callback
@@ -270,6 +503,47 @@ mhu_send_status_t MHU_send_message(uint32_t sender_id,
   return MHU_SEND_OK;
 }
 
+/**
+ * @brief     Queue a message on a channel without waiting
+ * @param     sender_id
+ * @param     channel_number
+ * @param     message_data
+ * @param     callback         Called from the sender interrupt once the
+ *                             receiver acknowledged the message, may be NULL
+ * @return    MHU_SEND_OK              Message was queued
+ *            MHU_SEND_RECEIVER_BUSY   Channel queue is full
+ *            MHU_SEND_FAILED          Invalid sender or channel
+ * @note      Producers may run in thread or interrupt context, but not at
+ *            a higher priority than the sender interrupt. Queued and
+ *            blocking MHU_send_message() traffic must not share a sender
+ *            frame.
+ */
+mhu_send_status_t MHU_send_message_async(uint32_t sender_id,
+                                         uint32_t channel_number,
+                                         uint32_t message_data,
+                                         MHU_send_complete_callback_t callback)
+{
+  if (!sender_id_valid(sender_id) || (channel_number >= MHU_CHANNELS))
+  {
+    return MHU_SEND_FAILED;
+  }
+
+  mhu_send_queue_t * queue = &s_send_queue[sender_id][channel_number];
+
+  if (!send_queue_push(queue, message_data, callback))
+  {
+    return MHU_SEND_RECEIVER_BUSY;
+  }
+
+  // Start the channel if nobody else is draining it
+  if (__atomic_exchange_n(&queue->owner, 1, __ATOMIC_ACQ_REL) == 0)
+  {
+    send_queue_start_next(sender_id, channel_number);
+  }
+
+  return MHU_SEND_OK;
+}
+
 /**
  *
  * @param sender_frame_base_address_list
@@ -290,6 +564,23 @@ void MHU_sender_initialize(uint32_t sender_frame_base_address_list[],
   s_r2nr_callback = NULL;
   s_chcomb_callback = msg_acked_callback;
 
+  for (uint32_t sender_id = 0; sender_id < sender_frame_count; sender_id++)
+  {
+    for (uint32_t channel = 0; channel < MHU_CHANNELS; channel++)
+    {
+      mhu_send_queue_t * queue = &s_send_queue[sender_id][channel];
+
+      for (uint32_t i = 0; i < MHU_SEND_QUEUE_DEPTH; i++)
+      {
+        queue->slot[i].sequence = i;
+      }
+      queue->head = 0;
+      queue->tail = 0;
+      queue->owner = 0;
+      queue->state = MHU_SEND_STATE_IDLE;
+    }
+  }
+
   uint32_t mask_disable = (MHU_CHCOMB | MHU_R2NR | MHU_NR2R);
   uint32_t mask_enable = (MHU_CHCOMB | MHU_R2NR | MHU_NR2R);
 
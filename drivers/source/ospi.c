@@ -459,7 +459,30 @@ void ospi_irq_handler(OSPI_Type *ospi, ospi_transfer_t *transfer)
         {
             tx_data = 0;
 
-            if (transfer->tx_buff == NULL)
+            if (transfer->tx_current_cnt < transfer->tx_hdr_cnt)
+            {
+                tx_data = transfer->tx_hdr[transfer->tx_current_cnt];
+            }
+            else if (transfer->tx_hdr_cnt)
+            {
+                /* Data following a header is packed in the frame width */
+                if (frame_size > SPI_CTRLR0_DFS_16bit)
+                {
+                    tx_data = transfer->tx_buff[0];
+                    transfer->tx_buff = (transfer->tx_buff + 1);
+                }
+                else if (frame_size > SPI_CTRLR0_DFS_8bit)
+                {
+                    tx_data = *((const uint16_t *) transfer->tx_buff);
+                    transfer->tx_buff = (const uint32_t *) ((const uint8_t *) transfer->tx_buff + sizeof(uint16_t));
+                }
+                else
+                {
+                    tx_data = *((const uint8_t *) transfer->tx_buff);
+                    transfer->tx_buff = (const uint32_t *) ((const uint8_t *) transfer->tx_buff + sizeof(uint8_t));
+                }
+            }
+            else if (transfer->tx_buff == NULL)
             {
                 /* Check if the default buffer transmit is enabled */
                 if (transfer->tx_default_enable == true)
@@ -65,6 +65,8 @@ SD_DRV_STATUS sd_host_init(sd_handle_t *pHsd, uint8_t bus_width, uint8_t dma_mod
     pHsd->state     = SD_CARD_STATE_INIT;
     pHsd->bus_width = bus_width;
     pHsd->dma_mode  = dma_mode;
+    pHsd->max_speed = RTE_SDC_BUS_SPEED;
+    pHsd->bus_speed = SDMMC_BUS_SPEED_DS;
 
     /* Get the Host Controller version */
     pHsd->hc_version = *((volatile uint16_t *)(SDMMC_HC_VERSION_REG)) & SDMMC_HC_VERSION_REG_Msk;
@@ -92,6 +94,17 @@ SD_DRV_STATUS sd_host_init(sd_handle_t *pHsd, uint8_t bus_width, uint8_t dma_mod
     hc_set_bus_power(pHsd, (uint8_t)(powerlevel | SDMMC_PC_BUS_PWR_VDD1_Msk));
     hc_set_tout(pHsd, 0xE);
 
+    /* Status enabled, signals only while queued requests are in flight */
+    hc_config_interrupt(pHsd);
+
+    pHsd->req_head = NULL;
+    pHsd->req_tail = NULL;
+
+    NVIC_DisableIRQ(SDMMC_IRQ_IRQn);
+    NVIC_ClearPendingIRQ(SDMMC_IRQ_IRQn);
+    NVIC_SetPriority(SDMMC_IRQ_IRQn, RTE_SDC_IRQ_PRI);
+    NVIC_EnableIRQ(SDMMC_IRQ_IRQn);
+
     if(pHsd->dma_mode == SDMMC_HOST_CTRL1_SDMA_MODE)
         hc_config_dma(pHsd, (uint8_t)(SDMMC_HOST_CTRL1_SDMA_MODE | SDMMC_HOST_CTRL1_DMA_SEL_1BIT_MODE));
     else if(pHsd->dma_mode == SDMMC_HOST_CTRL1_ADMA2_MODE)
@@ -200,13 +213,185 @@ SD_DRV_STATUS sd_card_init(sd_handle_t *pHsd){
         }
     }
 
+    /* Negotiate a faster bus, falls back down to default speed */
+    if(!(pHsd->sd_card.sdio_mode) && (pHsd->max_speed != SDMMC_BUS_SPEED_DS))
+        return sd_set_bus_speed(pHsd, (SDMMC_BUS_SPEED)pHsd->max_speed);
+
     reg = SDMMC_OP_CLK_DIVSOR_Msk | SDMMC_CLK_GEN_SEL_Msk | SDMMC_PLL_EN_Msk |
           SDMMC_CLK_EN_Msk | SDMMC_INTERNAL_CLK_EN_Msk;
     hc_set_clk_freq(pHsd, reg);
 
+    pHsd->sd_card.busspeed = SDMMC_CLK_25_MHZ;
+
     return SD_DRV_STATUS_OK;
 }
 
+/* Bus speed modes from the fastest to the slowest */
+static const uint8_t sd_speed_ladder[] = {
+    SDMMC_BUS_SPEED_SDR104,
+    SDMMC_BUS_SPEED_SDR50,
+    SDMMC_BUS_SPEED_DDR50,
+    SDMMC_BUS_SPEED_HS,
+    SDMMC_BUS_SPEED_DS
+};
+
+#define SD_SPEED_LADDER_LEN     (sizeof(sd_speed_ladder) / sizeof(sd_speed_ladder[0]))
+
+/* SD clock of every bus speed mode, indexed by SDMMC_BUS_SPEED */
+static const uint32_t sd_speed_clk[] = {
+    SDMMC_CLK_25_MHZ,
+    SDMMC_CLK_50_MHz,
+    SDMMC_CLK_100_MHZ,
+    SDMMC_CLK_100_MHZ,
+    SDMMC_CLK_50_MHz
+};
+
+/**
+  \fn           uint8_t sd_speed_usable(uint16_t card_support, uint32_t hc_caps2, uint8_t uhs, SDMMC_BUS_SPEED max)
+  \brief        Bus speed modes both the card and the host can run
+  \param[in]    card_support - CMD6 access mode support bits of the card
+  \param[in]    hc_caps2 - host capabilities 2 register
+  \param[in]    uhs - 1.8v signaling and 4bit bus are in place
+  \param[in]    max - fastest mode allowed
+  \return       bit mask of usable SDMMC_BUS_SPEED modes, default speed
+                is always included
+  */
+uint8_t sd_speed_usable(uint16_t card_support, uint32_t hc_caps2, uint8_t uhs, SDMMC_BUS_SPEED max){
+
+    uint8_t usable = (1U << SDMMC_BUS_SPEED_DS);
+
+    if(card_support & (1U << SDMMC_BUS_SPEED_HS))
+        usable |= (1U << SDMMC_BUS_SPEED_HS);
+
+    if(uhs){
+        if((card_support & (1U << SDMMC_BUS_SPEED_SDR50)) && (hc_caps2 & SDMMC_HOST_CAP2_SDR50_Msk))
+            usable |= (1U << SDMMC_BUS_SPEED_SDR50);
+        if((card_support & (1U << SDMMC_BUS_SPEED_SDR104)) && (hc_caps2 & SDMMC_HOST_CAP2_SDR104_Msk))
+            usable |= (1U << SDMMC_BUS_SPEED_SDR104);
+        if((card_support & (1U << SDMMC_BUS_SPEED_DDR50)) && (hc_caps2 & SDMMC_HOST_CAP2_DDR50_Msk))
+            usable |= (1U << SDMMC_BUS_SPEED_DDR50);
+    }
+
+    /* Drop the modes above max */
+    for(uint32_t i = 0; (i < SD_SPEED_LADDER_LEN) && (sd_speed_ladder[i] != max); i++)
+        usable &= (uint8_t)~(1U << sd_speed_ladder[i]);
+
+    return (uint8_t)(usable | (1U << SDMMC_BUS_SPEED_DS));
+}
+
+/**
+  \fn           SDMMC_BUS_SPEED sd_speed_next(uint8_t usable, SDMMC_BUS_SPEED cur)
+  \brief        Next mode to try on the fallback ladder
+  \param[in]    usable - bit mask from sd_speed_usable()
+  \param[in]    cur - mode that failed, SDMMC_BUS_SPEED_NONE for the first try
+  \return       next slower usable mode, SDMMC_BUS_SPEED_NONE at the end
+  */
+SDMMC_BUS_SPEED sd_speed_next(uint8_t usable, SDMMC_BUS_SPEED cur){
+
+    uint32_t i = 0;
+
+    if(cur != SDMMC_BUS_SPEED_NONE){
+        while((i < SD_SPEED_LADDER_LEN) && (sd_speed_ladder[i] != cur))
+            i++;
+        i++;
+    }
+
+    for(; i < SD_SPEED_LADDER_LEN; i++){
+        if(usable & (1U << sd_speed_ladder[i]))
+            return (SDMMC_BUS_SPEED)sd_speed_ladder[i];
+    }
+
+    return SDMMC_BUS_SPEED_NONE;
+}
+
+/**
+  \fn           SD_DRV_STATUS sd_set_bus_speed(sd_handle_t *pHsd, SDMMC_BUS_SPEED max)
+  \brief        Switch the card to the fastest mode up to max with CMD6,
+                tune the sampling point where required and step down the
+                ladder when switching or tuning fails
+  \param[in]    pHsd - Global SD Handle pointer
+  \param[in]    max - fastest mode allowed
+  \return       sd driver status
+  */
+SD_DRV_STATUS sd_set_bus_speed(sd_handle_t *pHsd, SDMMC_BUS_SPEED max){
+
+    uint8_t status[SDMMC_SWITCH_STATUS_LEN];
+    uint32_t caps2 = pHsd->regs->SDMMC_CAPABILITIES2_R;
+    uint16_t support = 0;
+    uint8_t uhs, usable, switched = (pHsd->bus_speed != SDMMC_BUS_SPEED_DS);
+    SDMMC_BUS_SPEED speed;
+
+    /* UHS-I modes need 1.8v signaling and the 4bit bus */
+    uhs = (pHsd->regs->SDMMC_HOST_CTRL2_R & SDMMC_HOST_CTRL2_SIGNALING_EN_Msk) &&
+          (pHsd->bus_width == SDMMC_4_BIT_MODE);
+
+    if(max != SDMMC_BUS_SPEED_DS){
+        if(hc_switch_func(pHsd, SDMMC_SWITCH_MODE_CHECK | SDMMC_SWITCH_GRP_KEEP | 0xFU, status) == SDMMC_HC_STATUS_OK)
+            support = (uint16_t)((status[SDMMC_SWITCH_GRP1_SUPPORT_BYTE] << 8) | status[SDMMC_SWITCH_GRP1_SUPPORT_BYTE + 1]);
+    }
+
+    usable = sd_speed_usable(support, caps2, uhs, max);
+
+    for(speed = sd_speed_next(usable, SDMMC_BUS_SPEED_NONE); speed != SDMMC_BUS_SPEED_NONE;
+        speed = sd_speed_next(usable, speed)){
+
+#ifdef SDMMC_PRINTF_DEBUG
+        printf("SD bus speed mode %d...\n", speed);
+#endif
+
+        /* A card that never left default speed needs no switch back */
+        if(switched || (speed != SDMMC_BUS_SPEED_DS)){
+
+            switched = 1;
+
+            if(hc_switch_func(pHsd, SDMMC_SWITCH_MODE_SET | SDMMC_SWITCH_GRP_KEEP | speed, status) != SDMMC_HC_STATUS_OK)
+                continue;
+
+            if((status[SDMMC_SWITCH_GRP1_SELECT_BYTE] & 0xFU) != speed)
+                continue;
+        }
+
+        if(hc_set_bus_speed(pHsd, speed) != SDMMC_HC_STATUS_OK)
+            continue;
+
+        if((speed == SDMMC_BUS_SPEED_SDR104) ||
+           ((speed == SDMMC_BUS_SPEED_SDR50) && (caps2 & SDMMC_HOST_CAP2_SDR50_TUNING_Msk))){
+            if(hc_execute_tuning(pHsd) != SDMMC_HC_STATUS_OK)
+                continue;
+        }
+
+        pHsd->bus_speed        = speed;
+        pHsd->sd_card.busspeed = sd_speed_clk[speed];
+
+        return SD_DRV_STATUS_OK;
+    }
+
+    return SD_DRV_STATUS_CARD_INIT_ERR;
+}
+
+/**
+  \fn           SD_DRV_STATUS sd_bus_speed(SDMMC_BUS_SPEED max)
+  \brief        Renegotiate the bus speed of the initialized card
+  \param[in]    max - fastest mode allowed
+  \return       sd driver status
+  */
+SD_DRV_STATUS sd_bus_speed(SDMMC_BUS_SPEED max){
+
+    if((Hsd.req_head != NULL) || (Hsd.state != SD_CARD_STATE_TRAN))
+        return SD_DRV_STATUS_CARD_INIT_ERR;
+
+    return sd_set_bus_speed(&Hsd, max);
+}
+
+/**
+  \fn           SDMMC_BUS_SPEED sd_get_bus_speed(void)
+  \brief        Bus speed mode in use
+  \return       SDMMC_BUS_SPEED
+  */
+SDMMC_BUS_SPEED sd_get_bus_speed(void){
+    return (SDMMC_BUS_SPEED)Hsd.bus_speed;
+}
+
 /**
   \fn           SD_init
   \brief        main SD initialize function
@@ -246,6 +431,14 @@ SD_DRV_STATUS sd_uninit(uint8_t devId)
 
     /* release the card */
     sd_handle_t *pHsd           = &Hsd;
+
+    /* Queued requests are dropped without a callback */
+    NVIC_DisableIRQ(SDMMC_IRQ_IRQn);
+    pHsd->regs->SDMMC_NORMAL_INT_SIGNAL_EN_R = 0U;
+    pHsd->regs->SDMMC_ERROR_INT_SIGNAL_EN_R  = 0U;
+    pHsd->req_head = NULL;
+    pHsd->req_tail = NULL;
+
     pHsd->sd_cmd.cmdidx         = CMD7;
     pHsd->sd_cmd.data_present   = 0;
     pHsd->sd_cmd.arg            = 0xFFFF0000; //any other RCA to perform card de-selection
@@ -290,6 +483,10 @@ SD_DRV_STATUS sd_read(uint32_t sec, uint16_t BlkCnt, volatile unsigned char *Des
     if(DestBuff == NULL)
         return SD_DRV_STATUS_RD_ERR;
 
+    /* The controller is owned by the request queue */
+    if(pHsd->req_head != NULL)
+        return SD_DRV_STATUS_RD_ERR;
+
 #ifdef SDMMC_PRINTF_DEBUG
     printf("SD READ Dest Buff: 0x%p Sec: %u, Block Count: %u\n",DestBuff,sec,BlkCnt);
 #endif
@@ -298,7 +495,10 @@ SD_DRV_STATUS sd_read(uint32_t sec, uint16_t BlkCnt, volatile unsigned char *Des
     pHsd->state = SD_CARD_STATE_DATA;
 
 retry:
-    hc_read_setup(pHsd, (uint32_t)LocalToGlobal((const volatile void *)DestBuff), sec, BlkCnt);
+    if(hc_read_setup(pHsd, (uint32_t)LocalToGlobal((const volatile void *)DestBuff), sec, BlkCnt) != SDMMC_HC_STATUS_OK){
+        pHsd->state = SD_CARD_STATE_TRAN;
+        return SD_DRV_STATUS_RD_ERR;
+    }
 
     if(hc_check_xfer_done(pHsd, timeout_cnt) == SDMMC_HC_STATUS_OK)
         RTSS_InvalidateDCache_by_Addr(DestBuff, BlkCnt * SDMMC_BLK_SIZE_512_Msk);
@@ -343,6 +543,10 @@ SD_DRV_STATUS sd_write(uint32_t sector, uint32_t BlkCnt, volatile unsigned char
     if(SrcBuff == NULL)
         return SD_DRV_STATUS_WR_ERR;
 
+    /* The controller is owned by the request queue */
+    if(pHsd->req_head != NULL)
+        return SD_DRV_STATUS_WR_ERR;
+
 #ifdef SDMMC_PRINTF_DEBUG
     printf("SD WRITE Src Buff: 0x%p Sec: %d, Block Count: %d\n",SrcBuff,sector,BlkCnt);
 #endif
@@ -351,7 +555,8 @@ SD_DRV_STATUS sd_write(uint32_t sector, uint32_t BlkCnt, volatile unsigned char
     RTSS_CleanDCache_by_Addr(SrcBuff, BlkCnt * SDMMC_BLK_SIZE_512_Msk);
 
 retry:
-    hc_write_setup(pHsd, (uint32_t)LocalToGlobal((const volatile void *)SrcBuff), sector, BlkCnt);
+    if(hc_write_setup(pHsd, (uint32_t)LocalToGlobal((const volatile void *)SrcBuff), sector, BlkCnt) != SDMMC_HC_STATUS_OK)
+        return SD_DRV_STATUS_WR_ERR;
 
     if(hc_check_xfer_done(pHsd, timeout_cnt) != SDMMC_HC_STATUS_OK){
         hc_reset(pHsd, (uint8_t)(SDMMC_SW_RST_DAT_Msk | SDMMC_SW_RST_CMD_Msk));
@@ -374,3 +579,322 @@ retry:
     return SD_DRV_STATUS_OK;
 }
 
+/**
+  \fn           static uint16_t sd_iov_blk_cnt(const sd_iovec_t *iov, uint32_t iovcnt)
+  \brief        Number of sectors covered by a list of buffer segments
+  \param[in]    iov - buffer segments
+  \param[in]    iovcnt - number of segments
+  \return       block count, 0 if the total is not a whole number of sectors
+  */
+static uint16_t sd_iov_blk_cnt(const sd_iovec_t *iov, uint32_t iovcnt){
+
+    uint32_t total = 0;
+
+    if((iov == NULL) || (iovcnt == 0))
+        return 0;
+
+    for(uint32_t i = 0; i < iovcnt; i++){
+        if(iov[i].buff == NULL)
+            return 0;
+        total += iov[i].len;
+    }
+
+    if((total % SDMMC_BLK_SIZE_512_Msk) || ((total / SDMMC_BLK_SIZE_512_Msk) > 0xFFFFU))
+        return 0;
+
+    return (uint16_t)(total / SDMMC_BLK_SIZE_512_Msk);
+}
+
+/**
+  \fn           SD_DRV_STATUS sd_readv(uint32_t sec, const sd_iovec_t *iov, uint32_t iovcnt)
+  \brief        Read consecutive sd sectors into a list of buffer segments
+                using one ADMA2 descriptor chain
+  \param[in]    sec - input sector number to read
+  \param[in]    iov - destination buffer segments, 4 byte aligned
+  \param[in]    iovcnt - number of segments
+  \return       sd driver status
+  */
+SD_DRV_STATUS sd_readv(uint32_t sec, const sd_iovec_t *iov, uint32_t iovcnt){
+
+    sd_handle_t *pHsd =  &Hsd;
+    uint16_t BlkCnt = sd_iov_blk_cnt(iov, iovcnt);
+    uint32_t timeout_cnt = 2000 * BlkCnt;
+    uint8_t retryCnt = 1;
+
+    if(!BlkCnt || (pHsd->req_head != NULL))
+        return SD_DRV_STATUS_RD_ERR;
+
+    /* Change the Card State from Tran to Data */
+    pHsd->state = SD_CARD_STATE_DATA;
+
+retry:
+    if(hc_readv_setup(pHsd, iov, iovcnt, sec, BlkCnt) != SDMMC_HC_STATUS_OK){
+        pHsd->state = SD_CARD_STATE_TRAN;
+        return SD_DRV_STATUS_RD_ERR;
+    }
+
+    if(hc_check_xfer_done(pHsd, timeout_cnt) == SDMMC_HC_STATUS_OK){
+        for(uint32_t i = 0; i < iovcnt; i++)
+            RTSS_InvalidateDCache_by_Addr(iov[i].buff, iov[i].len);
+    }else{
+        /* Soft reset Host controller cmd and data lines */
+        hc_reset(pHsd, (uint8_t)(SDMMC_SW_RST_DAT_Msk | SDMMC_SW_RST_CMD_Msk));
+
+        if(!retryCnt--)
+            return SD_DRV_STATUS_RD_ERR;
+        goto retry;
+    }
+
+    /* Change the Card State from Data to Tran */
+    pHsd->state = SD_CARD_STATE_TRAN;
+
+    return SD_DRV_STATUS_OK;
+}
+
+/**
+  \fn           SD_DRV_STATUS sd_writev(uint32_t sector, const sd_iovec_t *iov, uint32_t iovcnt)
+  \brief        Write consecutive sd sectors from a list of buffer segments
+                using one ADMA2 descriptor chain
+  \param[in]    sector - input sector number to write
+  \param[in]    iov - source buffer segments, 4 byte aligned
+  \param[in]    iovcnt - number of segments
+  \return       sd driver status
+  */
+SD_DRV_STATUS sd_writev(uint32_t sector, const sd_iovec_t *iov, uint32_t iovcnt){
+
+    sd_handle_t *pHsd =  &Hsd;
+    uint16_t BlkCnt = sd_iov_blk_cnt(iov, iovcnt);
+    uint32_t timeout_cnt = 2000 * BlkCnt;
+    uint8_t retryCnt = 1;
+
+    if(!BlkCnt || (pHsd->req_head != NULL))
+        return SD_DRV_STATUS_WR_ERR;
+
+    /* Clean the DCache */
+    for(uint32_t i = 0; i < iovcnt; i++)
+        RTSS_CleanDCache_by_Addr(iov[i].buff, iov[i].len);
+
+retry:
+    if(hc_writev_setup(pHsd, iov, iovcnt, sector, BlkCnt) != SDMMC_HC_STATUS_OK)
+        return SD_DRV_STATUS_WR_ERR;
+
+    if(hc_check_xfer_done(pHsd, timeout_cnt) != SDMMC_HC_STATUS_OK){
+        hc_reset(pHsd, (uint8_t)(SDMMC_SW_RST_DAT_Msk | SDMMC_SW_RST_CMD_Msk));
+
+        if(!retryCnt--)
+            return SD_DRV_STATUS_WR_ERR;
+        goto retry;
+    }
+
+    return SD_DRV_STATUS_OK;
+}
+
+/**
+  \fn           static SD_DRV_STATUS sd_req_issue(sd_handle_t *pHsd, sd_req_t *req)
+  \brief        Start the transfer of a queued request, completion is
+                signalled by the transfer complete or an error interrupt
+  \param[in]    pHsd - Global SD Handle pointer
+  \param[in]    req - request to start
+  \return       sd driver status, an error if the DMA could not be set up
+                and no command was issued
+  */
+static SD_DRV_STATUS sd_req_issue(sd_handle_t *pHsd, sd_req_t *req){
+
+    uint32_t buff = (uint32_t)LocalToGlobal((const volatile void *)req->buff);
+
+    pHsd->regs->SDMMC_NORMAL_INT_SIGNAL_EN_R = SDMMC_INTR_TC_Msk;
+    pHsd->regs->SDMMC_ERROR_INT_SIGNAL_EN_R  = SDMMC_ERROR_INTR_ALL_Msk;
+
+    if(req->write){
+        pHsd->state = SD_CARD_STATE_RCV;
+        if(hc_write_setup(pHsd, buff, req->sector, req->blk_cnt) == SDMMC_HC_STATUS_OK)
+            return SD_DRV_STATUS_OK;
+    }else{
+        pHsd->state = SD_CARD_STATE_DATA;
+        if(hc_read_setup(pHsd, buff, req->sector, req->blk_cnt) == SDMMC_HC_STATUS_OK)
+            return SD_DRV_STATUS_OK;
+    }
+
+    pHsd->state = SD_CARD_STATE_TRAN;
+
+    return req->write ? SD_DRV_STATUS_WR_ERR : SD_DRV_STATUS_RD_ERR;
+}
+
+/**
+  \fn           static sd_req_t *sd_req_start(sd_handle_t *pHsd)
+  \brief        Issue the request at the head of the queue. Requests that
+                can't be started are unlinked and returned, the caller
+                completes them with sd_req_fail().
+  \param[in]    pHsd - Global SD Handle pointer
+  \return       list of failed requests, NULL if none
+  */
+static sd_req_t *sd_req_start(sd_handle_t *pHsd){
+
+    sd_req_t *failed = NULL, **failed_tail = &failed, *req;
+
+    while((req = pHsd->req_head) != NULL){
+
+        if(sd_req_issue(pHsd, req) == SD_DRV_STATUS_OK)
+            return failed;
+
+        pHsd->req_head = req->next;
+        req->next      = NULL;
+        *failed_tail   = req;
+        failed_tail    = &req->next;
+    }
+
+    pHsd->req_tail = NULL;
+    pHsd->regs->SDMMC_NORMAL_INT_SIGNAL_EN_R = 0U;
+    pHsd->regs->SDMMC_ERROR_INT_SIGNAL_EN_R  = 0U;
+
+    return failed;
+}
+
+/**
+  \fn           static void sd_req_fail(sd_req_t *failed)
+  \brief        Call the callbacks of requests that could not be started
+  \param[in]    failed - list returned by sd_req_start()
+  \return       none
+  */
+static void sd_req_fail(sd_req_t *failed){
+
+    sd_req_t *req;
+
+    while(failed != NULL){
+        req       = failed;
+        failed    = req->next;
+        req->next = NULL;
+        req->cb(req, req->write ? SD_DRV_STATUS_WR_ERR : SD_DRV_STATUS_RD_ERR);
+    }
+}
+
+/**
+  \fn           SD_DRV_STATUS sd_submit(sd_req_t *req)
+  \brief        Queue a block read or write. The transfer starts right away
+                if the controller is idle, otherwise when the requests
+                queued before it are completed. req->cb is called from the
+                SDMMC interrupt once the request is done.
+  \param[in]    req - request, must stay valid until its callback
+  \return       sd driver status, on an error the request was not queued
+                and req->cb is not called
+  */
+SD_DRV_STATUS sd_submit(sd_req_t *req){
+
+    sd_handle_t *pHsd = &Hsd;
+    SD_DRV_STATUS status = SD_DRV_STATUS_OK;
+    uint32_t primask;
+
+    if((req == NULL) || (req->buff == NULL) || !req->blk_cnt || (req->cb == NULL) ||
+       ((pHsd->dma_mode == SDMMC_HOST_CTRL1_ADMA2_MODE) &&
+        (((uint32_t)req->buff & SDMMC_ADMA2_ALIGN_Msk) || (req->blk_cnt > SDMMC_ADMA2_MAX_BLK_CNT))))
+        return ((req != NULL) && req->write) ? SD_DRV_STATUS_WR_ERR : SD_DRV_STATUS_RD_ERR;
+
+    /* Clean the DCache */
+    if(req->write)
+        RTSS_CleanDCache_by_Addr(req->buff, req->blk_cnt * SDMMC_BLK_SIZE_512_Msk);
+
+    req->next  = NULL;
+    req->retry = 1;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if(pHsd->req_tail != NULL){
+        pHsd->req_tail->next = req;
+        pHsd->req_tail       = req;
+    }else{
+        pHsd->req_head = req;
+        pHsd->req_tail = req;
+        status = sd_req_issue(pHsd, req);
+        if(status != SD_DRV_STATUS_OK){
+            /* Nothing was started, the request goes back to the caller */
+            pHsd->req_head = NULL;
+            pHsd->req_tail = NULL;
+            pHsd->regs->SDMMC_NORMAL_INT_SIGNAL_EN_R = 0U;
+            pHsd->regs->SDMMC_ERROR_INT_SIGNAL_EN_R  = 0U;
+        }
+    }
+
+    __set_PRIMASK(primask);
+
+    return status;
+}
+
+/**
+  \fn           void sd_irq_handler(sd_handle_t *pHsd)
+  \brief        Complete the request in progress, start the next queued one
+                and then call the completion callback
+  \param[in]    pHsd - Global SD Handle pointer
+  \return       none
+  */
+void sd_irq_handler(sd_handle_t *pHsd){
+
+    sd_req_t *req = pHsd->req_head;
+    sd_req_t *failed;
+    SD_DRV_STATUS status;
+    uint16_t norm_stat, err_stat;
+
+    norm_stat = pHsd->regs->SDMMC_NORMAL_INT_STAT_R;
+    err_stat  = pHsd->regs->SDMMC_ERROR_INT_STAT_R;
+
+    if(req == NULL){
+        pHsd->regs->SDMMC_NORMAL_INT_SIGNAL_EN_R = 0U;
+        pHsd->regs->SDMMC_ERROR_INT_SIGNAL_EN_R  = 0U;
+        pHsd->regs->SDMMC_NORMAL_INT_STAT_R      = norm_stat;
+        pHsd->regs->SDMMC_ERROR_INT_STAT_R       = err_stat;
+        return;
+    }
+
+    if(err_stat || (norm_stat & SDMMC_INTR_ERR_Msk)){
+
+        pHsd->regs->SDMMC_ERROR_INT_STAT_R  = err_stat;
+        pHsd->regs->SDMMC_NORMAL_INT_STAT_R = norm_stat;
+
+        /* Soft reset Host controller cmd and data lines */
+        hc_reset(pHsd, (uint8_t)(SDMMC_SW_RST_DAT_Msk | SDMMC_SW_RST_CMD_Msk));
+
+        if(req->retry){
+            req->retry--;
+            if(sd_req_issue(pHsd, req) == SD_DRV_STATUS_OK)
+                return;
+        }
+
+        status = req->write ? SD_DRV_STATUS_WR_ERR : SD_DRV_STATUS_RD_ERR;
+    }else if(norm_stat & SDMMC_INTR_TC_Msk){
+
+        pHsd->regs->SDMMC_NORMAL_INT_STAT_R = norm_stat;
+
+        if(!req->write)
+            RTSS_InvalidateDCache_by_Addr(req->buff, req->blk_cnt * SDMMC_BLK_SIZE_512_Msk);
+
+        status = SD_DRV_STATUS_OK;
+    }else{
+        /* Not the end of the transfer */
+        pHsd->regs->SDMMC_NORMAL_INT_STAT_R = norm_stat;
+        return;
+    }
+
+    pHsd->regs->SDMMC_HOST_CTRL1_R &= (uint8_t)~SDMMC_HOST_CTRL1_LED_ON; //led caution off
+
+    /* Change the Card State back to Tran */
+    pHsd->state = SD_CARD_STATE_TRAN;
+
+    /* Keep the bus busy: issue the next request before the callback */
+    pHsd->req_head = req->next;
+    failed = sd_req_start(pHsd);
+
+    req->next = NULL;
+    req->cb(req, status);
+
+    /* Requests behind this one whose transfer could not be set up */
+    sd_req_fail(failed);
+}
+
+/**
+  \fn           void SDMMC_IRQHandler(void)
+  \brief        SDMMC interrupt handler
+  \return       none
+  */
+void SDMMC_IRQHandler(void){
+    sd_irq_handler(&Hsd);
+}
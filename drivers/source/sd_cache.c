@@ -0,0 +1,481 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/**************************************************************************//**
+ * @file     sd_cache.c
+ * @version  V0.0.1
+ * @brief    Optional SD sector cache with read-ahead and write-back.
+ *           Small requests are served from an LRU of 512 byte sectors,
+ *           misses on a sequential stream prefetch the following sectors
+ *           and dirty sectors are written back as multi-block runs.
+ * @bug      None.
+ * @Note     None
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "sd_cache.h"
+#include "string.h"
+
+/* Largest run moved by one card command, one ADMA2 descriptor per sector */
+#if (RTE_SDC_CACHE_SECTORS < SDMMC_ADMA2_DESC_TBL_SIZE)
+#define SD_CACHE_MAX_RUN            RTE_SDC_CACHE_SECTORS
+#else
+#define SD_CACHE_MAX_RUN            SDMMC_ADMA2_DESC_TBL_SIZE
+#endif
+
+/* Requests larger than this bypass the cache */
+#define SD_CACHE_BYPASS_BLKS        (RTE_SDC_CACHE_SECTORS / 2)
+
+/**
+ * @brief  Cache entry information
+ */
+typedef struct _sd_cache_entry_t{
+    uint32_t                sector;         /*!< Cached sector number                   */
+    uint32_t                stamp;          /*!< Last use, for LRU replacement          */
+    uint8_t                 valid;          /*!< Entry holds a sector                   */
+    uint8_t                 dirty;          /*!< Entry differs from the card            */
+}sd_cache_entry_t;
+
+static volatile uint8_t sd_cache_data[RTE_SDC_CACHE_SECTORS][SDMMC_BLK_SIZE_512_Msk] __attribute__((section(SD_CACHE_SECTION))) __attribute__((aligned(32)));
+
+static sd_cache_entry_t sd_cache_tbl[RTE_SDC_CACHE_SECTORS];
+static sd_cache_stats_t sd_cache_stats;
+static uint32_t sd_cache_clock;
+static uint32_t sd_cache_next_sec;
+static uint8_t  sd_cache_dma_mode;
+
+extern sd_handle_t Hsd;
+
+/* Global SD Cached Driver Callback definitions */
+const diskio_t SD_Cache_Driver =
+{
+    sd_cache_init,
+    sd_cache_uninit,
+    sd_state,
+    sd_cache_read,
+    sd_cache_write,
+};
+
+/**
+  \fn           static inline uint32_t sd_cache_cycles(void)
+  \brief        Current cycle count for the latency counters
+  \return       DWT cycle counter
+  */
+static inline uint32_t sd_cache_cycles(void){
+    return DWT->CYCCNT;
+}
+
+/**
+  \fn           static int32_t sd_cache_find(uint32_t sec)
+  \brief        Look up a sector in the cache
+  \param[in]    sec - sector number
+  \return       entry index, -1 if not cached
+  */
+static int32_t sd_cache_find(uint32_t sec){
+
+    for(int32_t i = 0; i < RTE_SDC_CACHE_SECTORS; i++){
+        if(sd_cache_tbl[i].valid && (sd_cache_tbl[i].sector == sec))
+            return i;
+    }
+
+    return -1;
+}
+
+/**
+  \fn           static void sd_cache_touch(int32_t idx)
+  \brief        Mark an entry as most recently used
+  \param[in]    idx - entry index
+  \return       none
+  */
+static void sd_cache_touch(int32_t idx){
+    sd_cache_tbl[idx].stamp = ++sd_cache_clock;
+}
+
+/**
+  \fn           static SD_DRV_STATUS sd_cache_card_xfer(uint32_t sec, const int32_t *idx, uint32_t cnt, uint8_t write)
+  \brief        Move consecutive sectors between the card and cache entries.
+                With ADMA2 the run is one multi-block command over all the
+                entries, otherwise one command per sector.
+  \param[in]    sec - first sector
+  \param[in]    idx - cache entry of every sector
+  \param[in]    cnt - number of sectors
+  \param[in]    write - 1: entries to card, 0: card to entries
+  \return       sd driver status
+  */
+static SD_DRV_STATUS sd_cache_card_xfer(uint32_t sec, const int32_t *idx, uint32_t cnt, uint8_t write){
+
+    sd_iovec_t iov[SD_CACHE_MAX_RUN];
+    SD_DRV_STATUS status = SD_DRV_STATUS_OK;
+    uint32_t start = sd_cache_cycles();
+
+    if(sd_cache_dma_mode == SDMMC_HOST_CTRL1_ADMA2_MODE){
+
+        for(uint32_t i = 0; i < cnt; i++){
+            iov[i].buff = sd_cache_data[idx[i]];
+            iov[i].len  = SDMMC_BLK_SIZE_512_Msk;
+        }
+
+        status = write ? sd_writev(sec, iov, cnt) : sd_readv(sec, iov, cnt);
+
+        if(write)
+            sd_cache_stats.card_writes++;
+        else
+            sd_cache_stats.card_reads++;
+    }else{
+
+        for(uint32_t i = 0; (i < cnt) && (status == SD_DRV_STATUS_OK); i++){
+
+            status = write ? sd_write(sec + i, 1, sd_cache_data[idx[i]]) :
+                             sd_read(sec + i, 1, sd_cache_data[idx[i]]);
+
+            if(write)
+                sd_cache_stats.card_writes++;
+            else
+                sd_cache_stats.card_reads++;
+        }
+    }
+
+    if(write)
+        sd_cache_stats.write_cycles += (uint32_t)(sd_cache_cycles() - start);
+    else
+        sd_cache_stats.read_cycles += (uint32_t)(sd_cache_cycles() - start);
+
+    return status;
+}
+
+/**
+  \fn           SD_DRV_STATUS sd_cache_flush(void)
+  \brief        Write back all dirty sectors in ascending order, adjacent
+                sectors are coalesced into one multi-block write
+  \return       sd driver status
+  */
+SD_DRV_STATUS sd_cache_flush(void){
+
+    int32_t run[SD_CACHE_MAX_RUN];
+    uint32_t cnt, first, next = 0;
+    int32_t idx;
+
+    for(;;){
+
+        /* Lowest dirty sector not below next */
+        idx = -1;
+        for(int32_t i = 0; i < RTE_SDC_CACHE_SECTORS; i++){
+            if(sd_cache_tbl[i].dirty && (sd_cache_tbl[i].sector >= next) &&
+               ((idx < 0) || (sd_cache_tbl[i].sector < sd_cache_tbl[idx].sector)))
+                idx = i;
+        }
+
+        if(idx < 0)
+            return SD_DRV_STATUS_OK;
+
+        first  = sd_cache_tbl[idx].sector;
+        run[0] = idx;
+        cnt    = 1;
+
+        while(cnt < SD_CACHE_MAX_RUN){
+            idx = sd_cache_find(first + cnt);
+            if((idx < 0) || !sd_cache_tbl[idx].dirty)
+                break;
+            run[cnt++] = idx;
+        }
+
+        if(sd_cache_card_xfer(first, run, cnt, 1) != SD_DRV_STATUS_OK)
+            return SD_DRV_STATUS_WR_ERR;
+
+        for(uint32_t i = 0; i < cnt; i++)
+            sd_cache_tbl[run[i]].dirty = 0;
+
+        sd_cache_stats.writeback_sectors += cnt;
+
+        next = first + cnt;
+        if(next < first)
+            return SD_DRV_STATUS_OK;
+    }
+}
+
+/**
+  \fn           static int32_t sd_cache_alloc(uint32_t sec, uint32_t keep)
+  \brief        Take an entry for a new sector: a free one, else the least
+                recently used clean one. When every entry is dirty the
+                cache is written back first.
+  \param[in]    sec - sector number the entry will hold
+  \param[in]    keep - entries used after this stamp are not replaced
+  \return       entry index, -1 on write back failure
+  */
+static int32_t sd_cache_alloc(uint32_t sec, uint32_t keep){
+
+    int32_t idx = -1;
+
+    for(int32_t i = 0; i < RTE_SDC_CACHE_SECTORS; i++){
+
+        if(!sd_cache_tbl[i].valid){
+            idx = i;
+            break;
+        }
+
+        if(!sd_cache_tbl[i].dirty && (sd_cache_tbl[i].stamp <= keep) &&
+           ((idx < 0) || (sd_cache_tbl[i].stamp < sd_cache_tbl[idx].stamp)))
+            idx = i;
+    }
+
+    if(idx < 0){
+
+        if(sd_cache_flush() != SD_DRV_STATUS_OK)
+            return -1;
+
+        for(int32_t i = 0; i < RTE_SDC_CACHE_SECTORS; i++){
+            if((sd_cache_tbl[i].stamp <= keep) &&
+               ((idx < 0) || (sd_cache_tbl[i].stamp < sd_cache_tbl[idx].stamp)))
+                idx = i;
+        }
+
+        if(idx < 0)
+            return -1;
+    }
+
+    sd_cache_tbl[idx].sector = sec;
+    sd_cache_tbl[idx].valid  = 1;
+    sd_cache_tbl[idx].dirty  = 0;
+    sd_cache_touch(idx);
+
+    return idx;
+}
+
+/**
+  \fn           static SD_DRV_STATUS sd_cache_flush_range(uint32_t sec, uint32_t cnt)
+  \brief        Write back the cache if it holds dirty sectors in a range
+  \param[in]    sec - first sector
+  \param[in]    cnt - number of sectors
+  \return       sd driver status
+  */
+static SD_DRV_STATUS sd_cache_flush_range(uint32_t sec, uint32_t cnt){
+
+    for(int32_t i = 0; i < RTE_SDC_CACHE_SECTORS; i++){
+        if(sd_cache_tbl[i].dirty && ((sd_cache_tbl[i].sector - sec) < cnt))
+            return sd_cache_flush();
+    }
+
+    return SD_DRV_STATUS_OK;
+}
+
+/**
+  \fn           SD_DRV_STATUS sd_cache_init(uint8_t devId, uint8_t buswidth, uint8_t dmamode)
+  \brief        Initialize the SD card and empty the cache
+  \param[in]    devId - Device ID
+  \param[in]    buswidth - Bus width
+  \param[in]    dmamode - DMA mode
+  \return       sd driver status
+  */
+SD_DRV_STATUS sd_cache_init(uint8_t devId, uint8_t buswidth, uint8_t dmamode){
+
+    memset(sd_cache_tbl, 0, sizeof(sd_cache_tbl));
+    memset(&sd_cache_stats, 0, sizeof(sd_cache_stats));
+
+    sd_cache_clock    = 0;
+    sd_cache_next_sec = 0;
+    sd_cache_dma_mode = dmamode;
+
+    return sd_init(devId, buswidth, dmamode);
+}
+
+/**
+  \fn           SD_DRV_STATUS sd_cache_uninit(uint8_t devId)
+  \brief        Write back dirty sectors and uninitialize the SD card
+  \param[in]    devId - Device ID
+  \return       sd driver status
+  */
+SD_DRV_STATUS sd_cache_uninit(uint8_t devId){
+
+    SD_DRV_STATUS status = sd_cache_flush();
+
+    memset(sd_cache_tbl, 0, sizeof(sd_cache_tbl));
+
+    if(sd_uninit(devId) != SD_DRV_STATUS_OK)
+        return SD_DRV_STATUS_CARD_INIT_ERR;
+
+    return status;
+}
+
+/**
+  \fn           SD_DRV_STATUS sd_cache_read(uint32_t sec, uint16_t BlkCnt, volatile unsigned char *DestBuff)
+  \brief        Read sd sectors through the cache
+  \param[in]    sec - input sector number to read
+  \param[in]    BlkCnt - number of block to read
+  \param[in]    DestBuff - Destination buffer pointer
+  \return       sd driver status
+  */
+SD_DRV_STATUS sd_cache_read(uint32_t sec, uint16_t BlkCnt, volatile unsigned char *DestBuff){
+
+    int32_t run[SD_CACHE_MAX_RUN];
+    uint32_t i = 0, cnt, demand, start, keep;
+    uint8_t sequential = (sec == sd_cache_next_sec);
+    SD_DRV_STATUS status;
+    int32_t idx;
+
+    if((DestBuff == NULL) || !BlkCnt)
+        return SD_DRV_STATUS_RD_ERR;
+
+    sd_cache_next_sec = sec + BlkCnt;
+
+    /* Large transfers go straight to the card */
+    if(BlkCnt > SD_CACHE_BYPASS_BLKS){
+
+        if(sd_cache_flush_range(sec, BlkCnt) != SD_DRV_STATUS_OK)
+            return SD_DRV_STATUS_RD_ERR;
+
+        start  = sd_cache_cycles();
+        status = sd_read(sec, BlkCnt, DestBuff);
+        sd_cache_stats.read_cycles += (uint32_t)(sd_cache_cycles() - start);
+        sd_cache_stats.card_reads++;
+        sd_cache_stats.read_misses += BlkCnt;
+
+        return status;
+    }
+
+    while(i < BlkCnt){
+
+        idx = sd_cache_find(sec + i);
+
+        if(idx >= 0){
+            memcpy((void *)&DestBuff[i * SDMMC_BLK_SIZE_512_Msk], (const void *)sd_cache_data[idx], SDMMC_BLK_SIZE_512_Msk);
+            sd_cache_touch(idx);
+            sd_cache_stats.read_hits++;
+            i++;
+            continue;
+        }
+
+        /* Run of missing sectors, extended past the request on a sequential stream */
+        cnt = 0;
+        while(((i + cnt) < BlkCnt) && (cnt < SD_CACHE_MAX_RUN) && (sd_cache_find(sec + i + cnt) < 0))
+            cnt++;
+
+        demand = cnt;
+
+        if(sequential && ((i + cnt) == BlkCnt)){
+            while(((cnt - demand) < RTE_SDC_CACHE_READ_AHEAD) && (cnt < SD_CACHE_MAX_RUN) &&
+                  ((sec + i + cnt) < Hsd.sd_card.sectorcount) && (sd_cache_find(sec + i + cnt) < 0))
+                cnt++;
+        }
+
+        /* Entries taken for this run must not replace each other */
+        keep = sd_cache_clock;
+
+        for(uint32_t j = 0; j < cnt; j++){
+            run[j] = sd_cache_alloc(sec + i + j, keep);
+            if(run[j] < 0){
+                for(uint32_t k = 0; k < j; k++)
+                    sd_cache_tbl[run[k]].valid = 0;
+                return SD_DRV_STATUS_RD_ERR;
+            }
+        }
+
+        status = sd_cache_card_xfer(sec + i, run, cnt, 0);
+
+        /* A failed read-ahead must not fail the sectors asked for */
+        if((status != SD_DRV_STATUS_OK) && (cnt > demand)){
+            for(uint32_t j = demand; j < cnt; j++)
+                sd_cache_tbl[run[j]].valid = 0;
+            cnt    = demand;
+            status = sd_cache_card_xfer(sec + i, run, cnt, 0);
+        }
+
+        if(status != SD_DRV_STATUS_OK){
+            for(uint32_t j = 0; j < cnt; j++)
+                sd_cache_tbl[run[j]].valid = 0;
+            return SD_DRV_STATUS_RD_ERR;
+        }
+
+        for(uint32_t j = 0; j < demand; j++)
+            memcpy((void *)&DestBuff[(i + j) * SDMMC_BLK_SIZE_512_Msk], (const void *)sd_cache_data[run[j]], SDMMC_BLK_SIZE_512_Msk);
+
+        sd_cache_stats.read_misses += demand;
+        sd_cache_stats.read_ahead  += cnt - demand;
+        i += demand;
+    }
+
+    return SD_DRV_STATUS_OK;
+}
+
+/**
+  \fn           SD_DRV_STATUS sd_cache_write(uint32_t sector, uint32_t BlkCnt, volatile unsigned char *SrcBuff)
+  \brief        Write sd sectors into the cache, they reach the card on
+                eviction or sd_cache_flush()
+  \param[in]    sector - input sector number to write
+  \param[in]    BlkCnt - number of block to write
+  \param[in]    SrcBuff - Source buffer pointer
+  \return       sd driver status
+  */
+SD_DRV_STATUS sd_cache_write(uint32_t sector, uint32_t BlkCnt, volatile unsigned char *SrcBuff){
+
+    SD_DRV_STATUS status;
+    uint32_t start;
+    int32_t idx;
+
+    if((SrcBuff == NULL) || !BlkCnt)
+        return SD_DRV_STATUS_WR_ERR;
+
+    /* Large transfers go straight to the card, cached copies are stale */
+    if(BlkCnt > SD_CACHE_BYPASS_BLKS){
+
+        for(int32_t i = 0; i < RTE_SDC_CACHE_SECTORS; i++){
+            if(sd_cache_tbl[i].valid && ((sd_cache_tbl[i].sector - sector) < BlkCnt)){
+                sd_cache_tbl[i].valid = 0;
+                sd_cache_tbl[i].dirty = 0;
+            }
+        }
+
+        start  = sd_cache_cycles();
+        status = sd_write(sector, BlkCnt, SrcBuff);
+        sd_cache_stats.write_cycles += (uint32_t)(sd_cache_cycles() - start);
+        sd_cache_stats.card_writes++;
+
+        return status;
+    }
+
+    for(uint32_t i = 0; i < BlkCnt; i++){
+
+        idx = sd_cache_find(sector + i);
+
+        if(idx >= 0){
+            sd_cache_stats.write_hits++;
+        }else{
+            idx = sd_cache_alloc(sector + i, sd_cache_clock);
+            if(idx < 0)
+                return SD_DRV_STATUS_WR_ERR;
+            sd_cache_stats.write_misses++;
+        }
+
+        memcpy((void *)sd_cache_data[idx], (const void *)&SrcBuff[i * SDMMC_BLK_SIZE_512_Msk], SDMMC_BLK_SIZE_512_Msk);
+        sd_cache_tbl[idx].dirty = 1;
+        sd_cache_touch(idx);
+    }
+
+    return SD_DRV_STATUS_OK;
+}
+
+/**
+  \fn           void sd_cache_get_stats(sd_cache_stats_t *stats)
+  \brief        Copy the cache counters
+  \param[out]   stats - counters
+  \return       none
+  */
+void sd_cache_get_stats(sd_cache_stats_t *stats){
+    if(stats != NULL)
+        *stats = sd_cache_stats;
+}
+
+/**
+  \fn           void sd_cache_reset_stats(void)
+  \brief        Clear the cache counters
+  \return       none
+  */
+void sd_cache_reset_stats(void){
+    memset(&sd_cache_stats, 0, sizeof(sd_cache_stats));
+}
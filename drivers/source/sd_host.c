@@ -22,12 +22,13 @@
 /* Includes ------------------------------------------------------------------*/
 #include "sd_host.h"
 #include "sd.h"
+#include "string.h"
 
 #ifdef SDMMC_PRINTF_DEBUG
 #include "stdio.h"
 #endif
 
-static adma2_desc_t adma_desc_tbl[32] __attribute__((section("sd_dma_buf"))) __attribute__((aligned(32)));
+static adma2_desc_t adma_desc_tbl[SDMMC_ADMA2_DESC_TBL_SIZE] __attribute__((section("sd_dma_buf"))) __attribute__((aligned(32)));
 
 /**
   \fn          static uint8_t get_cmd_rsp_type(uint8_t Cmd)
@@ -77,6 +78,7 @@ static uint8_t hc_get_cmd_rsp_type(uint8_t Cmd){
             break;
         case CMD17:
         case CMD18:
+        case CMD19:
             RetVal = SDMMC_CMD_R_DATA_PRES_SEL_Msk | SDMMC_RESP_R48;
             break;
         case CMD23:
@@ -131,6 +133,7 @@ SDMMC_HC_STATUS hc_send_cmd(sd_handle_t *pHsd, sd_cmd_t *pCmd){
 
     if(pCmd->data_present){
 
+        cmd |= SDMMC_CMD_R_DATA_PRES_SEL_Msk;
         pHsd->regs->SDMMC_XFER_MODE_R  = pCmd->xfer_mode;
     }
 
@@ -492,7 +495,13 @@ SDMMC_HC_STATUS hc_get_card_opcond(sd_handle_t *pHsd){
             }
 
             pHsd->sd_cmd.cmdidx       = CMD41;
-            pHsd->sd_cmd.arg          = (SDMMC_CMD41_HCS | SDMMC_CMD41_3V3);// | SD_OCR_S18R);
+            pHsd->sd_cmd.arg          = (SDMMC_CMD41_HCS | SDMMC_CMD41_3V3);
+
+            /* Request 1.8v signaling only when a UHS-I mode will be negotiated */
+            if((pHsd->max_speed >= SDMMC_BUS_SPEED_SDR50) && (pHsd->max_speed != SDMMC_BUS_SPEED_NONE) &&
+               (pHsd->regs->SDMMC_CAPABILITIES2_R & SDMMC_HOST_CAP2_UHS_Msk))
+                pHsd->sd_cmd.arg     |= SDMMC_OCR_S18R;
+
             if(hc_send_cmd(pHsd, &pHsd->sd_cmd) != SDMMC_HC_STATUS_OK){
                 sd_error_handler();
             }
@@ -663,6 +672,196 @@ SDMMC_HC_STATUS hc_switch_1v8(sd_handle_t *pHsd){
     return SDMMC_HC_STATUS_OK;
 }
 
+/**
+  \fn           static SDMMC_HC_STATUS hc_wait_buf_rd(sd_handle_t *pHsd)
+  \brief        Wait for the buffer read ready of a PIO data read
+  \param[in]    pHsd - Global SD Handle pointer
+  \return       Host controller driver status
+  */
+static SDMMC_HC_STATUS hc_wait_buf_rd(sd_handle_t *pHsd){
+
+    uint32_t timeout_cnt = SDMMC_MAX_TIMEOUT_16;
+
+    while(!(pHsd->regs->SDMMC_NORMAL_INT_STAT_R & SDMMC_INTR_BRR_Msk)){
+
+        if(pHsd->regs->SDMMC_NORMAL_INT_STAT_R & SDMMC_INTR_ERR_Msk)
+            return SDMMC_HC_STATUS_ERR;
+
+        if(!timeout_cnt--)
+            return SDMMC_HC_STATUS_ERR;
+
+        sys_busy_loop_us(1);
+    }
+
+    pHsd->regs->SDMMC_NORMAL_INT_STAT_R = SDMMC_INTR_BRR_Msk;
+
+    return SDMMC_HC_STATUS_OK;
+}
+
+/**
+  \fn           SDMMC_HC_STATUS hc_switch_func(sd_handle_t *pHsd, uint32_t arg, uint8_t *status)
+  \brief        Send CMD6 switch function and read back the 64 byte
+                switch status
+  \param[in]    pHsd - Global SD Handle pointer
+  \param[in]    arg - CMD6 argument, check or set mode and the functions
+  \param[out]   status - switch status, SDMMC_SWITCH_STATUS_LEN bytes
+  \return       Host controller driver status
+  */
+SDMMC_HC_STATUS hc_switch_func(sd_handle_t *pHsd, uint32_t arg, uint8_t *status){
+
+    SDMMC_HC_STATUS ret = SDMMC_HC_STATUS_OK;
+    uint32_t data;
+
+    pHsd->regs->SDMMC_BLOCKSIZE_R   = SDMMC_SWITCH_STATUS_LEN;
+    pHsd->regs->SDMMC_BLOCKCOUNT_R  = 1;
+
+    pHsd->sd_cmd.cmdidx             = CMD6;
+    pHsd->sd_cmd.arg                = arg;
+    pHsd->sd_cmd.data_present       = 1;
+    pHsd->sd_cmd.xfer_mode          = SDMMC_XFER_MODE_DATA_XFER_RD_Msk;
+
+    if((hc_send_cmd(pHsd, &pHsd->sd_cmd) != SDMMC_HC_STATUS_OK) || (hc_wait_buf_rd(pHsd) != SDMMC_HC_STATUS_OK)){
+        ret = SDMMC_HC_STATUS_ERR;
+    }else{
+
+        /* Status is sent MSB first, the buffer port keeps the byte order */
+        for(uint32_t i = 0; i < SDMMC_SWITCH_STATUS_LEN; i += 4){
+            data = pHsd->regs->SDMMC_BUF_DATA_R;
+            status[i + 0] = (uint8_t)(data);
+            status[i + 1] = (uint8_t)(data >> 8);
+            status[i + 2] = (uint8_t)(data >> 16);
+            status[i + 3] = (uint8_t)(data >> 24);
+        }
+
+        /* Transfer complete, no DMA so the LED is left alone */
+        for(data = 1000; !(pHsd->regs->SDMMC_NORMAL_INT_STAT_R & SDMMC_INTR_TC_Msk); data--){
+            if(!data){
+                ret = SDMMC_HC_STATUS_ERR;
+                break;
+            }
+            sys_busy_loop_us(1);
+        }
+    }
+
+    pHsd->sd_cmd.data_present = 0;
+    pHsd->regs->SDMMC_BLOCKSIZE_R = SDMMC_BLK_SIZE_512_Msk;
+
+    if(ret != SDMMC_HC_STATUS_OK)
+        hc_reset(pHsd, (uint8_t)(SDMMC_SW_RST_DAT_Msk | SDMMC_SW_RST_CMD_Msk));
+
+    return ret;
+}
+
+/**
+  \fn           SDMMC_HC_STATUS hc_set_bus_speed(sd_handle_t *pHsd, SDMMC_BUS_SPEED speed)
+  \brief        Program the host timing and SD clock for a bus speed mode,
+                the card must already be switched with CMD6
+  \param[in]    pHsd - Global SD Handle pointer
+  \param[in]    speed - bus speed mode
+  \return       Host controller driver status
+  */
+SDMMC_HC_STATUS hc_set_bus_speed(sd_handle_t *pHsd, SDMMC_BUS_SPEED speed){
+
+    uint16_t clk, ctrl2, div;
+    uint16_t uhs;
+
+    switch(speed){
+        case SDMMC_BUS_SPEED_DS:
+            div = SDMMC_CLK_25MHz_DIV;
+            uhs = SDMMC_HOST_CTRL2_UHS_SDR12;
+            break;
+        case SDMMC_BUS_SPEED_HS:
+            div = SDMMC_CLK_50MHz_DIV;
+            uhs = SDMMC_HOST_CTRL2_UHS_SDR25;
+            break;
+        case SDMMC_BUS_SPEED_SDR50:
+            div = SDMMC_CLK_100MHz_DIV;
+            uhs = SDMMC_HOST_CTRL2_UHS_SDR50;
+            break;
+        case SDMMC_BUS_SPEED_SDR104:
+            div = SDMMC_CLK_100MHz_DIV;
+            uhs = SDMMC_HOST_CTRL2_UHS_SDR104;
+            break;
+        case SDMMC_BUS_SPEED_DDR50:
+            div = SDMMC_CLK_50MHz_DIV;
+            uhs = SDMMC_HOST_CTRL2_UHS_DDR50;
+            break;
+        default:
+            return SDMMC_HC_STATUS_ERR;
+    }
+
+    /* Stop the SD clock while the timing changes */
+    clk = pHsd->regs->SDMMC_CLK_CTRL_R;
+    hc_set_clk_freq(pHsd, (uint16_t)(clk & ~SDMMC_CLK_EN_Msk));
+
+    if(speed == SDMMC_BUS_SPEED_DS)
+        pHsd->regs->SDMMC_HOST_CTRL1_R &= (uint8_t)~SDMMC_HOST_CTRL1_HIGH_SPEED_MODE_EN;
+    else
+        pHsd->regs->SDMMC_HOST_CTRL1_R |= SDMMC_HOST_CTRL1_HIGH_SPEED_MODE_EN;
+
+    /* UHS mode select only applies with 1.8v signaling */
+    ctrl2 = pHsd->regs->SDMMC_HOST_CTRL2_R;
+    ctrl2 &= (uint16_t)~(SDMMC_HOST_CTRL2_UHS_MODE_SEL_Msk | SDMMC_HOST_CTRL2_SAMPLE_CLK_SEL_Msk);
+    if(ctrl2 & SDMMC_HOST_CTRL2_SIGNALING_EN_Msk)
+        ctrl2 |= uhs;
+    pHsd->regs->SDMMC_HOST_CTRL2_R = ctrl2;
+
+    clk = SDMMC_CLK_GEN_SEL_Msk | SDMMC_PLL_EN_Msk | SDMMC_CLK_EN_Msk | SDMMC_INTERNAL_CLK_EN_Msk |
+          (uint16_t)(div << SDMMC_FREQ_SEL_Pos);
+
+    return hc_set_clk_freq(pHsd, clk);
+}
+
+/**
+  \fn           SDMMC_HC_STATUS hc_execute_tuning(sd_handle_t *pHsd)
+  \brief        Run the sampling point tuning with CMD19, the host
+                compares the tuning blocks and picks the sampling clock
+  \param[in]    pHsd - Global SD Handle pointer
+  \return       Host controller driver status
+  */
+SDMMC_HC_STATUS hc_execute_tuning(sd_handle_t *pHsd){
+
+    uint16_t ctrl2;
+
+    pHsd->regs->SDMMC_BLOCKSIZE_R   = SDMMC_TUNING_BLK_LEN;
+    pHsd->regs->SDMMC_BLOCKCOUNT_R  = 1;
+    pHsd->regs->SDMMC_HOST_CTRL2_R |= SDMMC_HOST_CTRL2_EXEC_TUNING_Msk;
+
+    pHsd->sd_cmd.cmdidx             = CMD19;
+    pHsd->sd_cmd.arg                = 0;
+    pHsd->sd_cmd.data_present       = 1;
+    pHsd->sd_cmd.xfer_mode          = SDMMC_XFER_MODE_DATA_XFER_RD_Msk;
+
+    for(uint32_t loop = 0; loop < SDMMC_TUNING_MAX_LOOP; loop++){
+
+        if(hc_send_cmd(pHsd, &pHsd->sd_cmd) != SDMMC_HC_STATUS_OK)
+            break;
+
+        if(hc_wait_buf_rd(pHsd) != SDMMC_HC_STATUS_OK)
+            break;
+
+        /* The host clears Execute Tuning once a sampling point is found */
+        if(!(pHsd->regs->SDMMC_HOST_CTRL2_R & SDMMC_HOST_CTRL2_EXEC_TUNING_Msk))
+            break;
+    }
+
+    pHsd->sd_cmd.data_present = 0;
+    pHsd->regs->SDMMC_BLOCKSIZE_R = SDMMC_BLK_SIZE_512_Msk;
+
+    ctrl2 = pHsd->regs->SDMMC_HOST_CTRL2_R;
+
+    if((ctrl2 & SDMMC_HOST_CTRL2_EXEC_TUNING_Msk) || !(ctrl2 & SDMMC_HOST_CTRL2_SAMPLE_CLK_SEL_Msk)){
+
+        pHsd->regs->SDMMC_HOST_CTRL2_R = ctrl2 & (uint16_t)~(SDMMC_HOST_CTRL2_EXEC_TUNING_Msk |
+                                                             SDMMC_HOST_CTRL2_SAMPLE_CLK_SEL_Msk);
+        hc_reset(pHsd, (uint8_t)(SDMMC_SW_RST_DAT_Msk | SDMMC_SW_RST_CMD_Msk));
+
+        return SDMMC_HC_STATUS_ERR;
+    }
+
+    return SDMMC_HC_STATUS_OK;
+}
+
 /**
   \fn           SDMMC_HC_STATUS hc_go_idle(sd_handle_t *pHsd)
   \brief        put the card in idle mode
@@ -862,41 +1061,83 @@ SDMMC_HC_STATUS hc_set_blk_cnt(sd_handle_t *pHsd, uint32_t BlkCnt){
 }
 
 /**
-  \fn           SDMMC_HC_STATUS hc_dma_config(sd_handle_t *pHsd, uint32_t buff, uint32_t sector, uint16_t BlkCnt){
-  \brief        Setup read parameter and start reading sector
-  \param[in]    Global sd Handle pointer
-  \param[in]    destination buffer
-  \param[in]    sector number to read
-  \param[in]    Block Count
-  \return       Host controller driver status
+  \fn           uint32_t hc_adma2_build_desc(adma2_desc_t *tbl, uint32_t tbl_size, const sd_iovec_t *iov, uint32_t iovcnt)
+  \brief        Build a 32-bit ADMA2 descriptor chain over a list of buffer
+                segments. Segments are split at SDMMC_ADMA2_DESC_MAX_LEN,
+                a full 64KB descriptor is encoded with a length of 0.
+  \param[in]    tbl - descriptor table to fill
+  \param[in]    tbl_size - number of entries in the table
+  \param[in]    iov - buffer segments, 4 byte aligned address and length
+  \param[in]    iovcnt - number of segments
+  \return       number of descriptors used, 0 on invalid segments or
+                when the table is too small
   */
-SDMMC_HC_STATUS hc_dma_config(sd_handle_t *pHsd, uint32_t buff, uint32_t sector, uint16_t blk_cnt){
+uint32_t hc_adma2_build_desc(adma2_desc_t *tbl, uint32_t tbl_size, const sd_iovec_t *iov, uint32_t iovcnt){
 
-    ARG_UNUSED(sector);
-    hc_set_blk_cnt(pHsd, blk_cnt);
+    uint32_t desc_num = 0, addr, len, chunk;
 
-    /* Configure DMA buffer */
-    if(pHsd->dma_mode == SDMMC_HOST_CTRL1_ADMA2_MODE){
+    for(uint32_t i = 0; i < iovcnt; i++){
+
+        addr = LocalToGlobal(iov[i].buff);
+        len  = iov[i].len;
 
-        uint32_t desc_num = 0;
-        uint32_t total_desc = 0, bytes_per_desc;
+        if((len == 0) || (iov[i].buff == NULL) || ((addr | len) & SDMMC_ADMA2_ALIGN_Msk))
+            return 0;
 
-        bytes_per_desc = blk_cnt * SDMMC_BLK_SIZE_512_Msk;
+        while(len){
 
-        if(bytes_per_desc > SDMMC_ADMA2_DESC_MAX_LEN){
+            if(desc_num == tbl_size)
+                return 0;
 
-            total_desc = bytes_per_desc / SDMMC_ADMA2_DESC_MAX_LEN;
-            if(bytes_per_desc % SDMMC_ADMA2_DESC_MAX_LEN)
-                total_desc += 1;
+            chunk = (len > SDMMC_ADMA2_DESC_MAX_LEN) ? SDMMC_ADMA2_DESC_MAX_LEN : len;
+
+            tbl[desc_num].addr = addr;
+            tbl[desc_num].len  = (uint16_t)chunk; /* 64KB wraps to 0 */
+            tbl[desc_num].attr = SDMMC_ADMA2_DESC_TRAN | SDMMC_ADMA2_DESC_VALID;
+
+            desc_num++;
+            addr += chunk;
+            len  -= chunk;
         }
+    }
 
-        do{
-            adma_desc_tbl[desc_num].addr = buff + (desc_num * SDMMC_ADMA2_DESC_MAX_LEN);
-            adma_desc_tbl[desc_num].len  = bytes_per_desc;
-            adma_desc_tbl[desc_num].attr = SDMMC_ADMA2_DESC_TRAN | SDMMC_ADMA2_DESC_VALID;
-        }while(desc_num++ < total_desc);
+    if(desc_num)
+        tbl[desc_num - 1].attr |= SDMMC_ADMA2_DESC_END;
+
+    return desc_num;
+}
+
+/**
+  \fn           static SDMMC_HC_STATUS hc_dma_config_iov(sd_handle_t *pHsd, const sd_iovec_t *iov, uint32_t iovcnt, uint16_t blk_cnt)
+  \brief        Setup the DMA for a list of buffer segments. More than one
+                segment needs the ADMA2 mode.
+  \param[in]    pHsd - Global SD Handle pointer
+  \param[in]    iov - buffer segments
+  \param[in]    iovcnt - number of segments
+  \param[in]    blk_cnt - Block Count, must match the segment lengths
+  \return       Host controller driver status
+  */
+static SDMMC_HC_STATUS hc_dma_config_iov(sd_handle_t *pHsd, const sd_iovec_t *iov, uint32_t iovcnt, uint16_t blk_cnt){
+
+    uint32_t total = 0;
+
+    if((iov == NULL) || (iovcnt == 0) || (blk_cnt == 0))
+        return SDMMC_HC_STATUS_ERR;
+
+    for(uint32_t i = 0; i < iovcnt; i++)
+        total += iov[i].len;
+
+    if(total != ((uint32_t)blk_cnt * SDMMC_BLK_SIZE_512_Msk))
+        return SDMMC_HC_STATUS_ERR;
+
+    hc_set_blk_cnt(pHsd, blk_cnt);
+
+    /* Configure DMA buffer */
+    if(pHsd->dma_mode == SDMMC_HOST_CTRL1_ADMA2_MODE){
+
+        if(!hc_adma2_build_desc(adma_desc_tbl, SDMMC_ADMA2_DESC_TBL_SIZE, iov, iovcnt))
+            return SDMMC_HC_STATUS_ERR;
 
-        adma_desc_tbl[desc_num - 1].attr |= SDMMC_ADMA2_DESC_END;
 #ifdef SDMMC_PRINTF_DEBUG
         printf("ADMA Desc: 0x%x, addr: 0x%x, Len: 0x%x, Attr: 0x%x\n",(uint32_t)&adma_desc_tbl[0],adma_desc_tbl[0].addr,adma_desc_tbl[0].len,adma_desc_tbl[0].attr);
 #endif
@@ -904,24 +1145,44 @@ SDMMC_HC_STATUS hc_dma_config(sd_handle_t *pHsd, uint32_t buff, uint32_t sector,
         pHsd->regs->SDMMC_ADMA_SA_LOW_R = (uint32_t)LocalToGlobal((&adma_desc_tbl[0]));
     }
 
+    else if(iovcnt == 1)
+        pHsd->regs->SDMMC_ADMA_SA_LOW_R = (uint32_t)LocalToGlobal(iov[0].buff);
     else
-        pHsd->regs->SDMMC_ADMA_SA_LOW_R = (uint32_t)LocalToGlobal((const volatile void *)buff);
+        return SDMMC_HC_STATUS_ERR;
 
     return SDMMC_HC_STATUS_OK;
 }
 
 /**
-  \fn           SDMMC_HC_STATUS hc_read_setup(sd_handle_t *pHsd, uint32_t buff, uint32_t sector, uint16_t BlkCnt){
-  \brief        Setup read parameter and start reading sector
+  \fn           SDMMC_HC_STATUS hc_dma_config(sd_handle_t *pHsd, uint32_t buff, uint32_t sector, uint16_t BlkCnt){
+  \brief        Setup DMA for a single contiguous buffer
   \param[in]    Global sd Handle pointer
   \param[in]    destination buffer
   \param[in]    sector number to read
   \param[in]    Block Count
   \return       Host controller driver status
   */
-SDMMC_HC_STATUS hc_read_setup(sd_handle_t *pHsd, uint32_t buff, uint32_t sector, uint16_t BlkCnt){
+SDMMC_HC_STATUS hc_dma_config(sd_handle_t *pHsd, uint32_t buff, uint32_t sector, uint16_t blk_cnt){
 
-    hc_dma_config(pHsd, buff, sector, BlkCnt);
+    sd_iovec_t iov;
+
+    ARG_UNUSED(sector);
+
+    iov.buff = (volatile uint8_t *)buff;
+    iov.len  = (uint32_t)blk_cnt * SDMMC_BLK_SIZE_512_Msk;
+
+    return hc_dma_config_iov(pHsd, &iov, 1, blk_cnt);
+}
+
+/**
+  \fn           static void hc_read_cmd(sd_handle_t *pHsd, uint32_t sector, uint16_t BlkCnt)
+  \brief        Send the read command once the DMA is configured
+  \param[in]    Global sd Handle pointer
+  \param[in]    sector number to read
+  \param[in]    Block Count
+  \return       none
+  */
+static void hc_read_cmd(sd_handle_t *pHsd, uint32_t sector, uint16_t BlkCnt){
 
     pHsd->sd_cmd.arg              = sector;
     pHsd->sd_cmd.data_present     = 1;
@@ -947,22 +1208,17 @@ SDMMC_HC_STATUS hc_read_setup(sd_handle_t *pHsd, uint32_t buff, uint32_t sector,
     }
 
     pHsd->sd_cmd.data_present = 0;
-
-    return SDMMC_HC_STATUS_OK;
 }
 
 /**
-  \fn           SDMMC_HC_STATUS hc_write_setup(sd_handle_t *pHsd, uint32_t buff, uint32_t sector, uint16_t BlkCnt)
-  \brief        Setup write parameter and start writing sector
+  \fn           static void hc_write_cmd(sd_handle_t *pHsd, uint32_t sector, uint16_t BlkCnt)
+  \brief        Send the write command once the DMA is configured
   \param[in]    Global sd Handle pointer
-  \param[in]    source buffer
   \param[in]    sector number to write
   \param[in]    Block Count
-  \return       Host controller driver status
+  \return       none
   */
-SDMMC_HC_STATUS hc_write_setup(sd_handle_t *pHsd, uint32_t buff, uint32_t sector, uint16_t BlkCnt){
-
-    hc_dma_config(pHsd, buff, sector, BlkCnt);
+static void hc_write_cmd(sd_handle_t *pHsd, uint32_t sector, uint16_t BlkCnt){
 
     pHsd->sd_cmd.arg              = sector;
     pHsd->sd_cmd.data_present     = 1;
@@ -986,6 +1242,84 @@ SDMMC_HC_STATUS hc_write_setup(sd_handle_t *pHsd, uint32_t buff, uint32_t sector
     }
 
     pHsd->sd_cmd.data_present = 0;
+}
+
+/**
+  \fn           SDMMC_HC_STATUS hc_read_setup(sd_handle_t *pHsd, uint32_t buff, uint32_t sector, uint16_t BlkCnt){
+  \brief        Setup read parameter and start reading sector
+  \param[in]    Global sd Handle pointer
+  \param[in]    destination buffer
+  \param[in]    sector number to read
+  \param[in]    Block Count
+  \return       Host controller driver status
+  */
+SDMMC_HC_STATUS hc_read_setup(sd_handle_t *pHsd, uint32_t buff, uint32_t sector, uint16_t BlkCnt){
+
+    if(hc_dma_config(pHsd, buff, sector, BlkCnt) != SDMMC_HC_STATUS_OK)
+        return SDMMC_HC_STATUS_ERR;
+
+    hc_read_cmd(pHsd, sector, BlkCnt);
+
+    return SDMMC_HC_STATUS_OK;
+}
+
+/**
+  \fn           SDMMC_HC_STATUS hc_readv_setup(sd_handle_t *pHsd, const sd_iovec_t *iov, uint32_t iovcnt, uint32_t sector, uint16_t BlkCnt)
+  \brief        Setup a scatter read into a list of buffer segments and
+                start reading sector
+  \param[in]    Global sd Handle pointer
+  \param[in]    destination buffer segments
+  \param[in]    number of segments
+  \param[in]    sector number to read
+  \param[in]    Block Count
+  \return       Host controller driver status
+  */
+SDMMC_HC_STATUS hc_readv_setup(sd_handle_t *pHsd, const sd_iovec_t *iov, uint32_t iovcnt, uint32_t sector, uint16_t BlkCnt){
+
+    if(hc_dma_config_iov(pHsd, iov, iovcnt, BlkCnt) != SDMMC_HC_STATUS_OK)
+        return SDMMC_HC_STATUS_ERR;
+
+    hc_read_cmd(pHsd, sector, BlkCnt);
+
+    return SDMMC_HC_STATUS_OK;
+}
+
+/**
+  \fn           SDMMC_HC_STATUS hc_write_setup(sd_handle_t *pHsd, uint32_t buff, uint32_t sector, uint16_t BlkCnt)
+  \brief        Setup write parameter and start writing sector
+  \param[in]    Global sd Handle pointer
+  \param[in]    source buffer
+  \param[in]    sector number to write
+  \param[in]    Block Count
+  \return       Host controller driver status
+  */
+SDMMC_HC_STATUS hc_write_setup(sd_handle_t *pHsd, uint32_t buff, uint32_t sector, uint16_t BlkCnt){
+
+    if(hc_dma_config(pHsd, buff, sector, BlkCnt) != SDMMC_HC_STATUS_OK)
+        return SDMMC_HC_STATUS_ERR;
+
+    hc_write_cmd(pHsd, sector, BlkCnt);
+
+    return SDMMC_HC_STATUS_OK;
+}
+
+/**
+  \fn           SDMMC_HC_STATUS hc_writev_setup(sd_handle_t *pHsd, const sd_iovec_t *iov, uint32_t iovcnt, uint32_t sector, uint16_t BlkCnt)
+  \brief        Setup a gather write from a list of buffer segments and
+                start writing sector
+  \param[in]    Global sd Handle pointer
+  \param[in]    source buffer segments
+  \param[in]    number of segments
+  \param[in]    sector number to write
+  \param[in]    Block Count
+  \return       Host controller driver status
+  */
+SDMMC_HC_STATUS hc_writev_setup(sd_handle_t *pHsd, const sd_iovec_t *iov, uint32_t iovcnt, uint32_t sector, uint16_t BlkCnt){
+
+    if(hc_dma_config_iov(pHsd, iov, iovcnt, BlkCnt) != SDMMC_HC_STATUS_OK)
+        return SDMMC_HC_STATUS_ERR;
+
+    hc_write_cmd(pHsd, sector, BlkCnt);
 
     return SDMMC_HC_STATUS_OK;
 }
@@ -0,0 +1,834 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     flash_ftl.c
+ * @version  V1.0.0
+ * @brief    Log-structured flash translation layer on top of a CMSIS
+ *           ARM_DRIVER_FLASH.
+ *
+ *           Every erase sector starts with a metadata page followed by data
+ *           pages of FTL_PAGE_SIZE bytes:
+ *             0x00  header      magic, erase count, CRC
+ *             0x10  open mark   programmed to zero before the first data page
+ *             0x20  descriptors one per data page: logical page, sequence, CRC
+ *           A data page is programmed before its descriptor, so a page only
+ *           exists once its descriptor is complete. The newest sequence wins
+ *           when a logical page is found more than once at mount time.
+ *           Every metadata record is programmed exactly once.
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "flash_ftl.h"
+#include <string.h>
+
+#if (FTL_SPARE_SECTORS < 3)
+#error "FTL_SPARE_SECTORS must be at least 3"
+#endif
+
+#define FTL_MAGIC               0x4C544641U     /* "AFTL" */
+#define FTL_OPEN_OFFSET         0x10U
+#define FTL_DESC_OFFSET         0x20U
+#define FTL_RECORD_SIZE         0x10U
+#define FTL_BLANK               0xFFFFFFFFU
+#define FTL_NONE                0xFFFFFFFFU
+
+/* Sector states */
+#define FTL_SEC_FREE            0U      /* Erased, header written            */
+#define FTL_SEC_ACTIVE          1U      /* Receiving writes                  */
+#define FTL_SEC_USED            2U      /* Closed, reclaimable by GC         */
+#define FTL_SEC_ERASE           3U      /* No valid header, erased at mount  */
+#define FTL_SEC_BAD             4U      /* Erase or program failed           */
+
+/* Sector header record */
+typedef struct _ftl_header_t{
+    uint32_t                magic;
+    uint32_t                erase_count;
+    uint32_t                crc;
+    uint32_t                rsvd;
+}ftl_header_t;
+
+/* Data page descriptor record */
+typedef struct _ftl_desc_t{
+    uint32_t                page;
+    uint32_t                seq;
+    uint32_t                crc;
+    uint32_t                rsvd;
+}ftl_desc_t;
+
+/* Sector bookkeeping */
+typedef struct _ftl_sector_t{
+    uint32_t                erase_count;
+    uint16_t                valid;          /* Data pages holding the newest copy */
+    uint8_t                 state;
+    uint8_t                 next;           /* Next free data page when active    */
+}ftl_sector_t;
+
+static struct {
+    ARM_DRIVER_FLASH        *drv;
+    uint32_t                base;           /* Byte address of the region         */
+    uint32_t                sector_size;
+    uint32_t                num_sectors;
+    uint32_t                pages;          /* Data pages per sector              */
+    uint32_t                unit;           /* Driver data item size in bytes     */
+    uint32_t                capacity;       /* Logical pages                      */
+    uint32_t                seq;            /* Next descriptor sequence           */
+    uint32_t                active;         /* Sector receiving writes            */
+    uint32_t                free_cnt;
+    uint8_t                 wl_pending;
+    uint8_t                 mounted;
+} ftl;
+
+static ftl_sector_t ftl_sec[FTL_MAX_SECTORS];
+static uint32_t     ftl_map[FTL_MAX_PAGES];
+static uint32_t     ftl_buf[FTL_PAGE_SIZE / 4];
+static ftl_stats_t  ftl_stats;
+
+/**
+  \fn          static uint32_t ftl_crc(uint32_t w0, uint32_t w1)
+  \brief       CRC-32 of the two payload words of a metadata record.
+  \param[in]   w0  First word
+  \param[in]   w1  Second word
+  \return      CRC-32
+*/
+static uint32_t ftl_crc(uint32_t w0, uint32_t w1)
+{
+    uint32_t word[2] = {w0, w1};
+    const uint8_t *byte = (const uint8_t *)word;
+    uint32_t crc = 0xFFFFFFFFU;
+    uint32_t i, bit;
+
+    for (i = 0; i < sizeof(word); i++)
+    {
+        crc ^= byte[i];
+        for (bit = 0; bit < 8U; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    return ~crc;
+}
+
+/**
+  \fn          static inline uint32_t ftl_sector_addr(uint32_t sec)
+  \brief       Byte address of an FTL sector.
+  \param[in]   sec  Sector index within the region
+  \return      flash address
+*/
+static inline uint32_t ftl_sector_addr(uint32_t sec)
+{
+    return ftl.base + (sec * ftl.sector_size);
+}
+
+/**
+  \fn          static int32_t ftl_wait(void)
+  \brief       Wait for the flash driver to finish the current operation.
+  \return      \ref execution_status
+*/
+static int32_t ftl_wait(void)
+{
+    ARM_FLASH_STATUS status;
+
+    do
+    {
+        status = ftl.drv->GetStatus();
+    } while (status.busy);
+
+    return status.error ? ARM_DRIVER_ERROR : ARM_DRIVER_OK;
+}
+
+/**
+  \fn          static int32_t ftl_flash_read(uint32_t addr, void *data, uint32_t len)
+  \brief       Read bytes from flash.
+  \param[in]   addr  Flash address
+  \param[out]  data  Pointer to buffer
+  \param[in]   len   Number of bytes, multiple of the driver data width
+  \return      \ref execution_status
+*/
+static int32_t ftl_flash_read(uint32_t addr, void *data, uint32_t len)
+{
+    int32_t ret = ftl.drv->ReadData(addr, data, len / ftl.unit);
+
+    if (ret < 0)
+    {
+        return ret;
+    }
+    return ftl_wait();
+}
+
+/**
+  \fn          static int32_t ftl_flash_program(uint32_t addr, const void *data, uint32_t len)
+  \brief       Program bytes to flash.
+  \param[in]   addr  Flash address
+  \param[in]   data  Pointer to data
+  \param[in]   len   Number of bytes, multiple of the driver data width
+  \return      \ref execution_status
+*/
+static int32_t ftl_flash_program(uint32_t addr, const void *data, uint32_t len)
+{
+    int32_t ret = ftl.drv->ProgramData(addr, data, len / ftl.unit);
+
+    if (ret < 0)
+    {
+        return ret;
+    }
+    return ftl_wait();
+}
+
+/**
+  \fn          static int32_t ftl_read_desc(uint32_t ppn, ftl_desc_t *desc)
+  \brief       Read the descriptor of a data page.
+  \param[in]   ppn   Physical page number
+  \param[out]  desc  Pointer to descriptor
+  \return      \ref execution_status
+*/
+static int32_t ftl_read_desc(uint32_t ppn, ftl_desc_t *desc)
+{
+    uint32_t addr = ftl_sector_addr(ppn / ftl.pages) + FTL_DESC_OFFSET +
+                    ((ppn % ftl.pages) * FTL_RECORD_SIZE);
+
+    return ftl_flash_read(addr, desc, sizeof(ftl_desc_t));
+}
+
+/**
+  \fn          static int32_t ftl_blank(uint32_t sec)
+  \brief       Check that a sector is erased past its header. An erase cut
+               short by a power loss may leave a valid header in front of
+               stale data.
+  \param[in]   sec  Sector index
+  \return      1 if blank, 0 if not, or \ref execution_status on error
+*/
+static int32_t ftl_blank(uint32_t sec)
+{
+    uint32_t offset, i;
+    int32_t ret;
+
+    for (offset = 0; offset < ftl.sector_size; offset += FTL_PAGE_SIZE)
+    {
+        ret = ftl_flash_read(ftl_sector_addr(sec) + offset, ftl_buf, FTL_PAGE_SIZE);
+        if (ret != ARM_DRIVER_OK)
+        {
+            return ret;
+        }
+        for (i = (offset ? 0U : (FTL_OPEN_OFFSET / 4)); i < (FTL_PAGE_SIZE / 4); i++)
+        {
+            if (ftl_buf[i] != FTL_BLANK)
+            {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/**
+  \fn          static void ftl_wear_update(void)
+  \brief       Refresh the erase count spread and arm static wear leveling
+               when it exceeds FTL_WL_THRESHOLD.
+*/
+static void ftl_wear_update(void)
+{
+    uint32_t min = FTL_NONE, max = 0, sec;
+
+    for (sec = 0; sec < ftl.num_sectors; sec++)
+    {
+        if ((ftl_sec[sec].state == FTL_SEC_BAD) || (ftl_sec[sec].state == FTL_SEC_ERASE))
+        {
+            continue;
+        }
+        if (ftl_sec[sec].erase_count < min)
+        {
+            min = ftl_sec[sec].erase_count;
+        }
+        if (ftl_sec[sec].erase_count > max)
+        {
+            max = ftl_sec[sec].erase_count;
+        }
+    }
+
+    if (min == FTL_NONE)
+    {
+        min = 0;
+    }
+    ftl_stats.min_erase_count = min;
+    ftl_stats.max_erase_count = max;
+    ftl.wl_pending = ((max - min) > FTL_WL_THRESHOLD) ? 1U : 0U;
+}
+
+/**
+  \fn          static int32_t ftl_erase(uint32_t sec)
+  \brief       Erase a sector and write its header with the next erase count.
+               A sector that fails is retired until the next mount.
+  \param[in]   sec  Sector index
+  \return      \ref execution_status
+*/
+static int32_t ftl_erase(uint32_t sec)
+{
+    ftl_header_t hdr;
+    uint32_t addr = ftl_sector_addr(sec);
+    int32_t ret;
+
+    if (ftl_sec[sec].state == FTL_SEC_FREE)
+    {
+        ftl.free_cnt--;
+    }
+
+    ret = ftl.drv->EraseSector(addr);
+    if (ret >= 0)
+    {
+        ret = ftl_wait();
+    }
+    ftl_stats.erases++;
+
+    if (ret == ARM_DRIVER_OK)
+    {
+        hdr.magic       = FTL_MAGIC;
+        hdr.erase_count = ftl_sec[sec].erase_count + 1U;
+        hdr.crc         = ftl_crc(hdr.magic, hdr.erase_count);
+        hdr.rsvd        = FTL_BLANK;
+        ret = ftl_flash_program(addr, &hdr, sizeof(hdr));
+    }
+
+    if (ret != ARM_DRIVER_OK)
+    {
+        ftl_sec[sec].state = FTL_SEC_BAD;
+        ftl_wear_update();
+        return ret;
+    }
+
+    ftl_sec[sec].erase_count = hdr.erase_count;
+    ftl_sec[sec].valid       = 0U;
+    ftl_sec[sec].state       = FTL_SEC_FREE;
+    ftl_sec[sec].next        = 0U;
+    ftl.free_cnt++;
+
+    ftl_wear_update();
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          static int32_t ftl_open(uint8_t worn)
+  \brief       Pick a free sector and make it the active one. Host writes
+               take the least worn sector, cold data moved by static wear
+               leveling takes the most worn one.
+  \param[in]   worn  Prefer the free sector with the highest erase count
+  \return      \ref execution_status
+*/
+static int32_t ftl_open(uint8_t worn)
+{
+    static const uint32_t open_mark[FTL_RECORD_SIZE / 4] = {0U};
+    uint32_t sec, best = FTL_NONE;
+    int32_t ret;
+
+    for (sec = 0; sec < ftl.num_sectors; sec++)
+    {
+        if (ftl_sec[sec].state != FTL_SEC_FREE)
+        {
+            continue;
+        }
+        if ((best == FTL_NONE) ||
+            (worn ? (ftl_sec[sec].erase_count > ftl_sec[best].erase_count) :
+                    (ftl_sec[sec].erase_count < ftl_sec[best].erase_count)))
+        {
+            best = sec;
+        }
+    }
+
+    if (best == FTL_NONE)
+    {
+        return ARM_DRIVER_ERROR;
+    }
+
+    ftl.free_cnt--;
+    ftl_sec[best].next = 0U;
+
+    ret = ftl_flash_program(ftl_sector_addr(best) + FTL_OPEN_OFFSET, open_mark, sizeof(open_mark));
+    if (ret != ARM_DRIVER_OK)
+    {
+        ftl_sec[best].state = FTL_SEC_USED;
+        return ret;
+    }
+
+    ftl_sec[best].state = FTL_SEC_ACTIVE;
+    ftl.active = best;
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          static int32_t ftl_put(uint32_t page, const void *data, uint8_t worn)
+  \brief       Append a logical page to the active sector and remap it.
+  \param[in]   page  Logical page
+  \param[in]   data  Pointer to FTL_PAGE_SIZE bytes
+  \param[in]   worn  Sector preference if a new sector has to be opened
+  \return      \ref execution_status
+*/
+static int32_t ftl_put(uint32_t page, const void *data, uint8_t worn)
+{
+    ftl_desc_t desc;
+    uint32_t sec, slot, addr, old;
+    int32_t ret;
+
+    if ((ftl.active != FTL_NONE) && (ftl_sec[ftl.active].next >= ftl.pages))
+    {
+        ftl_sec[ftl.active].state = FTL_SEC_USED;
+        ftl.active = FTL_NONE;
+    }
+
+    if (ftl.active == FTL_NONE)
+    {
+        ret = ftl_open(worn);
+        if (ret != ARM_DRIVER_OK)
+        {
+            return ret;
+        }
+    }
+
+    sec  = ftl.active;
+    slot = ftl_sec[sec].next++;
+    addr = ftl_sector_addr(sec);
+
+    ret = ftl_flash_program(addr + ((slot + 1U) * FTL_PAGE_SIZE), data, FTL_PAGE_SIZE);
+    ftl_stats.flash_writes++;
+
+    if (ret == ARM_DRIVER_OK)
+    {
+        desc.page = page;
+        desc.seq  = ftl.seq;
+        desc.crc  = ftl_crc(desc.page, desc.seq);
+        desc.rsvd = FTL_BLANK;
+        ret = ftl_flash_program(addr + FTL_DESC_OFFSET + (slot * FTL_RECORD_SIZE), &desc, sizeof(desc));
+    }
+    ftl.seq++;
+
+    if (ret != ARM_DRIVER_OK)
+    {
+        return ret;
+    }
+
+    old = ftl_map[page];
+    if (old != FTL_NONE)
+    {
+        ftl_sec[old / ftl.pages].valid--;
+    }
+    ftl_map[page] = (sec * ftl.pages) + slot;
+    ftl_sec[sec].valid++;
+
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          static int32_t ftl_gc(uint8_t *wl_allowed)
+  \brief       Reclaim one closed sector: move its valid pages to the active
+               sector and erase it. The victim is the coldest sector when
+               static wear leveling is armed and allowed, else the one with
+               the fewest valid pages.
+  \param[in,out] wl_allowed  Static wear leveling may pick the victim,
+                             cleared once it did
+  \return      \ref execution_status
+*/
+static int32_t ftl_gc(uint8_t *wl_allowed)
+{
+    uint32_t sec, page, room, victim = FTL_NONE, cold = FTL_NONE;
+    uint8_t wl = 0U;
+    int32_t ret;
+
+    room = (ftl.active != FTL_NONE) ? (ftl.pages - ftl_sec[ftl.active].next) : 0U;
+    if (ftl.free_cnt)
+    {
+        room += ftl.pages;
+    }
+
+    for (sec = 0; sec < ftl.num_sectors; sec++)
+    {
+        if (ftl_sec[sec].state != FTL_SEC_USED)
+        {
+            continue;
+        }
+        if ((cold == FTL_NONE) || (ftl_sec[sec].erase_count < ftl_sec[cold].erase_count))
+        {
+            cold = sec;
+        }
+        if ((victim == FTL_NONE) || (ftl_sec[sec].valid < ftl_sec[victim].valid) ||
+            ((ftl_sec[sec].valid == ftl_sec[victim].valid) &&
+             (ftl_sec[sec].erase_count < ftl_sec[victim].erase_count)))
+        {
+            victim = sec;
+        }
+    }
+
+    if (*wl_allowed && ftl.wl_pending && (cold != FTL_NONE) && (ftl_sec[cold].valid <= room) &&
+        ((ftl_sec[cold].erase_count + FTL_WL_THRESHOLD) < ftl_stats.max_erase_count))
+    {
+        victim = cold;
+        wl     = 1U;
+        *wl_allowed = 0U;
+    }
+    else if ((victim == FTL_NONE) || (ftl_sec[victim].valid >= ftl.pages) ||
+             (ftl_sec[victim].valid > room))
+    {
+        /* Nothing to gain, or nowhere to move the valid pages */
+        return ARM_DRIVER_ERROR;
+    }
+
+    for (page = 0; (page < ftl.capacity) && ftl_sec[victim].valid; page++)
+    {
+        if ((ftl_map[page] == FTL_NONE) || ((ftl_map[page] / ftl.pages) != victim))
+        {
+            continue;
+        }
+
+        ret = ftl_flash_read(ftl_sector_addr(victim) + (((ftl_map[page] % ftl.pages) + 1U) * FTL_PAGE_SIZE),
+                             ftl_buf, FTL_PAGE_SIZE);
+        if (ret == ARM_DRIVER_OK)
+        {
+            ret = ftl_put(page, ftl_buf, wl);
+        }
+        if (ret != ARM_DRIVER_OK)
+        {
+            return ret;
+        }
+        ftl_stats.gc_copies++;
+    }
+
+    ftl_stats.gc_runs++;
+    if (wl)
+    {
+        ftl_stats.wl_moves++;
+    }
+
+    /* The victim holds no valid page any more, a failed erase only retires it */
+    ret = ftl_erase(victim);
+    return (ret == ARM_DRIVER_ERROR) ? ARM_DRIVER_OK : ret;
+}
+
+/**
+  \fn          static int32_t ftl_scan(ARM_DRIVER_FLASH *drv, uint32_t first_sector, uint32_t num_sectors, uint8_t format)
+  \brief       Set up the region geometry, rebuild the mapping from the
+               sector metadata and erase the sectors left without a header.
+  \param[in]   drv           Flash driver
+  \param[in]   first_sector  First erase sector of the region
+  \param[in]   num_sectors   Number of erase sectors
+  \param[in]   format        Erase every sector instead of mounting
+  \return      \ref execution_status
+*/
+static int32_t ftl_scan(ARM_DRIVER_FLASH *drv, uint32_t first_sector, uint32_t num_sectors, uint8_t format)
+{
+    ARM_FLASH_INFO *info;
+    ARM_FLASH_CAPABILITIES cap;
+    const ftl_header_t *hdr = (const ftl_header_t *)ftl_buf;
+    const ftl_desc_t *desc;
+    ftl_desc_t old_desc;
+    uint32_t sec, slot, ppn, old, known = 0, sum = 0;
+    int32_t ret;
+
+    ftl.mounted = 0U;
+
+    if ((drv == NULL) || (num_sectors <= FTL_SPARE_SECTORS) || (num_sectors > FTL_MAX_SECTORS))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    info = drv->GetInfo();
+    cap  = drv->GetCapabilities();
+
+    if ((info == NULL) || (info->sector_info != NULL) ||
+        (info->sector_size % FTL_PAGE_SIZE) || (info->sector_size < (2U * FTL_PAGE_SIZE)))
+    {
+        return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+    if ((first_sector + num_sectors) > info->sector_count)
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    ftl.drv         = drv;
+    ftl.sector_size = info->sector_size;
+    ftl.num_sectors = num_sectors;
+    ftl.base        = first_sector * info->sector_size;
+    ftl.pages       = (info->sector_size / FTL_PAGE_SIZE) - 1U;
+    ftl.unit        = 1U << cap.data_width;
+    ftl.capacity    = (num_sectors - FTL_SPARE_SECTORS) * ftl.pages;
+    ftl.seq         = 0U;
+    ftl.active      = FTL_NONE;
+    ftl.free_cnt    = 0U;
+
+    if ((ftl.pages > 0xFFU) || ((FTL_DESC_OFFSET + (ftl.pages * FTL_RECORD_SIZE)) > FTL_PAGE_SIZE))
+    {
+        return ARM_DRIVER_ERROR_UNSUPPORTED;
+    }
+    if (ftl.capacity > FTL_MAX_PAGES)
+    {
+        ftl.capacity = FTL_MAX_PAGES;
+    }
+
+    memset(ftl_map, 0xFF, sizeof(ftl_map));
+    memset(ftl_sec, 0, sizeof(ftl_sec));
+
+    for (sec = 0; sec < num_sectors; sec++)
+    {
+        ret = ftl_flash_read(ftl_sector_addr(sec), ftl_buf, FTL_DESC_OFFSET + (ftl.pages * FTL_RECORD_SIZE));
+        if (ret != ARM_DRIVER_OK)
+        {
+            return ret;
+        }
+
+        ftl_sec[sec].state       = FTL_SEC_ERASE;
+        ftl_sec[sec].erase_count = FTL_NONE;
+        if ((hdr->magic != FTL_MAGIC) || (hdr->crc != ftl_crc(hdr->magic, hdr->erase_count)))
+        {
+            continue;
+        }
+
+        ftl_sec[sec].erase_count = hdr->erase_count;
+        sum += hdr->erase_count;
+        known++;
+
+        if (format)
+        {
+            continue;
+        }
+
+        if ((ftl_buf[FTL_OPEN_OFFSET / 4] == FTL_BLANK) && (ftl_buf[(FTL_OPEN_OFFSET / 4) + 1U] == FTL_BLANK) &&
+            (ftl_buf[(FTL_OPEN_OFFSET / 4) + 2U] == FTL_BLANK) && (ftl_buf[(FTL_OPEN_OFFSET / 4) + 3U] == FTL_BLANK))
+        {
+            ret = ftl_blank(sec);
+            if (ret < 0)
+            {
+                return ret;
+            }
+            if (ret)
+            {
+                ftl_sec[sec].state = FTL_SEC_FREE;
+                ftl.free_cnt++;
+            }
+            continue;
+        }
+
+        /* A sector that was active at power down is closed, its blank pages
+         * may hold the remains of an interrupted program.
+         */
+        ftl_sec[sec].state = FTL_SEC_USED;
+        ftl_sec[sec].next  = (uint8_t)ftl.pages;
+
+        for (slot = 0; slot < ftl.pages; slot++)
+        {
+            desc = (const ftl_desc_t *)&ftl_buf[(FTL_DESC_OFFSET + (slot * FTL_RECORD_SIZE)) / 4];
+            if ((desc->page >= ftl.capacity) || (desc->crc != ftl_crc(desc->page, desc->seq)))
+            {
+                continue;
+            }
+
+            if ((desc->seq + 1U) > ftl.seq)
+            {
+                ftl.seq = desc->seq + 1U;
+            }
+
+            ppn = (sec * ftl.pages) + slot;
+            old = ftl_map[desc->page];
+            if (old != FTL_NONE)
+            {
+                ret = ftl_read_desc(old, &old_desc);
+                if (ret != ARM_DRIVER_OK)
+                {
+                    return ret;
+                }
+                if (old_desc.seq > desc->seq)
+                {
+                    continue;
+                }
+                ftl_sec[old / ftl.pages].valid--;
+            }
+            ftl_map[desc->page] = ppn;
+            ftl_sec[sec].valid++;
+        }
+    }
+
+    /* Sectors whose header was lost take the average erase count */
+    for (sec = 0; sec < num_sectors; sec++)
+    {
+        if (ftl_sec[sec].state != FTL_SEC_ERASE)
+        {
+            continue;
+        }
+        if (ftl_sec[sec].erase_count == FTL_NONE)
+        {
+            ftl_sec[sec].erase_count = known ? (sum / known) : 0U;
+        }
+
+        ret = ftl_erase(sec);
+        if ((ret != ARM_DRIVER_OK) && (ret != ARM_DRIVER_ERROR))
+        {
+            return ret;
+        }
+    }
+
+    ftl_wear_update();
+    ftl.mounted = 1U;
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          int32_t ftl_mount(ARM_DRIVER_FLASH *drv, uint32_t first_sector, uint32_t num_sectors)
+  \brief       Rebuild the mapping of an FTL region.
+  \param[in]   drv           Flash driver
+  \param[in]   first_sector  First erase sector of the FTL region
+  \param[in]   num_sectors   Number of erase sectors in the region
+  \return      \ref execution_status
+*/
+int32_t ftl_mount(ARM_DRIVER_FLASH *drv, uint32_t first_sector, uint32_t num_sectors)
+{
+    return ftl_scan(drv, first_sector, num_sectors, 0U);
+}
+
+/**
+  \fn          int32_t ftl_format(ARM_DRIVER_FLASH *drv, uint32_t first_sector, uint32_t num_sectors)
+  \brief       Erase and mount an FTL region, keeping the erase counts.
+  \param[in]   drv           Flash driver
+  \param[in]   first_sector  First erase sector of the FTL region
+  \param[in]   num_sectors   Number of erase sectors in the region
+  \return      \ref execution_status
+*/
+int32_t ftl_format(ARM_DRIVER_FLASH *drv, uint32_t first_sector, uint32_t num_sectors)
+{
+    return ftl_scan(drv, first_sector, num_sectors, 1U);
+}
+
+/**
+  \fn          int32_t ftl_read(uint32_t page, void *data, uint32_t cnt)
+  \brief       Read logical pages.
+  \param[in]   page  First logical page
+  \param[out]  data  Pointer to buffer of cnt * FTL_PAGE_SIZE bytes
+  \param[in]   cnt   Number of logical pages
+  \return      \ref execution_status
+*/
+int32_t ftl_read(uint32_t page, void *data, uint32_t cnt)
+{
+    uint8_t *dst = (uint8_t *)data;
+    uint32_t ppn;
+    int32_t ret;
+
+    if (!ftl.mounted)
+    {
+        return ARM_DRIVER_ERROR;
+    }
+    if ((data == NULL) || (page >= ftl.capacity) || (cnt > (ftl.capacity - page)))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    while (cnt--)
+    {
+        ppn = ftl_map[page];
+        if (ppn == FTL_NONE)
+        {
+            memset(dst, 0xFF, FTL_PAGE_SIZE);
+        }
+        else
+        {
+            ret = ftl_flash_read(ftl_sector_addr(ppn / ftl.pages) + (((ppn % ftl.pages) + 1U) * FTL_PAGE_SIZE),
+                                 dst, FTL_PAGE_SIZE);
+            if (ret != ARM_DRIVER_OK)
+            {
+                return ret;
+            }
+        }
+        ftl_stats.host_reads++;
+        page++;
+        dst += FTL_PAGE_SIZE;
+    }
+
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          int32_t ftl_write(uint32_t page, const void *data, uint32_t cnt)
+  \brief       Write logical pages, running garbage collection as needed.
+  \param[in]   page  First logical page
+  \param[in]   data  Pointer to cnt * FTL_PAGE_SIZE bytes
+  \param[in]   cnt   Number of logical pages
+  \return      \ref execution_status
+*/
+int32_t ftl_write(uint32_t page, const void *data, uint32_t cnt)
+{
+    const uint8_t *src = (const uint8_t *)data;
+    uint8_t wl_allowed = 1U;
+    int32_t ret;
+
+    if (!ftl.mounted)
+    {
+        return ARM_DRIVER_ERROR;
+    }
+    if ((data == NULL) || (page >= ftl.capacity) || (cnt > (ftl.capacity - page)))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    while (cnt--)
+    {
+        /* A wear leveling move gains no free sector, one per write bounds
+           the latency and the greedy victim reclaims the rest */
+        while (ftl.free_cnt < FTL_GC_FREE_SECTORS)
+        {
+            ret = ftl_gc(&wl_allowed);
+            if (ret != ARM_DRIVER_OK)
+            {
+                return ret;
+            }
+        }
+
+        ret = ftl_put(page, src, 0U);
+        if (ret != ARM_DRIVER_OK)
+        {
+            return ret;
+        }
+        ftl_stats.host_writes++;
+        page++;
+        src += FTL_PAGE_SIZE;
+    }
+
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          uint32_t ftl_get_capacity(void)
+  \brief       Number of logical pages of the mounted region.
+  \return      logical pages, 0 when not mounted
+*/
+uint32_t ftl_get_capacity(void)
+{
+    return ftl.mounted ? ftl.capacity : 0U;
+}
+
+/**
+  \fn          void ftl_get_stats(ftl_stats_t *stats)
+  \brief       Copy the FTL counters.
+  \param[out]  stats  Pointer to counters
+*/
+void ftl_get_stats(ftl_stats_t *stats)
+{
+    if (stats != NULL)
+    {
+        *stats = ftl_stats;
+    }
+}
+
+/**
+  \fn          void ftl_reset_stats(void)
+  \brief       Clear the FTL counters, the erase count range is kept.
+*/
+void ftl_reset_stats(void)
+{
+    uint32_t min = ftl_stats.min_erase_count;
+    uint32_t max = ftl_stats.max_erase_count;
+
+    memset(&ftl_stats, 0, sizeof(ftl_stats));
+    ftl_stats.min_erase_count = min;
+    ftl_stats.max_erase_count = max;
+}
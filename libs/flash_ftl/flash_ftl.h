@@ -0,0 +1,143 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     flash_ftl.h
+ * @version  V1.0.0
+ * @brief    Log-structured flash translation layer on top of a CMSIS
+ *           ARM_DRIVER_FLASH. Logical pages are remapped on every write,
+ *           stale copies are reclaimed by garbage collection and erases are
+ *           spread over the region by dynamic and static wear leveling.
+ ******************************************************************************/
+#ifndef FLASH_FTL_H_
+#define FLASH_FTL_H_
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include "Driver_Flash.h"
+
+/* Logical page size in bytes, sector size must be a multiple of it */
+#ifndef FTL_PAGE_SIZE
+#define FTL_PAGE_SIZE               512
+#endif
+
+/* Largest number of erase sectors managed by the FTL */
+#ifndef FTL_MAX_SECTORS
+#define FTL_MAX_SECTORS             256
+#endif
+
+/* Largest number of logical pages, sizes the RAM mapping table */
+#ifndef FTL_MAX_PAGES
+#define FTL_MAX_PAGES               2048
+#endif
+
+/* Sectors kept back from the logical capacity as garbage collection headroom (min 3) */
+#ifndef FTL_SPARE_SECTORS
+#define FTL_SPARE_SECTORS           8
+#endif
+
+/* Garbage collection runs while fewer sectors than this are free */
+#ifndef FTL_GC_FREE_SECTORS
+#define FTL_GC_FREE_SECTORS         2
+#endif
+
+/* Erase count spread that triggers a static wear leveling move */
+#ifndef FTL_WL_THRESHOLD
+#define FTL_WL_THRESHOLD            32
+#endif
+
+/**
+ * @brief  FTL counters. The write amplification is
+ *         flash_writes / host_writes.
+ */
+typedef struct _ftl_stats_t{
+    uint32_t                host_writes;        /*!< Logical pages written by the caller    */
+    uint32_t                host_reads;         /*!< Logical pages read by the caller       */
+    uint32_t                flash_writes;       /*!< Pages programmed, including GC copies  */
+    uint32_t                gc_copies;          /*!< Valid pages moved by GC                */
+    uint32_t                gc_runs;            /*!< Sectors reclaimed by GC                */
+    uint32_t                wl_moves;           /*!< GC runs picked by static wear leveling */
+    uint32_t                erases;             /*!< Sector erases                          */
+    uint32_t                min_erase_count;    /*!< Lowest erase count in the region       */
+    uint32_t                max_erase_count;    /*!< Highest erase count in the region      */
+}ftl_stats_t;
+
+/**
+  \fn          int32_t ftl_mount(ARM_DRIVER_FLASH *drv, uint32_t first_sector, uint32_t num_sectors)
+  \brief       Rebuild the mapping from the sectors of an initialized and
+               powered flash driver. Sectors without a valid header, as left
+               by a blank device or an interrupted erase, are erased.
+  \param[in]   drv           Flash driver
+  \param[in]   first_sector  First erase sector of the FTL region
+  \param[in]   num_sectors   Number of erase sectors in the region
+  \return      \ref execution_status
+*/
+int32_t ftl_mount(ARM_DRIVER_FLASH *drv, uint32_t first_sector, uint32_t num_sectors);
+
+/**
+  \fn          int32_t ftl_format(ARM_DRIVER_FLASH *drv, uint32_t first_sector, uint32_t num_sectors)
+  \brief       Erase the region, discarding all logical pages but keeping
+               the erase counts, and mount it.
+  \param[in]   drv           Flash driver
+  \param[in]   first_sector  First erase sector of the FTL region
+  \param[in]   num_sectors   Number of erase sectors in the region
+  \return      \ref execution_status
+*/
+int32_t ftl_format(ARM_DRIVER_FLASH *drv, uint32_t first_sector, uint32_t num_sectors);
+
+/**
+  \fn          int32_t ftl_read(uint32_t page, void *data, uint32_t cnt)
+  \brief       Read logical pages. Pages never written read as 0xFF.
+  \param[in]   page  First logical page
+  \param[out]  data  Pointer to buffer of cnt * FTL_PAGE_SIZE bytes
+  \param[in]   cnt   Number of logical pages
+  \return      \ref execution_status
+*/
+int32_t ftl_read(uint32_t page, void *data, uint32_t cnt);
+
+/**
+  \fn          int32_t ftl_write(uint32_t page, const void *data, uint32_t cnt)
+  \brief       Write logical pages. Each page is replaced atomically: after
+               a power loss it reads back either its old or its new content.
+  \param[in]   page  First logical page
+  \param[in]   data  Pointer to cnt * FTL_PAGE_SIZE bytes
+  \param[in]   cnt   Number of logical pages
+  \return      \ref execution_status
+*/
+int32_t ftl_write(uint32_t page, const void *data, uint32_t cnt);
+
+/**
+  \fn          uint32_t ftl_get_capacity(void)
+  \brief       Number of logical pages of the mounted region.
+  \return      logical pages, 0 when not mounted
+*/
+uint32_t ftl_get_capacity(void);
+
+/**
+  \fn          void ftl_get_stats(ftl_stats_t *stats)
+  \brief       Copy the FTL counters.
+  \param[out]  stats  Pointer to counters
+*/
+void ftl_get_stats(ftl_stats_t *stats);
+
+/**
+  \fn          void ftl_reset_stats(void)
+  \brief       Clear the FTL counters.
+*/
+void ftl_reset_stats(void);
+
+#ifdef  __cplusplus
+}
+#endif
+#endif /* FLASH_FTL_H_ */
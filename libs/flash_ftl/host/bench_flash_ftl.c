@@ -0,0 +1,140 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     bench_flash_ftl.c
+ * @brief    Write amplification of flash_ftl over the simulated NOR device.
+ *           Each workload formats and fills the region, then overwrites
+ *           20 times its capacity in pages. The throughput is modelled from
+ *           the NOR operation counts with typical serial NOR timings.
+ *
+ *           ./bench_flash_ftl [seed]
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "flash_ftl.h"
+#include "nor_sim.h"
+
+/* Typical serial NOR timings */
+#define PAGE_PROGRAM_S      0.2e-3          /* 256-byte page program        */
+#define SECTOR_ERASE_S      30e-3           /* 4 KB sector erase            */
+#define READ_BYTES_PER_S    100e6           /* Quad read                    */
+
+#define PASSES              20U
+
+typedef enum {
+    WORKLOAD_SEQUENTIAL,
+    WORKLOAD_UNIFORM,
+    WORKLOAD_HOT_COLD,
+    WORKLOAD_HOT_5,
+    WORKLOAD_COUNT
+} workload_t;
+
+static const char *const workload_name[WORKLOAD_COUNT] = {
+    "sequential", "uniform", "80/20", "5% hot",
+};
+
+static uint8_t          data[FTL_PAGE_SIZE];
+
+static void fill(uint32_t page, uint32_t version)
+{
+    uint32_t i;
+
+    for (i = 0; i < FTL_PAGE_SIZE; i++)
+    {
+        data[i] = (uint8_t)((page * 7U) + (version * 13U) + i);
+    }
+}
+
+static uint32_t next_page(workload_t w, uint32_t i, uint32_t cap)
+{
+    switch (w)
+    {
+    case WORKLOAD_SEQUENTIAL:
+        return i % cap;
+    case WORKLOAD_UNIFORM:
+        return (uint32_t)rand() % cap;
+    case WORKLOAD_HOT_COLD:
+        /* 80% of the writes to 20% of the pages */
+        if ((rand() % 10) < 8)
+        {
+            return (uint32_t)rand() % (cap / 5U);
+        }
+        return (cap / 5U) + ((uint32_t)rand() % (cap - (cap / 5U)));
+    default:
+        /* All writes to 5% of the pages, the rest stays static */
+        return (uint32_t)rand() % (cap / 20U);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    ftl_stats_t         stats;
+    nor_sim_stats_t     nor;
+    uint32_t            cap, n, i;
+    double              t;
+    int                 w;
+
+    srand((unsigned)((argc > 1) ? atoi(argv[1]) : 1));
+    nor_sim_fill(0xFF);
+
+    printf("workload\tWA\tgc_runs\twl_moves\terase_min\terase_max\tKB/s\n");
+
+    for (w = 0; w < WORKLOAD_COUNT; w++)
+    {
+        if (ftl_format(&Driver_Flash_Sim, 0, NOR_SIM_SECTORS))
+        {
+            printf("format failed\n");
+            return EXIT_FAILURE;
+        }
+        cap = ftl_get_capacity();
+
+        for (i = 0; i < cap; i++)
+        {
+            fill(i, 0);
+            if (ftl_write(i, data, 1))
+            {
+                printf("fill failed\n");
+                return EXIT_FAILURE;
+            }
+        }
+
+        ftl_reset_stats();
+        nor_sim_reset_stats();
+
+        n = cap * PASSES;
+        for (i = 0; i < n; i++)
+        {
+            uint32_t page = next_page((workload_t)w, i, cap);
+
+            fill(page, i + 1U);
+            if (ftl_write(page, data, 1))
+            {
+                printf("%s: write failed\n", workload_name[w]);
+                return EXIT_FAILURE;
+            }
+        }
+
+        ftl_get_stats(&stats);
+        nor_sim_get_stats(&nor);
+
+        t = ((nor.program_bytes / (double)NOR_SIM_PAGE_SIZE) * PAGE_PROGRAM_S) +
+            (nor.erases * SECTOR_ERASE_S) + (nor.read_bytes / READ_BYTES_PER_S);
+
+        printf("%s\t%.3f\t%u\t%u\t%u\t%u\t%.1f\n", workload_name[w],
+               (double)stats.flash_writes / stats.host_writes,
+               (unsigned int)stats.gc_runs, (unsigned int)stats.wl_moves,
+               (unsigned int)stats.min_erase_count, (unsigned int)stats.max_erase_count,
+               ((double)n * FTL_PAGE_SIZE / 1024.0) / t);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,177 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     nor_sim.c
+ * @brief    RAM-backed NOR flash with power loss injection
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "nor_sim.h"
+
+#define NOR_SIM_SIZE        (NOR_SIM_SECTORS * NOR_SIM_SECTOR_SIZE)
+#define NOR_SIM_UNITS       (NOR_SIM_SIZE / NOR_SIM_PROGRAM_UNIT)
+
+static uint8_t          array[NOR_SIM_SIZE];
+static uint8_t          programmed[NOR_SIM_UNITS];
+static nor_sim_stats_t  stats;
+static long             loss_countdown = -1;
+static jmp_buf         *loss_env;
+
+static ARM_FLASH_INFO   info = {
+    NULL, NOR_SIM_SECTORS, NOR_SIM_SECTOR_SIZE, NOR_SIM_PAGE_SIZE,
+    NOR_SIM_PROGRAM_UNIT, 0xFF, {0}
+};
+
+void nor_sim_fill(uint8_t value)
+{
+    memset(array, value, sizeof(array));
+    memset(programmed, value != 0xFF, sizeof(programmed));
+}
+
+void nor_sim_power_loss(long units, jmp_buf *env)
+{
+    loss_countdown = units;
+    loss_env       = env;
+}
+
+void nor_sim_get_stats(nor_sim_stats_t *s)
+{
+    *s = stats;
+}
+
+void nor_sim_reset_stats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+/* Count down n units towards the power loss, 1 once it is due */
+static int power_lost(long n)
+{
+    if (loss_countdown < 0)
+    {
+        return 0;
+    }
+    if (loss_countdown < n)
+    {
+        loss_countdown = -1;
+        return 1;
+    }
+    loss_countdown -= n;
+    return 0;
+}
+
+static ARM_FLASH_CAPABILITIES sim_get_capabilities(void)
+{
+    ARM_FLASH_CAPABILITIES cap = {0};
+
+    cap.data_width = 1U;    /* 16-bit */
+    return cap;
+}
+
+static ARM_FLASH_STATUS sim_get_status(void)
+{
+    ARM_FLASH_STATUS status = {0};
+
+    return status;
+}
+
+static ARM_FLASH_INFO *sim_get_info(void)
+{
+    return &info;
+}
+
+static int32_t sim_read(uint32_t addr, void *data, uint32_t cnt)
+{
+    uint32_t len = cnt * NOR_SIM_PROGRAM_UNIT;
+
+    if ((addr % NOR_SIM_PROGRAM_UNIT) || (addr > NOR_SIM_SIZE) || (len > (NOR_SIM_SIZE - addr)))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+    memcpy(data, &array[addr], len);
+    stats.read_bytes += len;
+    return (int32_t)cnt;
+}
+
+static int32_t sim_program(uint32_t addr, const void *data, uint32_t cnt)
+{
+    const uint8_t *src = (const uint8_t *)data;
+    uint32_t       len = cnt * NOR_SIM_PROGRAM_UNIT;
+    uint32_t       n, unit;
+
+    if ((addr % NOR_SIM_PROGRAM_UNIT) || (addr > NOR_SIM_SIZE) || (len > (NOR_SIM_SIZE - addr)))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    for (n = 0; n < len; n += NOR_SIM_PROGRAM_UNIT)
+    {
+        unit = (addr + n) / NOR_SIM_PROGRAM_UNIT;
+
+        if (power_lost(1))
+        {
+            /* Torn unit, only some of the bits to clear are cleared */
+            array[addr + n]     &= (uint8_t)(src[n]     | rand());
+            array[addr + n + 1] &= (uint8_t)(src[n + 1] | rand());
+            longjmp(*loss_env, 1);
+        }
+
+        if (programmed[unit])
+        {
+            stats.reprograms++;
+        }
+        programmed[unit] = 1;
+
+        array[addr + n]     &= src[n];
+        array[addr + n + 1] &= src[n + 1];
+    }
+    stats.program_bytes += len;
+    return (int32_t)cnt;
+}
+
+static int32_t sim_erase_sector(uint32_t addr)
+{
+    uint32_t i;
+
+    if ((addr % NOR_SIM_SECTOR_SIZE) || (addr >= NOR_SIM_SIZE))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    if (power_lost(8))
+    {
+        /* Interrupted erase, part of the sector is erased */
+        for (i = 0; i < NOR_SIM_SECTOR_SIZE; i++)
+        {
+            if ((rand() % 3) == 0)
+            {
+                array[addr + i] = 0xFF;
+            }
+        }
+        longjmp(*loss_env, 1);
+    }
+
+    memset(&array[addr], 0xFF, NOR_SIM_SECTOR_SIZE);
+    memset(&programmed[addr / NOR_SIM_PROGRAM_UNIT], 0, NOR_SIM_SECTOR_SIZE / NOR_SIM_PROGRAM_UNIT);
+    stats.erases++;
+    return ARM_DRIVER_OK;
+}
+
+ARM_DRIVER_FLASH Driver_Flash_Sim = {
+    .GetCapabilities = sim_get_capabilities,
+    .ReadData        = sim_read,
+    .ProgramData     = sim_program,
+    .EraseSector     = sim_erase_sector,
+    .GetStatus       = sim_get_status,
+    .GetInfo         = sim_get_info,
+};
@@ -0,0 +1,75 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     nor_sim.h
+ * @brief    RAM-backed NOR flash for host builds of flash_ftl. Programming
+ *           only clears bits, 16-bit units written twice between erases are
+ *           counted. A power loss can be injected at any program unit or
+ *           erase: a unit being programmed keeps a random subset of its
+ *           cleared bits, a sector being erased is left with random bytes
+ *           erased, and execution jumps back to the caller's setjmp() point.
+ *           The array survives the jump, remounting is the reboot.
+ ******************************************************************************/
+#ifndef NOR_SIM_H_
+#define NOR_SIM_H_
+
+#include <setjmp.h>
+#include <stdint.h>
+#include "Driver_Flash.h"
+
+#define NOR_SIM_SECTORS         64U             /* Erase sectors                 */
+#define NOR_SIM_SECTOR_SIZE     4096U           /* Bytes per erase sector        */
+#define NOR_SIM_PAGE_SIZE       256U            /* Bytes per program page        */
+#define NOR_SIM_PROGRAM_UNIT    2U              /* Bytes per program unit        */
+
+/**
+ * @brief  Operation counters, in bytes for reads and programs
+ */
+typedef struct _nor_sim_stats_t{
+    uint32_t                read_bytes;         /*!< Bytes read                             */
+    uint32_t                program_bytes;      /*!< Bytes programmed                       */
+    uint32_t                erases;             /*!< Sector erases                          */
+    uint32_t                reprograms;         /*!< Units programmed twice without erase   */
+}nor_sim_stats_t;
+
+extern ARM_DRIVER_FLASH     Driver_Flash_Sim;
+
+/**
+  \fn          void nor_sim_fill(uint8_t value)
+  \brief       Fill the array with a value, as found on a new device.
+  \param[in]   value  Byte value of every location
+*/
+void nor_sim_fill(uint8_t value);
+
+/**
+  \fn          void nor_sim_power_loss(long units, jmp_buf *env)
+  \brief       Lose power at the program unit or erase after units more
+               program units have been written. An erase counts as 8 units.
+               units < 0 disables the injection.
+  \param[in]   units  Program units written before the power loss
+  \param[in]   env    Where execution continues after the power loss
+*/
+void nor_sim_power_loss(long units, jmp_buf *env);
+
+/**
+  \fn          void nor_sim_get_stats(nor_sim_stats_t *stats)
+  \brief       Copy the operation counters.
+  \param[out]  stats  Pointer to counters
+*/
+void nor_sim_get_stats(nor_sim_stats_t *stats);
+
+/**
+  \fn          void nor_sim_reset_stats(void)
+  \brief       Clear the operation counters.
+*/
+void nor_sim_reset_stats(void);
+
+#endif /* NOR_SIM_H_ */
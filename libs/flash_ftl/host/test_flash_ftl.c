@@ -0,0 +1,180 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     test_flash_ftl.c
+ * @brief    Power loss test of flash_ftl over the simulated NOR device.
+ *           Bursts of page writes, biased to a hot fifth of the capacity so
+ *           that garbage collection and wear leveling run, are checked
+ *           against a shadow copy. Every third burst loses power at a
+ *           random program unit or erase; after the remount the page being
+ *           written must read back old or new, and every other page must
+ *           be unchanged.
+ *
+ *           ./test_flash_ftl [seed] [bursts]
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "flash_ftl.h"
+#include "nor_sim.h"
+
+#define BURST           50
+
+static uint8_t          shadow[FTL_MAX_PAGES][FTL_PAGE_SIZE];
+static uint8_t          data[FTL_PAGE_SIZE];
+static uint8_t          buf[FTL_PAGE_SIZE];
+static jmp_buf          power_loss;
+
+/* Page content that differs for every page and version */
+static void fill(uint8_t *p, uint32_t page, uint32_t version)
+{
+    uint32_t i;
+
+    for (i = 0; i < FTL_PAGE_SIZE; i++)
+    {
+        p[i] = (uint8_t)((page * 7U) + (version * 13U) + i);
+    }
+}
+
+static int mount(void)
+{
+    return ftl_mount(&Driver_Flash_Sim, 0, NOR_SIM_SECTORS);
+}
+
+/* Compare every page with the shadow copy */
+static int store_matches(uint32_t cap)
+{
+    uint32_t page;
+
+    for (page = 0; page < cap; page++)
+    {
+        if (ftl_read(page, buf, 1) || memcmp(buf, shadow[page], FTL_PAGE_SIZE))
+        {
+            printf("page %u differs\n", (unsigned int)page);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(int argc, char **argv)
+{
+    int                 seed   = (argc > 1) ? atoi(argv[1]) : 1;
+    long                bursts = (argc > 2) ? atol(argv[2]) : 3000;
+    ftl_stats_t         stats;
+    nor_sim_stats_t     nor;
+    uint32_t            cap;
+    int                 j;
+    /* Static, so a longjmp() back from a power loss keeps their values */
+    static long         i, losses, old_state, new_state;
+    static uint32_t     page, version;
+
+    srand((unsigned)seed);
+
+    /* A new device holds no valid sector header */
+    nor_sim_fill(0x5A);
+    if (mount())
+    {
+        printf("FAIL: mount of a blank device\n");
+        return EXIT_FAILURE;
+    }
+
+    cap = ftl_get_capacity();
+    if ((cap == 0) || (cap > FTL_MAX_PAGES))
+    {
+        printf("FAIL: capacity %u\n", (unsigned int)cap);
+        return EXIT_FAILURE;
+    }
+    memset(shadow, 0xFF, sizeof(shadow));
+    if (!store_matches(cap))
+    {
+        printf("FAIL: unwritten pages do not read as 0xFF\n");
+        return EXIT_FAILURE;
+    }
+
+    for (i = 0; i < bursts; i++)
+    {
+        if ((i % 3) == 0)
+        {
+            nor_sim_power_loss(rand() % 3000, &power_loss);
+        }
+
+        if (setjmp(power_loss) == 0)
+        {
+            for (j = 0; j < BURST; j++)
+            {
+                page = (rand() % 4) ? (uint32_t)rand() % (cap / 5U) : (uint32_t)rand() % cap;
+                fill(data, page, ++version);
+
+                if (ftl_write(page, data, 1))
+                {
+                    printf("FAIL: burst %ld: write of page %u\n", i, (unsigned int)page);
+                    return EXIT_FAILURE;
+                }
+                memcpy(shadow[page], data, FTL_PAGE_SIZE);
+            }
+            nor_sim_power_loss(-1, NULL);
+
+            if (((i % 50) == 0) && !store_matches(cap))
+            {
+                printf("FAIL: burst %ld: content after writes\n", i);
+                return EXIT_FAILURE;
+            }
+            continue;
+        }
+
+        losses++;
+
+        if (mount())
+        {
+            printf("FAIL: burst %ld: mount after power loss\n", i);
+            return EXIT_FAILURE;
+        }
+
+        /* The page in flight holds its old or its new content */
+        if (ftl_read(page, buf, 1))
+        {
+            printf("FAIL: burst %ld: read of page %u\n", i, (unsigned int)page);
+            return EXIT_FAILURE;
+        }
+        if (!memcmp(buf, shadow[page], FTL_PAGE_SIZE))
+        {
+            old_state++;
+        }
+        else if (!memcmp(buf, data, FTL_PAGE_SIZE))
+        {
+            new_state++;
+            memcpy(shadow[page], data, FTL_PAGE_SIZE);
+        }
+        else
+        {
+            printf("FAIL: burst %ld: page %u torn by the power loss\n", i, (unsigned int)page);
+            return EXIT_FAILURE;
+        }
+
+        if (!store_matches(cap))
+        {
+            printf("FAIL: burst %ld: content after power loss\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+
+    ftl_get_stats(&stats);
+    nor_sim_get_stats(&nor);
+    printf("seed %d: %ld bursts of %d writes, %ld power losses (%ld old, %ld new), "
+           "%u pages, %u erases, erase counts %u..%u, %u reprogrammed units\n",
+           seed, bursts, BURST, losses, old_state, new_state, (unsigned int)cap,
+           (unsigned int)stats.erases, (unsigned int)stats.min_erase_count,
+           (unsigned int)stats.max_erase_count, (unsigned int)nor.reprograms);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     mram_host.c
+ * @brief    File-backed MRAM and software CRC-32 for host builds of mram_kv
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mram_host.h"
+
+static uint8_t  image[MRAM_HOST_SIZE];
+static FILE    *image_file;
+static long     loss_countdown = -1;
+static jmp_buf *loss_env;
+
+/* Write part of the image through to the file */
+static void image_store(uint32_t addr, uint32_t cnt)
+{
+    if (fseek(image_file, (long)addr, SEEK_SET) ||
+        (fwrite(&image[addr], 1, cnt, image_file) != cnt) ||
+        fflush(image_file))
+    {
+        perror("mram image");
+        exit(EXIT_FAILURE);
+    }
+}
+
+int mram_host_open(const char *path, int fresh)
+{
+    mram_host_close();
+
+    image_file = fresh ? NULL : fopen(path, "r+b");
+    if (image_file)
+    {
+        if (fread(image, 1, sizeof(image), image_file) == sizeof(image))
+        {
+            return 0;
+        }
+        fclose(image_file);
+    }
+
+    image_file = fopen(path, "w+b");
+    if (!image_file)
+    {
+        return -1;
+    }
+    memset(image, 0xA5, sizeof(image));
+    image_store(0, sizeof(image));
+    return 0;
+}
+
+void mram_host_close(void)
+{
+    if (image_file)
+    {
+        fclose(image_file);
+        image_file = NULL;
+    }
+}
+
+void mram_host_power_loss(long lines, jmp_buf *env)
+{
+    loss_countdown = lines;
+    loss_env       = env;
+}
+
+static int32_t host_mram_read(uint32_t addr, void *data, uint32_t cnt)
+{
+    if ((addr > MRAM_HOST_SIZE) || (cnt > (MRAM_HOST_SIZE - addr)))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+    memcpy(data, &image[addr], cnt);
+    return (int32_t)cnt;
+}
+
+static int32_t host_mram_program(uint32_t addr, const void *data, uint32_t cnt)
+{
+    const uint8_t *src = (const uint8_t *)data;
+    uint32_t       line, n, i;
+
+    if ((addr % MRAM_HOST_LINE) || (cnt % MRAM_HOST_LINE) ||
+        (addr > MRAM_HOST_SIZE) || (cnt > (MRAM_HOST_SIZE - addr)))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    for (n = 0; n < cnt; n += MRAM_HOST_LINE)
+    {
+        line = addr + n;
+
+        if (loss_countdown == 0)
+        {
+            /* The line being programmed is torn one of three ways */
+            switch (rand() % 3)
+            {
+            case 0:
+                for (i = 0; i < MRAM_HOST_LINE; i++)
+                {
+                    image[line + i] = (uint8_t)rand();
+                }
+                break;
+            case 1:
+                memcpy(&image[line], &src[n], MRAM_HOST_LINE);
+                break;
+            default:
+                break;
+            }
+            image_store(line, MRAM_HOST_LINE);
+            loss_countdown = -1;
+            longjmp(*loss_env, 1);
+        }
+        if (loss_countdown > 0)
+        {
+            loss_countdown--;
+        }
+
+        memcpy(&image[line], &src[n], MRAM_HOST_LINE);
+        image_store(line, MRAM_HOST_LINE);
+    }
+    return (int32_t)cnt;
+}
+
+/* Reflected CRC-32 (IEEE 802.3), the store only needs the same CRC at every mount */
+static int32_t host_crc_compute(const void *data_in, uint32_t len, uint32_t *data_out)
+{
+    const uint8_t *p   = (const uint8_t *)data_in;
+    uint32_t       crc = 0xFFFFFFFFU;
+    uint32_t       i, bit;
+
+    for (i = 0; i < len; i++)
+    {
+        crc ^= p[i];
+        for (bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+    *data_out = ~crc;
+    return ARM_DRIVER_OK;
+}
+
+ARM_DRIVER_MRAM Driver_MRAM_Host = {
+    .ReadData    = host_mram_read,
+    .ProgramData = host_mram_program,
+};
+
+ARM_DRIVER_CRC Driver_CRC_Host = {
+    .Compute     = host_crc_compute,
+};
@@ -0,0 +1,59 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     mram_host.h
+ * @brief    Host stand-ins for the MRAM and CRC drivers used by mram_kv.
+ *           The MRAM is an image file programmed in 16-byte lines, every
+ *           line goes to the file as it is programmed. A power loss can be
+ *           injected before any line: that line is left untouched, fully
+ *           written or filled with garbage, and execution jumps back to the
+ *           caller's setjmp() point. Reopening the file is the reboot.
+ ******************************************************************************/
+#ifndef MRAM_HOST_H_
+#define MRAM_HOST_H_
+
+#include <setjmp.h>
+#include <stdint.h>
+#include "Driver_MRAM.h"
+#include "Driver_CRC.h"
+
+#define MRAM_HOST_SIZE      (64U * 1024U)   /* Bytes of the image            */
+#define MRAM_HOST_LINE      16U             /* Bytes programmed at once      */
+
+extern ARM_DRIVER_MRAM      Driver_MRAM_Host;
+extern ARM_DRIVER_CRC       Driver_CRC_Host;
+
+/**
+  \fn          int mram_host_open(const char *path, int fresh)
+  \brief       Open the image file and load it. A fresh image is filled with
+               a pattern that is not a valid store.
+  \param[in]   path   Image file
+  \param[in]   fresh  Discard the current content of the file
+  \return      0 on success, -1 if the file can not be used
+*/
+int mram_host_open(const char *path, int fresh);
+
+/**
+  \fn          void mram_host_close(void)
+  \brief       Close the image file.
+*/
+void mram_host_close(void);
+
+/**
+  \fn          void mram_host_power_loss(long lines, jmp_buf *env)
+  \brief       Lose power when programming the line after lines more lines
+               have been programmed. lines < 0 disables the injection.
+  \param[in]   lines  Lines programmed before the power loss
+  \param[in]   env    Where execution continues after the power loss
+*/
+void mram_host_power_loss(long lines, jmp_buf *env);
+
+#endif /* MRAM_HOST_H_ */
@@ -0,0 +1,248 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     test_mram_kv.c
+ * @brief    Crash-injection test of mram_kv over a file-backed MRAM image.
+ *           Random sets, deletes and multi-key commits run against a model
+ *           of the expected content. A third of them lose power at a random
+ *           line; after the reboot the store must mount and hold either the
+ *           state before or the state after the interrupted update, never a
+ *           mix. Clean reboots are mixed in, and compactions happen as the
+ *           log fills.
+ *
+ *           ./test_mram_kv [seed] [iterations] [image file]
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mram_kv.h"
+#include "mram_host.h"
+
+#define REGION_OFF      0x1000U
+#define REGION_SIZE     (32U * 1024U)
+#define NKEYS           100
+#define MAX_OPS         6
+
+typedef struct {
+    uint8_t             value[NKEYS][MRAM_KV_MAX_VALUE_LEN];
+    int32_t             len[NKEYS];         /* -1: key absent */
+} model_t;
+
+static model_t          before, after;
+static jmp_buf          power_loss;
+
+static void key_name(char *buf, int k)
+{
+    sprintf(buf, "key/%d", k);
+}
+
+/* Compare the store with a model */
+static int store_matches(const model_t *m)
+{
+    uint8_t         buf[MRAM_KV_MAX_VALUE_LEN];
+    char            key[16];
+    mram_kv_stats_t stats;
+    uint32_t        keys = 0;
+    int32_t         ret;
+    int             k;
+
+    for (k = 0; k < NKEYS; k++)
+    {
+        key_name(key, k);
+        ret = mram_kv_get(key, buf, sizeof(buf));
+
+        if (m->len[k] < 0)
+        {
+            if (ret != MRAM_KV_ERROR_NOT_FOUND)
+            {
+                return 0;
+            }
+            continue;
+        }
+        if ((ret != m->len[k]) || memcmp(buf, m->value[k], (size_t)ret))
+        {
+            return 0;
+        }
+        keys++;
+    }
+
+    mram_kv_get_stats(&stats);
+    return stats.keys == keys;
+}
+
+static int mount(void)
+{
+    return mram_kv_mount(&Driver_MRAM_Host, &Driver_CRC_Host, REGION_OFF, REGION_SIZE);
+}
+
+int main(int argc, char **argv)
+{
+    static char         keys[MAX_OPS][MRAM_KV_MAX_KEY_LEN + 2];
+    static uint8_t      values[MAX_OPS][MRAM_KV_MAX_VALUE_LEN];
+    mram_kv_op_t        op[MAX_OPS];
+    mram_kv_stats_t     stats;
+    int                 seed  = (argc > 1) ? atoi(argv[1]) : 1;
+    long                iters = (argc > 2) ? atol(argv[2]) : 20000;
+    const char         *path  = (argc > 3) ? argv[3] : "mram_kv_test.img";
+    /* Static, so a longjmp() back from a power loss keeps their values */
+    static long         i, losses, old_state, new_state;
+    static int          cnt;
+    int                 j, k, b, len;
+    volatile int32_t    ret;
+
+    srand((unsigned)seed);
+
+    if (mram_host_open(path, 1))
+    {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+
+    if (mount() != MRAM_KV_ERROR_NO_STORE)
+    {
+        printf("FAIL: blank image mounted\n");
+        return EXIT_FAILURE;
+    }
+    if (mram_kv_format(&Driver_MRAM_Host, &Driver_CRC_Host, REGION_OFF, REGION_SIZE))
+    {
+        printf("FAIL: format\n");
+        return EXIT_FAILURE;
+    }
+
+    /* Key length limit, the longest key is accepted and removed again */
+    memset(keys[0], 'k', MRAM_KV_MAX_KEY_LEN + 1);
+    keys[0][MRAM_KV_MAX_KEY_LEN + 1] = '\0';
+    if (mram_kv_set(keys[0], "v", 1) != ARM_DRIVER_ERROR_PARAMETER)
+    {
+        printf("FAIL: over-long key accepted\n");
+        return EXIT_FAILURE;
+    }
+    keys[0][MRAM_KV_MAX_KEY_LEN] = '\0';
+    if (mram_kv_set(keys[0], "v", 1) || mram_kv_delete(keys[0]))
+    {
+        printf("FAIL: longest key\n");
+        return EXIT_FAILURE;
+    }
+
+    for (k = 0; k < NKEYS; k++)
+    {
+        before.len[k] = -1;
+    }
+
+    for (i = 0; i < iters; i++)
+    {
+        after = before;
+
+        /* Mostly single updates, some atomic commits of several keys */
+        cnt = (rand() % 4 == 0) ? 1 + (rand() % MAX_OPS) : 1;
+        for (j = 0; j < cnt; j++)
+        {
+            k = (rand() % 8 == 0) ? rand() % NKEYS : rand() % 10;
+            key_name(keys[j], k);
+            op[j].key = keys[j];
+
+            if (rand() % 10 == 0)
+            {
+                op[j].value  = NULL;
+                op[j].len    = 0;
+                after.len[k] = -1;
+                continue;
+            }
+
+            len = rand() % ((rand() % 5 == 0) ? MRAM_KV_MAX_VALUE_LEN + 1 : 24);
+            for (b = 0; b < len; b++)
+            {
+                values[j][b] = (uint8_t)rand();
+            }
+            op[j].value = values[j];
+            op[j].len   = (uint32_t)len;
+            memcpy(after.value[k], values[j], (size_t)len);
+            after.len[k] = len;
+        }
+
+        if (rand() % 3 == 0)
+        {
+            mram_host_power_loss((rand() % 4 == 0) ? rand() % 1200 : rand() % 40, &power_loss);
+        }
+
+        if (setjmp(power_loss) == 0)
+        {
+            if ((cnt == 1) && op[0].value)
+            {
+                ret = mram_kv_set(op[0].key, op[0].value, op[0].len);
+            }
+            else
+            {
+                ret = mram_kv_commit(op, (uint32_t)cnt);
+            }
+            mram_host_power_loss(-1, NULL);
+
+            if (ret)
+            {
+                printf("FAIL: iteration %ld: update returned %d\n", i, (int)ret);
+                return EXIT_FAILURE;
+            }
+            before = after;
+
+            if (rand() % 50 == 0)
+            {
+                /* Clean reboot */
+                if (mram_host_open(path, 0) || mount())
+                {
+                    printf("FAIL: iteration %ld: remount\n", i);
+                    return EXIT_FAILURE;
+                }
+            }
+            if (!store_matches(&before))
+            {
+                printf("FAIL: iteration %ld: content after update\n", i);
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            losses++;
+
+            if (mram_host_open(path, 0) || mount())
+            {
+                printf("FAIL: iteration %ld: mount after power loss\n", i);
+                return EXIT_FAILURE;
+            }
+
+            if (store_matches(&before))
+            {
+                old_state++;
+            }
+            else if (store_matches(&after))
+            {
+                new_state++;
+                before = after;
+            }
+            else
+            {
+                printf("FAIL: iteration %ld: neither old nor new content after power loss\n", i);
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
+    mram_kv_get_stats(&stats);
+    printf("seed %d: %ld updates, %ld power losses (%ld old, %ld new), %u keys, "
+           "%u compactions, log %u/%u\n", seed, iters, losses, old_state, new_state,
+           (unsigned)stats.keys, (unsigned)stats.compactions,
+           (unsigned)stats.log_used, (unsigned)stats.log_size);
+
+    mram_host_close();
+    remove(path);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,879 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     mram_kv.c
+ * @version  V1.0.0
+ * @brief    Power-fail-safe key/value store on MRAM.
+ *
+ *           The region is split in two halves, only one holds the active
+ *           log. Each half starts with a one-line header (magic, generation,
+ *           state, CRC) followed by records aligned to the 16-byte MRAM line:
+ *             line 0    magic, key length, flags, value length, generation, CRC
+ *             line 1..  key and value, zero padded to the line
+ *           The header line of a record is programmed first and its CRC
+ *           covers the whole record, so a torn record fails the check and
+ *           ends the log. Records carry the generation of their half, which
+ *           keeps stale records of an earlier use of the half out of the log.
+ *
+ *           All records of a commit but the last have KV_FLAG_MORE set; they
+ *           only take effect when the record closing the commit is found.
+ *           The records of an incomplete commit are overwritten by the next
+ *           update.
+ *
+ *           Compaction marks the other half COPYING with a new generation,
+ *           copies the live records and then rewrites the header line as
+ *           ACTIVE. Until that single line is written the old half stays the
+ *           active one.
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "mram_kv.h"
+#include <string.h>
+
+#define KV_MAGIC                0x564B4D41U     /* "AMKV" */
+#define KV_REC_MAGIC            0x564BU         /* "KV"   */
+#define KV_LINE                 16U
+#define KV_NONE                 0xFFFFFFFFU
+
+/* Half states */
+#define KV_HALF_COPYING         1U      /* Compaction in progress, not mounted */
+#define KV_HALF_ACTIVE          2U      /* Holds the log                       */
+
+/* Record flags */
+#define KV_FLAG_DELETE          (1U << 0)   /* Tombstone, no value             */
+#define KV_FLAG_MORE            (1U << 1)   /* More records of the same commit */
+
+/* RAM index slots, a power of two at least twice the key count */
+#define KV_INDEX_SIZE           (KV_POW2(MRAM_KV_MAX_KEYS) * 2U)
+#define KV_POW2(n)              (((n) <= 16U) ? 16U : ((n) <= 64U) ? 64U : ((n) <= 256U) ? 256U : \
+                                 ((n) <= 1024U) ? 1024U : ((n) <= 4096U) ? 4096U : 16384U)
+
+#define KV_ALIGN(n)             (((n) + (KV_LINE - 1U)) & ~(KV_LINE - 1U))
+#define KV_REC_SIZE(klen, vlen) (KV_LINE + KV_ALIGN((uint32_t)(klen) + (uint32_t)(vlen)))
+#define KV_REC_MAX              KV_REC_SIZE(MRAM_KV_MAX_KEY_LEN, MRAM_KV_MAX_VALUE_LEN)
+
+#if (MRAM_KV_MAX_KEY_LEN > 255) || (MRAM_KV_MAX_VALUE_LEN > 65535)
+#error "MRAM_KV_MAX_KEY_LEN must be below 256 and MRAM_KV_MAX_VALUE_LEN below 65536"
+#endif
+
+/* Half header line */
+typedef struct _kv_header_t{
+    uint32_t                magic;
+    uint32_t                gen;
+    uint32_t                state;
+    uint32_t                crc;
+}kv_header_t;
+
+/* Record header line */
+typedef struct _kv_record_t{
+    uint16_t                magic;
+    uint8_t                 key_len;
+    uint8_t                 flags;
+    uint16_t                val_len;
+    uint16_t                rsvd;
+    uint32_t                gen;
+    uint32_t                crc;
+}kv_record_t;
+
+/* RAM index slot */
+typedef struct _kv_slot_t{
+    uint32_t                hash;
+    uint32_t                offset;         /* Record offset in the active half, KV_NONE if free */
+}kv_slot_t;
+
+static struct {
+    ARM_DRIVER_MRAM         *mram;
+    ARM_DRIVER_CRC          *crc;
+    uint32_t                base;           /* MRAM address-offset of the region */
+    uint32_t                half_size;
+    uint32_t                active;         /* Active half, 0 or 1               */
+    uint32_t                gen;            /* Generation of the active half     */
+    uint32_t                max_gen;        /* Highest generation in use         */
+    uint32_t                write_off;      /* Next record in the active half    */
+    uint32_t                keys;
+    uint8_t                 mounted;
+} kv;
+
+static kv_slot_t        kv_index[KV_INDEX_SIZE];
+static uint32_t         kv_buf[KV_REC_MAX / 4];
+static mram_kv_stats_t  kv_stats;
+
+/**
+  \fn          static inline uint32_t kv_half_addr(uint32_t half)
+  \brief       MRAM address-offset of a log half.
+  \param[in]   half  Half index, 0 or 1
+  \return      MRAM address-offset
+*/
+static inline uint32_t kv_half_addr(uint32_t half)
+{
+    return kv.base + (half * kv.half_size);
+}
+
+/**
+  \fn          static uint32_t kv_hash(const char *key, uint32_t len)
+  \brief       FNV-1a hash of a key.
+  \param[in]   key  Key
+  \param[in]   len  Key length
+  \return      hash
+*/
+static uint32_t kv_hash(const char *key, uint32_t len)
+{
+    uint32_t hash = 0x811C9DC5U;
+    uint32_t i;
+
+    for (i = 0; i < len; i++)
+    {
+        hash = (hash ^ (uint8_t)key[i]) * 0x01000193U;
+    }
+    return hash;
+}
+
+/**
+  \fn          static int32_t kv_crc(void *data, uint32_t len, uint32_t *crc)
+  \brief       CRC of a record or header line with its CRC field zeroed.
+               The length is a multiple of the MRAM line.
+  \param[in]   data  Line aligned data, CRC field in the first line at 12
+  \param[in]   len   Length in bytes
+  \param[out]  crc   CRC
+  \return      \ref execution_status
+*/
+static int32_t kv_crc(void *data, uint32_t len, uint32_t *crc)
+{
+    uint32_t *word = (uint32_t *)data;
+    uint32_t saved = word[3];
+    uint32_t value = 0;
+    int32_t  ret;
+
+    word[3] = 0;
+    ret = kv.crc->Compute(data, len, &value);
+    word[3] = saved;
+
+    if (ret < 0)
+    {
+        return ret;
+    }
+    /* Written last, crc may point into data */
+    *crc = value;
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          static int32_t kv_read(uint32_t addr, void *data, uint32_t cnt)
+  \brief       Read from MRAM.
+  \param[in]   addr  MRAM address-offset
+  \param[out]  data  Buffer
+  \param[in]   cnt   Number of bytes
+  \return      \ref execution_status
+*/
+static int32_t kv_read(uint32_t addr, void *data, uint32_t cnt)
+{
+    int32_t ret = kv.mram->ReadData(addr, data, cnt);
+
+    return (ret == (int32_t)cnt) ? ARM_DRIVER_OK : ARM_DRIVER_ERROR;
+}
+
+/**
+  \fn          static int32_t kv_program(uint32_t addr, const void *data, uint32_t cnt)
+  \brief       Program MRAM lines.
+  \param[in]   addr  MRAM address-offset, line aligned
+  \param[in]   data  Data
+  \param[in]   cnt   Number of bytes, a multiple of the line
+  \return      \ref execution_status
+*/
+static int32_t kv_program(uint32_t addr, const void *data, uint32_t cnt)
+{
+    int32_t ret = kv.mram->ProgramData(addr, data, cnt);
+
+    if (ret != (int32_t)cnt)
+    {
+        return ARM_DRIVER_ERROR;
+    }
+    kv_stats.bytes_written += cnt;
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          static int32_t kv_write_header(uint32_t half, uint32_t gen, uint32_t state)
+  \brief       Program the header line of a log half.
+  \param[in]   half   Half index
+  \param[in]   gen    Generation
+  \param[in]   state  KV_HALF_COPYING or KV_HALF_ACTIVE
+  \return      \ref execution_status
+*/
+static int32_t kv_write_header(uint32_t half, uint32_t gen, uint32_t state)
+{
+    kv_header_t hdr = {KV_MAGIC, gen, state, 0};
+    int32_t     ret;
+
+    ret = kv_crc(&hdr, sizeof(hdr), &hdr.crc);
+    if (ret != ARM_DRIVER_OK)
+    {
+        return ret;
+    }
+    return kv_program(kv_half_addr(half), &hdr, sizeof(hdr));
+}
+
+/**
+  \fn          static int32_t kv_read_header(uint32_t half, kv_header_t *hdr)
+  \brief       Read and check the header line of a log half.
+  \param[in]   half  Half index
+  \param[out]  hdr   Header
+  \return      ARM_DRIVER_OK if the header is valid
+*/
+static int32_t kv_read_header(uint32_t half, kv_header_t *hdr)
+{
+    uint32_t crc;
+
+    if ((kv_read(kv_half_addr(half), hdr, sizeof(*hdr)) != ARM_DRIVER_OK) ||
+        (hdr->magic != KV_MAGIC) ||
+        (kv_crc(hdr, sizeof(*hdr), &crc) != ARM_DRIVER_OK) ||
+        (crc != hdr->crc))
+    {
+        return ARM_DRIVER_ERROR;
+    }
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          static uint32_t kv_load(uint32_t half, uint32_t gen, uint32_t off, kv_record_t *rec)
+  \brief       Read a record of a log half into kv_buf and check it.
+  \param[in]   half  Half index
+  \param[in]   gen   Generation of the half
+  \param[in]   off   Record offset in the half
+  \param[out]  rec   Record header line
+  \return      record size in bytes, 0 if no valid record is found
+*/
+static uint32_t kv_load(uint32_t half, uint32_t gen, uint32_t off, kv_record_t *rec)
+{
+    uint32_t size, crc;
+
+    if ((off + KV_LINE) > kv.half_size ||
+        (kv_read(kv_half_addr(half) + off, rec, sizeof(*rec)) != ARM_DRIVER_OK))
+    {
+        return 0;
+    }
+
+    if ((rec->magic != KV_REC_MAGIC) || (rec->gen != gen) ||
+        (rec->key_len == 0) || (rec->key_len > MRAM_KV_MAX_KEY_LEN) ||
+        (rec->val_len > MRAM_KV_MAX_VALUE_LEN))
+    {
+        return 0;
+    }
+
+    size = KV_REC_SIZE(rec->key_len, rec->val_len);
+    if (((off + size) > kv.half_size) ||
+        (kv_read(kv_half_addr(half) + off, kv_buf, size) != ARM_DRIVER_OK) ||
+        (kv_crc(kv_buf, size, &crc) != ARM_DRIVER_OK) ||
+        (crc != rec->crc))
+    {
+        return 0;
+    }
+    return size;
+}
+
+/**
+  \fn          static uint32_t kv_find(const char *key, uint32_t len, uint32_t hash)
+  \brief       Find the index slot of a key, or the free slot ending its probe
+               sequence.
+  \param[in]   key   Key
+  \param[in]   len   Key length
+  \param[in]   hash  Key hash
+  \return      slot index
+*/
+static uint32_t kv_find(const char *key, uint32_t len, uint32_t hash)
+{
+    uint32_t    mask = KV_INDEX_SIZE - 1U;
+    uint32_t    i    = hash & mask;
+    kv_record_t rec;
+    char        stored[MRAM_KV_MAX_KEY_LEN];
+
+    while (kv_index[i].offset != KV_NONE)
+    {
+        if (kv_index[i].hash == hash)
+        {
+            uint32_t addr = kv_half_addr(kv.active) + kv_index[i].offset;
+
+            if ((kv_read(addr, &rec, sizeof(rec)) == ARM_DRIVER_OK) &&
+                (rec.key_len == len) &&
+                (kv_read(addr + KV_LINE, stored, len) == ARM_DRIVER_OK) &&
+                (memcmp(stored, key, len) == 0))
+            {
+                return i;
+            }
+        }
+        i = (i + 1U) & mask;
+    }
+    return i;
+}
+
+/**
+  \fn          static void kv_remove(uint32_t slot)
+  \brief       Free an index slot, shifting back the entries of its probe
+               sequence so that no tombstones are needed.
+  \param[in]   slot  Slot index
+*/
+static void kv_remove(uint32_t slot)
+{
+    uint32_t mask = KV_INDEX_SIZE - 1U;
+    uint32_t i    = slot;
+    uint32_t j    = slot;
+    uint32_t home;
+
+    for (;;)
+    {
+        j = (j + 1U) & mask;
+        if (kv_index[j].offset == KV_NONE)
+        {
+            break;
+        }
+        home = kv_index[j].hash & mask;
+        /* Move j back to i unless its home slot lies cyclically in (i, j] */
+        if (((j > i) && ((home <= i) || (home > j))) ||
+            ((j < i) && ((home <= i) && (home > j))))
+        {
+            kv_index[i] = kv_index[j];
+            i = j;
+        }
+    }
+    kv_index[i].offset = KV_NONE;
+    kv.keys--;
+}
+
+/**
+  \fn          static int32_t kv_apply(const char *key, uint32_t len, uint32_t flags, uint32_t offset)
+  \brief       Point the index entry of a key to a new record.
+  \param[in]   key     Key
+  \param[in]   len     Key length
+  \param[in]   flags   Record flags
+  \param[in]   offset  Record offset in the active half
+  \return      \ref execution_status
+*/
+static int32_t kv_apply(const char *key, uint32_t len, uint32_t flags, uint32_t offset)
+{
+    uint32_t hash = kv_hash(key, len);
+    uint32_t slot = kv_find(key, len, hash);
+
+    if (flags & KV_FLAG_DELETE)
+    {
+        if (kv_index[slot].offset != KV_NONE)
+        {
+            kv_remove(slot);
+        }
+        return ARM_DRIVER_OK;
+    }
+
+    if (kv_index[slot].offset == KV_NONE)
+    {
+        if (kv.keys >= MRAM_KV_MAX_KEYS)
+        {
+            return MRAM_KV_ERROR_FULL;
+        }
+        kv.keys++;
+        kv_index[slot].hash = hash;
+    }
+    kv_index[slot].offset = offset;
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          static int32_t kv_replay(uint32_t start, uint32_t end)
+  \brief       Apply the records of a complete commit to the index at mount.
+  \param[in]   start  Offset of the first record
+  \param[in]   end    Offset after the last record
+  \return      \ref execution_status
+*/
+static int32_t kv_replay(uint32_t start, uint32_t end)
+{
+    kv_record_t rec;
+    uint32_t    off, size;
+    int32_t     ret;
+
+    for (off = start; off < end; off += size)
+    {
+        size = kv_load(kv.active, kv.gen, off, &rec);
+        if (size == 0)
+        {
+            return ARM_DRIVER_ERROR;
+        }
+        ret = kv_apply((const char *)kv_buf + KV_LINE, rec.key_len, rec.flags, off);
+        if (ret != ARM_DRIVER_OK)
+        {
+            return ret;
+        }
+    }
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          static int32_t kv_open(ARM_DRIVER_MRAM *mram, ARM_DRIVER_CRC *crc, uint32_t offset, uint32_t size)
+  \brief       Set up the region and read the generations of both halves.
+  \param[in]   mram    MRAM driver
+  \param[in]   crc     CRC driver
+  \param[in]   offset  MRAM address-offset of the region
+  \param[in]   size    Size of the region in bytes
+  \return      \ref execution_status
+*/
+static int32_t kv_open(ARM_DRIVER_MRAM *mram, ARM_DRIVER_CRC *crc, uint32_t offset, uint32_t size)
+{
+    kv_header_t hdr;
+    uint32_t    half;
+
+    if ((mram == NULL) || (crc == NULL) || (offset & (KV_LINE - 1U)))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    kv.mounted   = 0;
+    kv.mram      = mram;
+    kv.crc       = crc;
+    kv.base      = offset;
+    kv.half_size = (size / 2U) & ~(KV_LINE - 1U);
+    kv.max_gen   = 0;
+
+    if (kv.half_size < (KV_LINE + KV_REC_MAX))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    for (half = 0; half < 2U; half++)
+    {
+        if ((kv_read_header(half, &hdr) == ARM_DRIVER_OK) && (hdr.gen > kv.max_gen))
+        {
+            kv.max_gen = hdr.gen;
+        }
+    }
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          static int32_t kv_reserve(uint32_t size)
+  \brief       Make room for size bytes of records, compacting if needed.
+  \param[in]   size  Bytes to append
+  \return      \ref execution_status
+*/
+static int32_t kv_reserve(uint32_t size)
+{
+    int32_t ret;
+
+    if (!kv.mounted)
+    {
+        return ARM_DRIVER_ERROR;
+    }
+    if ((kv.write_off + size) <= kv.half_size)
+    {
+        return ARM_DRIVER_OK;
+    }
+
+    ret = mram_kv_compact();
+    if (ret != ARM_DRIVER_OK)
+    {
+        return ret;
+    }
+    return ((kv.write_off + size) <= kv.half_size) ? ARM_DRIVER_OK : MRAM_KV_ERROR_FULL;
+}
+
+/**
+  \fn          static int32_t kv_append(const char *key, uint32_t klen, const void *value, uint32_t vlen, uint32_t flags)
+  \brief       Build a record in kv_buf and program it at the end of the log.
+               Room must have been reserved.
+  \param[in]   key    Key
+  \param[in]   klen   Key length
+  \param[in]   value  Value
+  \param[in]   vlen   Value length
+  \param[in]   flags  Record flags
+  \return      \ref execution_status
+*/
+static int32_t kv_append(const char *key, uint32_t klen, const void *value, uint32_t vlen, uint32_t flags)
+{
+    kv_record_t *rec  = (kv_record_t *)kv_buf;
+    uint8_t     *data = (uint8_t *)kv_buf + KV_LINE;
+    uint32_t    size  = KV_REC_SIZE(klen, vlen);
+    int32_t     ret;
+
+    rec->magic   = KV_REC_MAGIC;
+    rec->key_len = (uint8_t)klen;
+    rec->flags   = (uint8_t)flags;
+    rec->val_len = (uint16_t)vlen;
+    rec->rsvd    = 0;
+    rec->gen     = kv.gen;
+
+    memcpy(data, key, klen);
+    if (vlen)
+    {
+        memcpy(data + klen, value, vlen);
+    }
+    memset(data + klen + vlen, 0, size - KV_LINE - klen - vlen);
+
+    ret = kv_crc(kv_buf, size, &rec->crc);
+    if (ret != ARM_DRIVER_OK)
+    {
+        return ret;
+    }
+
+    ret = kv_program(kv_half_addr(kv.active) + kv.write_off, kv_buf, size);
+    if (ret != ARM_DRIVER_OK)
+    {
+        return ret;
+    }
+    kv.write_off += size;
+    kv_stats.records++;
+    return ARM_DRIVER_OK;
+}
+
+/**
+  \fn          static int32_t kv_check_key(const char *key, uint32_t *len)
+  \brief       Validate a key and return its length.
+  \param[in]   key  NUL terminated key
+  \param[out]  len  Key length
+  \return      \ref execution_status
+*/
+static int32_t kv_check_key(const char *key, uint32_t *len)
+{
+    if (key == NULL)
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+    /* Bounded, the key may not be terminated within the limit */
+    *len = 0;
+    while ((*len <= MRAM_KV_MAX_KEY_LEN) && (key[*len] != '\0'))
+    {
+        (*len)++;
+    }
+    if ((*len == 0) || (*len > MRAM_KV_MAX_KEY_LEN))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+    return ARM_DRIVER_OK;
+}
+
+int32_t mram_kv_mount(ARM_DRIVER_MRAM *mram, ARM_DRIVER_CRC *crc, uint32_t offset, uint32_t size)
+{
+    kv_header_t hdr;
+    kv_record_t rec;
+    uint32_t    half, off, rec_size;
+    uint32_t    pending = KV_NONE;
+    int32_t     ret;
+
+    ret = kv_open(mram, crc, offset, size);
+    if (ret != ARM_DRIVER_OK)
+    {
+        return ret;
+    }
+
+    /* The active half with the newest generation holds the log */
+    kv.gen = 0;
+    for (half = 0; half < 2U; half++)
+    {
+        if ((kv_read_header(half, &hdr) == ARM_DRIVER_OK) &&
+            (hdr.state == KV_HALF_ACTIVE) && (hdr.gen > kv.gen))
+        {
+            kv.gen    = hdr.gen;
+            kv.active = half;
+        }
+    }
+    if (kv.gen == 0)
+    {
+        return MRAM_KV_ERROR_NO_STORE;
+    }
+
+    for (off = 0; off < KV_INDEX_SIZE; off++)
+    {
+        kv_index[off].offset = KV_NONE;
+    }
+    kv.keys = 0;
+
+    /* Replay every complete commit, the log ends at the first bad record */
+    for (off = KV_LINE; ; off += rec_size)
+    {
+        rec_size = kv_load(kv.active, kv.gen, off, &rec);
+        if (rec_size == 0)
+        {
+            break;
+        }
+        if (pending == KV_NONE)
+        {
+            pending = off;
+        }
+        if (!(rec.flags & KV_FLAG_MORE))
+        {
+            ret = kv_replay(pending, off + rec_size);
+            if (ret != ARM_DRIVER_OK)
+            {
+                return ret;
+            }
+            pending = KV_NONE;
+        }
+    }
+
+    /* An incomplete commit is overwritten by the next update */
+    kv.write_off = (pending != KV_NONE) ? pending : off;
+    kv.mounted   = 1;
+    return ARM_DRIVER_OK;
+}
+
+int32_t mram_kv_format(ARM_DRIVER_MRAM *mram, ARM_DRIVER_CRC *crc, uint32_t offset, uint32_t size)
+{
+    int32_t     ret;
+
+    ret = kv_open(mram, crc, offset, size);
+    if (ret != ARM_DRIVER_OK)
+    {
+        return ret;
+    }
+
+    /* Retire the other half, then start a new generation in half 0.
+     * Both headers only ever move to a higher generation, so records left
+     * over from any earlier use of a half can never match it again. */
+    ret = kv_write_header(1, kv.max_gen + 1U, KV_HALF_COPYING);
+    if (ret == ARM_DRIVER_OK)
+    {
+        ret = kv_write_header(0, kv.max_gen + 2U, KV_HALF_ACTIVE);
+    }
+    if (ret != ARM_DRIVER_OK)
+    {
+        return ret;
+    }
+
+    return mram_kv_mount(mram, crc, offset, size);
+}
+
+int32_t mram_kv_get(const char *key, void *value, uint32_t size)
+{
+    kv_record_t rec;
+    uint32_t    len, slot, addr;
+    int32_t     ret;
+
+    ret = kv_check_key(key, &len);
+    if (ret != ARM_DRIVER_OK)
+    {
+        return ret;
+    }
+    if (!kv.mounted)
+    {
+        return ARM_DRIVER_ERROR;
+    }
+
+    slot = kv_find(key, len, kv_hash(key, len));
+    if (kv_index[slot].offset == KV_NONE)
+    {
+        return MRAM_KV_ERROR_NOT_FOUND;
+    }
+
+    addr = kv_half_addr(kv.active) + kv_index[slot].offset;
+    ret  = kv_read(addr, &rec, sizeof(rec));
+    if (ret != ARM_DRIVER_OK)
+    {
+        return ret;
+    }
+
+    if (size > rec.val_len)
+    {
+        size = rec.val_len;
+    }
+    if (size)
+    {
+        if (value == NULL)
+        {
+            return ARM_DRIVER_ERROR_PARAMETER;
+        }
+        ret = kv_read(addr + KV_LINE + rec.key_len, value, size);
+        if (ret != ARM_DRIVER_OK)
+        {
+            return ret;
+        }
+    }
+    return rec.val_len;
+}
+
+int32_t mram_kv_set(const char *key, const void *value, uint32_t len)
+{
+    mram_kv_op_t op = {key, value, len};
+
+    if ((value == NULL) && (len != 0))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+    /* A NULL value deletes in a commit, use an empty one instead */
+    if (value == NULL)
+    {
+        op.value = "";
+    }
+    return mram_kv_commit(&op, 1);
+}
+
+int32_t mram_kv_delete(const char *key)
+{
+    mram_kv_op_t op = {key, NULL, 0};
+
+    return mram_kv_commit(&op, 1);
+}
+
+int32_t mram_kv_commit(const mram_kv_op_t *ops, uint32_t count)
+{
+    uint32_t i, klen, size = 0, added = 0, start;
+    int32_t  ret;
+
+    if ((ops == NULL) || (count == 0))
+    {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        ret = kv_check_key(ops[i].key, &klen);
+        if (ret != ARM_DRIVER_OK)
+        {
+            return ret;
+        }
+        if ((ops[i].value != NULL) && (ops[i].len > MRAM_KV_MAX_VALUE_LEN))
+        {
+            return ARM_DRIVER_ERROR_PARAMETER;
+        }
+        size += KV_REC_SIZE(klen, (ops[i].value != NULL) ? ops[i].len : 0U);
+    }
+
+    ret = kv_reserve(size);
+    if (ret != ARM_DRIVER_OK)
+    {
+        return ret;
+    }
+
+    /* Conservative check that the new keys fit in the index */
+    for (i = 0; i < count; i++)
+    {
+        klen = (uint32_t)strlen(ops[i].key);
+        if ((ops[i].value != NULL) &&
+            (kv_index[kv_find(ops[i].key, klen, kv_hash(ops[i].key, klen))].offset == KV_NONE))
+        {
+            added++;
+        }
+    }
+    if ((kv.keys + added) > MRAM_KV_MAX_KEYS)
+    {
+        return MRAM_KV_ERROR_FULL;
+    }
+
+    start = kv.write_off;
+    for (i = 0; i < count; i++)
+    {
+        ret = kv_append(ops[i].key, (uint32_t)strlen(ops[i].key),
+                        ops[i].value, (ops[i].value != NULL) ? ops[i].len : 0U,
+                        ((ops[i].value == NULL) ? KV_FLAG_DELETE : 0U) |
+                        ((i + 1U < count) ? KV_FLAG_MORE : 0U));
+        if (ret != ARM_DRIVER_OK)
+        {
+            /* Nothing committed, reuse the space */
+            kv.write_off = start;
+            return ret;
+        }
+    }
+
+    /* Committed, update the index */
+    for (i = 0; i < count; i++)
+    {
+        klen = (uint32_t)strlen(ops[i].key);
+        (void)kv_apply(ops[i].key, klen, (ops[i].value == NULL) ? KV_FLAG_DELETE : 0U, start);
+        start += KV_REC_SIZE(klen, (ops[i].value != NULL) ? ops[i].len : 0U);
+    }
+    return ARM_DRIVER_OK;
+}
+
+int32_t mram_kv_compact(void)
+{
+    kv_record_t rec;
+    kv_record_t *copy = (kv_record_t *)kv_buf;
+    uint32_t    dst, gen, i, off, size;
+    int32_t     ret;
+
+    if (!kv.mounted)
+    {
+        return ARM_DRIVER_ERROR;
+    }
+
+    dst = kv.active ^ 1U;
+    gen = kv.max_gen + 1U;
+
+    /* Records of the new generation are ignored until the half is ACTIVE */
+    ret = kv_write_header(dst, gen, KV_HALF_COPYING);
+    if (ret != ARM_DRIVER_OK)
+    {
+        return ret;
+    }
+    kv.max_gen = gen;
+
+    off = KV_LINE;
+    for (i = 0; i < KV_INDEX_SIZE; i++)
+    {
+        if (kv_index[i].offset == KV_NONE)
+        {
+            continue;
+        }
+        size = kv_load(kv.active, kv.gen, kv_index[i].offset, &rec);
+        if (size == 0)
+        {
+            return ARM_DRIVER_ERROR;
+        }
+        copy->flags = 0;
+        copy->gen   = gen;
+        ret = kv_crc(kv_buf, size, &copy->crc);
+        if (ret == ARM_DRIVER_OK)
+        {
+            ret = kv_program(kv_half_addr(dst) + off, kv_buf, size);
+        }
+        if (ret != ARM_DRIVER_OK)
+        {
+            return ret;
+        }
+        off += size;
+    }
+
+    ret = kv_write_header(dst, gen, KV_HALF_ACTIVE);
+    if (ret != ARM_DRIVER_OK)
+    {
+        return ret;
+    }
+
+    /* Switch over, records were copied in index order */
+    kv.active    = dst;
+    kv.gen       = gen;
+    kv.write_off = off;
+    off = KV_LINE;
+    for (i = 0; i < KV_INDEX_SIZE; i++)
+    {
+        if (kv_index[i].offset == KV_NONE)
+        {
+            continue;
+        }
+        ret = kv_read(kv_half_addr(dst) + off, &rec, sizeof(rec));
+        if (ret != ARM_DRIVER_OK)
+        {
+            return ret;
+        }
+        kv_index[i].offset = off;
+        off += KV_REC_SIZE(rec.key_len, rec.val_len);
+    }
+
+    kv_stats.compactions++;
+    return ARM_DRIVER_OK;
+}
+
+void mram_kv_get_stats(mram_kv_stats_t *stats)
+{
+    *stats           = kv_stats;
+    stats->keys      = kv.keys;
+    stats->log_used  = kv.mounted ? kv.write_off : 0U;
+    stats->log_size  = kv.half_size;
+}
+
+void mram_kv_reset_stats(void)
+{
+    memset(&kv_stats, 0, sizeof(kv_stats));
+}
@@ -0,0 +1,163 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     mram_kv.h
+ * @version  V1.0.0
+ * @brief    Power-fail-safe key/value store on MRAM. Records are appended
+ *           to a log of 16-byte MRAM lines and checked with the CRC driver,
+ *           a RAM hash index rebuilt at mount gives constant time lookups
+ *           and the log is compacted into the second half of the region
+ *           when it fills up. A set of updates can be committed atomically.
+ ******************************************************************************/
+#ifndef MRAM_KV_H_
+#define MRAM_KV_H_
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include "Driver_MRAM.h"
+#include "Driver_CRC.h"
+
+/* Largest number of keys, sizes the RAM index */
+#ifndef MRAM_KV_MAX_KEYS
+#define MRAM_KV_MAX_KEYS            128
+#endif
+
+/* Longest key in bytes, without the terminating NUL */
+#ifndef MRAM_KV_MAX_KEY_LEN
+#define MRAM_KV_MAX_KEY_LEN         32
+#endif
+
+/* Longest value in bytes */
+#ifndef MRAM_KV_MAX_VALUE_LEN
+#define MRAM_KV_MAX_VALUE_LEN       256
+#endif
+
+/* Key/value store specific error codes */
+#define MRAM_KV_ERROR_NOT_FOUND     (ARM_DRIVER_ERROR_SPECIFIC - 1)    /* Key not in the store          */
+#define MRAM_KV_ERROR_FULL          (ARM_DRIVER_ERROR_SPECIFIC - 2)    /* No room left after compaction */
+#define MRAM_KV_ERROR_NO_STORE      (ARM_DRIVER_ERROR_SPECIFIC - 3)    /* No valid store at mount       */
+
+/**
+ * @brief  One update of an atomic commit. A NULL value deletes the key.
+ */
+typedef struct _mram_kv_op_t{
+    const char              *key;               /*!< NUL terminated key                     */
+    const void              *value;             /*!< Value, NULL to delete the key          */
+    uint32_t                len;                /*!< Value length in bytes                  */
+}mram_kv_op_t;
+
+/**
+ * @brief  Store usage and counters.
+ */
+typedef struct _mram_kv_stats_t{
+    uint32_t                keys;               /*!< Keys in the store                      */
+    uint32_t                log_used;           /*!< Bytes of the active log in use         */
+    uint32_t                log_size;           /*!< Bytes of one log half                  */
+    uint32_t                records;            /*!< Records appended since reset           */
+    uint32_t                bytes_written;      /*!< MRAM bytes programmed since reset      */
+    uint32_t                compactions;        /*!< Compactions since reset                */
+}mram_kv_stats_t;
+
+/**
+  \fn          int32_t mram_kv_mount(ARM_DRIVER_MRAM *mram, ARM_DRIVER_CRC *crc, uint32_t offset, uint32_t size)
+  \brief       Mount the store and rebuild the index from the log. Records
+               of a commit interrupted by a power loss are discarded.
+               Both drivers must be initialized and powered, the CRC driver
+               without callback and set to the algorithm to be used for the
+               store (it must not change between mounts).
+  \param[in]   mram    MRAM driver
+  \param[in]   crc     CRC driver
+  \param[in]   offset  MRAM address-offset of the region, 16-byte aligned
+  \param[in]   size    Size of the region in bytes, split in two log halves
+  \return      \ref execution_status, MRAM_KV_ERROR_NO_STORE when the region
+               holds no store
+*/
+int32_t mram_kv_mount(ARM_DRIVER_MRAM *mram, ARM_DRIVER_CRC *crc, uint32_t offset, uint32_t size);
+
+/**
+  \fn          int32_t mram_kv_format(ARM_DRIVER_MRAM *mram, ARM_DRIVER_CRC *crc, uint32_t offset, uint32_t size)
+  \brief       Create an empty store in the region and mount it.
+  \param[in]   mram    MRAM driver
+  \param[in]   crc     CRC driver
+  \param[in]   offset  MRAM address-offset of the region, 16-byte aligned
+  \param[in]   size    Size of the region in bytes
+  \return      \ref execution_status
+*/
+int32_t mram_kv_format(ARM_DRIVER_MRAM *mram, ARM_DRIVER_CRC *crc, uint32_t offset, uint32_t size);
+
+/**
+  \fn          int32_t mram_kv_get(const char *key, void *value, uint32_t size)
+  \brief       Read the value of a key. At most size bytes are copied.
+  \param[in]   key    NUL terminated key
+  \param[out]  value  Buffer for the value
+  \param[in]   size   Size of the buffer in bytes
+  \return      length of the value or \ref execution_status
+*/
+int32_t mram_kv_get(const char *key, void *value, uint32_t size);
+
+/**
+  \fn          int32_t mram_kv_set(const char *key, const void *value, uint32_t len)
+  \brief       Add or replace a key. After a power loss the key reads back
+               either its old or its new value.
+  \param[in]   key    NUL terminated key
+  \param[in]   value  Value
+  \param[in]   len    Value length in bytes
+  \return      \ref execution_status
+*/
+int32_t mram_kv_set(const char *key, const void *value, uint32_t len);
+
+/**
+  \fn          int32_t mram_kv_delete(const char *key)
+  \brief       Remove a key.
+  \param[in]   key  NUL terminated key
+  \return      \ref execution_status
+*/
+int32_t mram_kv_delete(const char *key);
+
+/**
+  \fn          int32_t mram_kv_commit(const mram_kv_op_t *ops, uint32_t count)
+  \brief       Apply a set of updates atomically: after a power loss either
+               all or none of them are visible.
+  \param[in]   ops    Updates, applied in order
+  \param[in]   count  Number of updates
+  \return      \ref execution_status
+*/
+int32_t mram_kv_commit(const mram_kv_op_t *ops, uint32_t count);
+
+/**
+  \fn          int32_t mram_kv_compact(void)
+  \brief       Copy the live records to the other log half and switch to it.
+               Runs on its own when an update does not fit in the log.
+  \return      \ref execution_status
+*/
+int32_t mram_kv_compact(void);
+
+/**
+  \fn          void mram_kv_get_stats(mram_kv_stats_t *stats)
+  \brief       Copy the store usage and counters.
+  \param[out]  stats  Pointer to counters
+*/
+void mram_kv_get_stats(mram_kv_stats_t *stats);
+
+/**
+  \fn          void mram_kv_reset_stats(void)
+  \brief       Clear the store counters.
+*/
+void mram_kv_reset_stats(void);
+
+#ifdef  __cplusplus
+}
+#endif
+#endif /* MRAM_KV_H_ */
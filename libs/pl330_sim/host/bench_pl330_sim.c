@@ -0,0 +1,116 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     bench_pl330_sim.c
+ * @brief    Host benchmark: sweep total_len, burst size and burst length
+ *           through dma_generate_opcode() and report, per combination, the
+ *           program size, the executed instructions, the bus transfers
+ *           and beats. Output is one tab separated line per combination.
+ *
+ *           ./bench_pl330_sim [m2m|m2p|p2m]
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dma_op.h>
+#include "pl330_sim.h"
+
+#define MEM_BASE        0x02000000U
+#define MEM_HALF        0x40000U
+#define PERIPH_ADDR     0x49000000U
+
+static dma_config_info_t    dma_cfg;
+static uint8_t              mem[2 * MEM_HALF];
+static uint8_t              periph_buf[MEM_HALF];
+
+int main(int argc, char **argv)
+{
+    static const uint32_t lens[]  = { 16, 64, 256, 1000, 1024, 4096, 16384, 65536, 262144 };
+    static const uint8_t  blens[] = { 1, 2, 4, 8, 16 };
+    DMA_TRANSFER          direction = DMA_TRANSFER_MEM_TO_MEM;
+    dma_channel_info_t   *ch = &dma_cfg.channel_thread[0].channel_info;
+    dma_desc_info_t      *desc = &ch->desc_info;
+    pl330_sim_t           sim;
+    PL330_SIM_STATUS      status;
+    unsigned int          l, b, bsize;
+    uint32_t              len;
+
+    if(argc > 1)
+    {
+        if(!strcmp(argv[1], "m2p"))
+            direction = DMA_TRANSFER_MEM_TO_DEV;
+        else if(!strcmp(argv[1], "p2m"))
+            direction = DMA_TRANSFER_DEV_TO_MEM;
+        else if(strcmp(argv[1], "m2m"))
+        {
+            printf("usage: %s [m2m|m2p|p2m]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("total_len\tbsize\tblen\tmcode\tinstr\tloads\tstores\tbursts\tbeats\tinstr/KiB\n");
+
+    for(l = 0; l < sizeof(lens) / sizeof(lens[0]); l++)
+        for(bsize = 0; bsize < 4; bsize++)
+            for(b = 0; b < sizeof(blens) / sizeof(blens[0]); b++)
+            {
+                len = lens[l] & ~((1U << bsize) - 1U);
+
+                memset(&dma_cfg, 0, sizeof(dma_cfg));
+                desc->direction  = direction;
+                desc->total_len  = len;
+                desc->src_bsize  = (uint8_t)bsize;
+                desc->dst_bsize  = (uint8_t)bsize;
+                desc->src_blen   = blens[b];
+                desc->dst_blen   = blens[b];
+                desc->src_addr   = (direction == DMA_TRANSFER_DEV_TO_MEM) ? PERIPH_ADDR : MEM_BASE;
+                desc->dst_addr   = (direction == DMA_TRANSFER_MEM_TO_DEV) ? PERIPH_ADDR : MEM_BASE + MEM_HALF;
+
+                printf("%u\t%u\t%u\t", (unsigned)len, bsize, blens[b]);
+
+                if(!dma_generate_opcode(&dma_cfg, 0))
+                {
+                    printf("no fit in %u byte program\n", DMA_MICROCODE_SIZE);
+                    continue;
+                }
+
+                memset(&sim, 0, sizeof(sim));
+                sim.mem.data            = mem;
+                sim.mem.base            = MEM_BASE;
+                sim.mem.size            = sizeof(mem);
+                sim.periph.data         = periph_buf;
+                sim.periph.addr         = PERIPH_ADDR;
+                sim.periph.len          = (direction == DMA_TRANSFER_MEM_TO_MEM) ? 0 : len;
+                sim.periph.burst_bytes  = (uint32_t)blens[b] << bsize;
+
+                status = pl330_sim_run(&sim, dma_cfg.channel_thread[0].dma_mcode,
+                                       DMA_MICROCODE_SIZE);
+                if((status != PL330_SIM_OK) || (sim.stats.bytes_stored != len))
+                {
+                    printf("error %d, %u bytes stored\n", status,
+                           (unsigned)sim.stats.bytes_stored);
+                    return EXIT_FAILURE;
+                }
+
+                printf("%u\t%u\t%u\t%u\t%u\t%u\t%.1f\n",
+                       (unsigned)sim.stats.mcode_size,
+                       (unsigned)sim.stats.instructions,
+                       (unsigned)sim.stats.loads,
+                       (unsigned)sim.stats.stores,
+                       (unsigned)sim.stats.bursts,
+                       (unsigned)sim.stats.beats,
+                       (double)sim.stats.instructions * 1024.0 / (double)len);
+            }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,303 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     test_pl330_sim.c
+ * @brief    Host tests: run the programs of dma_generate_opcode() and
+ *           dma_generate_cyclic_opcode() through the interpreter and check
+ *           the moved data, the byte counts and the final addresses for
+ *           every direction, burst size and burst length.
+ ******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dma_op.h>
+#include "pl330_sim.h"
+
+#define MEM_BASE        0x02000000U
+#define MEM_HALF        0x10000U
+#define PERIPH_ADDR     0x49000000U
+
+static dma_config_info_t    dma_cfg;
+static uint8_t              mem[2 * MEM_HALF];
+static uint8_t              periph_buf[2 * MEM_HALF];
+static unsigned int         failures;
+
+#define CHECK(cond, ...)                                                    \
+    do {                                                                    \
+        if(!(cond))                                                         \
+        {                                                                   \
+            failures++;                                                     \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__);                     \
+            printf(__VA_ARGS__);                                            \
+            printf("\n");                                                   \
+        }                                                                   \
+    } while(0)
+
+static void fill(uint8_t *buf, uint32_t len, uint32_t seed)
+{
+    uint32_t i;
+
+    for(i = 0; i < len; i++)
+        buf[i] = (uint8_t)((i * 31U) + seed + (i >> 8));
+}
+
+static dma_channel_info_t *setup(DMA_TRANSFER direction, uint32_t len,
+                                 uint8_t bsize, uint8_t blen, uint32_t flags)
+{
+    dma_channel_info_t *ch = &dma_cfg.channel_thread[0].channel_info;
+    dma_desc_info_t    *desc = &ch->desc_info;
+
+    memset(&dma_cfg, 0, sizeof(dma_cfg));
+
+    ch->flags         = flags;
+    ch->event_index   = 3;
+    desc->direction   = direction;
+    desc->total_len   = len;
+    desc->src_bsize   = bsize;
+    desc->dst_bsize   = bsize;
+    desc->src_blen    = blen;
+    desc->dst_blen    = blen;
+    desc->periph_num  = 5;
+    desc->src_addr    = (direction == DMA_TRANSFER_DEV_TO_MEM) ? PERIPH_ADDR : MEM_BASE;
+    desc->dst_addr    = (direction == DMA_TRANSFER_MEM_TO_DEV) ? PERIPH_ADDR : MEM_BASE + MEM_HALF;
+
+    return ch;
+}
+
+static void sim_init(pl330_sim_t *sim, uint32_t periph_len, uint32_t burst_bytes)
+{
+    memset(sim, 0, sizeof(*sim));
+    sim->mem.data          = mem;
+    sim->mem.base          = MEM_BASE;
+    sim->mem.size          = sizeof(mem);
+    sim->periph.data       = periph_buf;
+    sim->periph.addr       = PERIPH_ADDR;
+    sim->periph.len        = periph_len;
+    sim->periph.burst_bytes = burst_bytes;
+}
+
+/* One block in every direction, for one length, burst size and length */
+static void test_block(DMA_TRANSFER direction, uint32_t len, uint8_t bsize, uint8_t blen)
+{
+    pl330_sim_t         sim;
+    PL330_SIM_STATUS    status;
+    const uint8_t      *src, *dst;
+    uint32_t            plen = 0;
+
+    setup(direction, len, bsize, blen, 0);
+
+    if(!dma_generate_opcode(&dma_cfg, 0))
+    {
+        /* Only large blocks may overflow DMA_MICROCODE_SIZE */
+        CHECK(len > 4096, "dir %d len %u bsize %u blen %u: no program",
+              direction, (unsigned)len, bsize, blen);
+        return;
+    }
+
+    fill(mem, sizeof(mem), len + bsize + blen);
+    fill(periph_buf, sizeof(periph_buf), len ^ 0x5AU);
+
+    if(direction != DMA_TRANSFER_MEM_TO_MEM)
+        plen = len;
+    sim_init(&sim, plen, (uint32_t)blen << bsize);
+
+    status = pl330_sim_run(&sim, dma_cfg.channel_thread[0].dma_mcode, DMA_MICROCODE_SIZE);
+    CHECK(status == PL330_SIM_OK, "dir %d len %u bsize %u blen %u: status %d",
+          direction, (unsigned)len, bsize, blen, status);
+    if(status != PL330_SIM_OK)
+        return;
+
+    src = (direction == DMA_TRANSFER_DEV_TO_MEM) ? periph_buf : mem;
+    dst = (direction == DMA_TRANSFER_MEM_TO_DEV) ? periph_buf : &mem[MEM_HALF];
+
+    CHECK(!memcmp(src, dst, len), "dir %d len %u bsize %u blen %u: data",
+          direction, (unsigned)len, bsize, blen);
+    CHECK(sim.stats.bytes_loaded == len && sim.stats.bytes_stored == len,
+          "dir %d len %u bsize %u blen %u: loaded %u stored %u", direction,
+          (unsigned)len, bsize, blen, (unsigned)sim.stats.bytes_loaded,
+          (unsigned)sim.stats.bytes_stored);
+    CHECK(sim.stats.events == 1, "events %u", (unsigned)sim.stats.events);
+
+    if(direction == DMA_TRANSFER_DEV_TO_MEM)
+        CHECK(sim.stats.sar == PERIPH_ADDR, "sar 0x%08x", (unsigned)sim.stats.sar);
+    else
+        CHECK(sim.stats.sar == MEM_BASE + len, "sar 0x%08x", (unsigned)sim.stats.sar);
+
+    if(direction == DMA_TRANSFER_MEM_TO_DEV)
+        CHECK(sim.stats.dar == PERIPH_ADDR, "dar 0x%08x", (unsigned)sim.stats.dar);
+    else
+        CHECK(sim.stats.dar == MEM_BASE + MEM_HALF + len, "dar 0x%08x", (unsigned)sim.stats.dar);
+
+    if(direction != DMA_TRANSFER_MEM_TO_MEM)
+        CHECK(sim.periph.pos == len, "periph pos %u", (unsigned)sim.periph.pos);
+}
+
+/* Cyclic Rx: every pass writes the buffer again and raises one event per period */
+static void test_cyclic(uint32_t len, uint8_t periods, uint8_t bsize, uint8_t blen)
+{
+    dma_channel_info_t *ch;
+    pl330_sim_t         sim;
+    PL330_SIM_STATUS    status;
+
+    ch = setup(DMA_TRANSFER_DEV_TO_MEM, len, bsize, blen, 0);
+    ch->periods = periods;
+
+    if(!dma_generate_cyclic_opcode(&dma_cfg, 0))
+    {
+        CHECK(0, "cyclic len %u periods %u bsize %u blen %u: no program",
+              (unsigned)len, periods, bsize, blen);
+        return;
+    }
+
+    fill(periph_buf, 2 * len, periods);
+    memset(mem, 0, sizeof(mem));
+    sim_init(&sim, 2 * len, (uint32_t)blen << bsize);
+    sim.max_passes = 2;
+
+    status = pl330_sim_run(&sim, dma_cfg.channel_thread[0].dma_mcode, DMA_MICROCODE_SIZE);
+    CHECK(status == PL330_SIM_OK, "cyclic len %u: status %d", (unsigned)len, status);
+    CHECK(sim.stats.cyclic && (sim.stats.passes == 2), "cyclic passes %u",
+          (unsigned)sim.stats.passes);
+    CHECK(sim.stats.events == 2U * periods, "cyclic events %u", (unsigned)sim.stats.events);
+    CHECK(sim.stats.bytes_stored == 2 * len, "cyclic stored %u",
+          (unsigned)sim.stats.bytes_stored);
+    CHECK(!memcmp(&mem[MEM_HALF], &periph_buf[len], len), "cyclic data of pass 2");
+    CHECK(sim.periph.pos == 2 * len, "cyclic periph pos %u", (unsigned)sim.periph.pos);
+}
+
+/* I2S mono Tx: every left sample is followed by a zero right sample */
+static void test_i2s_mono(uint32_t len)
+{
+    pl330_sim_t         sim;
+    PL330_SIM_STATUS    status;
+    uint32_t            i;
+    int                 ok = 1;
+
+    setup(DMA_TRANSFER_MEM_TO_DEV, len, 2, 1, DMA_CHANNEL_FLAG_I2S_MONO_MODE);
+    CHECK(dma_generate_opcode(&dma_cfg, 0), "mono: no program");
+
+    fill(mem, len, 7);
+    memset(periph_buf, 0xEE, 2 * len);
+    sim_init(&sim, 2 * len, 4);
+
+    status = pl330_sim_run(&sim, dma_cfg.channel_thread[0].dma_mcode, DMA_MICROCODE_SIZE);
+    CHECK(status == PL330_SIM_OK, "mono: status %d", status);
+
+    for(i = 0; i < len / 4; i++)
+    {
+        if(memcmp(&periph_buf[8 * i], &mem[4 * i], 4) ||
+           periph_buf[8 * i + 4] || periph_buf[8 * i + 5] ||
+           periph_buf[8 * i + 6] || periph_buf[8 * i + 7])
+            ok = 0;
+    }
+    CHECK(ok, "mono: sample layout");
+}
+
+/* A prepared program patched to new addresses copies to and from them only */
+static void test_patch_addr(uint32_t len, uint8_t bsize, uint8_t blen)
+{
+    dma_channel_info_t *ch;
+    pl330_sim_t         sim;
+    PL330_SIM_STATUS    status;
+    uint16_t            off, cnt;
+    const uint32_t      src_off = 0x100, dst_off = 0x240;
+
+    ch = setup(DMA_TRANSFER_MEM_TO_MEM, len, bsize, blen, 0);
+    CHECK(dma_generate_opcode(&dma_cfg, 0), "patch: no program");
+    CHECK(ch->flags & DMA_CHANNEL_FLAG_PREPARED, "patch: program not prepared");
+
+    ch->desc_info.src_addr += src_off;
+    ch->desc_info.dst_addr += dst_off;
+    dma_patch_opcode_addr(&dma_cfg, 0, &off, &cnt);
+    CHECK(cnt == 12 && (off + cnt) <= DMA_MICROCODE_SIZE, "patch: off %u len %u",
+          (unsigned)off, (unsigned)cnt);
+
+    fill(mem, sizeof(mem), len + 3);
+    memset(&mem[MEM_HALF], 0, MEM_HALF);
+    sim_init(&sim, 0, (uint32_t)blen << bsize);
+
+    status = pl330_sim_run(&sim, dma_cfg.channel_thread[0].dma_mcode, DMA_MICROCODE_SIZE);
+    CHECK(status == PL330_SIM_OK, "patch: status %d", status);
+    CHECK(!memcmp(&mem[src_off], &mem[MEM_HALF + dst_off], len), "patch: data");
+    CHECK(mem[MEM_HALF + dst_off - 1] == 0 && mem[MEM_HALF + dst_off + len] == 0,
+          "patch: bytes outside the new destination written");
+    CHECK(sim.stats.sar == MEM_BASE + src_off + len &&
+          sim.stats.dar == MEM_BASE + MEM_HALF + dst_off + len,
+          "patch: sar 0x%08x dar 0x%08x", (unsigned)sim.stats.sar, (unsigned)sim.stats.dar);
+}
+
+/* Malformed programs and peripherals that stop requesting */
+static void test_errors(void)
+{
+    static const uint8_t bad_op[]    = { OP_DMAWFE, 0x00, OP_DMAEND };
+    static const uint8_t no_end[]    = { OP_DMANOP, OP_DMANOP };
+    static const uint8_t bad_jump[]  = { OP_DMALP(0), 3, OP_DMALPEND(1, 0), 8, OP_DMAEND };
+    static const uint8_t underflow[] = { OP_DMAST, OP_DMAEND };
+    static const uint8_t leftover[]  = { OP_DMAMOV, DMA_REG_SAR, 0x00, 0x00, 0x00, 0x02,
+                                         OP_DMALD, OP_DMAEND };
+    static const uint8_t bus[]       = { OP_DMAMOV, DMA_REG_SAR, 0x00, 0x00, 0x00, 0x01,
+                                         OP_DMALD, OP_DMAEND };
+    static const uint8_t runaway[]   = { OP_DMALPEND(0, 0), 0 };
+    static const uint8_t stall[]     = { OP_DMAWFP(0), 0x28, OP_DMAEND };
+    pl330_sim_t sim;
+
+    sim_init(&sim, 0, 4);
+
+    CHECK(pl330_sim_run(&sim, bad_op, sizeof(bad_op)) == PL330_SIM_ERR_OPCODE, "bad opcode");
+    CHECK(pl330_sim_run(&sim, no_end, sizeof(no_end)) == PL330_SIM_ERR_PC, "no DMAEND");
+    CHECK(pl330_sim_run(&sim, bad_jump, sizeof(bad_jump)) == PL330_SIM_ERR_PC, "bad jump");
+    CHECK(pl330_sim_run(&sim, underflow, sizeof(underflow)) == PL330_SIM_ERR_MFIFO, "underflow");
+    CHECK(pl330_sim_run(&sim, leftover, sizeof(leftover)) == PL330_SIM_ERR_MFIFO, "leftover");
+    CHECK(pl330_sim_run(&sim, bus, sizeof(bus)) == PL330_SIM_ERR_BUS, "bus error");
+    CHECK(pl330_sim_run(&sim, stall, sizeof(stall)) == PL330_SIM_ERR_STALL, "stall");
+
+    sim.max_passes = 0xFFFFFFFFU;
+    CHECK(pl330_sim_run(&sim, runaway, sizeof(runaway)) == PL330_SIM_ERR_LIMIT, "runaway");
+}
+
+int main(void)
+{
+    static const uint32_t lens[]  = { 1, 4, 60, 64, 100, 256, 1000, 4096, 8200, 65536 };
+    static const uint8_t  blens[] = { 1, 2, 3, 4, 8, 16 };
+    DMA_TRANSFER          direction;
+    unsigned int          l, b, bsize;
+    uint32_t              len;
+
+    for(direction = DMA_TRANSFER_MEM_TO_MEM; direction < DMA_TRANSFER_NONE; direction++)
+        for(l = 0; l < sizeof(lens) / sizeof(lens[0]); l++)
+            for(bsize = 0; bsize < 4; bsize++)
+                for(b = 0; b < sizeof(blens) / sizeof(blens[0]); b++)
+                {
+                    /* The generators need a multiple of the beat size */
+                    len = lens[l] & ~((1U << bsize) - 1U);
+                    if(len)
+                        test_block(direction, len, (uint8_t)bsize, blens[b]);
+                }
+
+    test_cyclic(1024, 4, 2, 4);
+    test_cyclic(960, 3, 1, 8);
+    test_cyclic(256, 16, 0, 1);
+    test_i2s_mono(256);
+    test_patch_addr(1000, 2, 4);
+    test_patch_addr(4096, 3, 16);
+    test_errors();
+
+    if(failures)
+    {
+        printf("%u check(s) failed\n", failures);
+        return EXIT_FAILURE;
+    }
+
+    printf("All PL330 interpreter tests passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,445 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     pl330_sim.c
+ * @version  V1.0.0
+ * @brief    Portable PL330 channel program interpreter
+ ******************************************************************************/
+
+/* Includes ------------------------------------------------------------------*/
+#include "pl330_sim.h"
+#include <dma_opcode.h>
+#include <string.h>
+
+/* Request flag set by DMAWFP, checked by the conditional instructions */
+#define REQ_NONE            0xFFU
+#define REQ_SINGLE          0U
+#define REQ_BURST           1U
+
+typedef struct _pl330_sim_ctx_t {
+    pl330_sim_t             *sim;
+    dma_ccr_t               ccr;
+    uint32_t                sar;
+    uint32_t                dar;
+    uint8_t                 lc[2];
+    uint8_t                 req;
+    uint32_t                fifo_rd;
+    uint32_t                fifo_cnt;
+    uint8_t                 fifo[PL330_SIM_MFIFO_SIZE];
+} pl330_sim_ctx_t;
+
+/**
+  \fn          static bool pl330_sim_cond(const pl330_sim_ctx_t *ctx, uint8_t op)
+  \brief       Check whether a conditional instruction executes. The
+               encoding carries x in bit 0 and bs in bit 1.
+  \param[in]   ctx  Interpreter context
+  \param[in]   op  Instruction
+  \return      bool true if the instruction executes
+*/
+static bool pl330_sim_cond(const pl330_sim_ctx_t *ctx, uint8_t op)
+{
+    if(!(op & 0x1U) || (ctx->req == REQ_NONE))
+        return true;
+
+    return ctx->req == ((op >> 1) & 0x1U);
+}
+
+/**
+  \fn          static uint8_t* pl330_sim_beat_ptr(pl330_sim_ctx_t *ctx,
+                                                  uint32_t         addr,
+                                                  uint32_t         bytes)
+  \brief       Resolve the bus address of one beat. The peripheral data
+               register consumes the next bytes of its buffer.
+  \param[in]   ctx  Interpreter context
+  \param[in]   addr  Bus address of the beat
+  \param[in]   bytes  Beat size
+  \return      uint8_t* Backing storage, NULL for a bus error
+*/
+static uint8_t* pl330_sim_beat_ptr(pl330_sim_ctx_t *ctx,
+                                   uint32_t         addr,
+                                   uint32_t         bytes)
+{
+    pl330_sim_periph_t *periph = &ctx->sim->periph;
+    pl330_sim_mem_t    *mem    = &ctx->sim->mem;
+    uint8_t            *ptr;
+
+    if(periph->len && (addr == periph->addr))
+    {
+        if((periph->len - periph->pos) < bytes)
+            return NULL;
+
+        ptr = &periph->data[periph->pos];
+        periph->pos += bytes;
+        return ptr;
+    }
+
+    if((addr < mem->base) || ((addr - mem->base) > mem->size) ||
+       ((mem->size - (addr - mem->base)) < bytes))
+        return NULL;
+
+    return &mem->data[addr - mem->base];
+}
+
+/**
+  \fn          static PL330_SIM_STATUS pl330_sim_load(pl330_sim_ctx_t *ctx)
+  \brief       Read one transfer from SAR into the MFIFO
+  \param[in]   ctx  Interpreter context
+  \return      \ref PL330_SIM_STATUS
+*/
+static PL330_SIM_STATUS pl330_sim_load(pl330_sim_ctx_t *ctx)
+{
+    pl330_sim_stats_t *stats = &ctx->sim->stats;
+    uint32_t           beats = ctx->ccr.value_b.src_burst_len + 1U;
+    uint32_t           bytes = 1U << ctx->ccr.value_b.src_burst_size;
+    uint32_t           beat, i, wr;
+    uint8_t           *ptr;
+
+    if((ctx->fifo_cnt + (beats * bytes)) > PL330_SIM_MFIFO_SIZE)
+        return PL330_SIM_ERR_MFIFO;
+
+    for(beat = 0; beat < beats; beat++)
+    {
+        ptr = pl330_sim_beat_ptr(ctx, ctx->sar, bytes);
+        if(!ptr)
+            return PL330_SIM_ERR_BUS;
+
+        for(i = 0; i < bytes; i++)
+        {
+            wr = (ctx->fifo_rd + ctx->fifo_cnt) % PL330_SIM_MFIFO_SIZE;
+            ctx->fifo[wr] = ptr[i];
+            ctx->fifo_cnt++;
+        }
+
+        if(ctx->ccr.value_b.src_inc)
+            ctx->sar += bytes;
+    }
+
+    stats->loads++;
+    stats->beats += beats;
+    stats->bytes_loaded += beats * bytes;
+    if(beats > 1)
+        stats->bursts++;
+
+    return PL330_SIM_OK;
+}
+
+/**
+  \fn          static PL330_SIM_STATUS pl330_sim_store(pl330_sim_ctx_t *ctx,
+                                                       bool             zeros)
+  \brief       Write one transfer from the MFIFO, or zeros, to DAR
+  \param[in]   ctx  Interpreter context
+  \param[in]   zeros  DMASTZ, write zeros without using the MFIFO
+  \return      \ref PL330_SIM_STATUS
+*/
+static PL330_SIM_STATUS pl330_sim_store(pl330_sim_ctx_t *ctx, bool zeros)
+{
+    pl330_sim_stats_t *stats = &ctx->sim->stats;
+    uint32_t           beats = ctx->ccr.value_b.dst_burst_len + 1U;
+    uint32_t           bytes = 1U << ctx->ccr.value_b.dst_burst_size;
+    uint32_t           beat, i;
+    uint8_t           *ptr;
+
+    if(!zeros && (ctx->fifo_cnt < (beats * bytes)))
+        return PL330_SIM_ERR_MFIFO;
+
+    for(beat = 0; beat < beats; beat++)
+    {
+        ptr = pl330_sim_beat_ptr(ctx, ctx->dar, bytes);
+        if(!ptr)
+            return PL330_SIM_ERR_BUS;
+
+        for(i = 0; i < bytes; i++)
+        {
+            if(zeros)
+            {
+                ptr[i] = 0;
+            }
+            else
+            {
+                ptr[i] = ctx->fifo[ctx->fifo_rd];
+                ctx->fifo_rd = (ctx->fifo_rd + 1U) % PL330_SIM_MFIFO_SIZE;
+                ctx->fifo_cnt--;
+            }
+        }
+
+        if(ctx->ccr.value_b.dst_inc)
+            ctx->dar += bytes;
+    }
+
+    stats->stores++;
+    stats->beats += beats;
+    stats->bytes_stored += beats * bytes;
+    if(beats > 1)
+        stats->bursts++;
+
+    return PL330_SIM_OK;
+}
+
+/**
+  \fn          static PL330_SIM_STATUS pl330_sim_wfp(pl330_sim_ctx_t *ctx, uint8_t op)
+  \brief       Wait for a peripheral request and set the request flag
+  \param[in]   ctx  Interpreter context
+  \param[in]   op  DMAWFP instruction
+  \return      \ref PL330_SIM_STATUS
+*/
+static PL330_SIM_STATUS pl330_sim_wfp(pl330_sim_ctx_t *ctx, uint8_t op)
+{
+    pl330_sim_periph_t *periph = &ctx->sim->periph;
+    uint32_t            left   = periph->len - periph->pos;
+
+    /* Nothing else runs while the channel waits, so no request will come */
+    if(!left)
+        return PL330_SIM_ERR_STALL;
+
+    if(op == OP_DMAWFP_P(1))
+        ctx->req = (left >= periph->burst_bytes) ? REQ_BURST : REQ_SINGLE;
+    else
+        ctx->req = (op >> 1) & 0x1U;
+
+    ctx->sim->stats.periph_waits++;
+
+    return PL330_SIM_OK;
+}
+
+/**
+  \fn          PL330_SIM_STATUS pl330_sim_run(pl330_sim_t *sim, const uint8_t *mcode, uint16_t size)
+  \brief       Execute a channel program from its first byte
+  \param[in]   sim    Interpreter state, stats are cleared first
+  \param[in]   mcode  Channel program
+  \param[in]   size   Size of the program buffer
+  \return      \ref PL330_SIM_STATUS
+*/
+PL330_SIM_STATUS pl330_sim_run(pl330_sim_t *sim, const uint8_t *mcode, uint16_t size)
+{
+    /* The MFIFO model is too large for small target stacks, not reentrant */
+    static pl330_sim_ctx_t  ctx;
+    pl330_sim_stats_t      *stats = &sim->stats;
+    PL330_SIM_STATUS        status = PL330_SIM_OK;
+    uint32_t                pc = 0, imm, max_passes;
+    uint8_t                 op, len;
+    bool                    done = false;
+
+    memset(stats, 0, sizeof(*stats));
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.sim = sim;
+    ctx.req = REQ_NONE;
+
+    max_passes = sim->max_passes ? sim->max_passes : 1U;
+
+    while(!done && (status == PL330_SIM_OK))
+    {
+        if(stats->instructions >= PL330_SIM_MAX_INSTRUCTIONS)
+        {
+            status = PL330_SIM_ERR_LIMIT;
+            break;
+        }
+
+        if(pc >= size)
+        {
+            status = PL330_SIM_ERR_PC;
+            break;
+        }
+
+        op = mcode[pc];
+
+        switch(op)
+        {
+        case OP_DMAEND:
+        case OP_DMALD:
+        case OP_DMALDS:
+        case OP_DMALDB:
+        case OP_DMAST:
+        case OP_DMASTS:
+        case OP_DMASTB:
+        case OP_DMASTZ:
+        case OP_DMARMB:
+        case OP_DMAWMB:
+        case OP_DMANOP:
+            len = DMA_OP_1BYTE_LEN;
+            break;
+        case OP_DMALP(0):
+        case OP_DMALP(1):
+        case OP_DMALDP(0):
+        case OP_DMALDP(1):
+        case OP_DMASTP(0):
+        case OP_DMASTP(1):
+        case OP_DMALPEND(0, 0):
+        case OP_DMALPEND(0, 1):
+        case OP_DMALPEND(1, 0):
+        case OP_DMALPEND(1, 1):
+        case OP_DMALPENDS(0):
+        case OP_DMALPENDS(1):
+        case OP_DMALPENDB(0):
+        case OP_DMALPENDB(1):
+        case OP_DMAWFP(0):
+        case OP_DMAWFP(1):
+        case OP_DMAWFP_P(1):
+        case OP_DMASEV:
+        case OP_DMAFLUSHP:
+            len = DMA_OP_2BYTE_LEN;
+            break;
+        case OP_DMAADDH(0):
+        case OP_DMAADDH(1):
+        case OP_DMAADNH(0):
+        case OP_DMAADNH(1):
+            len = DMA_OP_3BYTE_LEN;
+            break;
+        case OP_DMAMOV:
+            len = DMA_OP_6BYTE_LEN;
+            break;
+        default:
+            /* DMAWFE has no event source here, DMAGO/DMAKILL are manager only */
+            len = 0;
+            break;
+        }
+
+        if(!len)
+        {
+            status = PL330_SIM_ERR_OPCODE;
+            break;
+        }
+
+        if((pc + len) > size)
+        {
+            status = PL330_SIM_ERR_PC;
+            break;
+        }
+
+        if((pc + len) > stats->mcode_size)
+            stats->mcode_size = (uint16_t)(pc + len);
+
+        stats->instructions++;
+
+        switch(op)
+        {
+        case OP_DMAEND:
+            done = true;
+            break;
+        case OP_DMAMOV:
+            imm = (uint32_t)mcode[pc + 2] | ((uint32_t)mcode[pc + 3] << 8) |
+                  ((uint32_t)mcode[pc + 4] << 16) | ((uint32_t)mcode[pc + 5] << 24);
+
+            if(mcode[pc + 1] == DMA_REG_SAR)
+                ctx.sar = imm;
+            else if(mcode[pc + 1] == DMA_REG_CCR)
+                ctx.ccr.value = imm;
+            else if(mcode[pc + 1] == DMA_REG_DAR)
+                ctx.dar = imm;
+            else
+                status = PL330_SIM_ERR_OPCODE;
+            break;
+        case OP_DMAADDH(0):
+        case OP_DMAADDH(1):
+            imm = (uint32_t)mcode[pc + 1] | ((uint32_t)mcode[pc + 2] << 8);
+            if(op & 0x2U)
+                ctx.dar += imm;
+            else
+                ctx.sar += imm;
+            break;
+        case OP_DMAADNH(0):
+        case OP_DMAADNH(1):
+            /* The immediate is extended with ones to 32 bits */
+            imm = 0xFFFF0000U | (uint32_t)mcode[pc + 1] | ((uint32_t)mcode[pc + 2] << 8);
+            if(op & 0x2U)
+                ctx.dar += imm;
+            else
+                ctx.sar += imm;
+            break;
+        case OP_DMALD:
+        case OP_DMALDS:
+        case OP_DMALDB:
+        case OP_DMALDP(0):
+        case OP_DMALDP(1):
+            if(pl330_sim_cond(&ctx, op))
+                status = pl330_sim_load(&ctx);
+            break;
+        case OP_DMAST:
+        case OP_DMASTS:
+        case OP_DMASTB:
+        case OP_DMASTP(0):
+        case OP_DMASTP(1):
+            if(pl330_sim_cond(&ctx, op))
+                status = pl330_sim_store(&ctx, false);
+            break;
+        case OP_DMASTZ:
+            status = pl330_sim_store(&ctx, true);
+            break;
+        case OP_DMAWFP(0):
+        case OP_DMAWFP(1):
+        case OP_DMAWFP_P(1):
+            status = pl330_sim_wfp(&ctx, op);
+            break;
+        case OP_DMAFLUSHP:
+            stats->flushes++;
+            break;
+        case OP_DMASEV:
+            stats->events++;
+            break;
+        case OP_DMALP(0):
+        case OP_DMALP(1):
+            /* The counter holds the iterations - 1 */
+            ctx.lc[(op >> 1) & 0x1U] = mcode[pc + 1];
+            stats->loops++;
+            break;
+        case OP_DMALPEND(0, 0):
+        case OP_DMALPEND(0, 1):
+            /* DMALPFE: jump back until the pass limit */
+            stats->passes++;
+            if(stats->passes >= max_passes)
+            {
+                stats->cyclic = true;
+                done = true;
+                break;
+            }
+            if(mcode[pc + 1] > pc)
+            {
+                status = PL330_SIM_ERR_PC;
+                break;
+            }
+            pc -= mcode[pc + 1];
+            continue;
+        case OP_DMALPEND(1, 0):
+        case OP_DMALPEND(1, 1):
+        case OP_DMALPENDS(0):
+        case OP_DMALPENDS(1):
+        case OP_DMALPENDB(0):
+        case OP_DMALPENDB(1):
+            if(pl330_sim_cond(&ctx, op) && ctx.lc[(op >> 2) & 0x1U])
+            {
+                ctx.lc[(op >> 2) & 0x1U]--;
+                stats->loop_jumps++;
+
+                if(mcode[pc + 1] > pc)
+                {
+                    status = PL330_SIM_ERR_PC;
+                    break;
+                }
+                pc -= mcode[pc + 1];
+                continue;
+            }
+            break;
+        default:
+            /* Barriers and DMANOP */
+            break;
+        }
+
+        pc += len;
+    }
+
+    /* Data left in the MFIFO never reaches the destination */
+    if((status == PL330_SIM_OK) && ctx.fifo_cnt)
+        status = PL330_SIM_ERR_MFIFO;
+
+    stats->sar = ctx.sar;
+    stats->dar = ctx.dar;
+
+    return status;
+}
@@ -0,0 +1,130 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/******************************************************************************
+ * @file     pl330_sim.h
+ * @version  V1.0.0
+ * @brief    Portable PL330 channel program interpreter. Runs the microcode
+ *           built by dma_op.c against a simulated memory and a peripheral
+ *           request model, moving the data through a modelled MFIFO, and
+ *           reports what the program cost. Plain C99, no hardware access,
+ *           so it builds on the host (see host/Makefile) as well as on the
+ *           target.
+ ******************************************************************************/
+#ifndef PL330_SIM_H_
+#define PL330_SIM_H_
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Bytes the modelled MFIFO holds between loads and stores */
+#ifndef PL330_SIM_MFIFO_SIZE
+#define PL330_SIM_MFIFO_SIZE        1024
+#endif
+
+/* Executed instructions after which a program is reported as runaway */
+#ifndef PL330_SIM_MAX_INSTRUCTIONS
+#define PL330_SIM_MAX_INSTRUCTIONS  (16U * 1024U * 1024U)
+#endif
+
+/**
+ * @brief  Result of pl330_sim_run()
+ */
+typedef enum _PL330_SIM_STATUS {
+    PL330_SIM_OK,                   /*!< DMAEND reached, or the cyclic pass limit */
+    PL330_SIM_ERR_OPCODE,           /*!< Unknown or unsupported instruction       */
+    PL330_SIM_ERR_PC,               /*!< PC or a jump left the program buffer     */
+    PL330_SIM_ERR_BUS,              /*!< Access outside the memory and peripheral */
+    PL330_SIM_ERR_MFIFO,            /*!< MFIFO overflow, underflow or left data   */
+    PL330_SIM_ERR_STALL,            /*!< DMAWFP with no request left to come      */
+    PL330_SIM_ERR_LIMIT,            /*!< PL330_SIM_MAX_INSTRUCTIONS exceeded      */
+} PL330_SIM_STATUS;
+
+/**
+ * @brief  Simulated memory, bus address base maps to data[0]
+ */
+typedef struct _pl330_sim_mem_t {
+    uint8_t                 *data;
+    uint32_t                base;
+    uint32_t                size;
+} pl330_sim_mem_t;
+
+/**
+ * @brief  Peripheral request model. The data register at addr is a FIFO:
+ *         loads from it return data[pos++], stores to it write data[pos++].
+ *         The peripheral signals a request while pos < len, a burst request
+ *         (for DMAWFP P) while at least burst_bytes are left, else a single.
+ */
+typedef struct _pl330_sim_periph_t {
+    uint8_t                 *data;
+    uint32_t                addr;
+    uint32_t                len;
+    uint32_t                pos;
+    uint32_t                burst_bytes;
+} pl330_sim_periph_t;
+
+/**
+ * @brief  Cost of the executed program
+ */
+typedef struct _pl330_sim_stats_t {
+    uint32_t                instructions;       /*!< Executed instructions              */
+    uint32_t                loads;              /*!< Read transfers issued (DMALD*)     */
+    uint32_t                stores;             /*!< Write transfers issued (DMAST*)    */
+    uint32_t                bursts;             /*!< Transfers of more than one beat    */
+    uint32_t                beats;              /*!< Bus beats of all transfers         */
+    uint32_t                bytes_loaded;       /*!< Bytes read from the source         */
+    uint32_t                bytes_stored;       /*!< Bytes written to the destination   */
+    uint32_t                periph_waits;       /*!< Executed DMAWFP                    */
+    uint32_t                flushes;            /*!< Executed DMAFLUSHP                 */
+    uint32_t                events;             /*!< Executed DMASEV                    */
+    uint32_t                loops;              /*!< Loops entered by DMALP             */
+    uint32_t                loop_jumps;         /*!< Backward jumps taken by DMALPEND   */
+    uint32_t                passes;             /*!< Passes of a DMALPFE loop           */
+    uint32_t                sar;                /*!< Final source address               */
+    uint32_t                dar;                /*!< Final destination address          */
+    uint16_t                mcode_size;         /*!< Highest executed program byte + 1  */
+    bool                    cyclic;             /*!< Stopped at the DMALPFE pass limit  */
+} pl330_sim_stats_t;
+
+/**
+ * @brief  Interpreter state, set up by the caller before pl330_sim_run()
+ */
+typedef struct _pl330_sim_t {
+    pl330_sim_mem_t         mem;                /*!< Simulated memory                   */
+    pl330_sim_periph_t      periph;             /*!< Peripheral, len 0 when unused      */
+    uint32_t                max_passes;         /*!< DMALPFE passes to run, 0 runs one  */
+    pl330_sim_stats_t       stats;              /*!< Filled in by pl330_sim_run()       */
+} pl330_sim_t;
+
+/**
+  \fn          PL330_SIM_STATUS pl330_sim_run(pl330_sim_t *sim, const uint8_t *mcode, uint16_t size)
+  \brief       Execute a channel program from its first byte. Loads fill the
+               MFIFO from SAR, stores drain it to DAR with the beat size and
+               burst length of the current CCR. Conditional single/burst
+               instructions follow the request type of the last DMAWFP and
+               always execute before any DMAWFP. Endian swapping, cache and
+               protection attributes are not modelled.
+  \param[in]   sim    Interpreter state, stats are cleared first
+  \param[in]   mcode  Channel program
+  \param[in]   size   Size of the program buffer
+  \return      \ref PL330_SIM_STATUS
+*/
+PL330_SIM_STATUS pl330_sim_run(pl330_sim_t *sim, const uint8_t *mcode, uint16_t size);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* PL330_SIM_H_ */
@@ -82,6 +82,41 @@ extern "C"
 
 #define OSPI_XIP_ENABLE_AES_DECRYPTION           0
 
+/**
+  \def OSPI_XIP_PREFETCH_ENABLE
+  \brief XIP read prefetch. Can be set to either 0(disable) or 1(enable).
+*/
+
+//   <o OSPI_XIP_PREFETCH_ENABLE> XIP read prefetch
+//      <0=>  Disable prefetch
+//      <1=>  Enable prefetch
+//   <i> The controller fetches the next sequential data while the current cache line fill is consumed.
+
+#define OSPI_XIP_PREFETCH_ENABLE                 1
+
+/**
+  \def OSPI_XIP_CONT_XFER_ENABLE
+  \brief XIP continuous transfer. Can be set to either 0(disable) or 1(enable).
+*/
+
+//   <o OSPI_XIP_CONT_XFER_ENABLE> XIP continuous transfer
+//      <0=>  Disable continuous transfer
+//      <1=>  Enable continuous transfer
+//   <i> Keep the flash selected between sequential XIP reads so a following line fill skips the command and address phase.
+
+#define OSPI_XIP_CONT_XFER_ENABLE                1
+
+/**
+  \def OSPI_XIP_CONT_XFER_TIMEOUT
+  \brief Continuous transfer timeout in OSPI clock cycles.
+*/
+
+//   <o> XIP continuous transfer timeout (in OSPI clock cycles) <1-255>
+//   <i> Idle cycles after which the flash is deselected in continuous transfer mode.
+//   <i> Default: 100
+
+#define OSPI_XIP_CONT_XFER_TIMEOUT               100
+
 // </h>
 //------------- <<< end of configuration section >>> ---------------------------
 
@@ -0,0 +1,47 @@
+/* Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+ * Use, distribution and modification of this code is permitted under the
+ * terms stated in the Alif Semiconductor Software License Agreement
+ *
+ * You should have received a copy of the Alif Semiconductor Software
+ * License Agreement with this file. If not, please write to:
+ * contact@alifsemi.com, or visit: https://alifsemi.com/license
+ *
+ */
+
+/**************************************************************************//**
+ * @file     ospi_xip_reloc.h
+ * @version  V1.0.0
+ * @brief    Section attributes for images executing from OSPI flash.
+ *           Marked functions and data are linked to run from ITCM / DTCM
+ *           and copied there from the XIP image by the startup copy table
+ *           (see Device/E7/AE722F80F55D5XX/linker_script/GCC/gcc_M55_HP_XIP.ld).
+ *           Functions and data can also be selected without source changes
+ *           through the ospi_xip_hot_itcm.ld / ospi_xip_hot_dtcm.ld fragments
+ *           that gcc_M55_HP_XIP.ld includes, generated by
+ *           ospi_xip/tools/xip_reloc_plan.py from a list of hot symbols.
+ * @bug      None.
+ * @Note     None
+ ******************************************************************************/
+
+#ifndef OSPI_XIP_RELOC_H
+#define OSPI_XIP_RELOC_H
+
+#ifdef  __cplusplus
+extern "C"
+{
+#endif
+
+/* Function executed from ITCM. noinline keeps the body out of XIP callers. */
+#define OSPI_XIP_ITCM_CODE          __attribute__((section(".itcm_text"), noinline))
+
+/* Initialized data placed in DTCM */
+#define OSPI_XIP_DTCM_DATA          __attribute__((section(".dtcm_data")))
+
+/* Read-only data (tables, coefficients) copied to DTCM */
+#define OSPI_XIP_DTCM_RODATA        __attribute__((section(".dtcm_rodata")))
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* OSPI_XIP_RELOC_H */
@@ -251,15 +251,19 @@ void ospi_xip_enter(ospi_flash_cfg_t *ospi_cfg, uint16_t incr_command, uint16_t
             | (0x0 << XIP_CTRL_INST_DDR_EN_OFFSET)
             | (0x1 << XIP_CTRL_RXDS_EN_OFFSET)
             | (0x1 << XIP_CTRL_INST_EN_OFFSET)
-            | (0x0 << XIP_CTRL_CONT_XFER_EN_OFFSET)
+            | (OSPI_XIP_CONT_XFER_ENABLE << XIP_CTRL_CONT_XFER_EN_OFFSET)
             | (0x0 << XIP_CTRL_HYPERBUS_EN_OFFSET)
             | (0x0 << XIP_CTRL_RXDS_SIG_EN)
             | (0x0 << XIP_CTRL_XIP_MBL_OFFSET)
-            | (0x0 << XIP_PREFETCH_EN_OFFSET)
+            | (OSPI_XIP_PREFETCH_ENABLE << XIP_PREFETCH_EN_OFFSET)
             | (0x0 << XIP_CTRL_RXDS_VL_EN_OFFSET);
 
     ospi_writel(ospi_cfg, xip_ctrl, val);
 
+#if OSPI_XIP_CONT_XFER_ENABLE
+    ospi_writel(ospi_cfg, xip_cnt_time_out, OSPI_XIP_CONT_XFER_TIMEOUT);
+#endif
+
     ospi_writel(ospi_cfg, rx_sample_dly, 0);
     ospi_cfg->aes_regs->aes_rxds_delay = 11;
 
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2023 Alif Semiconductor - All Rights Reserved.
+# Use, distribution and modification of this code is permitted under the
+# terms stated in the Alif Semiconductor Software License Agreement
+#
+# You should have received a copy of the Alif Semiconductor Software
+# License Agreement with this file. If not, please write to:
+# contact@alifsemi.com, or visit: https://alifsemi.com/license
+#
+
+"""Compute the TCM relocation plan of an OSPI XIP image.
+
+Reads the GNU ld map file of an image linked with gcc_M55_HP_XIP.ld and a
+list of hot symbols, one per line as "name [weight]" (weight e.g. a PC
+sample count from a profiling run, '#' starts a comment). Functions are
+matched to their .text.<name> input section, read-only data to
+.rodata.<name>, so the image must be built with -ffunction-sections and
+-fdata-sections.
+
+Symbols are taken by decreasing weight per byte (list order when no weight
+is given) while they fit in the ITCM / DTCM budget left after the sections
+already marked OSPI_XIP_ITCM_CODE / OSPI_XIP_DTCM_RODATA. The selected
+sections are written to the ospi_xip_hot_itcm.ld / ospi_xip_hot_dtcm.ld
+fragments included by the linker script; relink to apply the plan.
+
+Example:
+    xip_reloc_plan.py -m app.map -s hot.txt -o ospi_xip/config
+"""
+
+import argparse
+import os
+import re
+import sys
+
+ITCM_BUDGET = 0x40000           # __ITCM_RELOC_BUDGET in gcc_M55_HP_XIP.ld
+DTCM_BUDGET = 0x20000           # __DTCM_RELOC_BUDGET in gcc_M55_HP_XIP.ld
+SECTION_ALIGN = 4               # worst case padding per relocated section
+
+MAP_START = "Linker script and memory map"
+SECTION_RE = re.compile(r"^ (\.\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*))?$")
+ADDR_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(\S.*)$")
+
+
+def parse_map(path):
+    """Return {input section name: total size} from a GNU ld map file."""
+    sections = {}
+    pending = None
+    started = False
+
+    with open(path, encoding="utf-8", errors="replace") as fmap:
+        for line in fmap:
+            line = line.rstrip("\n")
+            if not started:
+                started = line.startswith(MAP_START)
+                continue
+
+            if pending is not None:
+                match = ADDR_RE.match(line)
+                if match:
+                    sections[pending] = sections.get(pending, 0) + int(match.group(2), 16)
+                pending = None
+                continue
+
+            match = SECTION_RE.match(line)
+            if not match:
+                continue
+            if match.group(2) is None:
+                # Long section names put address and size on the next line
+                pending = match.group(1)
+            else:
+                sections[match.group(1)] = sections.get(match.group(1), 0) + int(match.group(3), 16)
+
+    if not started:
+        raise ValueError("%s: not a GNU ld map file" % path)
+    return sections
+
+
+def parse_hot_list(path):
+    """Return [(symbol, weight or None)] in file order."""
+    symbols = []
+    with open(path, encoding="utf-8") as flist:
+        for lineno, line in enumerate(flist, 1):
+            fields = line.split("#", 1)[0].split()
+            if not fields:
+                continue
+            if len(fields) > 2:
+                raise ValueError("%s:%d: expected 'name [weight]'" % (path, lineno))
+            weight = float(fields[1]) if len(fields) == 2 else None
+            symbols.append((fields[0], weight))
+    return symbols
+
+
+def aligned(size):
+    return (size + SECTION_ALIGN - 1) & ~(SECTION_ALIGN - 1)
+
+
+def plan(sections, symbols, itcm_budget, dtcm_budget):
+    """Pick the input sections to relocate, returns the plan and a report."""
+    used = {
+        "itcm": sum(aligned(size) for name, size in sections.items() if name.startswith(".itcm_text")),
+        "dtcm": sum(aligned(size) for name, size in sections.items() if name.startswith(".dtcm_rodata")),
+    }
+    budget = {"itcm": itcm_budget, "dtcm": dtcm_budget}
+
+    candidates = []
+    missing = []
+    for order, (symbol, weight) in enumerate(symbols):
+        for prefix, region in ((".text.", "itcm"), (".rodata.", "dtcm")):
+            name = prefix + symbol
+            if name in sections:
+                candidates.append((order, symbol, weight, name, region, aligned(sections[name])))
+                break
+        else:
+            missing.append(symbol)
+
+    if any(weight is not None for _, _, weight, _, _, _ in candidates):
+        candidates.sort(key=lambda c: (-(c[2] or 0.0) / max(c[5], 1), c[0]))
+
+    selected = {"itcm": [], "dtcm": []}
+    skipped = []
+    for _, symbol, weight, name, region, size in candidates:
+        if used[region] + size <= budget[region]:
+            used[region] += size
+            selected[region].append((name, size, weight))
+        else:
+            skipped.append((symbol, region, size))
+
+    return selected, used, budget, missing, skipped
+
+
+def write_fragment(path, region, entries):
+    with open(path, "w", encoding="utf-8", newline="\n") as frag:
+        frag.write("/* Input sections relocated to %s, generated by xip_reloc_plan.py */\n" % region.upper())
+        for name, size, weight in entries:
+            note = "%d bytes" % size
+            if weight is not None:
+                note += ", weight %g" % weight
+            frag.write("    *(%s)    /* %s */\n" % (name, note))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("-m", "--map", required=True, help="GNU ld map file of the XIP image")
+    parser.add_argument("-s", "--symbols", required=True, help="hot symbol list, 'name [weight]' per line")
+    parser.add_argument("-o", "--outdir", help="directory for the linker fragments, report only when omitted")
+    parser.add_argument("--itcm-budget", type=lambda v: int(v, 0), default=ITCM_BUDGET,
+                        help="ITCM bytes for relocated code (default 0x%X)" % ITCM_BUDGET)
+    parser.add_argument("--dtcm-budget", type=lambda v: int(v, 0), default=DTCM_BUDGET,
+                        help="DTCM bytes for relocated read-only data (default 0x%X)" % DTCM_BUDGET)
+    parser.add_argument("--strict", action="store_true",
+                        help="fail when a listed symbol is missing or does not fit")
+    args = parser.parse_args()
+
+    try:
+        sections = parse_map(args.map)
+        symbols = parse_hot_list(args.symbols)
+    except (OSError, ValueError) as err:
+        print("error: %s" % err, file=sys.stderr)
+        return 2
+
+    selected, used, budget, missing, skipped = plan(sections, symbols, args.itcm_budget, args.dtcm_budget)
+
+    for region in ("itcm", "dtcm"):
+        print("%s: %d sections, %d / %d bytes" % (region.upper(), len(selected[region]), used[region], budget[region]))
+        for name, size, _ in selected[region]:
+            print("    %-48s %8d" % (name, size))
+    for symbol, region, size in skipped:
+        print("does not fit in %s: %s (%d bytes)" % (region.upper(), symbol, size))
+    for symbol in missing:
+        print("not found: %s (inlined, discarded or built without -ffunction-sections?)" % symbol)
+
+    if used["itcm"] > budget["itcm"] or used["dtcm"] > budget["dtcm"]:
+        print("error: sections marked in the source already exceed the budget", file=sys.stderr)
+        return 1
+
+    if args.outdir:
+        write_fragment(os.path.join(args.outdir, "ospi_xip_hot_itcm.ld"), "itcm", selected["itcm"])
+        write_fragment(os.path.join(args.outdir, "ospi_xip_hot_dtcm.ld"), "dtcm", selected["dtcm"])
+
+    return 1 if args.strict and (missing or skipped) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -347,6 +347,44 @@ typedef struct {
 	uint32_t trng_len;
 } net_proc_boot_args_t;
 
+/**
+ * Copies the response of one batch entry back to the caller
+ * @param packet      Response record as returned by SE
+ * @param user_data   Caller data registered with the entry
+ * @param error_code  Caller service error code location
+ */
+typedef void (*services_batch_unpack_t)(uintptr_t packet,
+					void *user_data,
+					uint32_t *error_code);
+
+/**
+ * @struct services_batch_entry_t
+ * @brief  One service record of a batch
+ */
+typedef struct {
+	uint16_t                service_id; /**< Service ID                   */
+	uint16_t                size;       /**< Record size in the arena     */
+	uint32_t                offset;     /**< Record offset in the arena   */
+	services_batch_unpack_t fn_unpack;  /**< Response unpack, may be NULL */
+	void                    *user_data;
+	uint32_t                *error_code;
+} services_batch_entry_t;
+
+/**
+ * @struct services_batch_t
+ * @brief  Batch of service records sent back to back to SE
+ */
+typedef struct {
+	uint8_t                 *arena;       /**< Record storage, 4 byte aligned  */
+	uint32_t                arena_size;
+	uint32_t                arena_used;
+	services_batch_entry_t  *entries;
+	uint32_t                *errors;      /**< Per entry transport error code  */
+	uint32_t                max_entries;
+	uint32_t                count;
+	uint32_t                waits;        /**< Blocking waits on SE responses  */
+} services_batch_t;
+
 /*******************************************************************************
  *  G L O B A L   D E F I N E S
  ******************************************************************************/
@@ -628,6 +666,21 @@ uint32_t SERVICES_pll_clkpll_is_locked(uint32_t services_handle, bool *is_locked
 uint32_t SERVICES_Boot_Net_Proc(uint32_t services_handle, net_proc_boot_args_t *boot_args, uint32_t *error_code);
 uint32_t SERVICES_Shutdown_Net_Proc(uint32_t services_handle, uint32_t *error_code);
 
+// Batch services
+void SERVICES_batch_init(services_batch_t *batch,
+			 uint8_t *arena, uint32_t arena_size,
+			 services_batch_entry_t *entries, uint32_t *errors,
+			 uint32_t max_entries);
+uintptr_t SERVICES_batch_add(services_batch_t *batch, uint16_t service_id,
+			     uint32_t size, services_batch_unpack_t fn_unpack,
+			     void *user_data, uint32_t *error_code);
+uint32_t SERVICES_batch_execute(uint32_t services_handle,
+				services_batch_t *batch,
+				uint32_t service_timeout);
+uint32_t SERVICES_batch_clocks_enable_clock(services_batch_t *batch, clock_enable_t clock, bool enable, uint32_t *error_code);
+uint32_t SERVICES_batch_get_run_cfg(services_batch_t *batch, run_profile_t *pp, uint32_t *error_code);
+uint32_t SERVICES_batch_set_run_cfg(services_batch_t *batch, run_profile_t *pp, uint32_t *error_code);
+
 // Update services
 uint32_t SERVICES_update_stoc(uint32_t services_handle,
 							  uint32_t image_address,
@@ -31,10 +31,40 @@ extern "C" {
  *  M A C R O   D E F I N E S
  ******************************************************************************/
 
+/**
+ * Maximum number of packet buffers in the asynchronous request pool
+ */
+#ifndef SERVICES_ASYNC_POOL_SIZE_MAX
+#define SERVICES_ASYNC_POOL_SIZE_MAX               8
+#endif
+
+/**
+ * Size of one asynchronous pool entry, rounded up to a D-Cache line so that
+ * cache maintenance on one request never touches a neighbouring buffer
+ */
+#define SERVICES_ASYNC_PACKET_STRIDE               \
+	((SERVICES_MAX_PACKET_BUFFER_SIZE + 31u) & ~31u)
+
+/**
+ * Asynchronous request handle returned when the pool is exhausted
+ */
+#define SERVICES_ASYNC_INVALID_HANDLE              0xFFFFFFFFul
+
 /*******************************************************************************
  *  T Y P E D E F S
  ******************************************************************************/
 
+/**
+ * Completion callback of an asynchronous service request, called from the
+ * MHU receive interrupt context.
+ * @param request     Handle returned by SERVICES_async_prepare()
+ * @param error_code  Transport layer error code of the request
+ * @param user_data   Pointer passed to SERVICES_async_submit()
+ */
+typedef void (*services_async_callback_t)(uint32_t request,
+					  uint32_t error_code,
+					  void *user_data);
+
 /**
  * @struct services_lib_t
  */
@@ -44,6 +74,10 @@ typedef struct {
 	wait_ms_t            fn_wait_ms;
 	uint32_t             wait_timeout;
 	print_msg_t          fn_print_msg;
+	uint32_t             packet_pool_address; /**< optional, 32 byte aligned,
+						 packet_pool_count entries of
+						 SERVICES_ASYNC_PACKET_STRIDE */
+	uint32_t             packet_pool_count;   /**< 0 disables async requests */
 } services_lib_t;
 
 /*******************************************************************************
@@ -60,6 +94,17 @@ int  SERVICES_synchronize_with_se(uint32_t services_handle);
 void SERVICES_send_msg_acked_callback(uint32_t sender_id, uint32_t channel_number);
 void SERVICES_rx_msg_callback(uint32_t receiver_id, uint32_t channel_number,
 			      uint32_t data);
+
+// Asynchronous (multi-outstanding) request APIs
+uint32_t  SERVICES_async_prepare(uint32_t size, uintptr_t *packet);
+uint32_t  SERVICES_async_submit(uint32_t services_handle, uint32_t request,
+				uint16_t service_id,
+				services_async_callback_t callback,
+				void *user_data);
+uint32_t  SERVICES_async_poll(uint32_t request);
+uint32_t  SERVICES_async_wait(uint32_t request, uint32_t service_timeout);
+void      SERVICES_async_release(uint32_t request);
+void      SERVICES_async_reset(void);
 #ifdef __cplusplus
 }
 #endif
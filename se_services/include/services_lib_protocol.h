@@ -101,8 +101,11 @@ extern "C" {
  */
 #define SERVICES_REQ_SUCCESS                       0x00
 #define SERVICES_REQ_NOT_ACKNOWLEDGE               0xFF
+#define SERVICES_REQ_PENDING                       0xFE
 #define SERVICES_REQ_TIMEOUT                       0xFD
 #define SERVICES_RESP_UNKNOWN_COMMAND              0xFC
+#define SERVICES_REQ_BATCH_FULL                    0xFB
+#define SERVICES_REQ_POOL_EXHAUSTED                0xFA
 
 /*******************************************************************************
  *  T Y P E D E F S
@@ -28,6 +28,7 @@
 #define SE_SERVICES_S_MHU             0           /* Secure MHU index             */
 #define SE_SERVICES_S_MHU_CHANNEL     0           /* Secure MHU channel number    */
 #define SE_SERVICES_MAX_TIMEOUT       0x01000000  /* Max timeout waiting for resp */
+#define SE_SERVICES_ASYNC_POOL_COUNT  4           /* Async requests in flight     */
 
 /* Set the IRQ Priority for MHU TX and RX IRQs */
 #define MHU_SESS_S_TX_IRQ_PRIORITY        2
@@ -44,6 +45,10 @@ static mhu_driver_out_t se_services_mhu_driver_out;
 static uint8_t
   se_services_packet_buffer[SERVICES_MAX_PACKET_BUFFER_SIZE] __attribute__ ((aligned (4)));
 
+/* Buffer pool for the asynchronous SE requests, one cache line aligned entry each */
+static uint8_t
+  se_services_packet_pool[SE_SERVICES_ASYNC_POOL_COUNT][SERVICES_ASYNC_PACKET_STRIDE] __attribute__ ((aligned (32)));
+
 /* Array holding the MHU Secure TX and RX address */
 static uint32_t se_services_sender_base_address_list[SE_SERVICES_MHU_COUNT] =
 {
@@ -111,6 +116,8 @@ static void se_services_initialize(MHU_send_message_t send_message)
          .fn_wait_ms            = &se_services_wait_ms,
          .wait_timeout          = SE_SERVICES_MAX_TIMEOUT,
          .fn_print_msg          = &se_services_print,
+         .packet_pool_address   = (uint32_t)se_services_packet_pool,
+         .packet_pool_count     = SE_SERVICES_ASYNC_POOL_COUNT,
     };
 
     SERVICES_initialize(&services_init_params);
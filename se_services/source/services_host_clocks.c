@@ -172,6 +172,50 @@ uint32_t SERVICES_clocks_enable_clock(uint32_t services_handle,
   return ret;
 }
 
+/**
+ * @brief Response unpacking of a batched clock enable
+ */
+static void clocks_enable_clock_unpack(uintptr_t packet, void *user_data,
+                                       uint32_t *error_code)
+{
+  clk_set_enable_svc_t * p_svc = (clk_set_enable_svc_t *)packet;
+
+  (void)user_data;
+  *error_code = p_svc->resp_error_code;
+}
+
+/**
+ * @fn   uint32_t SERVICES_batch_clocks_enable_clock(services_batch_t *batch,
+ *                                                   clock_enable_t clock,
+ *                                                   bool enable,
+ *                                                   uint32_t * error_code)
+ * @brief Queue a clock enable/disable in a batch
+ * @param batch
+ * @param clock             Clock to enable or disable
+ * @param enable            Enable/Disable flag
+ * @param error_code        Service error code, set when the batch executes
+ * @return                  SERVICES_REQ_BATCH_FULL if the record does not fit
+ */
+uint32_t SERVICES_batch_clocks_enable_clock(services_batch_t *batch,
+                                            clock_enable_t clock,
+                                            bool enable,
+                                            uint32_t * error_code)
+{
+  clk_set_enable_svc_t * p_svc =
+      (clk_set_enable_svc_t *)
+      SERVICES_batch_add(batch, SERVICE_CLOCK_SET_ENABLE,
+                         sizeof(clk_set_enable_svc_t),
+                         clocks_enable_clock_unpack, NULL, error_code);
+  if (NULL == p_svc)
+  {
+    return SERVICES_REQ_BATCH_FULL;
+  }
+
+  p_svc->send_clock_type = clock;
+  p_svc->send_enable = enable;
+  return SERVICES_REQ_SUCCESS;
+}
+
 /**
  * @fn  uint32_t SERVICES_clocks_set_ES0_frequency(uint32_t services_handle,
  *                                                 clock_frequency_t frequency,
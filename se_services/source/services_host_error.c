@@ -60,6 +60,12 @@ char *SERVICES_error_to_string(uint32_t error_code)
          p_str = "SERVICES_REQ_TIMEOUT          "; break;
        case SERVICES_RESP_UNKNOWN_COMMAND:
          p_str = "SERVICES_RESP_UNKNOWN_COMMAND "; break;
+       case SERVICES_REQ_PENDING:
+         p_str = "SERVICES_REQ_PENDING          "; break;
+       case SERVICES_REQ_BATCH_FULL:
+         p_str = "SERVICES_REQ_BATCH_FULL       "; break;
+       case SERVICES_REQ_POOL_EXHAUSTED:
+         p_str = "SERVICES_REQ_POOL_EXHAUSTED   "; break;
        default:
          p_str = ">>  Error UNKNOWN  <<"; break;
   }
@@ -31,9 +31,65 @@
 static services_lib_t s_services_host = {0};
 
 static uint32_t s_pkt_buffer_address_global = 0x0;
-static volatile bool s_service_req_ack_received = false;
+static volatile uint32_t s_ack_count = 0;
+static uint32_t s_send_count = 0;
+static uint32_t s_pkt_ack_seq = 0;
 static volatile bool s_new_msg_received = false;
 
+/**
+ * @enum  services_async_state_t
+ * @brief Life cycle of one asynchronous pool entry
+ */
+typedef enum {
+  SERVICES_ASYNC_FREE,        /* Available for SERVICES_async_prepare()  */
+  SERVICES_ASYNC_PREPARED,    /* Owned by the caller, not yet submitted  */
+  SERVICES_ASYNC_PENDING,     /* Sent to SE, waiting for the response    */
+  SERVICES_ASYNC_DONE,        /* Response received, waiting for release  */
+  SERVICES_ASYNC_QUARANTINED, /* Released while SE may still own it      */
+} services_async_state_t;
+
+/**
+ * @struct services_async_request_t
+ * @brief  Book-keeping of one asynchronous pool entry
+ */
+typedef struct {
+  volatile uint32_t         state;
+  volatile uint32_t         error_code;
+  uint32_t                  ack_seq;
+  uint32_t                  local_address;
+  uint32_t                  global_address;
+  services_async_callback_t callback;
+  void                     *user_data;
+} services_async_request_t;
+
+static services_async_request_t s_async_pool[SERVICES_ASYNC_POOL_SIZE_MAX];
+static uint32_t s_async_pool_count = 0;
+
+/**
+ * @brief Mask interrupts around pool book-keeping
+ */
+static inline uint32_t services_irq_save(void)
+{
+#if defined(A32)
+  __disable_irq();
+  return 0;
+#else
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  return primask;
+#endif
+}
+
+static inline void services_irq_restore(uint32_t primask)
+{
+#if defined(A32)
+  UNUSED(primask);
+  __enable_irq();
+#else
+  __set_PRIMASK(primask);
+#endif
+}
+
 /**
  * @brief Function to initialize the services library
  * @param init_params Initialization parameters
@@ -47,6 +103,29 @@ void SERVICES_initialize(services_lib_t * init_params)
   s_services_host.fn_wait_ms = init_params->fn_wait_ms;
   s_services_host.wait_timeout = init_params->wait_timeout,
   s_services_host.fn_print_msg = init_params->fn_print_msg;
+
+  s_async_pool_count = init_params->packet_pool_count;
+  if (s_async_pool_count > SERVICES_ASYNC_POOL_SIZE_MAX)
+  {
+    s_async_pool_count = SERVICES_ASYNC_POOL_SIZE_MAX;
+  }
+  if (0 == init_params->packet_pool_address)
+  {
+    s_async_pool_count = 0;
+  }
+  s_services_host.packet_pool_address = init_params->packet_pool_address;
+  s_services_host.packet_pool_count = s_async_pool_count;
+
+  for (uint32_t i = 0; i < s_async_pool_count; i++)
+  {
+    s_async_pool[i].state = SERVICES_ASYNC_FREE;
+    s_async_pool[i].local_address = init_params->packet_pool_address
+                                    + (i * SERVICES_ASYNC_PACKET_STRIDE);
+    s_async_pool[i].global_address =
+        LocalToGlobal((void *)s_async_pool[i].local_address);
+    s_async_pool[i].callback = NULL;
+    s_async_pool[i].user_data = NULL;
+  }
 }
 
 /**
@@ -131,7 +210,7 @@ static uint32_t services_get_channel_number(uint32_t services_handle)
 void SERVICES_send_msg_acked_callback(uint32_t sender_id,
                                       uint32_t channel_number)
 {
-  s_service_req_ack_received = true;
+  s_ack_count++;
   UNUSED(sender_id);
   UNUSED(channel_number);
 }
@@ -157,22 +236,64 @@ void SERVICES_rx_msg_callback(uint32_t receiver_id,
   {
     s_services_host.fn_print_msg("[SERVICESLIB] rx_msg=0x%x \n", service_data);
     s_new_msg_received = true;
+    return;
   }
-  else
+
+  // Match asynchronous requests by their packet buffer address
+  for (uint32_t i = 0; i < s_async_pool_count; i++)
   {
-    // @todo: handle invalid message
-    s_services_host.fn_print_msg("[SERVICESLIB] Invalid msg=0x%x\n",
-                                  service_data);
+    services_async_request_t * p_req = &s_async_pool[i];
+
+    if ((p_req->global_address == service_data)
+        && (SERVICES_ASYNC_QUARANTINED == p_req->state))
+    {
+      // SE is done with the buffer, nobody waits for the response
+      p_req->callback = NULL;
+      p_req->user_data = NULL;
+      p_req->state = SERVICES_ASYNC_FREE;
+      return;
+    }
+
+    if ((p_req->global_address == service_data)
+        && (SERVICES_ASYNC_PENDING == p_req->state))
+    {
+      service_header_t * p_header = (service_header_t *)p_req->local_address;
+
+      RTSS_InvalidateDCache_by_Addr((uint32_t *)p_req->local_address,
+                                    SERVICES_MAX_PACKET_BUFFER_SIZE);
+
+      p_req->error_code = p_header->hdr_error_code;
+      p_req->state = SERVICES_ASYNC_DONE;
+
+      if (NULL != p_req->callback)
+      {
+        p_req->callback(i, p_req->error_code, p_req->user_data);
+      }
+      return;
+    }
   }
+
+  // @todo: handle invalid message
+  s_services_host.fn_print_msg("[SERVICESLIB] Invalid msg=0x%x\n",
+                                service_data);
 }
 
 /**
- * @fn    uint32_t SERVICES_send_msg(uint32_t services_handle, uint32_t service_data)
- * @brief Send the MHU message pointed by 'service_data'
+ * @brief Send the MHU message pointed by 'service_data' and wait for its ACK
+ * @param services_handle
+ * @param services_data
+ * @param p_ack_seq  Returns the number of the message, ACKs arrive in send
+ *                   order so a late ACK of an earlier message is not taken
+ *                   for this one
  */
-uint32_t SERVICES_send_msg(uint32_t services_handle, uint32_t services_data)
+static uint32_t services_send_msg(uint32_t services_handle,
+                                  uint32_t services_data,
+                                  uint32_t *p_ack_seq)
 {
-    s_service_req_ack_received = false;
+    uint32_t primask = services_irq_save();
+    uint32_t ack_seq = ++s_send_count;
+    services_irq_restore(primask);
+    *p_ack_seq = ack_seq;
 
     // Send a MHU message
     uint32_t global_address = services_data;
@@ -182,7 +303,7 @@ uint32_t SERVICES_send_msg(uint32_t services_handle, uint32_t services_data)
 
     // Wait for a MHU 'send' ACK
     uint32_t timeout = SEND_MSG_ACK_TIMEOUT;
-    while (!s_service_req_ack_received)
+    while ((int32_t)(s_ack_count - ack_seq) < 0)
     {
       timeout--;
       if (0 == timeout) // ACK not received
@@ -193,6 +314,15 @@ uint32_t SERVICES_send_msg(uint32_t services_handle, uint32_t services_data)
     }
     return SERVICES_REQ_SUCCESS;
 }
+
+/**
+ * @fn    uint32_t SERVICES_send_msg(uint32_t services_handle, uint32_t service_data)
+ * @brief Send the MHU message pointed by 'service_data'
+ */
+uint32_t SERVICES_send_msg(uint32_t services_handle, uint32_t services_data)
+{
+    return services_send_msg(services_handle, services_data, &s_pkt_ack_seq);
+}
 /**
  * @brief Send services request to MHU
  * @param services_handle
@@ -253,3 +383,419 @@ uint32_t SERVICES_send_request(uint32_t services_handle,
 
   return p_header->hdr_error_code;
 }
+
+/**
+ * @fn    uint32_t SERVICES_async_prepare(uint32_t size, uintptr_t *packet)
+ * @brief Reserve and clear a packet buffer from the asynchronous pool
+ * @param size    Size of the service structure to be cleared
+ * @param packet  Returns the local address of the packet buffer
+ * @return        Request handle or SERVICES_ASYNC_INVALID_HANDLE if the
+ *                pool is exhausted
+ */
+uint32_t SERVICES_async_prepare(uint32_t size, uintptr_t *packet)
+{
+  uint32_t request = SERVICES_ASYNC_INVALID_HANDLE;
+
+  if ((NULL == packet) || (size > SERVICES_MAX_PACKET_BUFFER_SIZE))
+  {
+    return SERVICES_ASYNC_INVALID_HANDLE;
+  }
+
+  uint32_t primask = services_irq_save();
+  for (uint32_t i = 0; i < s_async_pool_count; i++)
+  {
+    if (SERVICES_ASYNC_FREE == s_async_pool[i].state)
+    {
+      s_async_pool[i].state = SERVICES_ASYNC_PREPARED;
+      request = i;
+      break;
+    }
+  }
+  services_irq_restore(primask);
+
+  if (SERVICES_ASYNC_INVALID_HANDLE != request)
+  {
+    memset((void *)s_async_pool[request].local_address, 0x0, size);
+    *packet = s_async_pool[request].local_address;
+  }
+
+  return request;
+}
+
+/**
+ * @fn    uint32_t SERVICES_async_submit(uint32_t services_handle,
+ *                                       uint32_t request,
+ *                                       uint16_t service_id,
+ *                                       services_async_callback_t callback,
+ *                                       void *user_data)
+ * @brief Send a prepared request to SE without waiting for the response
+ * @param services_handle
+ * @param request     Handle returned by SERVICES_async_prepare()
+ * @param service_id
+ * @param callback    Completion callback (may be NULL when polling)
+ * @param user_data   Passed back to the callback
+ * @return            Transport layer error code of the MHU send
+ * @note  Only the MHU ACK of the doorbell is waited for, the response is
+ *        matched in SERVICES_rx_msg_callback() by packet buffer address.
+ *        On an error SE may still have received the request, so it stays
+ *        pending and SERVICES_async_release() quarantines it.
+ */
+uint32_t SERVICES_async_submit(uint32_t services_handle,
+                               uint32_t request,
+                               uint16_t service_id,
+                               services_async_callback_t callback,
+                               void *user_data)
+{
+  if ((request >= s_async_pool_count)
+      || (SERVICES_ASYNC_PREPARED != s_async_pool[request].state))
+  {
+    return SERVICES_REQ_NOT_ACKNOWLEDGE;
+  }
+
+  services_async_request_t * p_req = &s_async_pool[request];
+  service_header_t * p_header = (service_header_t *)p_req->local_address;
+
+  s_services_host.fn_print_msg("[SERVICESLIB] Submit service request 0x%x\n",
+                               service_id);
+
+  p_header->hdr_service_id = service_id;
+  p_header->hdr_flags = 0;
+
+  p_req->callback = callback;
+  p_req->user_data = user_data;
+  p_req->error_code = SERVICES_REQ_PENDING;
+  p_req->state = SERVICES_ASYNC_PENDING;
+
+  RTSS_CleanDCache_by_Addr((uint32_t *)p_req->local_address,
+                           SERVICES_MAX_PACKET_BUFFER_SIZE);
+
+  return services_send_msg(services_handle, p_req->global_address,
+                           &p_req->ack_seq);
+}
+
+/**
+ * @fn    uint32_t SERVICES_async_poll(uint32_t request)
+ * @brief Query the state of a submitted request
+ * @param request
+ * @return SERVICES_REQ_PENDING while in flight, else the transport layer
+ *         error code of the response
+ */
+uint32_t SERVICES_async_poll(uint32_t request)
+{
+  if (request >= s_async_pool_count)
+  {
+    return SERVICES_REQ_NOT_ACKNOWLEDGE;
+  }
+
+  if (SERVICES_ASYNC_DONE != s_async_pool[request].state)
+  {
+    return SERVICES_REQ_PENDING;
+  }
+
+  return s_async_pool[request].error_code;
+}
+
+/**
+ * @fn    uint32_t SERVICES_async_wait(uint32_t request,
+ *                                     uint32_t service_timeout)
+ * @brief Wait for a submitted request to complete
+ * @param request
+ * @param service_timeout  Number of polls, DEFAULT_TIMEOUT uses the library
+ *                         wait timeout
+ * @return Transport layer error code
+ */
+uint32_t SERVICES_async_wait(uint32_t request, uint32_t service_timeout)
+{
+  uint32_t timeout = service_timeout != DEFAULT_TIMEOUT
+                     ? service_timeout :
+                     s_services_host.wait_timeout;
+  uint32_t ret;
+
+  while (SERVICES_REQ_PENDING == (ret = SERVICES_async_poll(request)))
+  {
+    timeout--;
+    if (0 == timeout) // No response from SE
+    {
+      return SERVICES_REQ_TIMEOUT;
+    }
+  }
+
+  return ret;
+}
+
+/**
+ * @fn    void SERVICES_async_release(uint32_t request)
+ * @brief Return a request to the pool
+ * @param request
+ * @note  A request that is still pending (timed out or not acknowledged) is
+ *        quarantined instead, SE still owns its packet buffer. The entry
+ *        returns to the pool when SE answers or SERVICES_async_reset() is
+ *        called.
+ */
+void SERVICES_async_release(uint32_t request)
+{
+  if (request >= s_async_pool_count)
+  {
+    return;
+  }
+
+  services_async_request_t * p_req = &s_async_pool[request];
+  uint32_t primask = services_irq_save();
+
+  if (SERVICES_ASYNC_PENDING == p_req->state)
+  {
+    p_req->state = SERVICES_ASYNC_QUARANTINED;
+  }
+  else if (SERVICES_ASYNC_QUARANTINED != p_req->state)
+  {
+    p_req->callback = NULL;
+    p_req->user_data = NULL;
+    p_req->state = SERVICES_ASYNC_FREE;
+  }
+
+  services_irq_restore(primask);
+}
+
+/**
+ * @fn    void SERVICES_async_reset(void)
+ * @brief Return the quarantined requests to the pool
+ * @note  Only call once SE can no longer answer them, e.g. after the MHU
+ *        link was reset and SERVICES_synchronize_with_se() succeeded.
+ */
+void SERVICES_async_reset(void)
+{
+  uint32_t primask = services_irq_save();
+
+  for (uint32_t i = 0; i < s_async_pool_count; i++)
+  {
+    if (SERVICES_ASYNC_QUARANTINED == s_async_pool[i].state)
+    {
+      s_async_pool[i].callback = NULL;
+      s_async_pool[i].user_data = NULL;
+      s_async_pool[i].state = SERVICES_ASYNC_FREE;
+    }
+  }
+
+  // ACKs lost with the link are not waited for
+  s_ack_count = s_send_count;
+
+  services_irq_restore(primask);
+}
+
+/**
+ * @fn    void SERVICES_batch_init(services_batch_t *batch,
+ *                                 uint8_t *arena, uint32_t arena_size,
+ *                                 services_batch_entry_t *entries,
+ *                                 uint32_t *errors, uint32_t max_entries)
+ * @brief Initialize an empty batch on caller provided storage
+ * @param batch
+ * @param arena        Storage for the packed service records
+ * @param arena_size
+ * @param entries      Entry descriptors, max_entries long
+ * @param errors       Per entry transport error codes, max_entries long
+ * @param max_entries
+ */
+void SERVICES_batch_init(services_batch_t *batch,
+                         uint8_t *arena, uint32_t arena_size,
+                         services_batch_entry_t *entries, uint32_t *errors,
+                         uint32_t max_entries)
+{
+  batch->arena = arena;
+  batch->arena_size = arena_size;
+  batch->arena_used = 0;
+  batch->entries = entries;
+  batch->errors = errors;
+  batch->max_entries = max_entries;
+  batch->count = 0;
+  batch->waits = 0;
+}
+
+/**
+ * @fn    uintptr_t SERVICES_batch_add(services_batch_t *batch,
+ *                                     uint16_t service_id, uint32_t size,
+ *                                     services_batch_unpack_t fn_unpack,
+ *                                     void *user_data, uint32_t *error_code)
+ * @brief Append a cleared service record to the batch
+ * @param batch
+ * @param service_id
+ * @param size         Size of the service structure
+ * @param fn_unpack    Called with the response once the entry succeeded
+ * @param user_data
+ * @param error_code   Service error code location passed to fn_unpack, one
+ *                     per entry
+ * @return             Record to be filled in, 0 if the batch is full
+ */
+uintptr_t SERVICES_batch_add(services_batch_t *batch, uint16_t service_id,
+                             uint32_t size, services_batch_unpack_t fn_unpack,
+                             void *user_data, uint32_t *error_code)
+{
+  uint32_t offset = (batch->arena_used + 3u) & ~3u;
+
+  if ((batch->count >= batch->max_entries)
+      || (size > SERVICES_MAX_PACKET_BUFFER_SIZE)
+      || ((offset + size) > batch->arena_size))
+  {
+    return 0;
+  }
+
+  services_batch_entry_t * p_entry = &batch->entries[batch->count];
+  p_entry->service_id = service_id;
+  p_entry->size = (uint16_t)size;
+  p_entry->offset = offset;
+  p_entry->fn_unpack = fn_unpack;
+  p_entry->user_data = user_data;
+  p_entry->error_code = error_code;
+
+  batch->errors[batch->count] = SERVICES_REQ_PENDING;
+  batch->arena_used = offset + size;
+  batch->count++;
+
+  memset(&batch->arena[offset], 0x0, size);
+  return (uintptr_t)&batch->arena[offset];
+}
+
+/**
+ * @brief Copy the response of a finished entry back and unpack it
+ */
+static void services_batch_complete(services_batch_t *batch,
+                                    uint32_t index,
+                                    uintptr_t packet,
+                                    uint32_t error_code)
+{
+  services_batch_entry_t * p_entry = &batch->entries[index];
+  uint8_t * p_record = &batch->arena[p_entry->offset];
+
+  batch->errors[index] = error_code;
+  if (SERVICES_REQ_TIMEOUT == error_code)
+  {
+    return;
+  }
+
+  memcpy(p_record, (void *)packet, p_entry->size);
+  if ((SERVICES_REQ_SUCCESS == error_code) && (NULL != p_entry->fn_unpack))
+  {
+    p_entry->fn_unpack((uintptr_t)p_record, p_entry->user_data,
+                       p_entry->error_code);
+  }
+}
+
+/**
+ * @fn    uint32_t SERVICES_batch_execute(uint32_t services_handle,
+ *                                        services_batch_t *batch,
+ *                                        uint32_t service_timeout)
+ * @brief Send all batch records to SE and collect the responses
+ * @param services_handle
+ * @param batch
+ * @param service_timeout
+ * @return First transport layer error code, SERVICES_REQ_SUCCESS if every
+ *         entry succeeded. Entries never sent keep SERVICES_REQ_PENDING.
+ *         SERVICES_REQ_POOL_EXHAUSTED when no pool entry is free and none of
+ *         the batch is in flight.
+ * @note  With an asynchronous pool the records are submitted back to back
+ *        and only the oldest response is waited for when the pool runs
+ *        dry, SE serves them in order. Without a pool every record is sent
+ *        through the single packet buffer.
+ */
+uint32_t SERVICES_batch_execute(uint32_t services_handle,
+                                services_batch_t *batch,
+                                uint32_t service_timeout)
+{
+  uint32_t ret = SERVICES_REQ_SUCCESS;
+  uint32_t next = 0;
+
+  batch->waits = 0;
+
+  if (0 == s_async_pool_count)
+  {
+    for (next = 0; next < batch->count; next++)
+    {
+      services_batch_entry_t * p_entry = &batch->entries[next];
+      uintptr_t packet = SERVICES_prepare_packet_buffer(p_entry->size);
+
+      memcpy((void *)packet, &batch->arena[p_entry->offset], p_entry->size);
+      uint32_t err = SERVICES_send_request(services_handle,
+                                           p_entry->service_id,
+                                           service_timeout);
+      batch->waits++;
+
+      services_batch_complete(batch, next, packet, err);
+      if (err != SERVICES_REQ_SUCCESS)
+      {
+        return err;
+      }
+    }
+    return ret;
+  }
+
+  uint32_t ring_entry[SERVICES_ASYNC_POOL_SIZE_MAX];
+  uint32_t ring_request[SERVICES_ASYNC_POOL_SIZE_MAX];
+  uint32_t head = 0;
+  uint32_t in_flight = 0;
+
+  while (1)
+  {
+    // Keep the pool full
+    while ((next < batch->count) && (SERVICES_REQ_SUCCESS == ret)
+           && (in_flight < s_async_pool_count))
+    {
+      services_batch_entry_t * p_entry = &batch->entries[next];
+      uintptr_t packet;
+      uint32_t request = SERVICES_async_prepare(p_entry->size, &packet);
+      if (SERVICES_ASYNC_INVALID_HANDLE == request)
+      {
+        // Held by other callers or quarantined, no response frees one
+        if (0 == in_flight)
+        {
+          batch->errors[next] = SERVICES_REQ_POOL_EXHAUSTED;
+          ret = SERVICES_REQ_POOL_EXHAUSTED;
+        }
+        break;
+      }
+
+      memcpy((void *)packet, &batch->arena[p_entry->offset], p_entry->size);
+      uint32_t err = SERVICES_async_submit(services_handle, request,
+                                           p_entry->service_id,
+                                           NULL, NULL);
+      if (err != SERVICES_REQ_SUCCESS)
+      {
+        SERVICES_async_release(request);
+        batch->errors[next] = err;
+        ret = err;
+        break;
+      }
+
+      uint32_t slot = (head + in_flight) % SERVICES_ASYNC_POOL_SIZE_MAX;
+      ring_entry[slot] = next;
+      ring_request[slot] = request;
+      in_flight++;
+      next++;
+    }
+
+    if (0 == in_flight)
+    {
+      break;
+    }
+
+    // Retire the oldest request
+    uint32_t request = ring_request[head];
+    if (SERVICES_REQ_PENDING == SERVICES_async_poll(request))
+    {
+      batch->waits++;
+    }
+    uint32_t err = SERVICES_async_wait(request, service_timeout);
+
+    services_batch_complete(batch, ring_entry[head],
+                            s_async_pool[request].local_address, err);
+    // A timed out request is quarantined until SE answers
+    SERVICES_async_release(request);
+    if ((err != SERVICES_REQ_SUCCESS) && (SERVICES_REQ_SUCCESS == ret))
+    {
+      ret = err;
+    }
+
+    head = (head + 1) % SERVICES_ASYNC_POOL_SIZE_MAX;
+    in_flight--;
+  }
+
+  return ret;
+}
@@ -45,24 +45,18 @@
  ******************************************************************************/
 
 /**
- * @brief aiPM RUN
+ * @brief aiPM RUN get response unpacking
  *
- * @param services_handle
- * @param pp
+ * @param packet      aipm_get_run_profile_svc_t response
+ * @param user_data   run_profile_t to fill in
  * @param error_code
- * @return
  */
-uint32_t SERVICES_get_run_cfg(uint32_t services_handle, run_profile_t *pp,
-                              uint32_t *error_code)
+static void get_run_cfg_unpack(uintptr_t packet, void *user_data,
+                               uint32_t *error_code)
 {
-  uint32_t srv_error_code = 0; /* Service function call return */
-
-  aipm_get_run_profile_svc_t * p_svc = (aipm_get_run_profile_svc_t *)
-      SERVICES_prepare_packet_buffer(sizeof(aipm_get_run_profile_svc_t));
+  aipm_get_run_profile_svc_t * p_svc = (aipm_get_run_profile_svc_t *)packet;
+  run_profile_t * pp = (run_profile_t *)user_data;
 
-  srv_error_code = SERVICES_send_request(services_handle,
-                                         SERVICE_POWER_GET_RUN_REQ_ID,
-                                         DEFAULT_TIMEOUT);
   *error_code = p_svc->resp_error_code; /* return actual call error */
 
   pp->aon_clk_src       = p_svc->resp_aon_clk_src;
@@ -80,26 +74,17 @@ uint32_t SERVICES_get_run_cfg(uint32_t services_handle, run_profile_t *pp,
   pp->ewic_cfg          = p_svc->resp_ewic_cfg;
   pp->vtor_address      = p_svc->resp_vtor_address;
   pp->vtor_address_ns   = p_svc->resp_vtor_address_ns;
-
-  return srv_error_code;  /* Return */
 }
 
 /**
- * @brief aiPM RUN
+ * @brief aiPM RUN set request packing
  *
- * @param services_handle
+ * @param p_svc
  * @param pp
- * @param error_code
- * @return
  */
-uint32_t SERVICES_set_run_cfg(uint32_t services_handle, run_profile_t *pp,
-                              uint32_t *error_code)
+static void set_run_cfg_pack(aipm_set_run_profile_svc_t *p_svc,
+                             run_profile_t *pp)
 {
-  uint32_t srv_error_code = 0; /* Service function call return */
-
-  aipm_set_run_profile_svc_t * p_svc = (aipm_set_run_profile_svc_t *)
-      SERVICES_prepare_packet_buffer(sizeof(aipm_set_run_profile_svc_t));
-
   /**
    * pack ready to send
    * @todo use memcpy()
@@ -119,15 +104,118 @@ uint32_t SERVICES_set_run_cfg(uint32_t services_handle, run_profile_t *pp,
   p_svc->send_ewic_cfg         = pp->ewic_cfg;
   p_svc->send_vtor_address     = pp->vtor_address;
   p_svc->send_vtor_address_ns  = pp->vtor_address_ns;
+}
+
+/**
+ * @brief aiPM RUN set response unpacking
+ *
+ * @param packet      aipm_set_run_profile_svc_t response
+ * @param user_data   unused
+ * @param error_code
+ */
+static void set_run_cfg_unpack(uintptr_t packet, void *user_data,
+                               uint32_t *error_code)
+{
+  aipm_set_run_profile_svc_t * p_svc = (aipm_set_run_profile_svc_t *)packet;
+
+  (void)user_data;
+  *error_code = p_svc->resp_error_code; /* return actual call error */
+}
+
+/**
+ * @brief aiPM RUN
+ *
+ * @param services_handle
+ * @param pp
+ * @param error_code
+ * @return
+ */
+uint32_t SERVICES_get_run_cfg(uint32_t services_handle, run_profile_t *pp,
+                              uint32_t *error_code)
+{
+  uint32_t srv_error_code = 0; /* Service function call return */
+
+  aipm_get_run_profile_svc_t * p_svc = (aipm_get_run_profile_svc_t *)
+      SERVICES_prepare_packet_buffer(sizeof(aipm_get_run_profile_svc_t));
+
+  srv_error_code = SERVICES_send_request(services_handle,
+                                         SERVICE_POWER_GET_RUN_REQ_ID,
+                                         DEFAULT_TIMEOUT);
+  get_run_cfg_unpack((uintptr_t)p_svc, pp, error_code);
+
+  return srv_error_code;  /* Return */
+}
+
+/**
+ * @brief aiPM RUN
+ *
+ * @param services_handle
+ * @param pp
+ * @param error_code
+ * @return
+ */
+uint32_t SERVICES_set_run_cfg(uint32_t services_handle, run_profile_t *pp,
+                              uint32_t *error_code)
+{
+  uint32_t srv_error_code = 0; /* Service function call return */
+
+  aipm_set_run_profile_svc_t * p_svc = (aipm_set_run_profile_svc_t *)
+      SERVICES_prepare_packet_buffer(sizeof(aipm_set_run_profile_svc_t));
+
+  set_run_cfg_pack(p_svc, pp);
 
   srv_error_code = SERVICES_send_request(services_handle,
                                          SERVICE_POWER_SET_RUN_REQ_ID,
                                          DEFAULT_TIMEOUT);
-  *error_code = p_svc->resp_error_code; /* return actual call error */
+  set_run_cfg_unpack((uintptr_t)p_svc, NULL, error_code);
 
    return srv_error_code;  /* Return error */
 }
 
+/**
+ * @brief aiPM RUN get, queued in a batch
+ *
+ * @param batch
+ * @param pp          Filled in when the batch is executed
+ * @param error_code
+ * @return            SERVICES_REQ_BATCH_FULL if the record does not fit
+ */
+uint32_t SERVICES_batch_get_run_cfg(services_batch_t *batch,
+                                    run_profile_t *pp,
+                                    uint32_t *error_code)
+{
+  uintptr_t packet = SERVICES_batch_add(batch, SERVICE_POWER_GET_RUN_REQ_ID,
+                                        sizeof(aipm_get_run_profile_svc_t),
+                                        get_run_cfg_unpack, pp, error_code);
+
+  return (0 == packet) ? SERVICES_REQ_BATCH_FULL : SERVICES_REQ_SUCCESS;
+}
+
+/**
+ * @brief aiPM RUN set, queued in a batch
+ *
+ * @param batch
+ * @param pp          Packed immediately, may be reused afterwards
+ * @param error_code
+ * @return            SERVICES_REQ_BATCH_FULL if the record does not fit
+ */
+uint32_t SERVICES_batch_set_run_cfg(services_batch_t *batch,
+                                    run_profile_t *pp,
+                                    uint32_t *error_code)
+{
+  aipm_set_run_profile_svc_t * p_svc = (aipm_set_run_profile_svc_t *)
+      SERVICES_batch_add(batch, SERVICE_POWER_SET_RUN_REQ_ID,
+                         sizeof(aipm_set_run_profile_svc_t),
+                         set_run_cfg_unpack, NULL, error_code);
+  if (NULL == p_svc)
+  {
+    return SERVICES_REQ_BATCH_FULL;
+  }
+
+  set_run_cfg_pack(p_svc, pp);
+  return SERVICES_REQ_SUCCESS;
+}
+
 /**
  * @brief aiPM OFF
  *
@@ -29,6 +29,7 @@
  *  M A C R O   D E F I N E S
  ******************************************************************************/
 #define PRINT_BUFFER_MAXIMUM  256 /* Max size of TTY print buffer */
+#define PACKET_POOL_COUNT     4   /* Async requests in flight          */
 
 #define TEST_PRINT_ENABLE           1   /* Enable printing from Test harness  */
 #define PRINT_VIA_CONSOLE           0   /* Print via Debugger console         */
@@ -43,6 +44,8 @@
  ******************************************************************************/
 static uint8_t
   s_packet_buffer[SERVICES_MAX_PACKET_BUFFER_SIZE] __attribute__ ((aligned (4)));
+static uint8_t
+  s_packet_pool[PACKET_POOL_COUNT][SERVICES_ASYNC_PACKET_STRIDE] __attribute__ ((aligned (32)));
 
 debug_print_function_t drv_debug_print_fn;
 
@@ -110,6 +113,8 @@ void SERVICES_Setup(MHU_send_message_t send_message, uint32_t timeout)
     .fn_wait_ms            = &SERVICES_wait_ms,
     .wait_timeout          = timeout,
     .fn_print_msg          = &SERVICES_print,
+    .packet_pool_address   = (uint32_t)s_packet_pool,
+    .packet_pool_count     = PACKET_POOL_COUNT,
   };
   drv_debug_print_fn = &SERVICES_print;
 
@@ -27,6 +27,7 @@
 #include "services_lib_linux.h"
 #else
 #include "services_lib_interface.h"
+#include "services_lib_ids.h"
 #endif
 
 
@@ -90,6 +91,7 @@ static uint32_t test_services_ldo_voltage(char *p_test_name,
 
 static uint32_t test_services_get_bus_frequencies(char *p_test_name, uint32_t services_handle);
 static uint32_t test_services_get_eui(char *p_test_name, uint32_t services_handle);
+static uint32_t test_services_async_heartbeat(char *p_test_name, uint32_t services_handle);
 
 /*******************************************************************************
  *  M A C R O   D E F I N E S
@@ -223,6 +225,7 @@ static services_test_t s_tests[] =
     { test_services_ldo_voltage,             "LDO voltage control    "     , false},  /*51*/
     { test_services_get_bus_frequencies,     "Get BUS frequencies    "     , false},  /*52*/
     { test_services_get_eui,                 "Get EUI-48/EUI-64 extensions", false},  /*53*/
+    { test_services_async_heartbeat,         "Async heartbeat burst  "     , false},  /*54*/
 };
 
 static SERVICES_toc_data_t     toc_info;    /*!< Global to test harness */
@@ -523,6 +526,68 @@ static uint32_t test_services_heartbeat(char *p_test_name,
   return (error_code);
 }
 
+/**
+ * @fn    static uint32_t test_services_async_heartbeat(char *p_test_name,
+ *                                                      uint32_t services_handle)
+ * @brief Keep the asynchronous request pool full of heartbeat requests and
+ *        check every response
+ * @param p_test_name
+ * @param services_handle
+ * @return
+ */
+static uint32_t test_services_async_heartbeat(char *p_test_name,
+                                              uint32_t services_handle)
+{
+  uint32_t error_code = SERVICES_REQ_SUCCESS;
+#ifndef A32_LINUX
+  uint32_t requests[SERVICES_ASYNC_POOL_SIZE_MAX];
+  uint32_t submitted = 0;
+  uintptr_t packet;
+
+  /* Fill the pool, no response is waited for between the submits */
+  while (submitted < SERVICES_ASYNC_POOL_SIZE_MAX)
+  {
+    uint32_t request = SERVICES_async_prepare(sizeof(service_header_t),
+                                              &packet);
+    if (SERVICES_ASYNC_INVALID_HANDLE == request)
+    {
+      break;
+    }
+
+    error_code = SERVICES_async_submit(services_handle, request,
+                                       SERVICE_MAINTENANCE_HEARTBEAT_ID,
+                                       NULL, NULL);
+    if (error_code != SERVICES_REQ_SUCCESS)
+    {
+      SERVICES_async_release(request);
+      break;
+    }
+    requests[submitted++] = request;
+  }
+
+  /* Collect the responses */
+  for (uint32_t i = 0; i < submitted; i++)
+  {
+    uint32_t ret = SERVICES_async_wait(requests[i], DEFAULT_TIMEOUT);
+    if (ret != SERVICES_REQ_SUCCESS)
+    {
+      error_code = ret;
+    }
+    SERVICES_async_release(requests[i]);
+  }
+
+  TEST_print(services_handle, "** TEST %s requests=%d error_code=%s\n",
+                              p_test_name,
+                              submitted,
+                              SERVICES_error_to_string(error_code));
+#else
+  (void)p_test_name;
+  (void)services_handle;
+#endif
+
+  return (error_code);
+}
+
 /**
   * System management Services
   */